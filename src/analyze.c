@@ -506,6 +506,10 @@ static progType analyzeProg (const const_striType sourceFileArgument,
           write_idents(resultProg);
         } /* if */
         clean_idents(resultProg);
+        if (options & TIERED_EXECUTION) {
+          resultProg->source_time = newestSourceFileTime(
+              (rtlHashType) resultProg->includeFileHash, resultProg->program_path);
+        } /* if */
         shutIncludeFileHash((rtlHashType) resultProg->includeFileHash);
         resultProg->includeFileHash = NULL;
         if (options & SHOW_STATISTICS) {
@@ -160,6 +160,12 @@
  *      C programs are compiled with a 64-bit C compiler.
  *  CC_OPT_LINK_TIME_OPTIMIZATION: (optional)
  *      Contains the compiler option for link time optimization (e.g.: "-flto").
+ *  CC_OPT_PROFILE_GENERATE: (optional)
+ *      Contains the compiler and linker option to generate a program,
+ *      which writes profile data (e.g.: "-fprofile-generate").
+ *  CC_OPT_PROFILE_USE: (optional)
+ *      Contains the compiler option to optimize with the profile data
+ *      of a previous run (e.g.: "-fprofile-use").
  *  LINKER_OPT_STATIC_LINKING: (optional)
  *      Contains the linker option to force static linking (e.g.: "-static").
  *  LINKER_OPT_DYN_LINK_LIBS: (optional)
@@ -4449,6 +4455,69 @@ static void determinePreprocessorProperties (FILE *versionFile)
 
 
 
+static void determineIntrinsicsProperties (FILE *versionFile)
+
+  { /* determineIntrinsicsProperties */
+    /* Functions with the target attribute are only executed if */
+    /* cpuid reports that the CPU supports the instructions.    */
+    fprintf(versionFile, "#define HAS_SHA_INTRINSICS %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <immintrin.h>\n"
+                             "#include <cpuid.h>\n"
+                             "__attribute__((target(\"sha,sse4.1,ssse3\")))\n"
+                             "static int shaTest (unsigned int *hash) {\n"
+                             "__m128i state = _mm_loadu_si128((const __m128i *) hash);\n"
+                             "state = _mm_sha256rnds2_epu32(state, state, state);\n"
+                             "state = _mm_sha1rnds4_epu32(state, state, 0);\n"
+                             "state = _mm_shuffle_epi8(state, state);\n"
+                             "return _mm_extract_epi32(state, 3);}\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "unsigned int hash[4] = {0, 0, 0, 0};\n"
+                             "unsigned int eax, ebx, ecx, edx;\n"
+                             "if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&\n"
+                             "    (ebx & (1 << 29)) != 0) {\n"
+                             "  printf(\"%d\\n\", shaTest(hash));\n"
+                             "} else {\n"
+                             "  printf(\"0\\n\");\n"
+                             "}\n"
+                             "return 0;}\n"));
+    /* SSE2 intrinsics are used without target attribute. */
+    /* This works only if SSE2 is part of the base ISA.   */
+    fprintf(versionFile, "#define HAS_SSE2_INTRINSICS %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <emmintrin.h>\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "short data[8] = {1, 2, 3, 4, 5, 6, 7, 8};\n"
+                             "__m128i vect = _mm_loadu_si128((const __m128i *) data);\n"
+                             "vect = _mm_mulhi_epi16(_mm_slli_epi16(vect, 12), vect);\n"
+                             "vect = _mm_madd_epi16(vect, vect);\n"
+                             "vect = _mm_packs_epi32(_mm_mul_epu32(vect, vect), vect);\n"
+                             "_mm_storeu_si128((__m128i *) data, vect);\n"
+                             "printf(\"%d\\n\", data[0] == 0);\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
+    fprintf(versionFile, "#define HAS_AVX2_INTRINSICS %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <immintrin.h>\n"
+                             "__attribute__((target(\"avx2\")))\n"
+                             "static int avx2Test (int *data) {\n"
+                             "__m256i vect = _mm256_loadu_si256((const __m256i *) data);\n"
+                             "vect = _mm256_mullo_epi32(vect, _mm256_set1_epi32(3));\n"
+                             "vect = _mm256_permute2x128_si256(vect, vect, 0x31);\n"
+                             "return _mm_extract_epi16(_mm256_extracti128_si256(vect, 1), 0);}\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "int data[8] = {1, 2, 3, 4, 5, 6, 7, 8};\n"
+                             "__builtin_cpu_init();\n"
+                             "if (__builtin_cpu_supports(\"avx2\")) {\n"
+                             "  printf(\"%d\\n\", avx2Test(data));\n"
+                             "} else {\n"
+                             "  printf(\"0\\n\");\n"
+                             "}\n"
+                             "return 0;}\n"));
+  } /* determineIntrinsicsProperties */
+
+
+
 static void localtimeProperties (FILE *versionFile)
 
   { /* localtimeProperties */
@@ -6811,6 +6880,24 @@ static void determineOsFunctions (FILE *versionFile)
                              "{printf(\"%d\\n\", test(\"asdf\") == 4);\n"
                              "return 0;}\n") &&
             doTest() == 1);
+    fprintf(versionFile,
+            "#define HAS_PTHREADS %d\n",
+            compileAndLinkOk("#include <stdio.h>\n#include <unistd.h>\n"
+                             "#include <pthread.h>\n"
+                             "int value = 0;\n"
+                             "void *work(void *data)\n"
+                             "{value = *(int *) data;return NULL;}\n"
+                             "int main(int argc,char *argv[])\n"
+                             "{pthread_t thread;int data = 1;\n"
+                             "if (pthread_create(&thread, NULL, work, &data) == 0 &&\n"
+                             "    pthread_join(thread, NULL) == 0) {\n"
+                             "  printf(\"%d\\n\", value == 1 &&\n"
+                             "         sysconf(_SC_NPROCESSORS_ONLN) >= 1);\n"
+                             "} else {\n"
+                             "  printf(\"0\\n\");\n"
+                             "}\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
   } /* determineOsFunctions */
 
 
@@ -7260,6 +7347,51 @@ static void determineOptionForLinkTimeOptimization (FILE *versionFile)
 
 
 
+static void determineOptionsForProfileGuidedOptimization (FILE *versionFile)
+
+  {
+    char objectName[NAME_SIZE];
+    char profileName[NAME_SIZE];
+    int canDoProfileGuidedOptimization = 0;
+
+  /* determineOptionsForProfileGuidedOptimization */
+    fprintf(logFile, "Check for profile guided optimization: ");
+#if defined CC_OPT_PROFILE_GENERATE && defined CC_OPT_PROFILE_USE
+    if (compileWithOptionsOk("#include <stdio.h>\n"
+                             "int main (int argc, char *argv[]) {\n"
+                             "printf(\"%d\\n\", argc >= 1);\n"
+                             "return 0; }\n",
+                             CC_OPT_PROFILE_GENERATE)) {
+      sprintf(objectName, "ctest%d%s", testNumber, OBJECT_FILE_EXTENSION);
+      /* The profile data of gcc is written to ctest<n>.gcda. */
+      sprintf(profileName, "ctest%d.gcda", testNumber);
+      if (doLink(objectName, CC_OPT_PROFILE_GENERATE) && doTest() == 1) {
+        canDoProfileGuidedOptimization =
+            compileWithOptionsOk("#include <stdio.h>\n"
+                                 "int main (int argc, char *argv[]) {\n"
+                                 "printf(\"%d\\n\", argc >= 1);\n"
+                                 "return 0; }\n",
+                                 CC_OPT_PROFILE_USE);
+      } /* if */
+      doRemove(profileName);
+    } /* if */
+    if (canDoProfileGuidedOptimization) {
+      fprintf(logFile, " Done with the options: %s and %s\n",
+              CC_OPT_PROFILE_GENERATE, CC_OPT_PROFILE_USE);
+      fprintf(versionFile, "#define CC_OPT_PROFILE_GENERATE \"%s\"\n",
+              CC_OPT_PROFILE_GENERATE);
+      fprintf(versionFile, "#define CC_OPT_PROFILE_USE \"%s\"\n",
+              CC_OPT_PROFILE_USE);
+    } else {
+      fprintf(logFile, " Not available.\n");
+    } /* if */
+#else
+    fprintf(logFile, "Not available.\n");
+#endif
+  } /* determineOptionsForProfileGuidedOptimization */
+
+
+
 #ifdef POTENTIAL_PARTIAL_LINKING_OPTIONS
 static int checkPartialLinking (const char *ccOptPartialLinking)
 
@@ -10761,6 +10893,7 @@ int main (int argc, char **argv)
     setSeed7Library(seed7_library_arg, buildDirectory, seed7Library);
     fprintf(logFile, " done\n");
     determineOptionForLinkTimeOptimization(versionFile);
+    determineOptionsForProfileGuidedOptimization(versionFile);
     determinePartialLinking(versionFile);
     numericSizes(versionFile);
     fprintf(logFile, "General settings: ");
@@ -10969,6 +11102,7 @@ int main (int argc, char **argv)
     determineStackDirection(versionFile);
     determineLanguageProperties(versionFile);
     determinePreprocessorProperties(versionFile);
+    determineIntrinsicsProperties(versionFile);
 #ifndef DEFAULT_STACK_SIZE
     if (sizeof(char *) == 8) { /* Machine with 64-bit addresses */
       /* Due to alignment some 64-bit machines have huge stack requirements. */
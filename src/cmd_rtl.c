@@ -115,6 +115,12 @@
 #ifndef LINKER_OPT_LTO_MANDATORY
 #define LINKER_OPT_LTO_MANDATORY 0
 #endif
+#ifndef CC_OPT_PROFILE_GENERATE
+#define CC_OPT_PROFILE_GENERATE ""
+#endif
+#ifndef CC_OPT_PROFILE_USE
+#define CC_OPT_PROFILE_USE ""
+#endif
 #ifndef CC_OPT_TRAP_OVERFLOW
 #define CC_OPT_TRAP_OVERFLOW ""
 #endif
@@ -2162,6 +2168,10 @@ striType cmdConfigValue (const const_striType name)
       opt = CC_OPT_LINK_TIME_OPTIMIZATION;
     } else if (strcmp(opt_name, "LINKER_OPT_LTO_MANDATORY") == 0) {
       opt = LINKER_OPT_LTO_MANDATORY ? "TRUE" : "FALSE";
+    } else if (strcmp(opt_name, "CC_OPT_PROFILE_GENERATE") == 0) {
+      opt = CC_OPT_PROFILE_GENERATE;
+    } else if (strcmp(opt_name, "CC_OPT_PROFILE_USE") == 0) {
+      opt = CC_OPT_PROFILE_USE;
     } else if (strcmp(opt_name, "CC_OPT_NO_WARNINGS") == 0) {
       opt = CC_OPT_NO_WARNINGS;
     } else if (strcmp(opt_name, "CC_OPT_OPTIMIZE_1") == 0) {
@@ -0,0 +1,1278 @@
+/********************************************************************/
+/*                                                                  */
+/*  cry_rtl.c     Primitive actions for cryptographic algorithms.   */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cry_rtl.c                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions for cryptographic algorithms.        */
+/*                                                                  */
+/*  The AEAD cipher ChaCha20-Poly1305 (RFC 8439) and the scalar     */
+/*  multiplication of the elliptic curves Curve25519 (X25519,       */
+/*  RFC 7748) and secp256r1 (P-256) are implemented here. Field     */
+/*  elements are kept in fixed size arrays of limbs. This way no    */
+/*  memory is allocated during the computations.                    */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "cry_rtl.h"
+
+
+#define CHACHA20_KEY_SIZE         32
+#define CHACHA20_POLY1305_NONCE_SIZE 12
+#define POLY1305_TAG_SIZE         16
+#define AEAD_BUFFER_SIZE        4096
+#define X25519_SIZE               32
+#define P256_SIZE                 32
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define LOAD_LE32(p) ((uint32Type) (p)[0]        | (uint32Type) (p)[1] <<  8 | \
+                      (uint32Type) (p)[2] << 16  | (uint32Type) (p)[3] << 24)
+
+#define QUARTER_ROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d,  8); \
+    c += d; b ^= c; b = ROTL32(b,  7);
+
+typedef struct {
+    uint32Type r[5];
+    uint32Type h[5];
+    uint32Type pad[4];
+  } poly1305Record;
+
+typedef uint64Type fe25519[10];
+typedef uint32Type p256Elem[8];
+
+typedef struct {
+    p256Elem x;
+    p256Elem y;
+    p256Elem z;  /* A z of zero describes the point at infinity. */
+  } p256PointRecord;
+
+static const uint32Type p256Prime[8] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xffffffff};
+
+/* R ** 2 mod p with R = 2 ** 256 (to convert to Montgomery form). */
+static const uint32Type p256RSquare[8] = {
+    0x00000003, 0x00000000, 0xffffffff, 0xfffffffb,
+    0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004};
+
+/* The constant b of the curve in Montgomery form. */
+static const uint32Type p256B[8] = {
+    0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd,
+    0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d};
+
+
+
+/**
+ *  Convert a string with characters from '\0;' to '\255;' to bytes.
+ *  @return TRUE if the conversion succeeded, or
+ *          FALSE if 'stri' has not the size 'size' or if it
+ *          contains a character beyond '\255;'.
+ */
+static boolType getFixedBytes (const const_striType stri, ucharType *bytes,
+    memSizeType size)
+
+  { /* getFixedBytes */
+    return stri->size == size && !memcpy_from_strelem(bytes, stri->mem, size);
+  } /* getFixedBytes */
+
+
+
+static void chacha20Block (const uint32Type *input, ucharType *output)
+
+  {
+    uint32Type x[16];
+    int round;
+    int pos;
+
+  /* chacha20Block */
+    memcpy(x, input, sizeof(x));
+    for (round = 0; round < 10; round++) {
+      QUARTER_ROUND(x[0], x[4], x[ 8], x[12]);
+      QUARTER_ROUND(x[1], x[5], x[ 9], x[13]);
+      QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+      QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+      QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+      QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+      QUARTER_ROUND(x[2], x[7], x[ 8], x[13]);
+      QUARTER_ROUND(x[3], x[4], x[ 9], x[14]);
+    } /* for */
+    for (pos = 0; pos < 16; pos++) {
+      x[pos] += input[pos];
+      output[4 * pos]     = (ucharType)  x[pos];
+      output[4 * pos + 1] = (ucharType) (x[pos] >>  8);
+      output[4 * pos + 2] = (ucharType) (x[pos] >> 16);
+      output[4 * pos + 3] = (ucharType) (x[pos] >> 24);
+    } /* for */
+  } /* chacha20Block */
+
+
+
+static void chacha20Init (uint32Type *state, const ucharType *key,
+    const ucharType *nonce)
+
+  {
+    int pos;
+
+  /* chacha20Init */
+    state[0] = 0x61707865;  /* "expand 32-byte k" */
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (pos = 0; pos < 8; pos++) {
+      state[4 + pos] = LOAD_LE32(&key[4 * pos]);
+    } /* for */
+    state[12] = 0;
+    state[13] = LOAD_LE32(&nonce[0]);
+    state[14] = LOAD_LE32(&nonce[4]);
+    state[15] = LOAD_LE32(&nonce[8]);
+  } /* chacha20Init */
+
+
+
+/**
+ *  Xor 'data' with the key stream of ChaCha20.
+ *  The block counter in state[12] is incremented for every block.
+ *  If 'length' is not a multiple of 64 the rest of the last key
+ *  stream block is not used.
+ */
+static void chacha20Xor (uint32Type *state, ucharType *data, memSizeType length)
+
+  {
+    ucharType keyStream[64];
+    memSizeType blockLength;
+    memSizeType pos;
+
+  /* chacha20Xor */
+    while (length != 0) {
+      chacha20Block(state, keyStream);
+      state[12]++;
+      blockLength = length > 64 ? 64 : length;
+      for (pos = 0; pos < blockLength; pos++) {
+        data[pos] ^= keyStream[pos];
+      } /* for */
+      data += blockLength;
+      length -= blockLength;
+    } /* while */
+  } /* chacha20Xor */
+
+
+
+static void poly1305Init (poly1305Record *poly, const ucharType *key)
+
+  {
+    int pos;
+
+  /* poly1305Init */
+    /* Clamp r as required by the specification. */
+    poly->r[0] =  LOAD_LE32(&key[ 0])       & 0x3ffffff;
+    poly->r[1] = (LOAD_LE32(&key[ 3]) >> 2) & 0x3ffff03;
+    poly->r[2] = (LOAD_LE32(&key[ 6]) >> 4) & 0x3ffc0ff;
+    poly->r[3] = (LOAD_LE32(&key[ 9]) >> 6) & 0x3f03fff;
+    poly->r[4] = (LOAD_LE32(&key[12]) >> 8) & 0x00fffff;
+    for (pos = 0; pos < 5; pos++) {
+      poly->h[pos] = 0;
+    } /* for */
+    for (pos = 0; pos < 4; pos++) {
+      poly->pad[pos] = LOAD_LE32(&key[16 + 4 * pos]);
+    } /* for */
+  } /* poly1305Init */
+
+
+
+/**
+ *  Process 16 byte blocks with Poly1305.
+ *  The limbs of h and r have 26 bits. If 'length' is not a multiple
+ *  of 16 the last block is padded with zero bytes. This is the
+ *  padding used by the AEAD construction of RFC 8439.
+ */
+static void poly1305Blocks (poly1305Record *poly, const ucharType *data,
+    memSizeType length)
+
+  {
+    ucharType block[16];
+    uint32Type r0, r1, r2, r3, r4;
+    uint32Type s1, s2, s3, s4;
+    uint32Type h0, h1, h2, h3, h4;
+    uint64Type d0, d1, d2, d3, d4;
+    uint32Type carry;
+
+  /* poly1305Blocks */
+    r0 = poly->r[0]; r1 = poly->r[1]; r2 = poly->r[2];
+    r3 = poly->r[3]; r4 = poly->r[4];
+    s1 = r1 * 5; s2 = r2 * 5; s3 = r3 * 5; s4 = r4 * 5;
+    h0 = poly->h[0]; h1 = poly->h[1]; h2 = poly->h[2];
+    h3 = poly->h[3]; h4 = poly->h[4];
+    while (length != 0) {
+      if (length < 16) {
+        memcpy(block, data, length);
+        memset(&block[length], 0, 16 - length);
+        data = block;
+        length = 16;
+      } /* if */
+      h0 += ( LOAD_LE32(&data[ 0])      ) & 0x3ffffff;
+      h1 += ( LOAD_LE32(&data[ 3]) >> 2 ) & 0x3ffffff;
+      h2 += ( LOAD_LE32(&data[ 6]) >> 4 ) & 0x3ffffff;
+      h3 += ( LOAD_LE32(&data[ 9]) >> 6 ) & 0x3ffffff;
+      h4 += ( LOAD_LE32(&data[12]) >> 8 ) | (1 << 24);
+      d0 = (uint64Type) h0 * r0 + (uint64Type) h1 * s4 + (uint64Type) h2 * s3 +
+           (uint64Type) h3 * s2 + (uint64Type) h4 * s1;
+      d1 = (uint64Type) h0 * r1 + (uint64Type) h1 * r0 + (uint64Type) h2 * s4 +
+           (uint64Type) h3 * s3 + (uint64Type) h4 * s2;
+      d2 = (uint64Type) h0 * r2 + (uint64Type) h1 * r1 + (uint64Type) h2 * r0 +
+           (uint64Type) h3 * s4 + (uint64Type) h4 * s3;
+      d3 = (uint64Type) h0 * r3 + (uint64Type) h1 * r2 + (uint64Type) h2 * r1 +
+           (uint64Type) h3 * r0 + (uint64Type) h4 * s4;
+      d4 = (uint64Type) h0 * r4 + (uint64Type) h1 * r3 + (uint64Type) h2 * r2 +
+           (uint64Type) h3 * r1 + (uint64Type) h4 * r0;
+      carry = (uint32Type) (d0 >> 26); h0 = (uint32Type) d0 & 0x3ffffff;
+      d1 += carry; carry = (uint32Type) (d1 >> 26); h1 = (uint32Type) d1 & 0x3ffffff;
+      d2 += carry; carry = (uint32Type) (d2 >> 26); h2 = (uint32Type) d2 & 0x3ffffff;
+      d3 += carry; carry = (uint32Type) (d3 >> 26); h3 = (uint32Type) d3 & 0x3ffffff;
+      d4 += carry; carry = (uint32Type) (d4 >> 26); h4 = (uint32Type) d4 & 0x3ffffff;
+      h0 += carry * 5; carry = h0 >> 26; h0 &= 0x3ffffff;
+      h1 += carry;
+      data += 16;
+      length -= 16;
+    } /* while */
+    poly->h[0] = h0; poly->h[1] = h1; poly->h[2] = h2;
+    poly->h[3] = h3; poly->h[4] = h4;
+  } /* poly1305Blocks */
+
+
+
+static void poly1305Finish (poly1305Record *poly, ucharType *tag)
+
+  {
+    uint32Type h0, h1, h2, h3, h4;
+    uint32Type g0, g1, g2, g3, g4;
+    uint32Type carry;
+    uint32Type mask;
+    uint64Type sum;
+    uint32Type word[4];
+    int pos;
+
+  /* poly1305Finish */
+    h0 = poly->h[0]; h1 = poly->h[1]; h2 = poly->h[2];
+    h3 = poly->h[3]; h4 = poly->h[4];
+    carry = h1 >> 26; h1 &= 0x3ffffff;
+    h2 += carry; carry = h2 >> 26; h2 &= 0x3ffffff;
+    h3 += carry; carry = h3 >> 26; h3 &= 0x3ffffff;
+    h4 += carry; carry = h4 >> 26; h4 &= 0x3ffffff;
+    h0 += carry * 5; carry = h0 >> 26; h0 &= 0x3ffffff;
+    h1 += carry;
+    /* Compute g = h - p = h + 5 - 2 ** 130. */
+    g0 = h0 + 5;     carry = g0 >> 26; g0 &= 0x3ffffff;
+    g1 = h1 + carry; carry = g1 >> 26; g1 &= 0x3ffffff;
+    g2 = h2 + carry; carry = g2 >> 26; g2 &= 0x3ffffff;
+    g3 = h3 + carry; carry = g3 >> 26; g3 &= 0x3ffffff;
+    g4 = h4 + carry - ((uint32Type) 1 << 26);
+    /* Select h if h < p and g otherwise. */
+    mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+    word[0] =  h0        | (h1 << 26);
+    word[1] = (h1 >>  6) | (h2 << 20);
+    word[2] = (h2 >> 12) | (h3 << 14);
+    word[3] = (h3 >> 18) | (h4 <<  8);
+    sum = 0;
+    for (pos = 0; pos < 4; pos++) {
+      sum += (uint64Type) word[pos] + poly->pad[pos];
+      tag[4 * pos]     = (ucharType)  sum;
+      tag[4 * pos + 1] = (ucharType) (sum >>  8);
+      tag[4 * pos + 2] = (ucharType) (sum >> 16);
+      tag[4 * pos + 3] = (ucharType) (sum >> 24);
+      sum >>= 32;
+    } /* for */
+  } /* poly1305Finish */
+
+
+
+/**
+ *  Add the padded additional data of the AEAD construction to 'poly'.
+ *  @return TRUE if the conversion succeeded, or
+ *          FALSE if 'aad' contains a character beyond '\255;'.
+ */
+static boolType poly1305AddStri (poly1305Record *poly, const const_striType aad)
+
+  {
+    ucharType buffer[AEAD_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType length;
+    memSizeType chunkLength;
+
+  /* poly1305AddStri */
+    mem = aad->mem;
+    length = aad->size;
+    while (length != 0) {
+      chunkLength = length > AEAD_BUFFER_SIZE ? AEAD_BUFFER_SIZE : length;
+      if (unlikely(memcpy_from_strelem(buffer, mem, chunkLength))) {
+        return FALSE;
+      } /* if */
+      poly1305Blocks(poly, buffer, chunkLength);
+      mem += chunkLength;
+      length -= chunkLength;
+    } /* while */
+    return TRUE;
+  } /* poly1305AddStri */
+
+
+
+static void poly1305AddLengths (poly1305Record *poly, memSizeType aadLength,
+    memSizeType dataLength)
+
+  {
+    ucharType block[16];
+    int pos;
+
+  /* poly1305AddLengths */
+    for (pos = 0; pos < 8; pos++) {
+      block[pos]     = (ucharType) ((uint64Type) aadLength  >> (8 * pos));
+      block[8 + pos] = (ucharType) ((uint64Type) dataLength >> (8 * pos));
+    } /* for */
+    poly1305Blocks(poly, block, 16);
+  } /* poly1305AddLengths */
+
+
+
+/**
+ *  Encrypt or decrypt with ChaCha20-Poly1305 (RFC 8439).
+ *  The result consists of the encrypted or decrypted data followed
+ *  by the computed authentication tag. The tag is always computed
+ *  from the encrypted data.
+ *  @return the result string, or NULL if an exception was raised.
+ */
+static striType chacha20Poly1305 (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const strElemType *data, memSizeType dataLength, boolType encrypt)
+
+  {
+    ucharType keyBytes[CHACHA20_KEY_SIZE];
+    ucharType nonceBytes[CHACHA20_POLY1305_NONCE_SIZE];
+    uint32Type state[16];
+    ucharType polyKey[64];
+    poly1305Record poly;
+    ucharType buffer[AEAD_BUFFER_SIZE];
+    ucharType tag[POLY1305_TAG_SIZE];
+    strElemType *dest;
+    memSizeType length;
+    memSizeType chunkLength;
+    striType result;
+
+  /* chacha20Poly1305 */
+    if (unlikely(!getFixedBytes(key, keyBytes, CHACHA20_KEY_SIZE) ||
+                 !getFixedBytes(nonce, nonceBytes, CHACHA20_POLY1305_NONCE_SIZE))) {
+      logError(printf("chacha20Poly1305: Illegal key or nonce.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, dataLength + POLY1305_TAG_SIZE))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = dataLength + POLY1305_TAG_SIZE;
+      chacha20Init(state, keyBytes, nonceBytes);
+      memset(polyKey, 0, 32);
+      chacha20Xor(state, polyKey, 32);
+      poly1305Init(&poly, polyKey);
+      if (unlikely(!poly1305AddStri(&poly, aad))) {
+        FREE_STRI(result, result->size);
+        logError(printf("chacha20Poly1305: Character beyond '\\255;' present.\n"););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+      dest = result->mem;
+      length = dataLength;
+      while (length != 0) {
+        chunkLength = length > AEAD_BUFFER_SIZE ? AEAD_BUFFER_SIZE : length;
+        if (unlikely(memcpy_from_strelem(buffer, data, chunkLength))) {
+          FREE_STRI(result, result->size);
+          logError(printf("chacha20Poly1305: Character beyond '\\255;' present.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        if (encrypt) {
+          chacha20Xor(state, buffer, chunkLength);
+          poly1305Blocks(&poly, buffer, chunkLength);
+        } else {
+          poly1305Blocks(&poly, buffer, chunkLength);
+          chacha20Xor(state, buffer, chunkLength);
+        } /* if */
+        memcpy_to_strelem(dest, buffer, chunkLength);
+        data += chunkLength;
+        dest += chunkLength;
+        length -= chunkLength;
+      } /* while */
+      poly1305AddLengths(&poly, aad->size, dataLength);
+      poly1305Finish(&poly, tag);
+      memcpy_to_strelem(dest, tag, POLY1305_TAG_SIZE);
+    } /* if */
+    return result;
+  } /* chacha20Poly1305 */
+
+
+
+static void fe25519Carry (uint64Type *h)
+
+  {
+    uint64Type carry;
+    int pos;
+
+  /* fe25519Carry */
+    for (pos = 0; pos < 9; pos++) {
+      if (pos & 1) {
+        carry = h[pos] >> 25;
+        h[pos] &= 0x1ffffff;
+      } else {
+        carry = h[pos] >> 26;
+        h[pos] &= 0x3ffffff;
+      } /* if */
+      h[pos + 1] += carry;
+    } /* for */
+    carry = h[9] >> 25;
+    h[9] &= 0x1ffffff;
+    h[0] += carry * 19;
+    carry = h[0] >> 26;
+    h[0] &= 0x3ffffff;
+    h[1] += carry;
+  } /* fe25519Carry */
+
+
+
+static void fe25519Add (fe25519 h, const fe25519 f, const fe25519 g)
+
+  {
+    int pos;
+
+  /* fe25519Add */
+    for (pos = 0; pos < 10; pos++) {
+      h[pos] = f[pos] + g[pos];
+    } /* for */
+    fe25519Carry(h);
+  } /* fe25519Add */
+
+
+
+/**
+ *  Compute h = f - g. To avoid negative limbs 2 * p is added.
+ */
+static void fe25519Sub (fe25519 h, const fe25519 f, const fe25519 g)
+
+  {
+    int pos;
+
+  /* fe25519Sub */
+    h[0] = f[0] + 0x7ffffda - g[0];
+    for (pos = 1; pos < 10; pos++) {
+      h[pos] = f[pos] + ((pos & 1) ? 0x3fffffe : 0x7fffffe) - g[pos];
+    } /* for */
+    fe25519Carry(h);
+  } /* fe25519Sub */
+
+
+
+/**
+ *  Compute h = f * g. The limbs have alternately 26 and 25 bits.
+ *  Products of two odd limbs are doubled and products that exceed
+ *  2 ** 255 are multiplied by 19 (2 ** 255 = 19 mod p).
+ */
+static void fe25519Mul (fe25519 h, const fe25519 f, const fe25519 g)
+
+  {
+    uint64Type product[10];
+    uint64Type factor;
+    int i;
+    int j;
+
+  /* fe25519Mul */
+    memset(product, 0, sizeof(product));
+    for (i = 0; i < 10; i++) {
+      for (j = 0; j < 10; j++) {
+        factor = g[j];
+        if (i & j & 1) {
+          factor <<= 1;
+        } /* if */
+        if (i + j >= 10) {
+          product[i + j - 10] += f[i] * (factor * 19);
+        } else {
+          product[i + j] += f[i] * factor;
+        } /* if */
+      } /* for */
+    } /* for */
+    fe25519Carry(product);
+    memcpy(h, product, sizeof(product));
+  } /* fe25519Mul */
+
+
+
+static void fe25519MulSmall (fe25519 h, const fe25519 f, uint64Type small)
+
+  {
+    int pos;
+
+  /* fe25519MulSmall */
+    for (pos = 0; pos < 10; pos++) {
+      h[pos] = f[pos] * small;
+    } /* for */
+    fe25519Carry(h);
+  } /* fe25519MulSmall */
+
+
+
+/**
+ *  Compute z ** (p - 2) which is the inverse of z (mod p).
+ */
+static void fe25519Invert (fe25519 h, const fe25519 z)
+
+  {
+    fe25519 power;
+    int bitNum;
+
+  /* fe25519Invert */
+    memcpy(power, z, sizeof(fe25519));
+    for (bitNum = 253; bitNum >= 0; bitNum--) {
+      fe25519Mul(power, power, power);
+      if (bitNum != 2 && bitNum != 4) {
+        fe25519Mul(power, power, z);
+      } /* if */
+    } /* for */
+    memcpy(h, power, sizeof(fe25519));
+  } /* fe25519Invert */
+
+
+
+static void fe25519ConditionalSwap (fe25519 f, fe25519 g, uint64Type swap)
+
+  {
+    uint64Type mask;
+    uint64Type diff;
+    int pos;
+
+  /* fe25519ConditionalSwap */
+    mask = (uint64Type) 0 - swap;
+    for (pos = 0; pos < 10; pos++) {
+      diff = (f[pos] ^ g[pos]) & mask;
+      f[pos] ^= diff;
+      g[pos] ^= diff;
+    } /* for */
+  } /* fe25519ConditionalSwap */
+
+
+
+static void fe25519FromBytes (fe25519 h, const ucharType *bytes)
+
+  {
+    uint64Type accumulator = 0;
+    int accumulatedBits = 0;
+    int width;
+    int bytePos = 0;
+    int pos;
+
+  /* fe25519FromBytes */
+    for (pos = 0; pos < 10; pos++) {
+      width = (pos & 1) ? 25 : 26;
+      while (accumulatedBits < width) {
+        accumulator |= (uint64Type) bytes[bytePos] << accumulatedBits;
+        bytePos++;
+        accumulatedBits += 8;
+      } /* while */
+      h[pos] = accumulator & (((uint64Type) 1 << width) - 1);
+      accumulator >>= width;
+      accumulatedBits -= width;
+    } /* for */
+  } /* fe25519FromBytes */
+
+
+
+static void fe25519ToBytes (ucharType *bytes, const fe25519 f)
+
+  {
+    fe25519 h;
+    fe25519 t;
+    uint64Type mask;
+    uint64Type accumulator = 0;
+    int accumulatedBits = 0;
+    int bytePos = 0;
+    int pos;
+
+  /* fe25519ToBytes */
+    memcpy(h, f, sizeof(fe25519));
+    fe25519Carry(h);
+    fe25519Carry(h);
+    /* Subtract p if h >= p: Add 19 and check if bit 255 is set. */
+    memcpy(t, h, sizeof(fe25519));
+    t[0] += 19;
+    for (pos = 0; pos < 9; pos++) {
+      if (pos & 1) {
+        t[pos + 1] += t[pos] >> 25;
+        t[pos] &= 0x1ffffff;
+      } else {
+        t[pos + 1] += t[pos] >> 26;
+        t[pos] &= 0x3ffffff;
+      } /* if */
+    } /* for */
+    mask = (uint64Type) 0 - (t[9] >> 25);
+    t[9] &= 0x1ffffff;
+    for (pos = 0; pos < 10; pos++) {
+      h[pos] = (h[pos] & ~mask) | (t[pos] & mask);
+    } /* for */
+    for (pos = 0; pos < 10; pos++) {
+      accumulator |= h[pos] << accumulatedBits;
+      accumulatedBits += (pos & 1) ? 25 : 26;
+      while (accumulatedBits >= 8) {
+        bytes[bytePos] = (ucharType) accumulator;
+        bytePos++;
+        accumulator >>= 8;
+        accumulatedBits -= 8;
+      } /* while */
+    } /* for */
+    bytes[bytePos] = (ucharType) accumulator;
+  } /* fe25519ToBytes */
+
+
+
+/**
+ *  Montgomery ladder of RFC 7748 for Curve25519.
+ */
+static void x25519ScalarMult (ucharType *result, const ucharType *scalar,
+    const ucharType *uCoordinate)
+
+  {
+    ucharType k[X25519_SIZE];
+    ucharType u[X25519_SIZE];
+    fe25519 x1, x2, z2, x3, z3;
+    fe25519 a, aa, b, bb, e, c, d, da, cb;
+    uint64Type swap = 0;
+    uint64Type bit;
+    int bitNum;
+
+  /* x25519ScalarMult */
+    memcpy(k, scalar, X25519_SIZE);
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+    memcpy(u, uCoordinate, X25519_SIZE);
+    u[31] &= 127;
+    fe25519FromBytes(x1, u);
+    memset(x2, 0, sizeof(fe25519));
+    x2[0] = 1;
+    memset(z2, 0, sizeof(fe25519));
+    memcpy(x3, x1, sizeof(fe25519));
+    memset(z3, 0, sizeof(fe25519));
+    z3[0] = 1;
+    for (bitNum = 254; bitNum >= 0; bitNum--) {
+      bit = (uint64Type) ((k[bitNum >> 3] >> (bitNum & 7)) & 1);
+      swap ^= bit;
+      fe25519ConditionalSwap(x2, x3, swap);
+      fe25519ConditionalSwap(z2, z3, swap);
+      swap = bit;
+      fe25519Add(a, x2, z2);
+      fe25519Mul(aa, a, a);
+      fe25519Sub(b, x2, z2);
+      fe25519Mul(bb, b, b);
+      fe25519Sub(e, aa, bb);
+      fe25519Add(c, x3, z3);
+      fe25519Sub(d, x3, z3);
+      fe25519Mul(da, d, a);
+      fe25519Mul(cb, c, b);
+      fe25519Add(x3, da, cb);
+      fe25519Mul(x3, x3, x3);
+      fe25519Sub(z3, da, cb);
+      fe25519Mul(z3, z3, z3);
+      fe25519Mul(z3, z3, x1);
+      fe25519Mul(x2, aa, bb);
+      fe25519MulSmall(z2, e, 121665);
+      fe25519Add(z2, z2, aa);
+      fe25519Mul(z2, z2, e);
+    } /* for */
+    fe25519ConditionalSwap(x2, x3, swap);
+    fe25519ConditionalSwap(z2, z3, swap);
+    fe25519Invert(z2, z2);
+    fe25519Mul(x2, x2, z2);
+    fe25519ToBytes(result, x2);
+  } /* x25519ScalarMult */
+
+
+
+/**
+ *  Subtract p from 'a' if 'carry' is set or if a >= p.
+ */
+static void p256ReduceOnce (uint32Type *a, uint32Type carry)
+
+  {
+    uint32Type t[8];
+    uint64Type diff;
+    uint32Type borrow = 0;
+    uint32Type mask;
+    int pos;
+
+  /* p256ReduceOnce */
+    for (pos = 0; pos < 8; pos++) {
+      diff = (uint64Type) a[pos] - p256Prime[pos] - borrow;
+      t[pos] = (uint32Type) diff;
+      borrow = (uint32Type) (diff >> 32) & 1;
+    } /* for */
+    /* Use t if a carry occurred or if no borrow occurred. */
+    mask = (uint32Type) 0 - (carry | (borrow ^ 1));
+    for (pos = 0; pos < 8; pos++) {
+      a[pos] = (a[pos] & ~mask) | (t[pos] & mask);
+    } /* for */
+  } /* p256ReduceOnce */
+
+
+
+static void p256Add (p256Elem r, const p256Elem a, const p256Elem b)
+
+  {
+    uint64Type sum = 0;
+    int pos;
+
+  /* p256Add */
+    for (pos = 0; pos < 8; pos++) {
+      sum += (uint64Type) a[pos] + b[pos];
+      r[pos] = (uint32Type) sum;
+      sum >>= 32;
+    } /* for */
+    p256ReduceOnce(r, (uint32Type) sum);
+  } /* p256Add */
+
+
+
+static void p256Sub (p256Elem r, const p256Elem a, const p256Elem b)
+
+  {
+    uint64Type diff;
+    uint64Type sum = 0;
+    uint32Type borrow = 0;
+    uint32Type mask;
+    int pos;
+
+  /* p256Sub */
+    for (pos = 0; pos < 8; pos++) {
+      diff = (uint64Type) a[pos] - b[pos] - borrow;
+      r[pos] = (uint32Type) diff;
+      borrow = (uint32Type) (diff >> 32) & 1;
+    } /* for */
+    /* Add p if a borrow occurred. */
+    mask = (uint32Type) 0 - borrow;
+    for (pos = 0; pos < 8; pos++) {
+      sum += (uint64Type) r[pos] + (p256Prime[pos] & mask);
+      r[pos] = (uint32Type) sum;
+      sum >>= 32;
+    } /* for */
+  } /* p256Sub */
+
+
+
+/**
+ *  Montgomery multiplication r = a * b / 2 ** 256 (mod p).
+ *  Since p = -1 (mod 2 ** 32) the Montgomery factor is 1.
+ */
+static void p256Mul (p256Elem r, const p256Elem a, const p256Elem b)
+
+  {
+    uint32Type t[10];
+    uint64Type sum;
+    uint32Type m;
+    int i;
+    int j;
+
+  /* p256Mul */
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < 8; i++) {
+      sum = 0;
+      for (j = 0; j < 8; j++) {
+        sum += (uint64Type) t[j] + (uint64Type) a[j] * b[i];
+        t[j] = (uint32Type) sum;
+        sum >>= 32;
+      } /* for */
+      sum += t[8];
+      t[8] = (uint32Type) sum;
+      t[9] = (uint32Type) (sum >> 32);
+      m = t[0];
+      sum = (uint64Type) t[0] + (uint64Type) m * p256Prime[0];
+      sum >>= 32;
+      for (j = 1; j < 8; j++) {
+        sum += (uint64Type) t[j] + (uint64Type) m * p256Prime[j];
+        t[j - 1] = (uint32Type) sum;
+        sum >>= 32;
+      } /* for */
+      sum += t[8];
+      t[7] = (uint32Type) sum;
+      t[8] = t[9] + (uint32Type) (sum >> 32);
+    } /* for */
+    memcpy(r, t, sizeof(p256Elem));
+    p256ReduceOnce(r, t[8]);
+  } /* p256Mul */
+
+
+
+static boolType p256IsZero (const p256Elem a)
+
+  {
+    uint32Type bits = 0;
+    int pos;
+
+  /* p256IsZero */
+    for (pos = 0; pos < 8; pos++) {
+      bits |= a[pos];
+    } /* for */
+    return bits == 0;
+  } /* p256IsZero */
+
+
+
+/**
+ *  Compute a ** (p - 2) which is the inverse of a (mod p).
+ */
+static void p256Invert (p256Elem r, const p256Elem a)
+
+  {
+    p256Elem power;
+    uint32Type exponentWord;
+    int bitNum;
+
+  /* p256Invert */
+    memcpy(power, a, sizeof(p256Elem));
+    /* The highest bit of p - 2 is set. */
+    for (bitNum = 254; bitNum >= 0; bitNum--) {
+      p256Mul(power, power, power);
+      exponentWord = bitNum < 32 ? p256Prime[0] - 2 : p256Prime[bitNum >> 5];
+      if ((exponentWord >> (bitNum & 31)) & 1) {
+        p256Mul(power, power, a);
+      } /* if */
+    } /* for */
+    memcpy(r, power, sizeof(p256Elem));
+  } /* p256Invert */
+
+
+
+/**
+ *  Double a point in jacobian coordinates (a = -3, dbl-2001-b).
+ *  The point at infinity (z = 0) stays at infinity.
+ */
+static void p256Double (p256PointRecord *r, const p256PointRecord *p)
+
+  {
+    p256Elem delta, gamma, beta, alpha, t1, t2;
+
+  /* p256Double */
+    p256Mul(delta, p->z, p->z);
+    p256Mul(gamma, p->y, p->y);
+    p256Mul(beta, p->x, gamma);
+    p256Sub(t1, p->x, delta);
+    p256Add(t2, p->x, delta);
+    p256Mul(t1, t1, t2);
+    p256Add(alpha, t1, t1);
+    p256Add(alpha, alpha, t1);
+    p256Add(t1, p->y, p->z);
+    p256Mul(t1, t1, t1);
+    p256Sub(t1, t1, gamma);
+    p256Sub(r->z, t1, delta);
+    p256Add(beta, beta, beta);
+    p256Add(beta, beta, beta);  /* 4 * beta */
+    p256Mul(t1, alpha, alpha);
+    p256Sub(t1, t1, beta);
+    p256Sub(r->x, t1, beta);
+    p256Sub(t1, beta, r->x);
+    p256Mul(t1, alpha, t1);
+    p256Mul(gamma, gamma, gamma);
+    p256Add(gamma, gamma, gamma);
+    p256Add(gamma, gamma, gamma);
+    p256Add(gamma, gamma, gamma);  /* 8 * gamma ** 2 */
+    p256Sub(r->y, t1, gamma);
+  } /* p256Double */
+
+
+
+/**
+ *  Add two points in jacobian coordinates (add-2007-bl).
+ */
+static void p256AddPoints (p256PointRecord *r, const p256PointRecord *p,
+    const p256PointRecord *q)
+
+  {
+    p256Elem z1z1, z2z2, u1, u2, s1, s2, h, i, j, rr, v, t1;
+
+  /* p256AddPoints */
+    if (p256IsZero(p->z)) {
+      memcpy(r, q, sizeof(p256PointRecord));
+    } else if (p256IsZero(q->z)) {
+      memcpy(r, p, sizeof(p256PointRecord));
+    } else {
+      p256Mul(z1z1, p->z, p->z);
+      p256Mul(z2z2, q->z, q->z);
+      p256Mul(u1, p->x, z2z2);
+      p256Mul(u2, q->x, z1z1);
+      p256Mul(s1, p->y, q->z);
+      p256Mul(s1, s1, z2z2);
+      p256Mul(s2, q->y, p->z);
+      p256Mul(s2, s2, z1z1);
+      p256Sub(h, u2, u1);
+      p256Sub(rr, s2, s1);
+      if (p256IsZero(h)) {
+        if (p256IsZero(rr)) {
+          p256Double(r, p);
+        } else {
+          memset(r, 0, sizeof(p256PointRecord));
+        } /* if */
+      } else {
+        p256Add(i, h, h);
+        p256Mul(i, i, i);
+        p256Mul(j, h, i);
+        p256Add(rr, rr, rr);
+        p256Mul(v, u1, i);
+        p256Add(t1, p->z, q->z);
+        p256Mul(t1, t1, t1);
+        p256Sub(t1, t1, z1z1);
+        p256Sub(t1, t1, z2z2);
+        p256Mul(r->z, t1, h);
+        p256Mul(t1, rr, rr);
+        p256Sub(t1, t1, j);
+        p256Sub(t1, t1, v);
+        p256Sub(r->x, t1, v);
+        p256Sub(t1, v, r->x);
+        p256Mul(t1, rr, t1);
+        p256Mul(s1, s1, j);
+        p256Add(s1, s1, s1);
+        p256Sub(r->y, t1, s1);
+      } /* if */
+    } /* if */
+  } /* p256AddPoints */
+
+
+
+static void p256FromBytes (p256Elem a, const ucharType *bytes)
+
+  {
+    int pos;
+
+  /* p256FromBytes */
+    for (pos = 0; pos < 8; pos++) {
+      a[pos] = (uint32Type) bytes[4 * (7 - pos)] << 24 |
+               (uint32Type) bytes[4 * (7 - pos) + 1] << 16 |
+               (uint32Type) bytes[4 * (7 - pos) + 2] <<  8 |
+               (uint32Type) bytes[4 * (7 - pos) + 3];
+    } /* for */
+  } /* p256FromBytes */
+
+
+
+static void p256ToBytes (ucharType *bytes, const p256Elem a)
+
+  {
+    int pos;
+
+  /* p256ToBytes */
+    for (pos = 0; pos < 8; pos++) {
+      bytes[4 * (7 - pos)]     = (ucharType) (a[pos] >> 24);
+      bytes[4 * (7 - pos) + 1] = (ucharType) (a[pos] >> 16);
+      bytes[4 * (7 - pos) + 2] = (ucharType) (a[pos] >>  8);
+      bytes[4 * (7 - pos) + 3] = (ucharType)  a[pos];
+    } /* for */
+  } /* p256ToBytes */
+
+
+
+static boolType p256LessThanPrime (const p256Elem a)
+
+  {
+    int pos;
+
+  /* p256LessThanPrime */
+    for (pos = 7; pos >= 0; pos--) {
+      if (a[pos] != p256Prime[pos]) {
+        return a[pos] < p256Prime[pos];
+      } /* if */
+    } /* for */
+    return FALSE;
+  } /* p256LessThanPrime */
+
+
+
+/**
+ *  Multiply the point 'encodedPoint' with 'scalar'.
+ *  A fixed window of 4 bits is used. The table entry is selected
+ *  by reading all entries.
+ *  @return FALSE if the point is not on the curve.
+ */
+static boolType p256ScalarMult (ucharType *encodedResult,
+    const ucharType *encodedPoint, const ucharType *scalar)
+
+  {
+    p256Elem one;
+    p256Elem lhs, rhs, t1;
+    p256PointRecord table[16];
+    p256PointRecord selected;
+    p256PointRecord product;
+    uint32Type mask;
+    unsigned int digit;
+    unsigned int index;
+    int nibbleNum;
+    int pos;
+
+  /* p256ScalarMult */
+    memset(&table[1], 0, sizeof(p256PointRecord));
+    p256FromBytes(table[1].x, &encodedPoint[1]);
+    p256FromBytes(table[1].y, &encodedPoint[1 + P256_SIZE]);
+    if (!p256LessThanPrime(table[1].x) || !p256LessThanPrime(table[1].y)) {
+      return FALSE;
+    } /* if */
+    memset(one, 0, sizeof(p256Elem));
+    one[0] = 1;
+    p256Mul(table[1].x, table[1].x, p256RSquare);
+    p256Mul(table[1].y, table[1].y, p256RSquare);
+    p256Mul(table[1].z, one, p256RSquare);
+    /* Check y ** 2 = x ** 3 - 3 * x + b */
+    p256Mul(lhs, table[1].y, table[1].y);
+    p256Mul(rhs, table[1].x, table[1].x);
+    p256Mul(rhs, rhs, table[1].x);
+    p256Add(t1, table[1].x, table[1].x);
+    p256Add(t1, t1, table[1].x);
+    p256Sub(rhs, rhs, t1);
+    p256Add(rhs, rhs, p256B);
+    p256Sub(lhs, lhs, rhs);
+    if (!p256IsZero(lhs)) {
+      return FALSE;
+    } /* if */
+    memset(&table[0], 0, sizeof(p256PointRecord));
+    p256Double(&table[2], &table[1]);
+    for (index = 3; index < 16; index++) {
+      p256AddPoints(&table[index], &table[index - 1], &table[1]);
+    } /* for */
+    memset(&product, 0, sizeof(p256PointRecord));
+    for (nibbleNum = 63; nibbleNum >= 0; nibbleNum--) {
+      p256Double(&product, &product);
+      p256Double(&product, &product);
+      p256Double(&product, &product);
+      p256Double(&product, &product);
+      digit = (scalar[31 - (nibbleNum >> 1)] >> (4 * (nibbleNum & 1))) & 15;
+      for (index = 0; index < 16; index++) {
+        mask = (uint32Type) 0 - (uint32Type) (index == digit);
+        for (pos = 0; pos < 8; pos++) {
+          if (index == 0) {
+            selected.x[pos] = 0;
+            selected.y[pos] = 0;
+            selected.z[pos] = 0;
+          } /* if */
+          selected.x[pos] |= table[index].x[pos] & mask;
+          selected.y[pos] |= table[index].y[pos] & mask;
+          selected.z[pos] |= table[index].z[pos] & mask;
+        } /* for */
+      } /* for */
+      p256AddPoints(&product, &product, &selected);
+    } /* for */
+    if (p256IsZero(product.z)) {
+      encodedResult[0] = 0;
+    } else {
+      p256Invert(t1, product.z);
+      p256Mul(lhs, t1, t1);
+      p256Mul(product.x, product.x, lhs);
+      p256Mul(lhs, lhs, t1);
+      p256Mul(product.y, product.y, lhs);
+      /* Convert from the Montgomery form. */
+      p256Mul(product.x, product.x, one);
+      p256Mul(product.y, product.y, one);
+      encodedResult[0] = 4;
+      p256ToBytes(&encodedResult[1], product.x);
+      p256ToBytes(&encodedResult[1 + P256_SIZE], product.y);
+    } /* if */
+    return TRUE;
+  } /* p256ScalarMult */
+
+
+
+/**
+ *  Decrypt data with the AEAD cipher ChaCha20-Poly1305 (RFC 8439).
+ *  The authentication tag is computed but not checked.
+ *  @param key Key with 32 bytes.
+ *  @param nonce Nonce with 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @param encrypted Encrypted data followed by a 16 byte tag.
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *          The tag at the end of 'encrypted' and the computed tag
+ *          must be equal.
+ *  @exception RANGE_ERROR If 'key' or 'nonce' have a wrong size, or
+ *             if 'encrypted' is shorter than 16 characters, or if a
+ *             character beyond '\255;' is present.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType cryChaCha20Poly1305Decode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType encrypted)
+
+  {
+    striType result;
+
+  /* cryChaCha20Poly1305Decode */
+    logFunction(printf("cryChaCha20Poly1305Decode(*, *, \"%s\", \"%s\")\n",
+                       striAsUnquotedCStri(aad),
+                       striAsUnquotedCStri(encrypted)););
+    if (unlikely(encrypted->size < POLY1305_TAG_SIZE)) {
+      logError(printf("cryChaCha20Poly1305Decode: Encrypted data too short.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      result = chacha20Poly1305(key, nonce, aad, encrypted->mem,
+                                encrypted->size - POLY1305_TAG_SIZE, FALSE);
+    } /* if */
+    logFunction(printf("cryChaCha20Poly1305Decode --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* cryChaCha20Poly1305Decode */
+
+
+
+/**
+ *  Encrypt data with the AEAD cipher ChaCha20-Poly1305 (RFC 8439).
+ *  @param key Key with 32 bytes.
+ *  @param nonce Nonce with 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @param plaintext Data to be encrypted.
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR If 'key' or 'nonce' have a wrong size, or
+ *             if a character beyond '\255;' is present.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType cryChaCha20Poly1305Encode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType plaintext)
+
+  {
+    striType result;
+
+  /* cryChaCha20Poly1305Encode */
+    logFunction(printf("cryChaCha20Poly1305Encode(*, *, \"%s\", \"%s\")\n",
+                       striAsUnquotedCStri(aad),
+                       striAsUnquotedCStri(plaintext)););
+    result = chacha20Poly1305(key, nonce, aad, plaintext->mem,
+                              plaintext->size, TRUE);
+    logFunction(printf("cryChaCha20Poly1305Encode --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* cryChaCha20Poly1305Encode */
+
+
+
+/**
+ *  Multiply a point of the elliptic curve secp256r1 (P-256) with a scalar.
+ *  @param point Point in uncompressed form ('\4;' followed by the
+ *         x and y coordinates with 32 bytes each in big endian).
+ *  @param scalar Scalar with 32 bytes in big endian.
+ *  @return the product in uncompressed form, or "" if the product
+ *          is the point at infinity.
+ *  @exception RANGE_ERROR If 'point' or 'scalar' have a wrong format
+ *             or if 'point' is not on the curve.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType cryP256Mult (const const_striType point, const const_striType scalar)
+
+  {
+    ucharType pointBytes[1 + 2 * P256_SIZE];
+    ucharType scalarBytes[P256_SIZE];
+    ucharType productBytes[1 + 2 * P256_SIZE];
+    memSizeType productSize;
+    striType result;
+
+  /* cryP256Mult */
+    logFunction(printf("cryP256Mult(\"%s\", *)\n", striAsUnquotedCStri(point)););
+    if (unlikely(!getFixedBytes(point, pointBytes, 1 + 2 * P256_SIZE) ||
+                 pointBytes[0] != 4 ||
+                 !getFixedBytes(scalar, scalarBytes, P256_SIZE) ||
+                 !p256ScalarMult(productBytes, pointBytes, scalarBytes))) {
+      logError(printf("cryP256Mult(\"%s\", *): Illegal point or scalar.\n",
+                      striAsUnquotedCStri(point)););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      productSize = productBytes[0] == 4 ? 1 + 2 * P256_SIZE : 0;
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, productSize))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = productSize;
+        memcpy_to_strelem(result->mem, productBytes, productSize);
+      } /* if */
+    } /* if */
+    logFunction(printf("cryP256Mult --> \"%s\"\n", striAsUnquotedCStri(result)););
+    return result;
+  } /* cryP256Mult */
+
+
+
+/**
+ *  Compute the X25519 function of RFC 7748.
+ *  @param scalar Scalar with 32 bytes in little endian (It is
+ *         clamped as described in RFC 7748).
+ *  @param uCoordinate U-coordinate with 32 bytes in little endian.
+ *  @return the u-coordinate of the product (32 bytes in little endian).
+ *  @exception RANGE_ERROR If 'scalar' or 'uCoordinate' have a wrong size
+ *             or if a character beyond '\255;' is present.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType cryX25519 (const const_striType scalar, const const_striType uCoordinate)
+
+  {
+    ucharType scalarBytes[X25519_SIZE];
+    ucharType uBytes[X25519_SIZE];
+    ucharType resultBytes[X25519_SIZE];
+    striType result;
+
+  /* cryX25519 */
+    logFunction(printf("cryX25519(*, \"%s\")\n", striAsUnquotedCStri(uCoordinate)););
+    if (unlikely(!getFixedBytes(scalar, scalarBytes, X25519_SIZE) ||
+                 !getFixedBytes(uCoordinate, uBytes, X25519_SIZE))) {
+      logError(printf("cryX25519(*, \"%s\"): Illegal scalar or u-coordinate.\n",
+                      striAsUnquotedCStri(uCoordinate)););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_STRI_SIZE_OK(result, X25519_SIZE))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      x25519ScalarMult(resultBytes, scalarBytes, uBytes);
+      result->size = X25519_SIZE;
+      memcpy_to_strelem(result->mem, resultBytes, X25519_SIZE);
+    } /* if */
+    logFunction(printf("cryX25519 --> \"%s\"\n", striAsUnquotedCStri(result)););
+    return result;
+  } /* cryX25519 */
@@ -0,0 +1,39 @@
+/********************************************************************/
+/*                                                                  */
+/*  cry_rtl.h     Primitive actions for cryptographic algorithms.   */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cry_rtl.h                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions for cryptographic algorithms.        */
+/*                                                                  */
+/********************************************************************/
+
+striType cryChaCha20Poly1305Decode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType encrypted);
+striType cryChaCha20Poly1305Encode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType plaintext);
+striType cryP256Mult (const const_striType point, const const_striType scalar);
+striType cryX25519 (const const_striType scalar, const const_striType uCoordinate);
@@ -0,0 +1,123 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/crylib.c                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for cryptographic algorithms.    */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "cry_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "crylib.h"
+
+
+
+/**
+ *  Decrypt arg_4 with ChaCha20-Poly1305 (key arg_1, nonce arg_2, aad arg_3).
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *  @exception RANGE_ERROR If a parameter has a wrong size or if a
+ *             character beyond '\255;' is present.
+ */
+objectType cry_chacha20_poly1305_decode (listType arguments)
+
+  { /* cry_chacha20_poly1305_decode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cryChaCha20Poly1305Decode(take_stri(arg_1(arguments)),
+                                  take_stri(arg_2(arguments)),
+                                  take_stri(arg_3(arguments)),
+                                  take_stri(arg_4(arguments))));
+  } /* cry_chacha20_poly1305_decode */
+
+
+
+/**
+ *  Encrypt arg_4 with ChaCha20-Poly1305 (key arg_1, nonce arg_2, aad arg_3).
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR If a parameter has a wrong size or if a
+ *             character beyond '\255;' is present.
+ */
+objectType cry_chacha20_poly1305_encode (listType arguments)
+
+  { /* cry_chacha20_poly1305_encode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cryChaCha20Poly1305Encode(take_stri(arg_1(arguments)),
+                                  take_stri(arg_2(arguments)),
+                                  take_stri(arg_3(arguments)),
+                                  take_stri(arg_4(arguments))));
+  } /* cry_chacha20_poly1305_encode */
+
+
+
+/**
+ *  Multiply the secp256r1 point arg_1 with the scalar arg_2.
+ *  @return the product in uncompressed form, or "" for the point
+ *          at infinity.
+ *  @exception RANGE_ERROR If arg_1 is not an uncompressed point on
+ *             the curve or if arg_2 has not 32 bytes.
+ */
+objectType cry_p256_mult (listType arguments)
+
+  { /* cry_p256_mult */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        cryP256Mult(take_stri(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* cry_p256_mult */
+
+
+
+/**
+ *  Compute the X25519 function with the scalar arg_1 and the u-coordinate arg_2.
+ *  @return the resulting u-coordinate (32 bytes in little endian).
+ *  @exception RANGE_ERROR If arg_1 or arg_2 have not 32 bytes.
+ */
+objectType cry_x25519 (listType arguments)
+
+  { /* cry_x25519 */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        cryX25519(take_stri(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* cry_x25519 */
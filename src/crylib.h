@@ -0,0 +1,31 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/crylib.h                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for cryptographic algorithms.    */
+/*                                                                  */
+/********************************************************************/
+
+objectType cry_chacha20_poly1305_decode (listType arguments);
+objectType cry_chacha20_poly1305_encode (listType arguments);
+objectType cry_p256_mult                (listType arguments);
+objectType cry_x25519                   (listType arguments);
@@ -314,6 +314,7 @@ typedef struct blockStruct {
     locListType local_vars;
     listType local_consts;
     objectType body;
+    uintType call_count;
   } blockRecord;
 
 typedef struct arrayStruct {
@@ -406,6 +407,7 @@ typedef struct progStruct {
     uintType option_flags;
     unsigned int error_count;
     void *includeFileHash;
+    intType source_time;
     idRootType ident;
     findIdType id_for;
     entityRootType entity;
@@ -158,10 +158,15 @@ typedef SQLHANDLE SQLHWND;
 #define SQL_DRIVER_NOPROMPT  0
 #define SQL_PARAM_INPUT      1
 
+#define SQL_ATTR_PARAM_BIND_TYPE  18
+#define SQL_ATTR_PARAMSET_SIZE    22
 #define SQL_ATTR_ODBC_VERSION    200
 #define SQL_ATTR_APP_ROW_DESC  10010
 
-#define SQL_CLOSE  0
+#define SQL_PARAM_BIND_BY_COLUMN 0UL
+
+#define SQL_CLOSE         0
+#define SQL_RESET_PARAMS  3
 
 #define SQL_DESC_TYPE             1002
 #define SQL_DESC_LENGTH           1003
@@ -418,6 +423,10 @@ SQLRETURN STDCALL SQLSetEnvAttr (SQLHENV    environmentHandle,
                                  SQLINTEGER attribute,
                                  SQLPOINTER value,
                                  SQLINTEGER stringLength);
+SQLRETURN STDCALL SQLSetStmtAttrW (SQLHSTMT   statementHandle,
+                                   SQLINTEGER attribute,
+                                   SQLPOINTER value,
+                                   SQLINTEGER stringLength);
 
 #if defined(__cplusplus) || defined(c_plusplus)
 }
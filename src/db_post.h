@@ -46,7 +46,8 @@ typedef enum {
   PGRES_BAD_RESPONSE,
   PGRES_NONFATAL_ERROR,
   PGRES_FATAL_ERROR,
-  PGRES_COPY_BOTH
+  PGRES_COPY_BOTH,
+  PGRES_SINGLE_TUPLE
 } ExecStatusType;
 
 typedef enum {
@@ -160,10 +161,13 @@ extern PGresult *CDECL PQexecPrepared (PGconn *conn,
                                        const int *paramFormats,
                                        int resultFormat);
 extern void CDECL PQfinish (PGconn *conn);
+extern void CDECL PQfreemem (void *ptr);
 extern char *CDECL PQfname (const PGresult *res, int field_num);
 extern Oid CDECL PQftype (const PGresult *res, int field_num);
+extern int CDECL PQgetCopyData (PGconn *conn, char **buffer, int async);
 extern int CDECL PQgetisnull (const PGresult *res, int tup_num, int field_num);
 extern int CDECL PQgetlength (const PGresult *res, int tup_num, int field_num);
+extern PGresult *CDECL PQgetResult (PGconn *conn);
 extern char *CDECL PQgetvalue (const PGresult *res, int tup_num, int field_num);
 extern int CDECL PQnfields (const PGresult *res);
 extern int CDECL PQnparams (const PGresult *res);
@@ -173,14 +177,24 @@ extern Oid CDECL PQparamtype (const PGresult *res, int param_num);
 extern PGresult *CDECL PQprepare (PGconn *conn, const char *stmtName,
                                   const char *query, int nParams,
                                   const Oid *paramTypes);
+extern int CDECL PQputCopyData (PGconn *conn, const char *buffer, int nbytes);
+extern int CDECL PQputCopyEnd (PGconn *conn, const char *errormsg);
 extern char *CDECL PQresStatus (ExecStatusType status);
 extern char *CDECL PQresultErrorMessage (const PGresult *res);
 extern ExecStatusType CDECL PQresultStatus (const PGresult *res);
+extern int CDECL PQsendQueryPrepared (PGconn *conn,
+                                      const char *stmtName,
+                                      int nParams,
+                                      const char *const * paramValues,
+                                      const int *paramLengths,
+                                      const int *paramFormats,
+                                      int resultFormat);
 extern int CDECL PQsetClientEncoding (PGconn *conn, const char *encoding);
 extern PGconn *CDECL PQsetdbLogin (const char *pghost, const char *pgport,
                                    const char *pgoptions, const char *pgtty,
                                    const char *dbName,
                                    const char *login, const char *pwd);
+extern int CDECL PQsetSingleRowMode (PGconn *conn);
 extern ConnStatusType CDECL PQstatus (const PGconn *conn);
 
 #if defined(__cplusplus) || defined(c_plusplus)
@@ -0,0 +1,2383 @@
+/********************************************************************/
+/*                                                                  */
+/*  dfl_rtl.c     Deflate compression and inflate decompression.    */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/dfl_rtl.c                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Deflate compression and inflate decompression.         */
+/*                                                                  */
+/*  Both directions work incrementally (RFC 1951 and RFC 1950).     */
+/*  The inflater accepts the compressed data in arbitrary pieces.   */
+/*  If a piece ends in the middle of a block header or a symbol     */
+/*  the decoding of this unit is undone and the remaining bytes     */
+/*  are kept until the next piece arrives. The deflater uses hash   */
+/*  chains to find matches and chooses between stored, fixed and    */
+/*  dynamic Huffman blocks. The states of both directions contain   */
+/*  no pointers, so they can be kept in a bstring.                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_PTHREADS
+#include "unistd.h"
+#include "pthread.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfl_rtl.h"
+
+
+#define MIN_MATCH              3
+#define WINDOW_MASK            (DFL_WINDOW_SIZE - 1)
+#define LOOKUP_MASK            ((1 << DFL_LOOKUP_BITS) - 1)
+#define ADLER_BASE             65521
+#define ADLER_NMAX             5552
+#define MIN_LOOKAHEAD          (DFL_MAX_MATCH + 1)
+#define TOO_FAR                4096
+#define MAX_STORED_LENGTH      65535
+#define END_OF_BLOCK           256
+#define NUM_CODE_LENGTH_CODES  19
+#define COPY_SLACK             8
+#define INFLATE_LIMIT          (DFL_INFLATE_BUFFER_SIZE - DFL_MAX_MATCH - COPY_SLACK)
+
+#define MODE_ZLIB_HEADER  0
+#define MODE_BLOCK_HEADER 1
+#define MODE_STORED       2
+#define MODE_HUFFMAN      3
+#define MODE_CHECKSUM     4
+#define MODE_DONE         5
+
+#define DFL_JOB_OKAY         0
+#define DFL_JOB_RANGE_ERROR  1
+#define DFL_JOB_MEMORY_ERROR 2
+#define DFL_MAX_WORKERS     64
+#define DFL_INFLATE_PIECE  16384
+
+/* A job deflates or inflates one piece of data. */
+typedef struct {
+    const strElemType *input;
+    memSizeType dictionaryLength;
+    memSizeType inputLength;
+    memSizeType inputUsed;
+    int level;
+    boolType lastPiece;
+    int status;
+    ucharType *output;
+    memSizeType outputLength;
+    memSizeType outputCapacity;
+  } dflJobRecord, *dflJobType;
+
+#if HAS_PTHREADS
+typedef struct {
+    dflJobType jobs;
+    memSizeType numJobs;
+    memSizeType nextJob;
+    void (*work) (dflJobType job);
+    pthread_mutex_t mutex;
+  } dflJobQueueRecord, *dflJobQueueType;
+#endif
+
+typedef struct {
+    const ucharType *data;
+    memSizeType size;
+    memSizeType pos;
+    uint64Type bitBuffer;
+    unsigned int bitCount;
+    boolType overrun;
+  } bitInputType;
+
+static const uint16Type lengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+static const ucharType lengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+static const uint16Type distanceBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577};
+
+static const ucharType distanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static const ucharType codeLengthOrder[NUM_CODE_LENGTH_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+/* Maximum chain length and nice length for the levels 0 to 9. */
+static const uint16Type levelMaxChain[10] = {
+    0, 4, 8, 32, 16, 32, 128, 256, 1024, 4096};
+
+static const uint16Type levelNiceLength[10] = {
+    0, 8, 16, 32, 16, 32, 128, 128, 258, 258};
+
+/* Matches with at least maxLazy bytes are taken without checking */
+/* the next position. If the match has at least goodLength bytes  */
+/* the next position is checked with a quarter of the chain.      */
+static const uint16Type levelMaxLazy[10] = {
+    0, 0, 0, 0, 4, 16, 16, 32, 128, 258};
+
+static const uint16Type levelGoodLength[10] = {
+    0, 4, 4, 4, 4, 8, 8, 8, 32, 32};
+
+
+
+/**
+ *  Compute the Adler-32 checksum (RFC 1950) of 'data'.
+ *  @param adler Checksum of the previous data or 1 at the start.
+ *  @return the checksum of the previous data followed by 'data'.
+ */
+uint32Type dflAdler32 (uint32Type adler, const ucharType *data,
+    memSizeType length)
+
+  {
+    uint32Type sum1;
+    uint32Type sum2;
+    memSizeType blockLength;
+
+  /* dflAdler32 */
+    sum1 = adler & 0xffff;
+    sum2 = adler >> 16;
+    while (length != 0) {
+      blockLength = length < ADLER_NMAX ? length : ADLER_NMAX;
+      length -= blockLength;
+      while (blockLength >= 8) {
+        sum1 += data[0]; sum2 += sum1;
+        sum1 += data[1]; sum2 += sum1;
+        sum1 += data[2]; sum2 += sum1;
+        sum1 += data[3]; sum2 += sum1;
+        sum1 += data[4]; sum2 += sum1;
+        sum1 += data[5]; sum2 += sum1;
+        sum1 += data[6]; sum2 += sum1;
+        sum1 += data[7]; sum2 += sum1;
+        data += 8;
+        blockLength -= 8;
+      } /* while */
+      while (blockLength != 0) {
+        sum1 += *data++;
+        sum2 += sum1;
+        blockLength--;
+      } /* while */
+      sum1 %= ADLER_BASE;
+      sum2 %= ADLER_BASE;
+    } /* while */
+    return (sum2 << 16) | sum1;
+  } /* dflAdler32 */
+
+
+
+static inline unsigned int reverseBits (unsigned int code, unsigned int length)
+
+  {
+    unsigned int reversed = 0;
+
+  /* reverseBits */
+    while (length != 0) {
+      reversed = (reversed << 1) | (code & 1);
+      code >>= 1;
+      length--;
+    } /* while */
+    return reversed;
+  } /* reverseBits */
+
+
+
+/**
+ *  Create a Huffman decoding table from the code lengths.
+ *  Incomplete codes are accepted. Decoding an unused code
+ *  fails later.
+ *  @return TRUE if the table could be created, FALSE if the
+ *          code lengths are oversubscribed.
+ */
+static boolType buildHuffmanTable (dflHuffmanRecord *table,
+    const ucharType *lengths, unsigned int numSymbols)
+
+  {
+    uint16Type offset[16];
+    uint16Type nextCode[16];
+    unsigned int symbol;
+    unsigned int length;
+    unsigned int code;
+    unsigned int index;
+    int left;
+
+  /* buildHuffmanTable */
+    memset(table->count, 0, sizeof(table->count));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      table->count[lengths[symbol]]++;
+    } /* for */
+    table->count[0] = 0;
+    left = 1;
+    for (length = 1; length <= 15; length++) {
+      left <<= 1;
+      left -= table->count[length];
+      if (left < 0) {
+        return FALSE;
+      } /* if */
+    } /* for */
+    offset[1] = 0;
+    nextCode[1] = 0;
+    for (length = 1; length < 15; length++) {
+      offset[length + 1] = (uint16Type) (offset[length] + table->count[length]);
+      nextCode[length + 1] = (uint16Type) ((nextCode[length] + table->count[length]) << 1);
+    } /* for */
+    memset(table->lookup, 0, sizeof(table->lookup));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = lengths[symbol];
+      if (length != 0) {
+        table->symbol[offset[length]++] = (uint16Type) symbol;
+        code = nextCode[length]++;
+        if (length <= DFL_LOOKUP_BITS) {
+          for (index = reverseBits(code, length); index <= LOOKUP_MASK;
+               index += 1 << length) {
+            table->lookup[index] = (uint16Type) (symbol << 4 | length);
+          } /* for */
+        } /* if */
+      } /* if */
+    } /* for */
+    return TRUE;
+  } /* buildHuffmanTable */
+
+
+
+static void buildFixedTables (dflInflateType inflater)
+
+  {
+    ucharType lengths[DFL_NUM_LITERAL_CODES];
+
+  /* buildFixedTables */
+    memset(&lengths[0], 8, 144);
+    memset(&lengths[144], 9, 112);
+    memset(&lengths[256], 7, 24);
+    memset(&lengths[280], 8, 8);
+    buildHuffmanTable(&inflater->literalTable, lengths, DFL_NUM_LITERAL_CODES);
+    memset(lengths, 5, DFL_NUM_DISTANCE_CODES);
+    buildHuffmanTable(&inflater->distanceTable, lengths, DFL_NUM_DISTANCE_CODES);
+  } /* buildFixedTables */
+
+
+
+static inline void refillBits (bitInputType *input)
+
+  { /* refillBits */
+    while (input->bitCount <= 56 && input->pos < input->size) {
+      input->bitBuffer |= (uint64Type) input->data[input->pos] << input->bitCount;
+      input->pos++;
+      input->bitCount += 8;
+    } /* while */
+  } /* refillBits */
+
+
+
+/**
+ *  Get 'numBits' bits from 'input'.
+ *  If the input is exhausted zero bits are delivered and the
+ *  overrun flag is set. The caller must undo the current unit
+ *  in this case.
+ */
+static inline unsigned int getBits (bitInputType *input, unsigned int numBits)
+
+  {
+    unsigned int value;
+
+  /* getBits */
+    if (input->bitCount < numBits) {
+      refillBits(input);
+      if (input->bitCount < numBits) {
+        input->overrun = TRUE;
+        input->bitCount = numBits;
+      } /* if */
+    } /* if */
+    value = (unsigned int) (input->bitBuffer & ((1U << numBits) - 1));
+    input->bitBuffer >>= numBits;
+    input->bitCount -= numBits;
+    return value;
+  } /* getBits */
+
+
+
+/**
+ *  Decode one Huffman coded symbol.
+ *  @return the symbol or -1 if the code is not used by 'table'.
+ */
+static inline int decodeSymbol (bitInputType *input,
+    const dflHuffmanRecord *table)
+
+  {
+    unsigned int entry;
+    unsigned int length;
+    unsigned int bits;
+    unsigned int code;
+    unsigned int first;
+    unsigned int index;
+    unsigned int count;
+    int symbol;
+
+  /* decodeSymbol */
+    if (input->bitCount < 15) {
+      refillBits(input);
+    } /* if */
+    entry = table->lookup[input->bitBuffer & LOOKUP_MASK];
+    if (likely(entry != 0)) {
+      length = entry & 15;
+      symbol = (int) (entry >> 4);
+    } else {
+      /* Codes longer than DFL_LOOKUP_BITS are decoded bitwise. */
+      bits = (unsigned int) input->bitBuffer;
+      code = 0;
+      first = 0;
+      index = 0;
+      symbol = -1;
+      for (length = 1; length <= 15; length++) {
+        code |= bits & 1;
+        bits >>= 1;
+        count = table->count[length];
+        if (code < first + count) {
+          index += code - first;
+          if (index < DFL_NUM_LITERAL_CODES) {
+            symbol = table->symbol[index];
+          } /* if */
+          break;
+        } /* if */
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+      } /* for */
+      if (symbol < 0) {
+        if (input->bitCount < 15) {
+          input->overrun = TRUE;
+        } /* if */
+        return -1;
+      } /* if */
+    } /* if */
+    if (unlikely(length > input->bitCount)) {
+      input->overrun = TRUE;
+      input->bitCount = length;
+    } /* if */
+    input->bitBuffer >>= length;
+    input->bitCount -= length;
+    return symbol;
+  } /* decodeSymbol */
+
+
+
+/**
+ *  Read the code lengths of a dynamic Huffman block and create
+ *  the literal/length and the distance tables.
+ *  @return TRUE if the tables could be created, FALSE otherwise.
+ */
+static boolType readDynamicTables (bitInputType *input,
+    dflInflateType inflater)
+
+  {
+    ucharType lengths[DFL_NUM_LITERAL_CODES + DFL_NUM_DISTANCE_CODES];
+    ucharType codeLengthLengths[NUM_CODE_LENGTH_CODES];
+    dflHuffmanRecord codeLengthTable;
+    unsigned int numLiteralCodes;
+    unsigned int numDistanceCodes;
+    unsigned int numCodeLengthCodes;
+    unsigned int index;
+    unsigned int repeat;
+    int symbol;
+    ucharType value;
+
+  /* readDynamicTables */
+    numLiteralCodes = getBits(input, 5) + 257;
+    numDistanceCodes = getBits(input, 5) + 1;
+    numCodeLengthCodes = getBits(input, 4) + 4;
+    if (numLiteralCodes > 286 || numDistanceCodes > 30) {
+      return FALSE;
+    } /* if */
+    memset(codeLengthLengths, 0, sizeof(codeLengthLengths));
+    for (index = 0; index < numCodeLengthCodes; index++) {
+      codeLengthLengths[codeLengthOrder[index]] = (ucharType) getBits(input, 3);
+    } /* for */
+    if (!buildHuffmanTable(&codeLengthTable, codeLengthLengths,
+                           NUM_CODE_LENGTH_CODES)) {
+      return FALSE;
+    } /* if */
+    index = 0;
+    while (index < numLiteralCodes + numDistanceCodes) {
+      symbol = decodeSymbol(input, &codeLengthTable);
+      if (symbol < 0) {
+        return FALSE;
+      } else if (symbol < 16) {
+        lengths[index++] = (ucharType) symbol;
+      } else {
+        if (symbol == 16) {
+          if (index == 0) {
+            return FALSE;
+          } /* if */
+          value = lengths[index - 1];
+          repeat = 3 + getBits(input, 2);
+        } else if (symbol == 17) {
+          value = 0;
+          repeat = 3 + getBits(input, 3);
+        } else {
+          value = 0;
+          repeat = 11 + getBits(input, 7);
+        } /* if */
+        if (index + repeat > numLiteralCodes + numDistanceCodes) {
+          return FALSE;
+        } /* if */
+        memset(&lengths[index], value, repeat);
+        index += repeat;
+      } /* if */
+    } /* while */
+    return lengths[END_OF_BLOCK] != 0 &&
+        buildHuffmanTable(&inflater->literalTable, lengths, numLiteralCodes) &&
+        buildHuffmanTable(&inflater->distanceTable, &lengths[numLiteralCodes],
+                          numDistanceCodes);
+  } /* readDynamicTables */
+
+
+
+/**
+ *  Deliver the decompressed bytes not delivered so far.
+ *  If 'slide' is TRUE the window is moved to the start of
+ *  the buffer, such that it keeps the last DFL_WINDOW_SIZE bytes.
+ *  @return FALSE if the output function failed, TRUE otherwise.
+ */
+static boolType flushWindow (dflInflateType inflater, boolType slide,
+    dflOutputFuncType output, void *outputData)
+
+  { /* flushWindow */
+    if (inflater->windowPos > inflater->flushedPos) {
+      if (inflater->zlibFormat) {
+        inflater->adler = dflAdler32(inflater->adler,
+            &inflater->window[inflater->flushedPos],
+            inflater->windowPos - inflater->flushedPos);
+      } /* if */
+      if (!output(&inflater->window[inflater->flushedPos],
+                  inflater->windowPos - inflater->flushedPos, outputData)) {
+        return FALSE;
+      } /* if */
+      inflater->flushedPos = inflater->windowPos;
+    } /* if */
+    if (slide && inflater->windowPos > DFL_WINDOW_SIZE) {
+      memmove(inflater->window,
+              &inflater->window[inflater->windowPos - DFL_WINDOW_SIZE],
+              DFL_WINDOW_SIZE);
+      inflater->windowPos = DFL_WINDOW_SIZE;
+      inflater->flushedPos = DFL_WINDOW_SIZE;
+    } /* if */
+    return TRUE;
+  } /* flushWindow */
+
+
+
+/**
+ *  Copy 'length' bytes from 'distance' bytes back in the window.
+ *  The window has enough space for up to COPY_SLACK extra bytes.
+ */
+static inline void copyMatch (ucharType *dest, memSizeType distance,
+    unsigned int length)
+
+  {
+    const ucharType *source;
+    ucharType *end;
+
+  /* copyMatch */
+    source = dest - distance;
+    end = dest + length;
+    if (distance >= COPY_SLACK) {
+      do {
+        memcpy(dest, source, COPY_SLACK);
+        dest += COPY_SLACK;
+        source += COPY_SLACK;
+      } while (dest < end);
+    } else if (distance == 1) {
+      memset(dest, *source, length);
+    } else {
+      do {
+        *dest++ = *source++;
+      } while (dest < end);
+    } /* if */
+  } /* copyMatch */
+
+
+
+/**
+ *  Decode Huffman coded symbols until the end of the block is
+ *  reached or the input is exhausted.
+ *  @return DFL_NEED_INPUT if the input is exhausted, DFL_STREAM_END
+ *          if the end of the block is reached, DFL_DATA_ERROR or
+ *          DFL_OUTPUT_ERROR in case of an error.
+ */
+static int decodeHuffmanBlock (dflInflateType inflater,
+    bitInputType *input, dflOutputFuncType output, void *outputData)
+
+  {
+    memSizeType savedPos;
+    uint64Type savedBitBuffer;
+    unsigned int savedBitCount;
+    int symbol;
+    unsigned int length;
+    memSizeType distance;
+
+  /* decodeHuffmanBlock */
+    for (;;) {
+      if (unlikely(inflater->windowPos > INFLATE_LIMIT)) {
+        if (!flushWindow(inflater, TRUE, output, outputData)) {
+          return DFL_OUTPUT_ERROR;
+        } /* if */
+      } /* if */
+      savedPos = input->pos;
+      savedBitBuffer = input->bitBuffer;
+      savedBitCount = input->bitCount;
+      symbol = decodeSymbol(input, &inflater->literalTable);
+      if (symbol < END_OF_BLOCK && symbol >= 0) {
+        if (unlikely(input->overrun)) {
+          break;
+        } /* if */
+        inflater->window[inflater->windowPos++] = (ucharType) symbol;
+      } else if (symbol == END_OF_BLOCK) {
+        if (unlikely(input->overrun)) {
+          break;
+        } /* if */
+        return DFL_STREAM_END;
+      } else {
+        if (unlikely(symbol < 0 || symbol > 285)) {
+          if (input->overrun) {
+            break;
+          } /* if */
+          return DFL_DATA_ERROR;
+        } /* if */
+        symbol -= END_OF_BLOCK + 1;
+        length = lengthBase[symbol] + getBits(input, lengthExtra[symbol]);
+        symbol = decodeSymbol(input, &inflater->distanceTable);
+        if (unlikely(symbol < 0 || symbol >= 30)) {
+          if (input->overrun) {
+            break;
+          } /* if */
+          return DFL_DATA_ERROR;
+        } /* if */
+        distance = distanceBase[symbol] + getBits(input, distanceExtra[symbol]);
+        if (unlikely(input->overrun)) {
+          break;
+        } /* if */
+        if (unlikely(distance > inflater->windowPos)) {
+          return DFL_DATA_ERROR;
+        } /* if */
+        copyMatch(&inflater->window[inflater->windowPos], distance, length);
+        inflater->windowPos += length;
+      } /* if */
+    } /* for */
+    /* The input was exhausted: Undo the decoding of the last unit. */
+    input->pos = savedPos;
+    input->bitBuffer = savedBitBuffer;
+    input->bitCount = savedBitCount;
+    return DFL_NEED_INPUT;
+  } /* decodeHuffmanBlock */
+
+
+
+/**
+ *  Check if 'inflater' contains a consistent inflate state.
+ *  This check is done before a state from a bstring is used.
+ */
+boolType dflInflateIsValid (const dflInflateRecord *inflater)
+
+  { /* dflInflateIsValid */
+    return inflater->mode >= MODE_ZLIB_HEADER &&
+           inflater->mode <= MODE_DONE &&
+           inflater->storedRemaining <= MAX_STORED_LENGTH &&
+           inflater->pendingLength <= DFL_MAX_PENDING &&
+           inflater->pendingBitOffset < 8 &&
+           inflater->windowPos <= INFLATE_LIMIT &&
+           inflater->flushedPos <= inflater->windowPos;
+  } /* dflInflateIsValid */
+
+
+
+/**
+ *  Initialize an inflate state.
+ *  @param zlibFormat TRUE if the data starts with a zlib header
+ *         and ends with an Adler-32 checksum (RFC 1950), FALSE
+ *         if the data is raw DEFLATE data (RFC 1951).
+ */
+void dflInflateInit (dflInflateType inflater, boolType zlibFormat)
+
+  { /* dflInflateInit */
+    memset(inflater, 0, sizeof(dflInflateRecord));
+    inflater->mode = zlibFormat ? MODE_ZLIB_HEADER : MODE_BLOCK_HEADER;
+    inflater->zlibFormat = zlibFormat;
+    inflater->adler = 1;
+  } /* dflInflateInit */
+
+
+
+/**
+ *  Decompress the next piece of compressed data.
+ *  All bytes decompressed from 'input' are delivered with the
+ *  function 'output' before dflInflate returns. The bytes of an
+ *  incomplete unit at the end of 'input' are kept in 'inflater'.
+ *  At the end of the stream inflater->unusedInput is set to the
+ *  number of bytes at the end of 'input' that follow the stream.
+ *  @return DFL_NEED_INPUT if more input is needed, DFL_STREAM_END
+ *          if the end of the compressed data has been reached,
+ *          DFL_DATA_ERROR if the data is corrupt or DFL_OUTPUT_ERROR
+ *          if 'output' failed or the memory is exhausted.
+ */
+int dflInflate (dflInflateType inflater, const ucharType *input,
+    memSizeType inputLength, dflOutputFuncType output, void *outputData)
+
+  {
+    ucharType *joined = NULL;
+    bitInputType in;
+    bitInputType checkpoint;
+    unsigned int header;
+    unsigned int blockType;
+    boolType lastBlock;
+    memSizeType length;
+    memSizeType bitPos;
+    int result = DFL_NEED_INPUT;
+
+  /* dflInflate */
+    logFunction(printf("dflInflate(*, *, " FMT_U_MEM ", *, *)\n",
+                       inputLength););
+    if (inflater->pendingLength != 0) {
+      if (unlikely(inputLength > MAX_MEMSIZETYPE - DFL_MAX_PENDING ||
+                   (joined = (ucharType *) malloc(inflater->pendingLength +
+                                                  inputLength)) == NULL)) {
+        return DFL_OUTPUT_ERROR;
+      } /* if */
+      memcpy(joined, inflater->pending, inflater->pendingLength);
+      memcpy(&joined[inflater->pendingLength], input, inputLength);
+      in.data = joined;
+      in.size = inflater->pendingLength + inputLength;
+    } else {
+      in.data = input;
+      in.size = inputLength;
+    } /* if */
+    in.pos = 0;
+    in.bitBuffer = 0;
+    in.bitCount = 0;
+    in.overrun = FALSE;
+    getBits(&in, inflater->pendingBitOffset);
+    inflater->pendingLength = 0;
+    inflater->pendingBitOffset = 0;
+    while (result == DFL_NEED_INPUT) {
+      checkpoint = in;
+      switch (inflater->mode) {
+        case MODE_ZLIB_HEADER:
+          header = getBits(&in, 8) << 8;
+          header |= getBits(&in, 8);
+          if (in.overrun) {
+            in = checkpoint;
+            result = -1;
+          } else if (header % 31 != 0 || (header & 0x0f00) != 0x0800 ||
+                     (header >> 12) > 7 || (header & 0x20) != 0) {
+            result = DFL_DATA_ERROR;
+          } else {
+            inflater->mode = MODE_BLOCK_HEADER;
+          } /* if */
+          break;
+        case MODE_BLOCK_HEADER:
+          if (inflater->lastBlock) {
+            inflater->mode = inflater->zlibFormat ? MODE_CHECKSUM : MODE_DONE;
+            break;
+          } /* if */
+          lastBlock = getBits(&in, 1) != 0;
+          blockType = getBits(&in, 2);
+          if (blockType == 0) {
+            getBits(&in, in.bitCount & 7);
+            length = getBits(&in, 16);
+            if (in.overrun) {
+              in = checkpoint;
+              result = -1;
+            } else if ((length ^ getBits(&in, 16)) != 0xffff || in.overrun) {
+              if (in.overrun) {
+                in = checkpoint;
+                result = -1;
+              } else {
+                result = DFL_DATA_ERROR;
+              } /* if */
+            } else {
+              inflater->storedRemaining = length;
+              inflater->lastBlock = lastBlock;
+              inflater->mode = MODE_STORED;
+            } /* if */
+          } else if (blockType == 1) {
+            if (in.overrun) {
+              in = checkpoint;
+              result = -1;
+            } else {
+              buildFixedTables(inflater);
+              inflater->lastBlock = lastBlock;
+              inflater->mode = MODE_HUFFMAN;
+            } /* if */
+          } else if (blockType == 2) {
+            if (!readDynamicTables(&in, inflater) || in.overrun) {
+              if (in.overrun) {
+                in = checkpoint;
+                result = -1;
+              } else {
+                result = DFL_DATA_ERROR;
+              } /* if */
+            } else {
+              inflater->lastBlock = lastBlock;
+              inflater->mode = MODE_HUFFMAN;
+            } /* if */
+          } else if (in.overrun) {
+            in = checkpoint;
+            result = -1;
+          } else {
+            result = DFL_DATA_ERROR;
+          } /* if */
+          break;
+        case MODE_STORED:
+          /* Give the whole bytes of the bit buffer back to the input. */
+          in.pos -= in.bitCount >> 3;
+          in.bitBuffer = 0;
+          in.bitCount = 0;
+          if (inflater->windowPos > INFLATE_LIMIT - 1) {
+            if (!flushWindow(inflater, TRUE, output, outputData)) {
+              result = DFL_OUTPUT_ERROR;
+              break;
+            } /* if */
+          } /* if */
+          length = INFLATE_LIMIT - inflater->windowPos;
+          if (length > inflater->storedRemaining) {
+            length = inflater->storedRemaining;
+          } /* if */
+          if (length > in.size - in.pos) {
+            length = in.size - in.pos;
+          } /* if */
+          memcpy(&inflater->window[inflater->windowPos], &in.data[in.pos], length);
+          inflater->windowPos += length;
+          in.pos += length;
+          inflater->storedRemaining -= length;
+          if (inflater->storedRemaining == 0) {
+            inflater->mode = MODE_BLOCK_HEADER;
+          } else if (in.pos == in.size) {
+            result = -1;
+          } /* if */
+          break;
+        case MODE_HUFFMAN:
+          switch (decodeHuffmanBlock(inflater, &in, output, outputData)) {
+            case DFL_STREAM_END:   inflater->mode = MODE_BLOCK_HEADER; break;
+            case DFL_NEED_INPUT:   result = -1;                        break;
+            case DFL_DATA_ERROR:   result = DFL_DATA_ERROR;            break;
+            default:               result = DFL_OUTPUT_ERROR;          break;
+          } /* switch */
+          break;
+        case MODE_CHECKSUM:
+          getBits(&in, in.bitCount & 7);
+          header = getBits(&in, 8) << 24;
+          header |= getBits(&in, 8) << 16;
+          header |= getBits(&in, 8) << 8;
+          header |= getBits(&in, 8);
+          if (in.overrun) {
+            in = checkpoint;
+            result = -1;
+          } else if (!flushWindow(inflater, FALSE, output, outputData)) {
+            result = DFL_OUTPUT_ERROR;
+          } else if (header != inflater->adler) {
+            logError(printf("dflInflate: Adler-32 checksum mismatch.\n"););
+            result = DFL_DATA_ERROR;
+          } else {
+            inflater->mode = MODE_DONE;
+          } /* if */
+          break;
+        default:
+          /* The bytes after the end of the stream are not used. */
+          bitPos = (in.pos << 3) - in.bitCount;
+          inflater->unusedInput = in.size - ((bitPos + 7) >> 3);
+          result = DFL_STREAM_END;
+          break;
+      } /* switch */
+    } /* while */
+    if (result == -1) {
+      /* Keep the bytes of the unit that could not be completed. */
+      bitPos = (in.pos << 3) - in.bitCount;
+      length = in.size - (bitPos >> 3);
+      if (unlikely(length > DFL_MAX_PENDING)) {
+        result = DFL_DATA_ERROR;
+      } else {
+        memcpy(inflater->pending, &in.data[bitPos >> 3], length);
+        inflater->pendingLength = (unsigned int) length;
+        inflater->pendingBitOffset = (unsigned int) (bitPos & 7);
+        result = DFL_NEED_INPUT;
+      } /* if */
+    } /* if */
+    if (result == DFL_NEED_INPUT || result == DFL_STREAM_END) {
+      if (!flushWindow(inflater, inflater->windowPos > INFLATE_LIMIT,
+                       output, outputData)) {
+        result = DFL_OUTPUT_ERROR;
+      } /* if */
+    } /* if */
+    if (joined != NULL) {
+      free(joined);
+    } /* if */
+    logFunction(printf("dflInflate --> %d\n", result););
+    return result;
+  } /* dflInflate */
+
+
+
+/**
+ *  Compute Huffman code lengths from the symbol frequencies.
+ *  If the lengths exceed 'maxBits' the frequencies are flattened
+ *  and the computation is repeated. At least two symbols get a
+ *  code, such that the resulting code is always complete.
+ */
+static void buildCodeLengths (const uint32Type *frequency,
+    unsigned int numSymbols, unsigned int maxBits, ucharType *lengths)
+
+  {
+    uint32Type weight[2 * DFL_NUM_LITERAL_CODES];
+    uint16Type parent[2 * DFL_NUM_LITERAL_CODES];
+    ucharType depth[2 * DFL_NUM_LITERAL_CODES];
+    uint16Type order[DFL_NUM_LITERAL_CODES];
+    uint32Type scaled[DFL_NUM_LITERAL_CODES];
+    unsigned int numLeaves;
+    unsigned int leafIndex;
+    unsigned int nodeIndex;
+    unsigned int numNodes;
+    unsigned int index;
+    unsigned int pick;
+    unsigned int child[2];
+    unsigned int maxDepth;
+    uint16Type symbol;
+    boolType tooLong;
+
+  /* buildCodeLengths */
+    memset(lengths, 0, numSymbols);
+    memcpy(scaled, frequency, numSymbols * sizeof(uint32Type));
+    do {
+      numLeaves = 0;
+      for (index = 0; index < numSymbols; index++) {
+        if (scaled[index] != 0) {
+          /* Insertion sort by frequency. */
+          leafIndex = numLeaves;
+          while (leafIndex > 0 && scaled[order[leafIndex - 1]] > scaled[index]) {
+            order[leafIndex] = order[leafIndex - 1];
+            leafIndex--;
+          } /* while */
+          order[leafIndex] = (uint16Type) index;
+          numLeaves++;
+        } /* if */
+      } /* for */
+      if (numLeaves <= 1) {
+        symbol = numLeaves == 1 ? order[0] : 0;
+        lengths[symbol] = 1;
+        lengths[symbol == 0 ? 1 : 0] = 1;
+        return;
+      } /* if */
+      for (index = 0; index < numLeaves; index++) {
+        weight[index] = scaled[order[index]];
+      } /* for */
+      /* Two queues: The sorted leaves and the created nodes. */
+      leafIndex = 0;
+      nodeIndex = numLeaves;
+      numNodes = numLeaves;
+      while (numNodes < 2 * numLeaves - 1) {
+        for (pick = 0; pick < 2; pick++) {
+          if (leafIndex < numLeaves &&
+              (nodeIndex >= numNodes || weight[leafIndex] <= weight[nodeIndex])) {
+            child[pick] = leafIndex++;
+          } else {
+            child[pick] = nodeIndex++;
+          } /* if */
+        } /* for */
+        weight[numNodes] = weight[child[0]] + weight[child[1]];
+        parent[child[0]] = (uint16Type) numNodes;
+        parent[child[1]] = (uint16Type) numNodes;
+        numNodes++;
+      } /* while */
+      depth[numNodes - 1] = 0;
+      maxDepth = 0;
+      for (index = numNodes - 1; index-- > 0; ) {
+        depth[index] = (ucharType) (depth[parent[index]] + 1);
+        if (index < numLeaves && depth[index] > maxDepth) {
+          maxDepth = depth[index];
+        } /* if */
+      } /* for */
+      tooLong = maxDepth > maxBits;
+      if (tooLong) {
+        for (index = 0; index < numSymbols; index++) {
+          if (scaled[index] != 0) {
+            scaled[index] = (scaled[index] + 1) >> 1;
+          } /* if */
+        } /* for */
+      } /* if */
+    } while (tooLong);
+    for (index = 0; index < numLeaves; index++) {
+      lengths[order[index]] = depth[index];
+    } /* for */
+  } /* buildCodeLengths */
+
+
+
+/**
+ *  Compute the canonical codes (with reversed bit order) for 'lengths'.
+ */
+static void buildCodes (const ucharType *lengths, unsigned int numSymbols,
+    uint16Type *codes)
+
+  {
+    uint16Type count[16];
+    uint16Type nextCode[16];
+    unsigned int symbol;
+    unsigned int length;
+
+  /* buildCodes */
+    memset(count, 0, sizeof(count));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      count[lengths[symbol]]++;
+    } /* for */
+    count[0] = 0;
+    nextCode[1] = 0;
+    for (length = 1; length < 15; length++) {
+      nextCode[length + 1] = (uint16Type) ((nextCode[length] + count[length]) << 1);
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = lengths[symbol];
+      if (length != 0) {
+        codes[symbol] = (uint16Type) reverseBits(nextCode[length]++, length);
+      } else {
+        codes[symbol] = 0;
+      } /* if */
+    } /* for */
+  } /* buildCodes */
+
+
+
+static inline unsigned int floorLog2 (unsigned int number)
+
+  {
+    unsigned int result = 0;
+
+  /* floorLog2 */
+    while (number > 1) {
+      number >>= 1;
+      result++;
+    } /* while */
+    return result;
+  } /* floorLog2 */
+
+
+
+/**
+ *  Determine the length code index (0 to 28) of a match length.
+ */
+static inline unsigned int lengthCodeIndex (unsigned int length)
+
+  {
+    unsigned int value;
+    unsigned int numBits;
+
+  /* lengthCodeIndex */
+    value = length - MIN_MATCH;
+    if (value < 8) {
+      return value;
+    } else if (value == 255) {
+      return 28;
+    } else {
+      numBits = floorLog2(value);
+      return 4 * (numBits - 1) + ((value >> (numBits - 2)) & 3);
+    } /* if */
+  } /* lengthCodeIndex */
+
+
+
+/**
+ *  Determine the distance code (0 to 29) of a match distance.
+ */
+static inline unsigned int distanceCode (unsigned int distance)
+
+  {
+    unsigned int value;
+    unsigned int numBits;
+
+  /* distanceCode */
+    value = distance - 1;
+    if (value < 4) {
+      return value;
+    } else {
+      numBits = floorLog2(value);
+      return 2 * numBits + ((value >> (numBits - 1)) & 1);
+    } /* if */
+  } /* distanceCode */
+
+
+
+static inline void putBits (dflDeflateType deflater, unsigned int value,
+    unsigned int numBits)
+
+  { /* putBits */
+    deflater->bitBuffer |= (uint64Type) value << deflater->bitCount;
+    deflater->bitCount += numBits;
+    while (deflater->bitCount >= 8) {
+      deflater->output[deflater->outputLength++] = (ucharType) deflater->bitBuffer;
+      deflater->bitBuffer >>= 8;
+      deflater->bitCount -= 8;
+    } /* while */
+  } /* putBits */
+
+
+
+static inline void alignToByte (dflDeflateType deflater)
+
+  { /* alignToByte */
+    if (deflater->bitCount != 0) {
+      putBits(deflater, 0, 8 - deflater->bitCount);
+    } /* if */
+  } /* alignToByte */
+
+
+
+/**
+ *  Deliver the bytes in the output buffer, if less than 'reserve'
+ *  bytes are free.
+ */
+static inline boolType flushOutput (dflDeflateType deflater,
+    unsigned int reserve, dflOutputFuncType output, void *outputData)
+
+  {
+    boolType okay = TRUE;
+
+  /* flushOutput */
+    if (deflater->outputLength > DFL_OUTPUT_BUFFER_SIZE - reserve) {
+      okay = output(deflater->output, deflater->outputLength, outputData);
+      deflater->outputLength = 0;
+    } /* if */
+    return okay;
+  } /* flushOutput */
+
+
+
+/**
+ *  Compute the number of bits needed to write the symbols of the
+ *  current block with the given code lengths.
+ */
+static uint64Type symbolBits (const dflDeflateRecord *deflater,
+    const ucharType *literalLengths, const ucharType *distanceLengths)
+
+  {
+    unsigned int index;
+    uint64Type bits = 0;
+
+  /* symbolBits */
+    for (index = 0; index < DFL_NUM_LITERAL_CODES - 2; index++) {
+      bits += (uint64Type) deflater->literalFrequency[index] *
+          (unsigned int) (literalLengths[index] +
+           (index > END_OF_BLOCK ? lengthExtra[index - END_OF_BLOCK - 1] : 0));
+    } /* for */
+    for (index = 0; index < DFL_NUM_DISTANCE_CODES - 2; index++) {
+      bits += (uint64Type) deflater->distanceFrequency[index] *
+          (distanceLengths[index] + distanceExtra[index]);
+    } /* for */
+    return bits;
+  } /* symbolBits */
+
+
+
+static boolType writeSymbols (dflDeflateType deflater,
+    const ucharType *literalLengths, const uint16Type *literalCodes,
+    const ucharType *distanceLengths, const uint16Type *distanceCodes,
+    dflOutputFuncType output, void *outputData)
+
+  {
+    unsigned int index;
+    unsigned int length;
+    unsigned int distance;
+    unsigned int code;
+
+  /* writeSymbols */
+    for (index = 0; index < deflater->numSymbols; index++) {
+      if (deflater->outputLength > DFL_OUTPUT_BUFFER_SIZE - 16 &&
+          !flushOutput(deflater, 16, output, outputData)) {
+        return FALSE;
+      } /* if */
+      distance = deflater->symbolDistance[index];
+      if (distance == 0) {
+        code = deflater->symbolLength[index];
+        putBits(deflater, literalCodes[code], literalLengths[code]);
+      } else {
+        length = deflater->symbolLength[index];
+        code = lengthCodeIndex(length);
+        putBits(deflater, literalCodes[code + END_OF_BLOCK + 1],
+                literalLengths[code + END_OF_BLOCK + 1]);
+        putBits(deflater, length - lengthBase[code], lengthExtra[code]);
+        code = distanceCode(distance);
+        putBits(deflater, distanceCodes[code], distanceLengths[code]);
+        putBits(deflater, distance - distanceBase[code], distanceExtra[code]);
+      } /* if */
+    } /* for */
+    putBits(deflater, literalCodes[END_OF_BLOCK], literalLengths[END_OF_BLOCK]);
+    return TRUE;
+  } /* writeSymbols */
+
+
+
+/**
+ *  Write the symbols collected since the start of the block.
+ *  The block type (stored, fixed or dynamic Huffman codes) with
+ *  the smallest size is chosen.
+ */
+static boolType emitBlock (dflDeflateType deflater, boolType lastBlock,
+    dflOutputFuncType output, void *outputData)
+
+  {
+    ucharType literalLengths[DFL_NUM_LITERAL_CODES];
+    ucharType distanceLengths[DFL_NUM_DISTANCE_CODES];
+    uint16Type literalCodes[DFL_NUM_LITERAL_CODES];
+    uint16Type distanceCodes[DFL_NUM_DISTANCE_CODES];
+    ucharType fixedLiteralLengths[DFL_NUM_LITERAL_CODES];
+    ucharType fixedDistanceLengths[DFL_NUM_DISTANCE_CODES];
+    ucharType combined[DFL_NUM_LITERAL_CODES + DFL_NUM_DISTANCE_CODES];
+    ucharType runSymbol[DFL_NUM_LITERAL_CODES + DFL_NUM_DISTANCE_CODES];
+    ucharType runExtra[DFL_NUM_LITERAL_CODES + DFL_NUM_DISTANCE_CODES];
+    uint32Type codeLengthFrequency[NUM_CODE_LENGTH_CODES];
+    ucharType codeLengthLengths[NUM_CODE_LENGTH_CODES];
+    uint16Type codeLengthCodes[NUM_CODE_LENGTH_CODES];
+    unsigned int numLiteralCodes;
+    unsigned int numDistanceCodes;
+    unsigned int numCodeLengthCodes;
+    unsigned int numRuns = 0;
+    unsigned int index;
+    unsigned int runLength;
+    unsigned int maxRun;
+    uint64Type dynamicBits;
+    uint64Type fixedBits;
+    uint64Type storedBits;
+    memSizeType blockLength;
+    memSizeType chunkLength;
+    const ucharType *raw;
+
+  /* emitBlock */
+    deflater->literalFrequency[END_OF_BLOCK] = 1;
+    buildCodeLengths(deflater->literalFrequency, DFL_NUM_LITERAL_CODES - 2,
+                     15, literalLengths);
+    literalLengths[DFL_NUM_LITERAL_CODES - 2] = 0;
+    literalLengths[DFL_NUM_LITERAL_CODES - 1] = 0;
+    buildCodeLengths(deflater->distanceFrequency, DFL_NUM_DISTANCE_CODES - 2,
+                     15, distanceLengths);
+    distanceLengths[DFL_NUM_DISTANCE_CODES - 2] = 0;
+    distanceLengths[DFL_NUM_DISTANCE_CODES - 1] = 0;
+    numLiteralCodes = DFL_NUM_LITERAL_CODES - 2;
+    while (literalLengths[numLiteralCodes - 1] == 0) {
+      numLiteralCodes--;
+    } /* while */
+    numDistanceCodes = DFL_NUM_DISTANCE_CODES - 2;
+    while (numDistanceCodes > 1 && distanceLengths[numDistanceCodes - 1] == 0) {
+      numDistanceCodes--;
+    } /* while */
+    memcpy(combined, literalLengths, numLiteralCodes);
+    memcpy(&combined[numLiteralCodes], distanceLengths, numDistanceCodes);
+    /* Run length encoding of the code lengths. */
+    memset(codeLengthFrequency, 0, sizeof(codeLengthFrequency));
+    index = 0;
+    while (index < numLiteralCodes + numDistanceCodes) {
+      runLength = 1;
+      while (index + runLength < numLiteralCodes + numDistanceCodes &&
+             combined[index + runLength] == combined[index]) {
+        runLength++;
+      } /* while */
+      if (combined[index] == 0 && runLength >= 3) {
+        maxRun = runLength > 138 ? 138 : runLength;
+        if (maxRun >= 11) {
+          runSymbol[numRuns] = 18;
+          runExtra[numRuns] = (ucharType) (maxRun - 11);
+        } else {
+          runSymbol[numRuns] = 17;
+          runExtra[numRuns] = (ucharType) (maxRun - 3);
+        } /* if */
+        index += maxRun;
+      } else if (runLength >= 4) {
+        runSymbol[numRuns] = combined[index];
+        runExtra[numRuns] = 0;
+        codeLengthFrequency[combined[index]]++;
+        numRuns++;
+        maxRun = runLength - 1 > 6 ? 6 : runLength - 1;
+        runSymbol[numRuns] = 16;
+        runExtra[numRuns] = (ucharType) (maxRun - 3);
+        index += 1 + maxRun;
+      } else {
+        runSymbol[numRuns] = combined[index];
+        runExtra[numRuns] = 0;
+        index++;
+      } /* if */
+      codeLengthFrequency[runSymbol[numRuns]]++;
+      numRuns++;
+    } /* while */
+    buildCodeLengths(codeLengthFrequency, NUM_CODE_LENGTH_CODES, 7,
+                     codeLengthLengths);
+    numCodeLengthCodes = NUM_CODE_LENGTH_CODES;
+    while (numCodeLengthCodes > 4 &&
+           codeLengthLengths[codeLengthOrder[numCodeLengthCodes - 1]] == 0) {
+      numCodeLengthCodes--;
+    } /* while */
+    dynamicBits = 3 + 5 + 5 + 4 + 3 * numCodeLengthCodes;
+    for (index = 0; index < numRuns; index++) {
+      dynamicBits += codeLengthLengths[runSymbol[index]];
+      if (runSymbol[index] >= 16) {
+        dynamicBits += runSymbol[index] == 16 ? 2 : (runSymbol[index] == 17 ? 3 : 7);
+      } /* if */
+    } /* for */
+    dynamicBits += symbolBits(deflater, literalLengths, distanceLengths);
+    memset(&fixedLiteralLengths[0], 8, 144);
+    memset(&fixedLiteralLengths[144], 9, 112);
+    memset(&fixedLiteralLengths[256], 7, 24);
+    memset(&fixedLiteralLengths[280], 8, 8);
+    memset(fixedDistanceLengths, 5, DFL_NUM_DISTANCE_CODES);
+    fixedBits = 3 + symbolBits(deflater, fixedLiteralLengths, fixedDistanceLengths);
+    blockLength = deflater->position - deflater->blockStart;
+    storedBits = (blockLength + 5 * (blockLength / MAX_STORED_LENGTH + 1)) * 8 + 7;
+    if (!flushOutput(deflater, 1024, output, outputData)) {
+      return FALSE;
+    } /* if */
+    if (deflater->level == 0 ||
+        (storedBits <= dynamicBits && storedBits <= fixedBits)) {
+      raw = &deflater->window[deflater->blockStart];
+      do {
+        chunkLength = blockLength > MAX_STORED_LENGTH ? MAX_STORED_LENGTH : blockLength;
+        blockLength -= chunkLength;
+        putBits(deflater, lastBlock && blockLength == 0, 1);
+        putBits(deflater, 0, 2);
+        alignToByte(deflater);
+        putBits(deflater, (unsigned int) chunkLength, 16);
+        putBits(deflater, (unsigned int) chunkLength ^ 0xffff, 16);
+        while (chunkLength != 0) {
+          if (!flushOutput(deflater, 1, output, outputData)) {
+            return FALSE;
+          } /* if */
+          index = DFL_OUTPUT_BUFFER_SIZE - deflater->outputLength;
+          if (index > chunkLength) {
+            index = (unsigned int) chunkLength;
+          } /* if */
+          memcpy(&deflater->output[deflater->outputLength], raw, index);
+          deflater->outputLength += index;
+          raw += index;
+          chunkLength -= index;
+        } /* while */
+        if (!flushOutput(deflater, 1024, output, outputData)) {
+          return FALSE;
+        } /* if */
+      } while (blockLength != 0);
+    } else if (fixedBits <= dynamicBits) {
+      putBits(deflater, lastBlock, 1);
+      putBits(deflater, 1, 2);
+      buildCodes(fixedLiteralLengths, DFL_NUM_LITERAL_CODES, literalCodes);
+      buildCodes(fixedDistanceLengths, DFL_NUM_DISTANCE_CODES, distanceCodes);
+      if (!writeSymbols(deflater, fixedLiteralLengths, literalCodes,
+                        fixedDistanceLengths, distanceCodes, output, outputData)) {
+        return FALSE;
+      } /* if */
+    } else {
+      putBits(deflater, lastBlock, 1);
+      putBits(deflater, 2, 2);
+      putBits(deflater, numLiteralCodes - 257, 5);
+      putBits(deflater, numDistanceCodes - 1, 5);
+      putBits(deflater, numCodeLengthCodes - 4, 4);
+      for (index = 0; index < numCodeLengthCodes; index++) {
+        putBits(deflater, codeLengthLengths[codeLengthOrder[index]], 3);
+      } /* for */
+      buildCodes(codeLengthLengths, NUM_CODE_LENGTH_CODES, codeLengthCodes);
+      for (index = 0; index < numRuns; index++) {
+        putBits(deflater, codeLengthCodes[runSymbol[index]],
+                codeLengthLengths[runSymbol[index]]);
+        if (runSymbol[index] == 16) {
+          putBits(deflater, runExtra[index], 2);
+        } else if (runSymbol[index] == 17) {
+          putBits(deflater, runExtra[index], 3);
+        } else if (runSymbol[index] == 18) {
+          putBits(deflater, runExtra[index], 7);
+        } /* if */
+      } /* for */
+      buildCodes(literalLengths, DFL_NUM_LITERAL_CODES, literalCodes);
+      buildCodes(distanceLengths, DFL_NUM_DISTANCE_CODES, distanceCodes);
+      if (!writeSymbols(deflater, literalLengths, literalCodes,
+                        distanceLengths, distanceCodes, output, outputData)) {
+        return FALSE;
+      } /* if */
+    } /* if */
+    memset(deflater->literalFrequency, 0, sizeof(deflater->literalFrequency));
+    memset(deflater->distanceFrequency, 0, sizeof(deflater->distanceFrequency));
+    deflater->numSymbols = 0;
+    deflater->blockStart = deflater->position;
+    return TRUE;
+  } /* emitBlock */
+
+
+
+static inline uint32Type hashPosition (const ucharType *data)
+
+  { /* hashPosition */
+    return ((((uint32Type) data[0] << 16) | ((uint32Type) data[1] << 8) |
+             (uint32Type) data[2]) * 0x9e3779b1) >> (32 - DFL_HASH_BITS);
+  } /* hashPosition */
+
+
+
+/**
+ *  Return the previous position with the same hash as 'position'.
+ *  Positions are inserted into the hash chains in ascending order.
+ */
+static inline int32Type matchCandidate (dflDeflateType deflater,
+    memSizeType position)
+
+  {
+    uint32Type hash;
+    int32Type candidate;
+
+  /* matchCandidate */
+    if (position >= deflater->hashedPosition) {
+      hash = hashPosition(&deflater->window[position]);
+      candidate = deflater->head[hash];
+      deflater->prev[position & WINDOW_MASK] = candidate;
+      deflater->head[hash] = (int32Type) position;
+      deflater->hashedPosition = position + 1;
+    } else {
+      candidate = deflater->prev[position & WINDOW_MASK];
+    } /* if */
+    return candidate;
+  } /* matchCandidate */
+
+
+
+static inline void insertPositions (dflDeflateType deflater,
+    memSizeType limit)
+
+  { /* insertPositions */
+    if (limit + MIN_MATCH > deflater->windowFill) {
+      limit = deflater->windowFill - MIN_MATCH + 1;
+    } /* if */
+    while (deflater->hashedPosition < limit) {
+      matchCandidate(deflater, deflater->hashedPosition);
+    } /* while */
+  } /* insertPositions */
+
+
+
+static inline unsigned int matchLength (const ucharType *match,
+    const ucharType *scan, unsigned int maxLength)
+
+  {
+    uint64Type matchWord;
+    uint64Type scanWord;
+    unsigned int length = 0;
+
+  /* matchLength */
+    while (length + 8 <= maxLength) {
+      memcpy(&matchWord, &match[length], 8);
+      memcpy(&scanWord, &scan[length], 8);
+      if (matchWord != scanWord) {
+        break;
+      } /* if */
+      length += 8;
+    } /* while */
+    while (length < maxLength && match[length] == scan[length]) {
+      length++;
+    } /* while */
+    return length;
+  } /* matchLength */
+
+
+
+/**
+ *  Find the longest match for 'position' in the hash chain.
+ *  @return the length of the match or 0 if no match was found.
+ */
+static unsigned int findMatch (const dflDeflateRecord *deflater,
+    memSizeType position, int32Type candidate, unsigned int maxLength,
+    unsigned int chain, unsigned int *distance)
+
+  {
+    const ucharType *scan;
+    const ucharType *match;
+    int32Type lowLimit;
+    unsigned int bestLength = MIN_MATCH - 1;
+    unsigned int length;
+
+  /* findMatch */
+    scan = &deflater->window[position];
+    lowLimit = position > DFL_WINDOW_SIZE - MIN_LOOKAHEAD ?
+        (int32Type) (position - (DFL_WINDOW_SIZE - MIN_LOOKAHEAD)) : 0;
+    /* Overwritten chain entries can point forward: Stop at them. */
+    while (candidate >= lowLimit && (memSizeType) candidate < position &&
+           chain != 0) {
+      match = &deflater->window[candidate];
+      if (match[bestLength] == scan[bestLength] &&
+          match[bestLength - 1] == scan[bestLength - 1] &&
+          match[0] == scan[0] && match[1] == scan[1]) {
+        length = matchLength(match, scan, maxLength);
+        if (length > bestLength) {
+          bestLength = length;
+          *distance = (unsigned int) (position - (memSizeType) candidate);
+          if (length >= deflater->niceLength || length == maxLength) {
+            break;
+          } /* if */
+        } /* if */
+      } /* if */
+      candidate = deflater->prev[candidate & WINDOW_MASK];
+      chain--;
+    } /* while */
+    if (bestLength == MIN_MATCH && *distance > TOO_FAR &&
+        deflater->lazyMatching) {
+      /* A short match with a large distance is not worth it. */
+      bestLength = 0;
+    } /* if */
+    return bestLength >= MIN_MATCH ? bestLength : 0;
+  } /* findMatch */
+
+
+
+static inline boolType addSymbol (dflDeflateType deflater,
+    unsigned int length, unsigned int distance,
+    dflOutputFuncType output, void *outputData)
+
+  { /* addSymbol */
+    deflater->symbolLength[deflater->numSymbols] = (uint16Type) length;
+    deflater->symbolDistance[deflater->numSymbols] = (uint16Type) distance;
+    deflater->numSymbols++;
+    if (distance == 0) {
+      deflater->literalFrequency[length]++;
+      deflater->position++;
+    } else {
+      deflater->literalFrequency[lengthCodeIndex(length) + END_OF_BLOCK + 1]++;
+      deflater->distanceFrequency[distanceCode(distance)]++;
+      deflater->position += length;
+    } /* if */
+    if (deflater->numSymbols >= DFL_MAX_SYMBOLS) {
+      return emitBlock(deflater, FALSE, output, outputData);
+    } /* if */
+    return TRUE;
+  } /* addSymbol */
+
+
+
+/**
+ *  Compress the data in the window. Unless 'lastPass' is TRUE the
+ *  compression stops when less than MIN_LOOKAHEAD bytes follow.
+ */
+static boolType compressWindow (dflDeflateType deflater, boolType lastPass,
+    dflOutputFuncType output, void *outputData)
+
+  {
+    memSizeType position;
+    memSizeType available;
+    unsigned int maxLength;
+    unsigned int length;
+    unsigned int distance = 0;
+    unsigned int nextLength = 0;
+    unsigned int nextDistance = 0;
+    boolType nextMatchFound = FALSE;
+    unsigned int chain;
+    int32Type candidate;
+
+  /* compressWindow */
+    while (deflater->position + (lastPass ? 0 : MIN_LOOKAHEAD) <
+           deflater->windowFill) {
+      position = deflater->position;
+      available = deflater->windowFill - position;
+      maxLength = available > DFL_MAX_MATCH ? DFL_MAX_MATCH : (unsigned int) available;
+      length = 0;
+      if (nextMatchFound) {
+        /* The match was found while checking the previous position. */
+        length = nextLength;
+        distance = nextDistance;
+        nextMatchFound = FALSE;
+      } else if (deflater->maxChain != 0 && available >= MIN_MATCH) {
+        candidate = matchCandidate(deflater, position);
+        length = findMatch(deflater, position, candidate, maxLength,
+                           deflater->maxChain, &distance);
+      } /* if */
+      if (length != 0 && deflater->lazyMatching &&
+          length < levelMaxLazy[deflater->level] &&
+          available > (memSizeType) length + 1) {
+        chain = length >= levelGoodLength[deflater->level] ?
+            deflater->maxChain >> 2 : deflater->maxChain;
+        candidate = matchCandidate(deflater, position + 1);
+        nextLength = findMatch(deflater, position + 1, candidate,
+                               available - 1 > DFL_MAX_MATCH ?
+                               DFL_MAX_MATCH : (unsigned int) (available - 1),
+                               chain, &nextDistance);
+        if (nextLength > length) {
+          /* Emit a literal and take the longer match at position + 1. */
+          length = 0;
+          nextMatchFound = TRUE;
+        } /* if */
+      } /* if */
+      if (length == 0) {
+        if (!addSymbol(deflater, deflater->window[position], 0,
+                       output, outputData)) {
+          return FALSE;
+        } /* if */
+      } else {
+        if (!addSymbol(deflater, length, distance, output, outputData)) {
+          return FALSE;
+        } /* if */
+        insertPositions(deflater, position + length);
+      } /* if */
+    } /* while */
+    return TRUE;
+  } /* compressWindow */
+
+
+
+/**
+ *  Move the upper half of the window to the lower half.
+ */
+static boolType slideWindow (dflDeflateType deflater,
+    dflOutputFuncType output, void *outputData)
+
+  {
+    unsigned int index;
+    int32Type value;
+
+  /* slideWindow */
+    if (deflater->blockStart < DFL_WINDOW_SIZE &&
+        !emitBlock(deflater, FALSE, output, outputData)) {
+      return FALSE;
+    } /* if */
+    memmove(deflater->window, &deflater->window[DFL_WINDOW_SIZE],
+            deflater->windowFill - DFL_WINDOW_SIZE);
+    deflater->windowFill -= DFL_WINDOW_SIZE;
+    deflater->position -= DFL_WINDOW_SIZE;
+    deflater->blockStart -= DFL_WINDOW_SIZE;
+    if (deflater->hashedPosition > DFL_WINDOW_SIZE) {
+      deflater->hashedPosition -= DFL_WINDOW_SIZE;
+    } else {
+      deflater->hashedPosition = 0;
+    } /* if */
+    for (index = 0; index < (1 << DFL_HASH_BITS); index++) {
+      value = deflater->head[index] - DFL_WINDOW_SIZE;
+      deflater->head[index] = value < 0 ? -1 : value;
+    } /* for */
+    for (index = 0; index < DFL_WINDOW_SIZE; index++) {
+      value = deflater->prev[index] - DFL_WINDOW_SIZE;
+      deflater->prev[index] = value < 0 ? -1 : value;
+    } /* for */
+    return TRUE;
+  } /* slideWindow */
+
+
+
+/**
+ *  Check if 'deflater' contains a consistent deflate state.
+ *  This check is done before a state from a bstring is used.
+ */
+boolType dflDeflateIsValid (const dflDeflateRecord *deflater)
+
+  { /* dflDeflateIsValid */
+    return deflater->level >= 0 && deflater->level <= 9 &&
+           deflater->windowFill <= DFL_DEFLATE_BUFFER_SIZE &&
+           deflater->position <= deflater->windowFill &&
+           deflater->blockStart <= deflater->position &&
+           deflater->hashedPosition <= deflater->windowFill &&
+           deflater->maxChain <= levelMaxChain[9] &&
+           deflater->niceLength <= DFL_MAX_MATCH &&
+           deflater->bitCount < 8 &&
+           deflater->outputLength == 0 &&
+           deflater->numSymbols < DFL_MAX_SYMBOLS;
+  } /* dflDeflateIsValid */
+
+
+
+/**
+ *  Initialize a deflate state.
+ *  @param level Compression level from 0 (no compression) to
+ *         9 (best compression).
+ *  @param zlibFormat TRUE if a zlib header and an Adler-32 checksum
+ *         (RFC 1950) should be written, FALSE for raw DEFLATE data.
+ */
+void dflDeflateInit (dflDeflateType deflater, int level, boolType zlibFormat)
+
+  { /* dflDeflateInit */
+    memset(deflater, 0, sizeof(dflDeflateRecord));
+    if (level < 0) {
+      level = 0;
+    } else if (level > 9) {
+      level = 9;
+    } /* if */
+    deflater->level = level;
+    deflater->zlibFormat = zlibFormat;
+    deflater->maxChain = levelMaxChain[level];
+    deflater->niceLength = levelNiceLength[level];
+    deflater->lazyMatching = level >= 4;
+    deflater->adler = 1;
+    memset(deflater->head, 0xff, sizeof(deflater->head));
+    memset(deflater->prev, 0xff, sizeof(deflater->prev));
+  } /* dflDeflateInit */
+
+
+
+/**
+ *  Use the last bytes of 'dictionary' as history of a deflate state.
+ *  Matches may refer to the dictionary, but the dictionary itself
+ *  is not written. This function must be called directly after
+ *  dflDeflateInit().
+ */
+void dflDeflateSetDictionary (dflDeflateType deflater,
+    const ucharType *dictionary, memSizeType length)
+
+  { /* dflDeflateSetDictionary */
+    if (length > DFL_WINDOW_SIZE) {
+      dictionary += length - DFL_WINDOW_SIZE;
+      length = DFL_WINDOW_SIZE;
+    } /* if */
+    memcpy(deflater->window, dictionary, length);
+    deflater->windowFill = length;
+    deflater->position = length;
+    deflater->blockStart = length;
+    if (length >= MIN_MATCH) {
+      insertPositions(deflater, length);
+    } /* if */
+  } /* dflDeflateSetDictionary */
+
+
+
+/**
+ *  Compress the next piece of data.
+ *  All complete bytes of compressed data are delivered with the
+ *  function 'output' before dflDeflate returns.
+ *  @param finish TRUE if 'input' is the last piece of data.
+ *  @return TRUE if the data could be compressed, FALSE if 'output'
+ *          failed or the deflate state is already finished.
+ */
+boolType dflDeflate (dflDeflateType deflater, const ucharType *input,
+    memSizeType inputLength, boolType finish, dflOutputFuncType output,
+    void *outputData)
+
+  {
+    memSizeType length;
+    unsigned int header;
+    boolType okay = TRUE;
+
+  /* dflDeflate */
+    logFunction(printf("dflDeflate(*, *, " FMT_U_MEM ", %d, *, *)\n",
+                       inputLength, finish););
+    if (deflater->finished) {
+      return FALSE;
+    } /* if */
+    if (!deflater->headerWritten) {
+      if (deflater->zlibFormat) {
+        header = 0x7800 | (deflater->level < 2 ? 0 :
+            (deflater->level < 6 ? 1 : (deflater->level == 6 ? 2 : 3))) << 6;
+        header += 31 - header % 31;
+        putBits(deflater, header >> 8, 8);
+        putBits(deflater, header & 0xff, 8);
+      } /* if */
+      deflater->headerWritten = TRUE;
+    } /* if */
+    do {
+      length = DFL_DEFLATE_BUFFER_SIZE - deflater->windowFill;
+      if (length > inputLength) {
+        length = inputLength;
+      } /* if */
+      memcpy(&deflater->window[deflater->windowFill], input, length);
+      if (deflater->zlibFormat) {
+        deflater->adler = dflAdler32(deflater->adler, input, length);
+      } /* if */
+      deflater->windowFill += length;
+      input += length;
+      inputLength -= length;
+      okay = compressWindow(deflater, finish && inputLength == 0,
+                            output, outputData);
+      if (okay && deflater->windowFill == DFL_DEFLATE_BUFFER_SIZE) {
+        okay = slideWindow(deflater, output, outputData);
+      } /* if */
+    } while (okay && inputLength != 0);
+    if (okay && finish) {
+      okay = emitBlock(deflater, TRUE, output, outputData);
+      if (okay) {
+        alignToByte(deflater);
+        if (deflater->zlibFormat) {
+          putBits(deflater, deflater->adler >> 24, 8);
+          putBits(deflater, (deflater->adler >> 16) & 0xff, 8);
+          putBits(deflater, (deflater->adler >> 8) & 0xff, 8);
+          putBits(deflater, deflater->adler & 0xff, 8);
+        } /* if */
+        deflater->finished = TRUE;
+      } /* if */
+    } /* if */
+    if (okay && deflater->outputLength != 0) {
+      okay = output(deflater->output, deflater->outputLength, outputData);
+    } /* if */
+    deflater->outputLength = 0;
+    logFunction(printf("dflDeflate --> %d\n", okay););
+    return okay;
+  } /* dflDeflate */
+
+
+
+/**
+ *  Compress all data given to dflDeflate() so far (sync flush).
+ *  The current block is closed and an empty stored block aligns
+ *  the compressed data to a byte boundary. Afterwards the stream
+ *  can be continued with dflDeflate(). Independently compressed
+ *  pieces that end with a sync flush can be concatenated, if only
+ *  the last piece is finished.
+ *  @return TRUE if the data could be compressed, FALSE if 'output'
+ *          failed or the deflate state is already finished.
+ */
+boolType dflDeflateFlush (dflDeflateType deflater,
+    dflOutputFuncType output, void *outputData)
+
+  {
+    boolType okay;
+
+  /* dflDeflateFlush */
+    logFunction(printf("dflDeflateFlush(*, *, *)\n"););
+    if (deflater->finished || !deflater->headerWritten) {
+      return FALSE;
+    } /* if */
+    okay = compressWindow(deflater, TRUE, output, outputData);
+    if (okay && deflater->position != deflater->blockStart) {
+      okay = emitBlock(deflater, FALSE, output, outputData);
+    } /* if */
+    if (okay) {
+      okay = flushOutput(deflater, 1024, output, outputData);
+    } /* if */
+    if (okay) {
+      /* Empty stored block, which is not the last block. */
+      putBits(deflater, 0, 3);
+      alignToByte(deflater);
+      putBits(deflater, 0, 16);
+      putBits(deflater, 0xffff, 16);
+      okay = output(deflater->output, deflater->outputLength, outputData);
+    } /* if */
+    deflater->outputLength = 0;
+    logFunction(printf("dflDeflateFlush --> %d\n", okay););
+    return okay;
+  } /* dflDeflateFlush */
+
+
+
+static boolType appendToJob (const ucharType *data, memSizeType length,
+    void *outputData)
+
+  {
+    dflJobType job;
+    memSizeType newCapacity;
+    ucharType *resized;
+
+  /* appendToJob */
+    job = (dflJobType) outputData;
+    if (length > job->outputCapacity - job->outputLength) {
+      if (unlikely(length > MAX_MEMSIZETYPE - job->outputLength)) {
+        return FALSE;
+      } /* if */
+      newCapacity = job->outputCapacity > MAX_MEMSIZETYPE / 2 ?
+          MAX_MEMSIZETYPE : 2 * job->outputCapacity;
+      if (newCapacity < job->outputLength + length) {
+        newCapacity = job->outputLength + length;
+      } /* if */
+      if (newCapacity < DFL_OUTPUT_BUFFER_SIZE) {
+        newCapacity = DFL_OUTPUT_BUFFER_SIZE;
+      } /* if */
+      resized = (ucharType *) realloc(job->output, newCapacity);
+      if (unlikely(resized == NULL)) {
+        return FALSE;
+      } /* if */
+      job->output = resized;
+      job->outputCapacity = newCapacity;
+    } /* if */
+    memcpy(&job->output[job->outputLength], data, length);
+    job->outputLength += length;
+    return TRUE;
+  } /* appendToJob */
+
+
+
+/**
+ *  Deflate one piece of a string. The characters before the piece
+ *  are used as dictionary. Unless the piece is the last one of the
+ *  string the compressed data ends with a sync flush.
+ *  This function runs in a worker thread. It must not allocate
+ *  Seed7 objects or raise exceptions.
+ */
+static void deflateJob (dflJobType job)
+
+  {
+    dflDeflateType deflater;
+    ucharType *buffer;
+    memSizeType totalLength;
+
+  /* deflateJob */
+    totalLength = job->dictionaryLength + job->inputLength;
+    deflater = (dflDeflateType) malloc(sizeof(dflDeflateRecord));
+    buffer = (ucharType *) malloc(totalLength != 0 ? totalLength : 1);
+    if (unlikely(deflater == NULL || buffer == NULL)) {
+      job->status = DFL_JOB_MEMORY_ERROR;
+    } else if (unlikely(memcpy_from_strelem(buffer, job->input,
+                                            totalLength))) {
+      job->status = DFL_JOB_RANGE_ERROR;
+    } else {
+      dflDeflateInit(deflater, job->level, FALSE);
+      dflDeflateSetDictionary(deflater, buffer, job->dictionaryLength);
+      if (unlikely(!dflDeflate(deflater, &buffer[job->dictionaryLength],
+                               job->inputLength, job->lastPiece,
+                               appendToJob, job) ||
+                   (!job->lastPiece &&
+                    !dflDeflateFlush(deflater, appendToJob, job)))) {
+        job->status = DFL_JOB_MEMORY_ERROR;
+      } /* if */
+    } /* if */
+    free(buffer);
+    free(deflater);
+  } /* deflateJob */
+
+
+
+/**
+ *  Inflate the raw DEFLATE data at the beginning of a string.
+ *  The number of characters used is stored in job->inputUsed.
+ *  This function runs in a worker thread. It must not allocate
+ *  Seed7 objects or raise exceptions.
+ */
+static void inflateJob (dflJobType job)
+
+  {
+    dflInflateType inflater;
+    ucharType piece[DFL_INFLATE_PIECE];
+    memSizeType position = 0;
+    memSizeType length = 0;
+    int result = DFL_NEED_INPUT;
+
+  /* inflateJob */
+    inflater = (dflInflateType) malloc(sizeof(dflInflateRecord));
+    if (unlikely(inflater == NULL)) {
+      job->status = DFL_JOB_MEMORY_ERROR;
+    } else {
+      dflInflateInit(inflater, FALSE);
+      while (result == DFL_NEED_INPUT && position < job->inputLength &&
+             job->status == DFL_JOB_OKAY) {
+        length = job->inputLength - position;
+        if (length > DFL_INFLATE_PIECE) {
+          length = DFL_INFLATE_PIECE;
+        } /* if */
+        if (unlikely(memcpy_from_strelem(piece, &job->input[position],
+                                         length))) {
+          job->status = DFL_JOB_RANGE_ERROR;
+        } else {
+          position += length;
+          result = dflInflate(inflater, piece, length, appendToJob, job);
+        } /* if */
+      } /* while */
+      if (job->status == DFL_JOB_OKAY) {
+        if (result == DFL_STREAM_END) {
+          job->inputUsed = position - (inflater->unusedInput < length ?
+                                       inflater->unusedInput : length);
+        } else if (result == DFL_OUTPUT_ERROR) {
+          job->status = DFL_JOB_MEMORY_ERROR;
+        } else {
+          /* The data is corrupt or truncated. */
+          job->status = DFL_JOB_RANGE_ERROR;
+        } /* if */
+      } /* if */
+      free(inflater);
+    } /* if */
+  } /* inflateJob */
+
+
+
+#if HAS_PTHREADS
+static void *processJobQueue (void *data)
+
+  {
+    dflJobQueueType queue;
+    memSizeType index;
+
+  /* processJobQueue */
+    queue = (dflJobQueueType) data;
+    do {
+      pthread_mutex_lock(&queue->mutex);
+      index = queue->nextJob;
+      if (index < queue->numJobs) {
+        queue->nextJob++;
+      } /* if */
+      pthread_mutex_unlock(&queue->mutex);
+      if (index < queue->numJobs) {
+        queue->work(&queue->jobs[index]);
+      } /* if */
+    } while (index < queue->numJobs);
+    return NULL;
+  } /* processJobQueue */
+
+
+
+static unsigned int numberOfWorkers (memSizeType numJobs)
+
+  {
+    long numProcessors;
+    unsigned int numWorkers;
+
+  /* numberOfWorkers */
+    numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (numProcessors < 1) {
+      numWorkers = 1;
+    } else if (numProcessors > DFL_MAX_WORKERS) {
+      numWorkers = DFL_MAX_WORKERS;
+    } else {
+      numWorkers = (unsigned int) numProcessors;
+    } /* if */
+    if (numWorkers > numJobs) {
+      numWorkers = (unsigned int) numJobs;
+    } /* if */
+    return numWorkers;
+  } /* numberOfWorkers */
+#endif
+
+
+
+/**
+ *  Process the jobs with a pool of worker threads.
+ *  The calling thread works also. If no threads are available
+ *  or if threads cannot be created the jobs are processed by the
+ *  calling thread alone. The jobs are independent from each other,
+ *  so the order of processing does not influence the results.
+ */
+static void runJobs (dflJobType jobs, memSizeType numJobs,
+    void (*work) (dflJobType job))
+
+  {
+#if HAS_PTHREADS
+    dflJobQueueRecord queue;
+    pthread_t threads[DFL_MAX_WORKERS];
+    unsigned int numWorkers;
+    unsigned int numStarted = 0;
+#endif
+    memSizeType index;
+
+  /* runJobs */
+    logFunction(printf("runJobs(*, " FMT_U_MEM ", *)\n", numJobs););
+#if HAS_PTHREADS
+    numWorkers = numberOfWorkers(numJobs);
+    if (numWorkers > 1 && pthread_mutex_init(&queue.mutex, NULL) == 0) {
+      queue.jobs = jobs;
+      queue.numJobs = numJobs;
+      queue.nextJob = 0;
+      queue.work = work;
+      while (numStarted < numWorkers - 1 &&
+             pthread_create(&threads[numStarted], NULL,
+                            processJobQueue, &queue) == 0) {
+        numStarted++;
+      } /* while */
+      processJobQueue(&queue);
+      for (index = 0; index < numStarted; index++) {
+        pthread_join(threads[index], NULL);
+      } /* for */
+      pthread_mutex_destroy(&queue.mutex);
+      return;
+    } /* if */
+#endif
+    for (index = 0; index < numJobs; index++) {
+      work(&jobs[index]);
+    } /* for */
+  } /* runJobs */
+
+
+
+/**
+ *  Check the results of the jobs and free their output.
+ *  @return the exception to be raised or 0 if all jobs succeeded.
+ */
+static int jobsError (dflJobType jobs, memSizeType numJobs)
+
+  {
+    memSizeType index;
+    int err_info = OKAY_NO_ERROR;
+
+  /* jobsError */
+    for (index = 0; index < numJobs; index++) {
+      if (jobs[index].status == DFL_JOB_MEMORY_ERROR) {
+        err_info = MEMORY_ERROR;
+      } else if (jobs[index].status == DFL_JOB_RANGE_ERROR &&
+                 err_info == OKAY_NO_ERROR) {
+        err_info = RANGE_ERROR;
+      } /* if */
+    } /* for */
+    if (err_info != OKAY_NO_ERROR) {
+      for (index = 0; index < numJobs; index++) {
+        free(jobs[index].output);
+      } /* for */
+    } /* if */
+    return err_info;
+  } /* jobsError */
+
+
+
+/**
+ *  Concatenate the output of consecutive jobs to a string.
+ *  The output of the jobs is freed.
+ *  @return the concatenated string or NULL if there is not enough
+ *          memory.
+ */
+static striType joinJobOutput (dflJobType jobs, memSizeType numJobs)
+
+  {
+    memSizeType index;
+    memSizeType length = 0;
+    memSizeType pos = 0;
+    striType result;
+
+  /* joinJobOutput */
+    for (index = 0; index < numJobs; index++) {
+      length += jobs[index].outputLength;
+    } /* for */
+    if (likely(ALLOC_STRI_CHECK_SIZE(result, length))) {
+      result->size = length;
+      for (index = 0; index < numJobs; index++) {
+        memcpy_to_strelem(&result->mem[pos], jobs[index].output,
+                          jobs[index].outputLength);
+        pos += jobs[index].outputLength;
+      } /* for */
+    } /* if */
+    for (index = 0; index < numJobs; index++) {
+      free(jobs[index].output);
+      jobs[index].output = NULL;
+    } /* for */
+    return result;
+  } /* joinJobOutput */
+
+
+
+/**
+ *  Prepare the jobs to deflate 'uncompressed' in pieces.
+ *  The number of jobs is returned. If 'jobs' is NULL only the
+ *  number of jobs is computed.
+ */
+static memSizeType prepareDeflateJobs (const const_striType uncompressed,
+    int level, boolType finish, dflJobType jobs)
+
+  {
+    memSizeType start = 0;
+    memSizeType length;
+    memSizeType numJobs = 0;
+
+  /* prepareDeflateJobs */
+    do {
+      length = uncompressed->size - start;
+      if (length > DFL_PIECE_SIZE) {
+        length = DFL_PIECE_SIZE;
+      } /* if */
+      if (jobs != NULL) {
+        memset(&jobs[numJobs], 0, sizeof(dflJobRecord));
+        jobs[numJobs].dictionaryLength =
+            start > DFL_WINDOW_SIZE ? DFL_WINDOW_SIZE : start;
+        jobs[numJobs].input =
+            &uncompressed->mem[start - jobs[numJobs].dictionaryLength];
+        jobs[numJobs].inputLength = length;
+        jobs[numJobs].level = level;
+        jobs[numJobs].lastPiece = finish && start + length == uncompressed->size;
+      } /* if */
+      numJobs++;
+      start += length;
+    } while (start < uncompressed->size);
+    return numJobs;
+  } /* prepareDeflateJobs */
+
+
+
+/**
+ *  Compress a string with the DEFLATE algorithm (RFC 1951).
+ *  The string is split into pieces of DFL_PIECE_SIZE bytes, which
+ *  are compressed in parallel, if threads are available. Every
+ *  piece uses the 32 KiB before it as dictionary and ends with a
+ *  sync flush. This way the pieces can be concatenated to one
+ *  DEFLATE stream. The result does not depend on the number of
+ *  threads used.
+ *  @param uncompressed String with bytes to be compressed.
+ *  @param level Compression level from 0 (no compression) to
+ *         9 (best compression).
+ *  @param finish TRUE if the last block of the stream should be
+ *         written, FALSE if the stream is continued by the result
+ *         of another call of dflDeflateStri.
+ *  @return the compressed data.
+ *  @exception RANGE_ERROR If 'level' is not in the range 0 to 9 or
+ *             if 'uncompressed' contains a character beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to compress.
+ */
+striType dflDeflateStri (const const_striType uncompressed, intType level,
+    boolType finish)
+
+  {
+    memSizeType numJobs;
+    dflJobType jobs;
+    int err_info;
+    striType result;
+
+  /* dflDeflateStri */
+    logFunction(printf("dflDeflateStri(\"%s\", " FMT_D ", %d)\n",
+                       striAsUnquotedCStri(uncompressed), level, finish););
+    if (unlikely(level < 0 || level > 9)) {
+      logError(printf("dflDeflateStri: Level " FMT_D " not in range 0 to 9.\n",
+                      level););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    numJobs = prepareDeflateJobs(uncompressed, (int) level, finish, NULL);
+    if (unlikely(numJobs > MAX_MEMSIZETYPE / sizeof(dflJobRecord) ||
+                 (jobs = (dflJobType) malloc(numJobs *
+                                             sizeof(dflJobRecord))) == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    prepareDeflateJobs(uncompressed, (int) level, finish, jobs);
+    runJobs(jobs, numJobs, deflateJob);
+    err_info = jobsError(jobs, numJobs);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      result = NULL;
+    } else if (unlikely((result = joinJobOutput(jobs, numJobs)) == NULL)) {
+      err_info = MEMORY_ERROR;
+    } /* if */
+    free(jobs);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("dflDeflateStri --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* dflDeflateStri */
+
+
+
+/**
+ *  Compress every element of an array of strings with DEFLATE.
+ *  Every element is compressed to a complete DEFLATE stream.
+ *  All elements and all pieces of big elements are compressed in
+ *  parallel, if threads are available.
+ *  @param uncompressedArr Array of strings with bytes to be compressed.
+ *  @param level Compression level from 0 (no compression) to
+ *         9 (best compression).
+ *  @return an array with the compressed data of the elements.
+ *  @exception RANGE_ERROR If 'level' is not in the range 0 to 9 or
+ *             if an element contains a character beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to compress.
+ */
+rtlArrayType dflDeflateArray (const const_rtlArrayType uncompressedArr,
+    intType level)
+
+  {
+    memSizeType numElements;
+    memSizeType index;
+    memSizeType numJobs = 0;
+    memSizeType jobIndex;
+    dflJobType jobs = NULL;
+    int err_info = OKAY_NO_ERROR;
+    rtlArrayType result = NULL;
+
+  /* dflDeflateArray */
+    logFunction(printf("dflDeflateArray(*, " FMT_D ")\n", level););
+    if (unlikely(level < 0 || level > 9)) {
+      logError(printf("dflDeflateArray: Level " FMT_D " not in range 0 to 9.\n",
+                      level););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    numElements = arraySize(uncompressedArr);
+    for (index = 0; index < numElements; index++) {
+      numJobs += prepareDeflateJobs(uncompressedArr->arr[index].value.striValue,
+                                    (int) level, TRUE, NULL);
+    } /* for */
+    if (unlikely(numJobs > MAX_MEMSIZETYPE / sizeof(dflJobRecord) ||
+                 (numJobs != 0 &&
+                  (jobs = (dflJobType) malloc(numJobs *
+                                              sizeof(dflJobRecord))) == NULL) ||
+                 !ALLOC_RTL_ARRAY(result, numElements))) {
+      free(jobs);
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result->min_position = uncompressedArr->min_position;
+    result->max_position = uncompressedArr->max_position;
+    jobIndex = 0;
+    for (index = 0; index < numElements; index++) {
+      jobIndex += prepareDeflateJobs(uncompressedArr->arr[index].value.striValue,
+                                     (int) level, TRUE, &jobs[jobIndex]);
+    } /* for */
+    runJobs(jobs, numJobs, deflateJob);
+    err_info = jobsError(jobs, numJobs);
+    jobIndex = 0;
+    for (index = 0; index < numElements; index++) {
+      if (err_info == OKAY_NO_ERROR) {
+        numJobs = prepareDeflateJobs(uncompressedArr->arr[index].value.striValue,
+                                     (int) level, TRUE, NULL);
+        result->arr[index].value.striValue =
+            joinJobOutput(&jobs[jobIndex], numJobs);
+        jobIndex += numJobs;
+        if (unlikely(result->arr[index].value.striValue == NULL)) {
+          err_info = MEMORY_ERROR;
+        } /* if */
+      } else {
+        result->arr[index].value.striValue = NULL;
+      } /* if */
+    } /* for */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      for (index = 0; index < numElements; index++) {
+        if (result->arr[index].value.striValue != NULL) {
+          FREE_STRI(result->arr[index].value.striValue,
+                    result->arr[index].value.striValue->size);
+        } /* if */
+      } /* for */
+      free(jobs);
+      FREE_RTL_ARRAY(result, numElements);
+      raise_error(err_info);
+      return NULL;
+    } /* if */
+    free(jobs);
+    logFunction(printf("dflDeflateArray --> arr (size=" FMT_U_MEM ")\n",
+                       numElements););
+    return result;
+  } /* dflDeflateArray */
+
+
+
+/**
+ *  Decompress DEFLATE data (RFC 1951) that starts at 'bytePos'.
+ *  Data that follows the compressed data is not used.
+ *  @param compressed String that contains DEFLATE data.
+ *  @param bytePos Position of the DEFLATE data in 'compressed'.
+ *         Afterwards 'bytePos' refers to the first character after
+ *         the compressed data.
+ *  @return the uncompressed data.
+ *  @exception RANGE_ERROR If 'bytePos' is not in the range 1 to
+ *             length(compressed) + 1 or if the data is not in
+ *             DEFLATE format.
+ *  @exception MEMORY_ERROR Not enough memory to decompress.
+ */
+striType dflInflateStri (const const_striType compressed,
+    intType *const bytePos)
+
+  {
+    dflJobRecord job;
+    striType result;
+
+  /* dflInflateStri */
+    logFunction(printf("dflInflateStri(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *bytePos););
+    if (unlikely(*bytePos < 1 ||
+                 (uintType) *bytePos - 1 > compressed->size)) {
+      logError(printf("dflInflateStri: Position " FMT_D " not in range "
+                      "1 to " FMT_U_MEM ".\n",
+                      *bytePos, compressed->size + 1););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    memset(&job, 0, sizeof(dflJobRecord));
+    job.input = &compressed->mem[*bytePos - 1];
+    job.inputLength = compressed->size - (memSizeType) (*bytePos - 1);
+    inflateJob(&job);
+    if (unlikely(job.status != DFL_JOB_OKAY)) {
+      free(job.output);
+      raise_error(job.status == DFL_JOB_MEMORY_ERROR ?
+                  MEMORY_ERROR : RANGE_ERROR);
+      return NULL;
+    } else if (unlikely((result = joinJobOutput(&job, 1)) == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    *bytePos += (intType) job.inputUsed;
+    logFunction(printf("dflInflateStri --> \"%s\" (bytePos=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *bytePos););
+    return result;
+  } /* dflInflateStri */
+
+
+
+/**
+ *  Decompress every element of an array of strings with DEFLATE.
+ *  Every element must contain a DEFLATE stream (RFC 1951). The
+ *  elements are decompressed in parallel, if threads are available.
+ *  @param compressedArr Array of strings with DEFLATE data.
+ *  @return an array with the uncompressed data of the elements.
+ *  @exception RANGE_ERROR If an element is not in DEFLATE format.
+ *  @exception MEMORY_ERROR Not enough memory to decompress.
+ */
+rtlArrayType dflInflateArray (const const_rtlArrayType compressedArr)
+
+  {
+    memSizeType numElements;
+    memSizeType index;
+    dflJobType jobs = NULL;
+    int err_info = OKAY_NO_ERROR;
+    rtlArrayType result = NULL;
+
+  /* dflInflateArray */
+    logFunction(printf("dflInflateArray(*)\n"););
+    numElements = arraySize(compressedArr);
+    if (unlikely(numElements > MAX_MEMSIZETYPE / sizeof(dflJobRecord) ||
+                 (numElements != 0 &&
+                  (jobs = (dflJobType) malloc(numElements *
+                                              sizeof(dflJobRecord))) == NULL) ||
+                 !ALLOC_RTL_ARRAY(result, numElements))) {
+      free(jobs);
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result->min_position = compressedArr->min_position;
+    result->max_position = compressedArr->max_position;
+    for (index = 0; index < numElements; index++) {
+      memset(&jobs[index], 0, sizeof(dflJobRecord));
+      jobs[index].input = compressedArr->arr[index].value.striValue->mem;
+      jobs[index].inputLength = compressedArr->arr[index].value.striValue->size;
+    } /* for */
+    runJobs(jobs, numElements, inflateJob);
+    err_info = jobsError(jobs, numElements);
+    for (index = 0; index < numElements; index++) {
+      if (err_info == OKAY_NO_ERROR) {
+        result->arr[index].value.striValue = joinJobOutput(&jobs[index], 1);
+        if (unlikely(result->arr[index].value.striValue == NULL)) {
+          err_info = MEMORY_ERROR;
+        } /* if */
+      } else {
+        result->arr[index].value.striValue = NULL;
+      } /* if */
+    } /* for */
+    free(jobs);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      for (index = 0; index < numElements; index++) {
+        if (result->arr[index].value.striValue != NULL) {
+          FREE_STRI(result->arr[index].value.striValue,
+                    result->arr[index].value.striValue->size);
+        } /* if */
+      } /* for */
+      FREE_RTL_ARRAY(result, numElements);
+      raise_error(err_info);
+      return NULL;
+    } /* if */
+    logFunction(printf("dflInflateArray --> arr (size=" FMT_U_MEM ")\n",
+                       numElements););
+    return result;
+  } /* dflInflateArray */
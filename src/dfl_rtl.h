@@ -0,0 +1,131 @@
+/********************************************************************/
+/*                                                                  */
+/*  dfl_rtl.h     Deflate compression and inflate decompression.    */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/dfl_rtl.h                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Deflate compression and inflate decompression.         */
+/*                                                                  */
+/********************************************************************/
+
+#define DFL_WINDOW_SIZE          32768
+#define DFL_MAX_MATCH              258
+#define DFL_INFLATE_BUFFER_SIZE (4 * DFL_WINDOW_SIZE)
+#define DFL_MAX_PENDING           1024
+#define DFL_LOOKUP_BITS             10
+#define DFL_NUM_LITERAL_CODES      288
+#define DFL_NUM_DISTANCE_CODES      32
+#define DFL_HASH_BITS               15
+#define DFL_DEFLATE_BUFFER_SIZE (2 * DFL_WINDOW_SIZE)
+#define DFL_MAX_SYMBOLS          16384
+#define DFL_OUTPUT_BUFFER_SIZE   16384
+#define DFL_PIECE_SIZE          131072
+
+/* Results of dflInflate: */
+#define DFL_NEED_INPUT    0
+#define DFL_STREAM_END    1
+#define DFL_DATA_ERROR    2
+#define DFL_OUTPUT_ERROR  3
+
+/* The output function returns FALSE if it could not take the data. */
+typedef boolType (*dflOutputFuncType) (const ucharType *data,
+    memSizeType length, void *outputData);
+
+typedef struct {
+    uint16Type lookup[1 << DFL_LOOKUP_BITS];
+    uint16Type count[16];
+    uint16Type symbol[DFL_NUM_LITERAL_CODES];
+  } dflHuffmanRecord;
+
+/* The inflate state contains no pointers. It can be copied */
+/* with memcpy() and stored in a bstring.                   */
+typedef struct {
+    int mode;
+    boolType zlibFormat;
+    boolType lastBlock;
+    uint32Type adler;
+    memSizeType storedRemaining;
+    unsigned int pendingLength;
+    unsigned int pendingBitOffset;
+    memSizeType windowPos;
+    memSizeType flushedPos;
+    memSizeType unusedInput;
+    dflHuffmanRecord literalTable;
+    dflHuffmanRecord distanceTable;
+    ucharType pending[DFL_MAX_PENDING];
+    ucharType window[DFL_INFLATE_BUFFER_SIZE];
+  } dflInflateRecord, *dflInflateType;
+
+/* The deflate state contains no pointers. It can be copied */
+/* with memcpy() and stored in a bstring.                   */
+typedef struct {
+    int level;
+    boolType zlibFormat;
+    boolType headerWritten;
+    boolType finished;
+    unsigned int maxChain;
+    unsigned int niceLength;
+    boolType lazyMatching;
+    uint32Type adler;
+    memSizeType windowFill;
+    memSizeType position;
+    memSizeType blockStart;
+    uint64Type bitBuffer;
+    unsigned int bitCount;
+    unsigned int outputLength;
+    unsigned int numSymbols;
+    memSizeType hashedPosition;
+    int32Type head[1 << DFL_HASH_BITS];
+    int32Type prev[DFL_WINDOW_SIZE];
+    uint16Type symbolLength[DFL_MAX_SYMBOLS];
+    uint16Type symbolDistance[DFL_MAX_SYMBOLS];
+    uint32Type literalFrequency[DFL_NUM_LITERAL_CODES];
+    uint32Type distanceFrequency[DFL_NUM_DISTANCE_CODES];
+    ucharType window[DFL_DEFLATE_BUFFER_SIZE];
+    ucharType output[DFL_OUTPUT_BUFFER_SIZE];
+  } dflDeflateRecord, *dflDeflateType;
+
+
+uint32Type dflAdler32 (uint32Type adler, const ucharType *data,
+    memSizeType length);
+boolType dflInflateIsValid (const dflInflateRecord *inflater);
+void dflInflateInit (dflInflateType inflater, boolType zlibFormat);
+int dflInflate (dflInflateType inflater, const ucharType *input,
+    memSizeType inputLength, dflOutputFuncType output, void *outputData);
+boolType dflDeflateIsValid (const dflDeflateRecord *deflater);
+void dflDeflateInit (dflDeflateType deflater, int level, boolType zlibFormat);
+boolType dflDeflate (dflDeflateType deflater, const ucharType *input,
+    memSizeType inputLength, boolType finish, dflOutputFuncType output,
+    void *outputData);
+void dflDeflateSetDictionary (dflDeflateType deflater,
+    const ucharType *dictionary, memSizeType length);
+boolType dflDeflateFlush (dflDeflateType deflater,
+    dflOutputFuncType output, void *outputData);
+striType dflDeflateStri (const const_striType uncompressed, intType level,
+    boolType finish);
+rtlArrayType dflDeflateArray (const const_rtlArrayType uncompressedArr,
+    intType level);
+striType dflInflateStri (const const_striType compressed,
+    intType *const bytePos);
+rtlArrayType dflInflateArray (const const_rtlArrayType compressedArr);
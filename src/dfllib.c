@@ -0,0 +1,205 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/dfllib.c                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for deflate compression.         */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "arrutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "str_rtl.h"
+#include "dfl_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfllib.h"
+
+
+
+/**
+ *  Convert an rtlArrayType to an arrayType object.
+ *  The strings in 'anRtlArray' are reused in the created arrayType
+ *  object. The memory of 'anRtlArray' itself is freed. It is assumed
+ *  that 'anRtlArray' is not used afterwards.
+ *  @return the new created arrayType object.
+ *  @exception MEMORY_ERROR Not enough memory to create the array.
+ */
+static objectType toArrayType (rtlArrayType anRtlArray)
+
+  {
+    memSizeType arraySize;
+    memSizeType pos;
+    arrayType anArray;
+    typeType typeOfString;
+    objectType element;
+    objectType result;
+
+  /* toArrayType */
+    if (unlikely(anRtlArray == NULL)) {
+      /* Assume that an exception was already raised */
+      result = NULL;
+    } else {
+      arraySize = arraySize(anRtlArray);
+      if (unlikely(!ALLOC_ARRAY(anArray, arraySize))) {
+        for (pos = 0; pos < arraySize; pos++) {
+          strDestr(anRtlArray->arr[pos].value.striValue);
+        } /* for */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        anArray->min_position = anRtlArray->min_position;
+        anArray->max_position = anRtlArray->max_position;
+        typeOfString = take_type(SYS_STRI_TYPE);
+        pos = arraySize;
+        element = &anArray->arr[pos];
+        while (pos != 0) {
+          pos--;
+          element--;
+          element->type_of = typeOfString;
+          element->descriptor.property = NULL;
+          element->value.striValue = anRtlArray->arr[pos].value.striValue;
+          INIT_CATEGORY_OF_VAR(element, STRIOBJECT);
+        } /* while */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = bld_array_temp(anArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* toArrayType */
+
+
+
+/**
+ *  Compress the string arg_1 with DEFLATE and the level arg_2.
+ *  The string is compressed in pieces, which are processed in
+ *  parallel. If arg_3 is FALSE the last block is not written and
+ *  the DEFLATE stream can be continued with another result.
+ *  @return the compressed data.
+ *  @exception RANGE_ERROR If arg_2 is not in the range 0 to 9 or
+ *             if arg_1 contains a character beyond '\255;'.
+ */
+objectType dfl_deflate (listType arguments)
+
+  { /* dfl_deflate */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_bool(arg_3(arguments));
+    return bld_stri_temp(
+        dflDeflateStri(take_stri(arg_1(arguments)),
+                       take_int(arg_2(arguments)),
+                       take_bool(arg_3(arguments)) == SYS_TRUE_OBJECT));
+  } /* dfl_deflate */
+
+
+
+/**
+ *  Compress every element of the array arg_1 with DEFLATE.
+ *  The elements are compressed in parallel with the level arg_2.
+ *  @return an array with the compressed elements.
+ *  @exception RANGE_ERROR If arg_2 is not in the range 0 to 9 or
+ *             if an element contains a character beyond '\255;'.
+ */
+objectType dfl_deflate_array (listType arguments)
+
+  {
+    rtlArrayType uncompressedArr;
+    rtlArrayType compressedArr;
+
+  /* dfl_deflate_array */
+    isit_array(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    uncompressedArr = gen_rtl_array(take_array(arg_1(arguments)));
+    if (unlikely(uncompressedArr == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      compressedArr = dflDeflateArray(uncompressedArr,
+                                       take_int(arg_2(arguments)));
+      FREE_RTL_ARRAY(uncompressedArr, ARRAY_LENGTH(uncompressedArr));
+      return toArrayType(compressedArr);
+    } /* if */
+  } /* dfl_deflate_array */
+
+
+
+/**
+ *  Decompress the DEFLATE data that starts at position arg_2 of arg_1.
+ *  Afterwards arg_2 refers to the first character after the
+ *  compressed data.
+ *  @return the uncompressed data.
+ *  @exception RANGE_ERROR If arg_2 is not a position in arg_1 or
+ *             if the data is not in DEFLATE format.
+ */
+objectType dfl_inflate (listType arguments)
+
+  {
+    objectType bytePos;
+
+  /* dfl_inflate */
+    isit_stri(arg_1(arguments));
+    bytePos = arg_2(arguments);
+    isit_int(bytePos);
+    is_variable(bytePos);
+    return bld_stri_temp(
+        dflInflateStri(take_stri(arg_1(arguments)),
+                       &bytePos->value.intValue));
+  } /* dfl_inflate */
+
+
+
+/**
+ *  Decompress every element of the array arg_1 with DEFLATE.
+ *  The elements are decompressed in parallel.
+ *  @return an array with the uncompressed elements.
+ *  @exception RANGE_ERROR If an element is not in DEFLATE format.
+ */
+objectType dfl_inflate_array (listType arguments)
+
+  {
+    rtlArrayType compressedArr;
+    rtlArrayType uncompressedArr;
+
+  /* dfl_inflate_array */
+    isit_array(arg_1(arguments));
+    compressedArr = gen_rtl_array(take_array(arg_1(arguments)));
+    if (unlikely(compressedArr == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      uncompressedArr = dflInflateArray(compressedArr);
+      FREE_RTL_ARRAY(compressedArr, ARRAY_LENGTH(compressedArr));
+      return toArrayType(uncompressedArr);
+    } /* if */
+  } /* dfl_inflate_array */
@@ -0,0 +1,31 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/dfllib.h                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for deflate compression.         */
+/*                                                                  */
+/********************************************************************/
+
+objectType dfl_deflate       (listType arguments);
+objectType dfl_deflate_array (listType arguments);
+objectType dfl_inflate       (listType arguments);
+objectType dfl_inflate_array (listType arguments);
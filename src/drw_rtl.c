@@ -501,6 +501,122 @@ winType drwGetPixmapFromPixels (const const_rtlArrayType image)
 
 
 
+/**
+ *  Create a pixmap from RGB data with 3 bytes per pixel.
+ *  The lines of the image are stored one after another.
+ *  @param rgbData Red, green and blue byte of every pixel.
+ *  @param width Width of the image in pixels.
+ *  @param height Height of the image in pixels.
+ *  @return the created pixmap.
+ *  @exception RANGE_ERROR If width or height are not positive or
+ *             if the size of 'rgbData' does not fit to them.
+ */
+winType drwGetPixmapFromRgb (const const_bstriType rgbData, intType width,
+    intType height)
+
+  {
+    const ucharType *rgb;
+    memSizeType numPixels;
+    memSizeType index;
+    int32Type *image_data;
+    winType result;
+
+  /* drwGetPixmapFromRgb */
+    logFunction(printf("drwGetPixmapFromRgb(\"" FMT_U_MEM " bytes\", "
+                       FMT_D ", " FMT_D ")\n",
+                       rgbData->size, width, height););
+    if (unlikely(width <= 0 || height <= 0 ||
+                 (uintType) width > MAX_MEMSIZETYPE / 3 / (uintType) height ||
+                 rgbData->size != 3 * (memSizeType) width * (memSizeType) height)) {
+      logError(printf("drwGetPixmapFromRgb(\"" FMT_U_MEM " bytes\", "
+                      FMT_D ", " FMT_D "): Illegal size.\n",
+                      rgbData->size, width, height););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      numPixels = (memSizeType) width * (memSizeType) height;
+      if (unlikely(numPixels > MAX_MEMSIZETYPE / sizeof(int32Type) ||
+                   (image_data = (int32Type *) malloc(numPixels *
+                                                      sizeof(int32Type))) == NULL)) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        rgb = rgbData->mem;
+        for (index = 0; index < numPixels; index++) {
+          image_data[index] = (int32Type) drwRgbColor(
+              (intType) rgb[0] << 8,
+              (intType) rgb[1] << 8,
+              (intType) rgb[2] << 8);
+          rgb += 3;
+        } /* for */
+        result = drwImage(image_data, (memSizeType) width,
+                          (memSizeType) height, TRUE);
+        free(image_data);
+      } /* if */
+    } /* if */
+    logFunction(printf("drwGetPixmapFromRgb --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return result;
+  } /* drwGetPixmapFromRgb */
+
+
+
+/**
+ *  Get the RGB data of a pixmap with 3 bytes per pixel.
+ *  The lines of the image are stored one after another.
+ *  The pixel data is converted in place, so the memory needed
+ *  is not more than the memory of the pixel data.
+ *  @param sourceWin Pixmap to be converted.
+ *  @return red, green and blue byte of every pixel.
+ */
+bstriType drwGetRgb (const_winType sourceWin)
+
+  {
+    bstriType pixelData;
+    const int32Type *pixel;
+    ucharType *rgb;
+    memSizeType pixelDataSize;
+    memSizeType numPixels;
+    memSizeType index;
+    intType red;
+    intType green;
+    intType blue;
+    bstriType result;
+
+  /* drwGetRgb */
+    logFunction(printf("drwGetRgb(" FMT_U_MEM ")\n", (memSizeType) sourceWin););
+    pixelData = drwGetPixelData(sourceWin);
+    if (pixelData == NULL) {
+      result = NULL;
+    } else {
+      pixelDataSize = pixelData->size;
+      numPixels = pixelDataSize / sizeof(int32Type);
+      pixel = (const int32Type *) pixelData->mem;
+      rgb = pixelData->mem;
+      /* The bytes written never overtake the pixels read. */
+      for (index = 0; index < numPixels; index++) {
+        drwPixelToRgb((intType) pixel[index], &red, &green, &blue);
+        rgb[0] = (ucharType) (red >> 8);
+        rgb[1] = (ucharType) (green >> 8);
+        rgb[2] = (ucharType) (blue >> 8);
+        rgb += 3;
+      } /* for */
+      REALLOC_BSTRI_SIZE_OK(result, pixelData, pixelDataSize, 3 * numPixels);
+      if (unlikely(result == NULL)) {
+        FREE_BSTRI(pixelData, pixelDataSize);
+        raise_error(MEMORY_ERROR);
+      } else {
+        COUNT3_BSTRI(pixelDataSize, 3 * numPixels);
+        result->size = 3 * numPixels;
+      } /* if */
+    } /* if */
+    logFunction(printf("drwGetRgb --> \"%s\"\n",
+                       bstriAsUnquotedCStri(result)););
+    return result;
+  } /* drwGetRgb */
+
+
+
 const_bstriType pltAlign (const const_bstriType pointList)
 
   {
@@ -35,4 +35,7 @@ void drwDestr (const winType old_win);
 intType drwGetImagePixel (const_bstriType image, intType width,
     intType height, intType x, intType y);
 winType drwGetPixmapFromPixels (const const_rtlArrayType image);
+winType drwGetPixmapFromRgb (const const_bstriType rgbData, intType width,
+    intType height);
+bstriType drwGetRgb (const_winType sourceWin);
 const_bstriType pltAlign (const const_bstriType pointList);
@@ -1022,6 +1022,43 @@ objectType drw_get_pixmap_from_pixels (listType arguments)
 
 
 
+/**
+ *  Create a pixmap from RGB data with 3 bytes per pixel.
+ *  @param arg_1 RGB data with the lines of the image one after another.
+ *  @param arg_2 Width of the image in pixels.
+ *  @param arg_3 Height of the image in pixels.
+ *  @return the created pixmap.
+ *  @exception RANGE_ERROR If width or height are not positive or
+ *             if the size of the RGB data does not fit to them.
+ */
+objectType drw_get_pixmap_from_rgb (listType arguments)
+
+  { /* drw_get_pixmap_from_rgb */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_win_temp(
+        drwGetPixmapFromRgb(take_bstri(arg_1(arguments)),
+                            take_int(arg_2(arguments)),
+                            take_int(arg_3(arguments))));
+  } /* drw_get_pixmap_from_rgb */
+
+
+
+/**
+ *  Get the RGB data of the pixmap arg_1 with 3 bytes per pixel.
+ *  @return red, green and blue byte of every pixel with the
+ *          lines of the image one after another.
+ */
+objectType drw_get_rgb (listType arguments)
+
+  { /* drw_get_rgb */
+    isit_win(arg_1(arguments));
+    return bld_bstri_temp(drwGetRgb(take_win(arg_1(arguments))));
+  } /* drw_get_rgb */
+
+
+
 objectType drw_hashcode (listType arguments)
 
   { /* drw_hashcode */
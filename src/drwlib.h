@@ -66,6 +66,8 @@ objectType drw_get_pixel_data            (listType arguments);
 objectType drw_get_pixel_data_from_array (listType arguments);
 objectType drw_get_pixmap                (listType arguments);
 objectType drw_get_pixmap_from_pixels    (listType arguments);
+objectType drw_get_pixmap_from_rgb       (listType arguments);
+objectType drw_get_rgb                   (listType arguments);
 objectType drw_hashcode                  (listType arguments);
 objectType drw_height                    (listType arguments);
 objectType drw_line                      (listType arguments);
@@ -62,7 +62,22 @@
   /* bits for the comparison has a "random" effect for the binary   */
   /* tree. This speeds the tree up a measurable amount of time.     */
 
-#define PTR_LESS(P1,P2) (((memSizeType) (P1) & 0377L) < ((memSizeType) (P2) & 0377L))
+/* #define PTR_LESS(P1,P2) (((memSizeType) (P1) & 0377L) < ((memSizeType) (P2) & 0377L)) */
+
+  /* Heap objects are aligned, so the lowest bits of their addresses */
+  /* are zero. Comparing only 8 lower bits gives just 16 or 32      */
+  /* different keys and pointers with equal keys form long lists.   */
+  /* Multiplying the address with an odd constant (Fibonacci        */
+  /* hashing) spreads all address bits over the high bits of the    */
+  /* product. Comparing the products keeps the "random" effect and  */
+  /* gives a tree with a depth proportional to log(n).              */
+
+#if POINTER_SIZE == 64
+#define PTR_MIX(P) ((uint64Type) (memSizeType) (P) * UINT64_SUFFIX(0x9e3779b97f4a7c15))
+#else
+#define PTR_MIX(P) ((uint32Type) (memSizeType) (P) * (uint32Type) 0x9e3779b9)
+#endif
+#define PTR_LESS(P1,P2) (PTR_MIX(P1) < PTR_MIX(P2))
 
 /* #define PTR_LESS(P1,P2) (((memSizeType) (P1) & 0177400L) < ((memSizeType) (P2) & 0177400L)) */
 /* #define PTR_LESS(P1,P2) ((P1) < (P2)) */
@@ -38,6 +38,7 @@
 
 #include "common.h"
 #include "data.h"
+#include "data_rtl.h"
 #include "sigutl.h"
 #include "heaputl.h"
 #include "flistutl.h"
@@ -52,6 +53,7 @@
 #include "runerr.h"
 #include "match.h"
 #include "prclib.h"
+#include "option.h"
 
 #undef EXTERN
 #define EXTERN
@@ -531,6 +533,27 @@ static objectType exec_lambda (const_blockType block,
 
 
 
+static void count_call (objectType subroutine_object)
+
+  {
+    blockType block;
+
+  /* count_call */
+    block = subroutine_object->value.blockValue;
+    block->call_count++;
+    if (unlikely(block->call_count >= HOT_FUNCTION_CALLS)) {
+      logMessage(printf("count_call: hot function: ");
+                 trace1(subroutine_object);
+                 printf("\n"););
+      prog->option_flags &= ~(uintType) TIERED_EXECUTION;
+      if (hotFunctionHandler != NULL) {
+        hotFunctionHandler(subroutine_object);
+      } /* if */
+    } /* if */
+  } /* count_call */
+
+
+
 static listType eval_arg_list (register listType act_param_list, uint32Type *temp_bits_ptr)
 
   {
@@ -741,6 +764,9 @@ objectType exec_call (objectType object)
             actual_parameters, object);
         break;
       case BLOCKOBJECT:
+        if (unlikely(prog->option_flags & TIERED_EXECUTION)) {
+          count_call(subroutine_object);
+        } /* if */
 /*        printf("blockobject ");
         trace1(subroutine_object);
         printf(" params ");
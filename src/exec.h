@@ -32,6 +32,17 @@ EXTERN volatile boolType interrupt_flag;
 #endif
 EXTERN volatile int signal_number;
 
+/* With TIERED_EXECUTION the calls of every function are counted.   */
+/* When a function is called HOT_FUNCTION_CALLS times the counting  */
+/* stops and hotFunctionHandler is called once.                     */
+#define HOT_FUNCTION_CALLS 100000
+
+#ifdef DO_INIT
+void (*hotFunctionHandler) (const_objectType hotFunction) = NULL;
+#else
+EXTERN void (*hotFunctionHandler) (const_objectType hotFunction);
+#endif
+
 
 void doSuspendInterpreter (int signalNum);
 objectType exec_object (register objectType object);
@@ -56,6 +56,7 @@
 #include "striutl.h"
 #include "sigutl.h"
 #include "ut8_rtl.h"
+#include "set_rtl.h"
 #include "cmd_rtl.h"
 #include "stat_drv.h"
 #include "big_drv.h"
@@ -98,6 +99,7 @@ extern int _chsize (int fd, long size);
 #define BUFFER_SIZE             4096
 #define GETS_DEFAULT_SIZE    1048576
 #define READ_STRI_INIT_SIZE      256
+#define READ_TOKEN_BUFFER_SIZE   256
 #define READ_STRI_SIZE_DELTA    2048
 
 
@@ -2293,6 +2295,139 @@ boolType filSeekable (fileType aFile)
 
 
 
+/**
+ *  Read a string from 'inFile' as long as its characters are in 'charSet'.
+ *  The string starts with the character in 'terminationChar'. If this
+ *  character is not in 'charSet' nothing is read and "" is returned.
+ *  Otherwise characters are read until a character that is not in
+ *  'charSet' is found. This character is also read from 'inFile' and
+ *  assigned to 'terminationChar'. At the end of the file EOF is assigned
+ *  to 'terminationChar'. The characters are taken directly from the
+ *  buffer of the C file, such that scanners can read a sequence of
+ *  digits, letters or whitespace with one call.
+ *  @param inFile File from which the string is read.
+ *  @param charSet Set of the characters that are accepted.
+ *  @param terminationChar Variable with the first character of the
+ *         string, which receives the first character which is not
+ *         in 'charSet' (or EOF).
+ *  @return the string read without the termination character.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ *  @exception FILE_ERROR A system function returns an error.
+ */
+striType filSetRead (fileType inFile, const const_setType charSet,
+    charType *terminationChar)
+
+  {
+    cFileType cInFile;
+    register int ch;
+    register memSizeType position;
+    strElemType buffer[READ_TOKEN_BUFFER_SIZE];
+    strElemType *memory;
+    memSizeType memlength;
+    memSizeType newmemlength;
+    striType resized_result;
+    striType result = NULL;
+
+  /* filSetRead */
+    logFunction(printf("filSetRead(%s%d, *, '\\" FMT_U32 ";')\n",
+                       inFile == NULL ? "NULL " : "",
+                       inFile != NULL ? safe_fileno(inFile->cFile) : 0,
+                       *terminationChar););
+    cInFile = inFile->cFile;
+    if (unlikely(cInFile == NULL)) {
+      logError(printf("filSetRead: Attempt to read from closed file.\n"););
+      raise_error(FILE_ERROR);
+#if FREAD_WRONG_FOR_WRITE_ONLY_FILES
+    } else if (unlikely(!inFile->readingAllowed)) {
+      logError(printf("filSetRead(%d, *, *): "
+                      "The file is not open for reading.\n",
+                      safe_fileno(cInFile)););
+      raise_error(FILE_ERROR);
+#endif
+    } else if (*terminationChar == (charType) EOF ||
+               !charIsSetElem(*terminationChar, charSet)) {
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, 0))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = 0;
+      } /* if */
+    } else {
+      /* Short strings are collected in buffer. Longer strings */
+      /* are collected in the result, which grows as needed.   */
+      memory = buffer;
+      memlength = READ_TOKEN_BUFFER_SIZE;
+      memory[0] = *terminationChar;
+      position = 1;
+      flockfile(cInFile);
+      while ((ch = getc_unlocked(cInFile)) != EOF &&
+             charIsSetElem(ch, charSet)) {
+        if (unlikely(position >= memlength)) {
+          newmemlength = memlength + READ_STRI_SIZE_DELTA;
+          if (result == NULL) {
+            if (likely(ALLOC_STRI_CHECK_SIZE(result, newmemlength))) {
+              memcpy(result->mem, buffer, position * sizeof(strElemType));
+            } /* if */
+          } else {
+            REALLOC_STRI_CHECK_SIZE(resized_result, result, memlength, newmemlength);
+            if (unlikely(resized_result == NULL)) {
+              FREE_STRI(result, memlength);
+            } else {
+              COUNT3_STRI(memlength, newmemlength);
+            } /* if */
+            result = resized_result;
+          } /* if */
+          if (unlikely(result == NULL)) {
+            funlockfile(cInFile);
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+          memory = result->mem;
+          memlength = newmemlength;
+        } /* if */
+        memory[position++] = (strElemType) ch;
+      } /* while */
+      funlockfile(cInFile);
+      if (unlikely(ch == EOF && position == 1 && ferror(cInFile))) {
+        if (result != NULL) {
+          FREE_STRI(result, memlength);
+        } /* if */
+        logError(printf("filSetRead(%d, *, '\\" FMT_U32 ";'): "
+                        "getc_unlocked(%d) failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        safe_fileno(cInFile), *terminationChar,
+                        safe_fileno(cInFile), errno, strerror(errno)););
+        raise_error(FILE_ERROR);
+        result = NULL;
+      } else if (result == NULL) {
+        if (unlikely(!ALLOC_STRI_SIZE_OK(result, position))) {
+          raise_error(MEMORY_ERROR);
+        } else {
+          memcpy(result->mem, buffer, position * sizeof(strElemType));
+          result->size = position;
+          *terminationChar = (charType) ch;
+        } /* if */
+      } else {
+        REALLOC_STRI_SIZE_SMALLER(resized_result, result, memlength, position);
+        if (unlikely(resized_result == NULL)) {
+          FREE_STRI(result, memlength);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          result = resized_result;
+          COUNT3_STRI(memlength, position);
+          result->size = position;
+          *terminationChar = (charType) ch;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("filSetRead(%d, *, '\\" FMT_U32 ";') --> \"%s\"\n",
+                       safe_fileno(cInFile), *terminationChar,
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* filSetRead */
+
+
+
 void filSetbuf (fileType aFile, intType mode, intType size)
 
   {
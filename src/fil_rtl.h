@@ -77,6 +77,8 @@ fileType filPopen (const const_striType command,
 void filPrint (const const_striType stri);
 void filSeek (fileType aFile, intType file_position);
 boolType filSeekable (fileType aFile);
+striType filSetRead (fileType inFile, const const_setType charSet,
+    charType *terminationChar);
 void filSetbuf (fileType aFile, intType mode, intType size);
 intType filTell (fileType aFile);
 striType filTerminatedRead (fileType inFile, charType terminator,
@@ -698,6 +698,42 @@ objectType fil_setbuf (listType arguments)
 
 
 
+/**
+ *  Read a string from inFile/arg_1 as long as its characters are in charSet/arg_2.
+ *  The string starts with the character in terminationChar/arg_3. If
+ *  this character is not in charSet/arg_2 nothing is read and "" is
+ *  returned. Otherwise characters are read until a character that is
+ *  not in charSet/arg_2 is found. This character is assigned to
+ *  terminationChar/arg_3. At the end of the file EOF is assigned to
+ *  terminationChar/arg_3.
+ *  @param inFile/arg_1 File from which the string is read.
+ *  @param charSet/arg_2 Set of the characters that are accepted.
+ *  @param terminationChar/arg_3 Variable with the first character of
+ *         the string, which receives the first character which is not
+ *         in charSet/arg_2 (or EOF).
+ *  @return the characters in charSet/arg_2 starting with terminationChar/arg_3.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ *  @exception FILE_ERROR A system function returns an error.
+ */
+objectType fil_set_read (listType arguments)
+
+  {
+    objectType terminationChar;
+
+  /* fil_set_read */
+    isit_file(arg_1(arguments));
+    isit_set(arg_2(arguments));
+    terminationChar = arg_3(arguments);
+    isit_char(terminationChar);
+    is_variable(terminationChar);
+    return bld_stri_temp(
+        filSetRead(take_file(arg_1(arguments)),
+                   take_set(arg_2(arguments)),
+                   &terminationChar->value.charValue));
+  } /* fil_set_read */
+
+
+
 /**
  *  Obtain the current file position.
  *  The file position is measured in bytes from the start of the file.
@@ -56,6 +56,7 @@ objectType fil_print            (listType arguments);
 objectType fil_seek             (listType arguments);
 objectType fil_seekable         (listType arguments);
 objectType fil_setbuf           (listType arguments);
+objectType fil_set_read         (listType arguments);
 objectType fil_tell             (listType arguments);
 objectType fil_terminated_read  (listType arguments);
 objectType fil_truncate         (listType arguments);
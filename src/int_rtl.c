@@ -40,6 +40,9 @@
 #include "string.h"
 #include "time.h"
 #include "limits.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
 
 #include "common.h"
 #include "data_rtl.h"
@@ -216,6 +219,16 @@ const const_ustriType digitTable[] = {
     (const_ustriType) "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
   };
 
+/**
+ *  The decimal digits of the numbers from 0 to 99. The digits of
+ *  the number n are at digitPairs[2 * n] and digitPairs[2 * n + 1].
+ */
+static const char digitPairs[] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
 #ifdef HAS_DOUBLE_INTTYPE
 doubleUintType seed;
 #else
@@ -748,6 +761,39 @@ intType uintCmpGeneric (const genericType value1, const genericType value2)
 
 
 
+/**
+ *  Write the decimal digits of an unsigned integer in front of 'digitsEnd'.
+ *  The digits are written backward, starting with the least significant
+ *  one. Each division by 100 produces two digits, which are taken
+ *  from the table digitPairs. Leading zeros are not written.
+ *  @param digitsEnd Address after the last digit. There must be room
+ *         for INTTYPE_DECIMAL_SIZE characters in front of it.
+ *  @return the address of the first (most significant) digit.
+ */
+strElemType *uintDecimalDigits (uintType number, strElemType *digitsEnd)
+
+  {
+    unsigned int pairIndex;
+
+  /* uintDecimalDigits */
+    while (number >= 100) {
+      pairIndex = (unsigned int) (number % 100) << 1;
+      number /= 100;
+      *(--digitsEnd) = (strElemType) digitPairs[pairIndex + 1];
+      *(--digitsEnd) = (strElemType) digitPairs[pairIndex];
+    } /* while */
+    if (number >= 10) {
+      pairIndex = (unsigned int) number << 1;
+      *(--digitsEnd) = (strElemType) digitPairs[pairIndex + 1];
+      *(--digitsEnd) = (strElemType) digitPairs[pairIndex];
+    } else {
+      *(--digitsEnd) = (strElemType) number + '0';
+    } /* if */
+    return digitsEnd;
+  } /* uintDecimalDigits */
+
+
+
 /**
  *  Convert an unsigned integer into a big-endian encoded string of bytes.
  *  The result uses binary representation with a base of 256.
@@ -872,6 +918,39 @@ striType uintNBytesLe (uintType number, intType length)
 
 
 
+/**
+ *  Write the digits of 'number' in the numeral system 'base' backward.
+ *  A division by base * base produces two digits. They are separated
+ *  with an unsigned int division of the remainder. This halves the
+ *  number of uintType divisions.
+ *  @return the address of the first (most significant) digit.
+ */
+static strElemType *uintRadixDigits (uintType number, unsigned int base,
+    const_ustriType digits, strElemType *digitsEnd)
+
+  {
+    uintType squaredBase;
+    unsigned int pair;
+
+  /* uintRadixDigits */
+    squaredBase = (uintType) base * (uintType) base;
+    while (number >= squaredBase) {
+      pair = (unsigned int) (number % squaredBase);
+      number /= squaredBase;
+      *(--digitsEnd) = (strElemType) digits[pair % base];
+      *(--digitsEnd) = (strElemType) digits[pair / base];
+    } /* while */
+    pair = (unsigned int) number;
+    if (pair >= base) {
+      *(--digitsEnd) = (strElemType) digits[pair % base];
+      pair /= base;
+    } /* if */
+    *(--digitsEnd) = (strElemType) digits[pair];
+    return digitsEnd;
+  } /* uintRadixDigits */
+
+
+
 /**
  *  Convert an unsigned number to a string using a radix.
  *  The conversion uses the numeral system with the given base.
@@ -900,11 +979,13 @@ striType uintRadix (uintType number, intType base, boolType upperCase)
       raise_error(RANGE_ERROR);
       result = NULL;
     } else {
-      digits = digitTable[upperCase];
       buffer = &buffer_1[RADIX_BUFFER_SIZE];
-      do {
-        *(--buffer) = (strElemType) (digits[number % (uintType) base]);
-      } while ((number /= (uintType) base) != 0);
+      if (base == 10) {
+        buffer = uintDecimalDigits(number, buffer);
+      } else {
+        digits = digitTable[upperCase];
+        buffer = uintRadixDigits(number, (unsigned int) base, digits, buffer);
+      } /* if */
       length = (memSizeType) (&buffer_1[RADIX_BUFFER_SIZE] - buffer);
       if (unlikely(!ALLOC_STRI_SIZE_OK(result, length))) {
         raise_error(MEMORY_ERROR);
@@ -971,7 +1052,6 @@ striType uintRadixPow2 (uintType number, int shift, int mask, boolType upperCase
 striType uintStr (uintType number)
 
   {
-    strElemType *buffer;
     memSizeType length;
     striType result;
 
@@ -982,10 +1062,7 @@ striType uintStr (uintType number)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = length;
-      buffer = &result->mem[length];
-      do {
-        *(--buffer) = (strElemType) (number % 10 + '0');
-      } while ((number /= 10) != 0);
+      uintDecimalDigits(number, &result->mem[length]);
     } /* if */
     logFunction(printf("uintStr --> \"%s\"\n",
                        striAsUnquotedCStri(result)););
@@ -1953,10 +2030,7 @@ striType intLpad0 (intType number, const intType padSize)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = result_size;
-      buffer = &result->mem[result_size];
-      do {
-        *(--buffer) = (strElemType) (unsigned_number % 10 + '0');
-      } while ((unsigned_number /= 10) != 0);
+      buffer = uintDecimalDigits(unsigned_number, &result->mem[result_size]);
       if (buffer != result->mem) {
         while (buffer != &result->mem[1]) {
           *(--buffer) = (strElemType) '0';
@@ -2398,6 +2472,61 @@ striType intNBytesLeUnsigned (intType number, intType length)
 
 
 
+#if INTTYPE_SIZE == 64
+/**
+ *  Convert eight decimal digits to their value with SWAR operations.
+ *  The characters are packed into the bytes of an uint64Type word
+ *  (the first character goes to the lowest byte). All eight bytes
+ *  are checked for '0' to '9' at once. The digits are combined
+ *  pairwise with three multiplications (SIMD within a register).
+ *  @param digits Address of eight characters.
+ *  @return the value of the eight digits (0 to 99999999), or
+ *          UINT64TYPE_MAX if a character is not a decimal digit.
+ */
+static inline uint64Type parseEightDigits (const strElemType *digits)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i words;
+#endif
+    uint64Type digitBytes;
+
+  /* parseEightDigits */
+#if HAS_SSE2_INTRINSICS
+    /* Characters above 255 saturate to 0 or 255, which are no digits. */
+    words = _mm_packs_epi32(_mm_loadu_si128((const __m128i *) digits),
+                            _mm_loadu_si128((const __m128i *) &digits[4]));
+    _mm_storel_epi64((__m128i *) &digitBytes, _mm_packus_epi16(words, words));
+#else
+    if ((digits[0] | digits[1] | digits[2] | digits[3] |
+         digits[4] | digits[5] | digits[6] | digits[7]) > 0xff) {
+      return UINT64TYPE_MAX;
+    } /* if */
+    digitBytes = (uint64Type) digits[0]       | (uint64Type) digits[1] <<  8 |
+                 (uint64Type) digits[2] << 16 | (uint64Type) digits[3] << 24 |
+                 (uint64Type) digits[4] << 32 | (uint64Type) digits[5] << 40 |
+                 (uint64Type) digits[6] << 48 | (uint64Type) digits[7] << 56;
+#endif
+    /* A byte is a digit if its upper half is 3 before and after 6 is added. */
+    if (((digitBytes & UINT64_SUFFIX(0xf0f0f0f0f0f0f0f0)) |
+        (((digitBytes + UINT64_SUFFIX(0x0606060606060606)) &
+          UINT64_SUFFIX(0xf0f0f0f0f0f0f0f0)) >> 4)) !=
+        UINT64_SUFFIX(0x3333333333333333)) {
+      return UINT64TYPE_MAX;
+    } /* if */
+    digitBytes -= UINT64_SUFFIX(0x3030303030303030);
+    /* Combine neighbour digits to two digit numbers in every second byte. */
+    digitBytes = digitBytes * 10 + (digitBytes >> 8);
+    /* Combine the four two digit numbers with 100, 1000000 and 10000. */
+    return (((digitBytes & UINT64_SUFFIX(0x000000ff000000ff)) *
+             UINT64_SUFFIX(0x000f424000000064)) +
+            (((digitBytes >> 16) & UINT64_SUFFIX(0x000000ff000000ff)) *
+             UINT64_SUFFIX(0x0000271000000001))) >> 32;
+  } /* parseEightDigits */
+#endif
+
+
+
 /**
  *  Convert a string to an integer number.
  *  The string must contain an integer literal consisting of an
@@ -2416,6 +2545,9 @@ intType intParse (const const_striType stri)
     boolType negative;
     memSizeType position = 0;
     uintType digitval;
+#if INTTYPE_SIZE == 64
+    uint64Type eightDigits;
+#endif
     uintType uintValue;
     intType intResult;
 
@@ -2441,6 +2573,18 @@ intType intParse (const const_striType stri)
     } else {
       uintValue = 0;
       okay = TRUE;
+#if INTTYPE_SIZE == 64
+      /* Up to 16 digits are converted eight at a time. This cannot */
+      /* overflow. The remaining digits are left to the loop below, */
+      /* which also checks for illegal digits and for overflow.     */
+      while (stri->size - position >= 8 &&
+             uintValue < UINT64_SUFFIX(100000000) &&
+             (eightDigits = parseEightDigits(&stri->mem[position])) !=
+             UINT64TYPE_MAX) {
+        uintValue = uintValue * UINT64_SUFFIX(100000000) + eightDigits;
+        position += 8;
+      } /* while */
+#endif
 #if TWOS_COMPLEMENT_INTTYPE
       while (position < stri->size &&
              (digitval = ((uintType) stri->mem[position]) - ((uintType) '0')) <= 9) {
@@ -2654,11 +2798,14 @@ striType intRadix (intType number, intType base, boolType upperCase)
       } else {
         unsigned_number = (uintType) number;
       } /* if */
-      digits = digitTable[upperCase];
       buffer = &buffer_1[RADIX_BUFFER_SIZE];
-      do {
-        *(--buffer) = (strElemType) (digits[unsigned_number % (uintType) base]);
-      } while ((unsigned_number /= (uintType) base) != 0);
+      if (base == 10) {
+        buffer = uintDecimalDigits(unsigned_number, buffer);
+      } else {
+        digits = digitTable[upperCase];
+        buffer = uintRadixDigits(unsigned_number, (unsigned int) base,
+                                 digits, buffer);
+      } /* if */
       if (negative) {
         *(--buffer) = (strElemType) '-';
       } /* if */
@@ -2829,7 +2976,6 @@ striType intStr (intType number)
   {
     register uintType unsigned_number;
     boolType negative;
-    strElemType *buffer;
     memSizeType length;
     striType result;
 
@@ -2851,10 +2997,7 @@ striType intStr (intType number)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = length;
-      buffer = &result->mem[length];
-      do {
-        *(--buffer) = (strElemType) (unsigned_number % 10 + '0');
-      } while ((unsigned_number /= 10) != 0);
+      uintDecimalDigits(unsigned_number, &result->mem[length]);
       if (negative) {
         result->mem[0] = (strElemType) '-';
       } /* if */
@@ -2890,10 +3033,8 @@ striType intStrToBuffer (intType number, striType buffer)
     } else {
       unsigned_number = (uintType) number;
     } /* if */
-    bufferPtr = &buffer->mem1[INTTYPE_DECIMAL_SIZE];
-    do {
-      *(--bufferPtr) = (strElemType) (unsigned_number % 10 + '0');
-    } while ((unsigned_number /= 10) != 0);
+    bufferPtr = uintDecimalDigits(unsigned_number,
+                                  &buffer->mem1[INTTYPE_DECIMAL_SIZE]);
     if (negative) {
       *(--bufferPtr) = (strElemType) '-';
     } /* if */
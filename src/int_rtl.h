@@ -60,6 +60,7 @@ int uint32LeastSignificantBit (uint32Type number);
 int uint64LeastSignificantBit (uint64Type number);
 #endif
 intType uintCard (uintType number);
+strElemType *uintDecimalDigits (uintType number, strElemType *digitsEnd);
 striType uintRadix (uintType number, intType base, boolType upperCase);
 striType uintRadixPow2 (uintType number, int shift, int mask, boolType upperCase);
 striType uintStr (uintType number);
@@ -0,0 +1,1385 @@
+/********************************************************************/
+/*                                                                  */
+/*  jpg_rtl.c     Primitive actions to decode JPEG images.          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/jpg_rtl.c                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions to decode JPEG images.               */
+/*                                                                  */
+/*  The entropy coded data of a baseline JPEG scan is decoded here. */
+/*  This includes Huffman decoding, dequantization, the inverse     */
+/*  discrete cosine transform (IDCT), chroma upsampling and the     */
+/*  conversion from YCbCr to RGB. The IDCT and the color conversion */
+/*  use SSE2 or AVX2 if the C compiler and the CPU support them.    */
+/*  The IDCT is computed with 32-bit arithmetic that wraps around   */
+/*  in case of an overflow. This way the scalar and the SIMD code   */
+/*  deliver identical results for every input.                      */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
+#if HAS_AVX2_INTRINSICS
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "jpg_rtl.h"
+
+
+#define JPG_BLOCK_SIZE              64
+#define JPG_HUFFMAN_LOOKUP_BITS      9
+#define JPG_COEFFICIENT_LIMIT    32767
+#define JPG_PARAMETER_HEADER_SIZE    8
+#define JPG_MAX_COMPONENTS           3
+#define JPG_BUFFER_PADDING          32
+
+#define W1 2841  /* 2048 * sqrt(2.0) * cos(1 * PI / 16) */
+#define W2 2676  /* 2048 * sqrt(2.0) * cos(2 * PI / 16) */
+#define W3 2408  /* 2048 * sqrt(2.0) * cos(3 * PI / 16) */
+#define W5 1609  /* 2048 * sqrt(2.0) * cos(5 * PI / 16) */
+#define W6 1108  /* 2048 * sqrt(2.0) * cos(6 * PI / 16) */
+#define W7  565  /* 2048 * sqrt(2.0) * cos(7 * PI / 16) */
+
+#if RSHIFT_DOES_SIGN_EXTEND
+#define ASHR32(x, n) ((uint32Type) ((int32Type) (x) >> (n)))
+#else
+#define ASHR32(x, n) ((uint32Type) (x) >> (n) | \
+                      ((uint32Type) (x) & 0x80000000 ? ~(0xFFFFFFFF >> (n)) : 0))
+#endif
+
+typedef struct {
+    uint16Type fastLookup[1 << JPG_HUFFMAN_LOOKUP_BITS];
+    /* Decoded AC coefficients for short codes with a short value: */
+    int16Type fastAcValue[1 << JPG_HUFFMAN_LOOKUP_BITS];
+    /* Run length (4 bits) and number of used bits (4 bits) or 0:  */
+    ucharType fastAcInfo[1 << JPG_HUFFMAN_LOOKUP_BITS];
+    int32Type maxCode[17];
+    int32Type valueOffset[17];
+    ucharType values[256];
+  } huffmanTableType;
+
+typedef struct {
+    const strElemType *data;
+    memSizeType size;
+    memSizeType pos;
+    uint64Type buffer;
+    int bitCount;
+    boolType markerReached;
+  } bitReaderType;
+
+typedef struct {
+    int32Type quantization[JPG_BLOCK_SIZE];
+    huffmanTableType dcTable;
+    huffmanTableType acTable;
+    intType dcPredictor;
+  } componentType;
+
+typedef struct {
+    memSizeType width;
+    memSizeType height;
+    unsigned int numComponents;
+    unsigned int horizontal;
+    unsigned int vertical;
+    memSizeType restartInterval;
+    unsigned int scale;
+    unsigned int orientation;
+    componentType component[JPG_MAX_COMPONENTS];
+  } decoderType;
+
+typedef void (*idctFuncType) (const int32Type *coefficient,
+    int16Type *dest, memSizeType stride);
+typedef void (*convertFuncType) (const int16Type *luma,
+    const int16Type *chromaBlue, const int16Type *chromaRed,
+    unsigned int horizontal, ucharType *rgb, memSizeType width);
+
+/* Index of the natural order for the zigzag order of the coefficients. */
+static const unsigned char naturalOrder[JPG_BLOCK_SIZE + 16] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    /* Extra entries for corrupted data. */
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63};
+
+/* Box filtered IDCT basis functions (scaled by 2048) for 4 and 2 */
+/* output samples. They are used for the scaled decoding.          */
+static const int32Type reducedBasis4[4][4] = {
+    {2048,  2624,  1892,   922},
+    {2048,  1087, -1892, -2225},
+    {2048, -1087, -1892,  2225},
+    {2048, -2624,  1892,  -922}};
+
+static const int32Type reducedBasis2[2][2] = {
+    {2048,  1856},
+    {2048, -1856}};
+
+#if HAS_AVX2_INTRINSICS
+static int avx2InstructionsPresent = -1;
+#endif
+
+
+
+/**
+ *  Create a Huffman table from its JPEG specification.
+ *  The specification consists of 16 counts of codes with the
+ *  lengths 1 to 16 followed by the symbols (values) of the codes.
+ *  @param spec Start of the specification.
+ *  @param remaining Number of elements available at 'spec'.
+ *  @return the number of elements used by the specification, or
+ *          0 if the specification is not valid.
+ */
+static memSizeType buildHuffmanTable (huffmanTableType *table,
+    const strElemType *spec, memSizeType remaining)
+
+  {
+    unsigned int numberOfCodes = 0;
+    unsigned int length;
+    unsigned int count;
+    unsigned int valueIndex = 0;
+    uint32Type code = 0;
+    uint32Type fill;
+    memSizeType specSize = 0;
+
+  /* buildHuffmanTable */
+    memset(table->fastLookup, 0, sizeof(table->fastLookup));
+    if (remaining >= 16) {
+      for (length = 0; length < 16; length++) {
+        if (spec[length] > 255) {
+          return 0;
+        } /* if */
+        numberOfCodes += (unsigned int) spec[length];
+      } /* for */
+      if (numberOfCodes <= 256 && remaining - 16 >= numberOfCodes) {
+        for (valueIndex = 0; valueIndex < numberOfCodes; valueIndex++) {
+          if (spec[16 + valueIndex] > 255) {
+            return 0;
+          } /* if */
+          table->values[valueIndex] = (ucharType) spec[16 + valueIndex];
+        } /* for */
+        valueIndex = 0;
+        for (length = 1; length <= 16; length++) {
+          count = (unsigned int) spec[length - 1];
+          table->valueOffset[length] = (int32Type) valueIndex - (int32Type) code;
+          if (count != 0) {
+            if (code + count > (uint32Type) 1 << length) {
+              return 0;
+            } /* if */
+            if (length <= JPG_HUFFMAN_LOOKUP_BITS) {
+              for (; count != 0; count--, code++, valueIndex++) {
+                for (fill = 0; fill < (uint32Type) 1 << (JPG_HUFFMAN_LOOKUP_BITS - length);
+                     fill++) {
+                  table->fastLookup[(code << (JPG_HUFFMAN_LOOKUP_BITS - length)) | fill] =
+                      (uint16Type) (length << 8 | table->values[valueIndex]);
+                } /* for */
+              } /* for */
+            } else {
+              code += count;
+              valueIndex += count;
+            } /* if */
+            table->maxCode[length] = (int32Type) code - 1;
+          } else {
+            table->maxCode[length] = -1;
+          } /* if */
+          code <<= 1;
+        } /* for */
+        specSize = 16 + numberOfCodes;
+      } /* if */
+    } /* if */
+    return specSize;
+  } /* buildHuffmanTable */
+
+
+
+/**
+ *  Create the lookup table for AC coefficients.
+ *  If a Huffman code and the value that follows it fit into the
+ *  lookup bits the decoded value is stored in the table. This way
+ *  a symbol and its value are decoded with one table lookup.
+ */
+static void buildFastAcTable (huffmanTableType *table)
+
+  {
+    unsigned int index;
+    unsigned int length;
+    unsigned int symbol;
+    unsigned int bitWidth;
+    unsigned int run;
+    int32Type value;
+
+  /* buildFastAcTable */
+    memset(table->fastAcInfo, 0, sizeof(table->fastAcInfo));
+    for (index = 0; index < 1 << JPG_HUFFMAN_LOOKUP_BITS; index++) {
+      if (table->fastLookup[index] != 0) {
+        length = (unsigned int) table->fastLookup[index] >> 8;
+        symbol = (unsigned int) table->fastLookup[index] & 0xff;
+        run = symbol >> 4;
+        bitWidth = symbol & 0xf;
+        if (bitWidth != 0 && length + bitWidth <= JPG_HUFFMAN_LOOKUP_BITS) {
+          value = (int32Type) (((index << length) & ((1 << JPG_HUFFMAN_LOOKUP_BITS) - 1))
+                               >> (JPG_HUFFMAN_LOOKUP_BITS - bitWidth));
+          if (value < (int32Type) 1 << (bitWidth - 1)) {
+            value -= ((int32Type) 1 << bitWidth) - 1;
+          } /* if */
+          table->fastAcValue[index] = (int16Type) value;
+          table->fastAcInfo[index] = (ucharType) (run << 4 | (length + bitWidth));
+        } /* if */
+      } /* if */
+    } /* for */
+  } /* buildFastAcTable */
+
+
+
+static void initBitReader (bitReaderType *reader, const const_striType scanData)
+
+  { /* initBitReader */
+    reader->data = scanData->mem;
+    reader->size = scanData->size;
+    reader->pos = 0;
+    reader->buffer = 0;
+    reader->bitCount = 0;
+    reader->markerReached = FALSE;
+  } /* initBitReader */
+
+
+
+/**
+ *  Fill the bit buffer with at least 57 bits.
+ *  Stuffed zero bytes after 0xff are removed. When a marker is
+ *  reached zero bits are delivered.
+ */
+static void fillBitBuffer (bitReaderType *reader)
+
+  {
+    uint64Type byte;
+
+  /* fillBitBuffer */
+    while (reader->bitCount <= 56) {
+      byte = 0;
+      if (!reader->markerReached && reader->pos < reader->size) {
+        byte = reader->data[reader->pos] & 0xff;
+        if (byte == 0xff) {
+          if (reader->pos + 1 < reader->size &&
+              reader->data[reader->pos + 1] == 0) {
+            reader->pos += 2;
+          } else {
+            reader->markerReached = TRUE;
+            byte = 0;
+          } /* if */
+        } else {
+          reader->pos++;
+        } /* if */
+      } /* if */
+      reader->buffer |= byte << (56 - reader->bitCount);
+      reader->bitCount += 8;
+    } /* while */
+  } /* fillBitBuffer */
+
+
+
+/**
+ *  Skip to the data after the next restart marker (RST0 - RST7).
+ *  The remaining bits of the current byte are discarded.
+ */
+static void processRestartMarker (bitReaderType *reader)
+
+  { /* processRestartMarker */
+    reader->buffer = 0;
+    reader->bitCount = 0;
+    reader->markerReached = FALSE;
+    while (reader->pos + 1 < reader->size &&
+           (reader->data[reader->pos] != 0xff ||
+            reader->data[reader->pos + 1] < 0xd0 ||
+            reader->data[reader->pos + 1] > 0xd7)) {
+      reader->pos++;
+    } /* while */
+    if (reader->pos + 1 < reader->size) {
+      reader->pos += 2;
+    } /* if */
+  } /* processRestartMarker */
+
+
+
+/**
+ *  Decode a Huffman symbol. The bit buffer must contain at least 16 bits.
+ *  @return the symbol, or -1 if the code is not in the table.
+ */
+static inline int decodeHuffman (bitReaderType *reader, const huffmanTableType *table)
+
+  {
+    unsigned int entry;
+    unsigned int length;
+    int32Type code;
+
+  /* decodeHuffman */
+    entry = table->fastLookup[reader->buffer >> (64 - JPG_HUFFMAN_LOOKUP_BITS)];
+    if (likely(entry != 0)) {
+      length = entry >> 8;
+      reader->buffer <<= length;
+      reader->bitCount -= (int) length;
+      return (int) (entry & 0xff);
+    } else {
+      for (length = JPG_HUFFMAN_LOOKUP_BITS + 1; length <= 16; length++) {
+        code = (int32Type) (reader->buffer >> (64 - length));
+        if (code <= table->maxCode[length]) {
+          reader->buffer <<= length;
+          reader->bitCount -= (int) length;
+          return table->values[code + table->valueOffset[length]];
+        } /* if */
+      } /* for */
+      return -1;
+    } /* if */
+  } /* decodeHuffman */
+
+
+
+/**
+ *  Read a value with 'bitWidth' bits (1 to 16) and extend its sign.
+ *  Negative values are encoded with the highest bit set to zero.
+ */
+static inline int32Type receiveExtend (bitReaderType *reader, unsigned int bitWidth)
+
+  {
+    int32Type value;
+
+  /* receiveExtend */
+    value = (int32Type) (reader->buffer >> (64 - bitWidth));
+    reader->buffer <<= bitWidth;
+    reader->bitCount -= (int) bitWidth;
+    if (value < (int32Type) 1 << (bitWidth - 1)) {
+      value -= ((int32Type) 1 << bitWidth) - 1;
+    } /* if */
+    return value;
+  } /* receiveExtend */
+
+
+
+static inline int32Type clampCoefficient (intType coefficient)
+
+  { /* clampCoefficient */
+    if (coefficient > JPG_COEFFICIENT_LIMIT) {
+      return JPG_COEFFICIENT_LIMIT;
+    } else if (coefficient < -JPG_COEFFICIENT_LIMIT) {
+      return -JPG_COEFFICIENT_LIMIT;
+    } else {
+      return (int32Type) coefficient;
+    } /* if */
+  } /* clampCoefficient */
+
+
+
+/**
+ *  Decode and dequantize the 64 coefficients of a block.
+ *  The coefficients are stored in natural order. Only the
+ *  coefficients that are not zero are written. The caller
+ *  must zero 'coefficient' before.
+ *  @return the zigzag index of the last coefficient that is not
+ *          zero (0 for a block with only a DC coefficient), or
+ *          -1 if the data is corrupted.
+ */
+static int decodeBlock (bitReaderType *reader, componentType *component,
+    int32Type *coefficient)
+
+  {
+    int symbol;
+    unsigned int bitWidth;
+    unsigned int lookupIndex;
+    unsigned int fastAcInfo;
+    int index;
+    int lastIndex = 0;
+
+  /* decodeBlock */
+    if (reader->bitCount < 32) {
+      fillBitBuffer(reader);
+    } /* if */
+    symbol = decodeHuffman(reader, &component->dcTable);
+    if (unlikely(symbol < 0 || symbol > 16)) {
+      return -1;
+    } else if (symbol != 0) {
+      component->dcPredictor += receiveExtend(reader, (unsigned int) symbol);
+    } /* if */
+    coefficient[0] = clampCoefficient(component->dcPredictor *
+                                      component->quantization[0]);
+    index = 0;
+    do {
+      if (reader->bitCount < 32) {
+        fillBitBuffer(reader);
+      } /* if */
+      lookupIndex = (unsigned int) (reader->buffer >> (64 - JPG_HUFFMAN_LOOKUP_BITS));
+      fastAcInfo = component->acTable.fastAcInfo[lookupIndex];
+      if (fastAcInfo != 0) {
+        /* The symbol and the value are decoded with one lookup. */
+        reader->buffer <<= fastAcInfo & 0xf;
+        reader->bitCount -= (int) (fastAcInfo & 0xf);
+        index += (int) (fastAcInfo >> 4) + 1;
+        if (unlikely(index >= JPG_BLOCK_SIZE)) {
+          return -1;
+        } /* if */
+        coefficient[naturalOrder[index]] = clampCoefficient(
+            (intType) component->acTable.fastAcValue[lookupIndex] *
+            component->quantization[index]);
+        lastIndex = index;
+        symbol = index != JPG_BLOCK_SIZE - 1;
+      } else {
+        symbol = decodeHuffman(reader, &component->acTable);
+        if (unlikely(symbol < 0)) {
+          return -1;
+        } /* if */
+        index += (symbol >> 4) + 1;
+        bitWidth = (unsigned int) symbol & 0xf;
+        if (bitWidth != 0) {
+          if (unlikely(index >= JPG_BLOCK_SIZE)) {
+            return -1;
+          } /* if */
+          coefficient[naturalOrder[index]] = clampCoefficient(
+              (intType) receiveExtend(reader, bitWidth) *
+              component->quantization[index]);
+          lastIndex = index;
+          if (index == JPG_BLOCK_SIZE - 1) {
+            symbol = 0;
+          } /* if */
+        } else if (unlikely(symbol != 0 && index >= JPG_BLOCK_SIZE)) {
+          return -1;
+        } /* if */
+      } /* if */
+    } while (symbol != 0);
+    return lastIndex;
+  } /* decodeBlock */
+
+
+
+static inline int16Type saturateInt16 (int32Type value)
+
+  { /* saturateInt16 */
+    if (value > 32767) {
+      return 32767;
+    } else if (value < -32768) {
+      return -32768;
+    } else {
+      return (int16Type) value;
+    } /* if */
+  } /* saturateInt16 */
+
+
+
+/**
+ *  One dimensional IDCT of 8 values with wrap around arithmetic.
+ *  The values are scaled by 2048 during the computation. At the
+ *  end the scaling is reversed.
+ */
+static void idct8Scalar (uint32Type *a, int step)
+
+  {
+    uint32Type x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  /* idct8Scalar */
+    x0 = (a[0] << 11) + 128;
+    x1 = a[4 * step] << 11;
+    x2 = a[6 * step];
+    x3 = a[2 * step];
+    x4 = a[1 * step];
+    x5 = a[7 * step];
+    x6 = a[5 * step];
+    x7 = a[3 * step];
+
+    /* First stage */
+    x8 = W7 * (x4 + x5);
+    x4 = x8 + (W1 - W7) * x4;
+    x5 = x8 - (W1 + W7) * x5;
+    x8 = W3 * (x6 + x7);
+    x6 = x8 - (W3 - W5) * x6;
+    x7 = x8 - (W3 + W5) * x7;
+
+    /* Second stage */
+    x8 = x0 + x1;
+    x0 -= x1;
+    x1 = W6 * (x3 + x2);
+    x2 = x1 - (W2 + W6) * x2;
+    x3 = x1 + (W2 - W6) * x3;
+    x1 = x4 + x6;
+    x4 -= x6;
+    x6 = x5 + x7;
+    x5 -= x7;
+
+    /* Third stage */
+    x7 = x8 + x3;
+    x8 -= x3;
+    x3 = x0 + x2;
+    x0 -= x2;
+    x2 = ASHR32(181 * (x4 + x5) + 128, 8);
+    x4 = ASHR32(181 * (x4 - x5) + 128, 8);
+
+    /* Fourth stage */
+    a[0]        = ASHR32(x7 + x1, 11);
+    a[1 * step] = ASHR32(x3 + x2, 11);
+    a[2 * step] = ASHR32(x0 + x4, 11);
+    a[3 * step] = ASHR32(x8 + x6, 11);
+    a[4 * step] = ASHR32(x8 - x6, 11);
+    a[5 * step] = ASHR32(x0 - x4, 11);
+    a[6 * step] = ASHR32(x3 - x2, 11);
+    a[7 * step] = ASHR32(x7 - x1, 11);
+  } /* idct8Scalar */
+
+
+
+/**
+ *  Compute the 8x8 IDCT of a block. First the rows and then the
+ *  columns are transformed. The result is scaled with factor 8
+ *  (the range for valid data is -1024 .. 1023).
+ *  @param coefficient 64 dequantized coefficients in natural order.
+ *  @param dest Destination for 8 lines with 8 samples.
+ *  @param stride Distance between two lines of 'dest'.
+ */
+static void idctBlockScalar (const int32Type *coefficient, int16Type *dest,
+    memSizeType stride)
+
+  {
+    uint32Type block[JPG_BLOCK_SIZE];
+    int index;
+    int column;
+
+  /* idctBlockScalar */
+    for (index = 0; index < JPG_BLOCK_SIZE; index++) {
+      block[index] = (uint32Type) coefficient[index];
+    } /* for */
+    for (index = 0; index < JPG_BLOCK_SIZE; index += 8) {
+      if ((block[index + 1] | block[index + 2] | block[index + 3] |
+           block[index + 4] | block[index + 5] | block[index + 6] |
+           block[index + 7]) == 0) {
+        /* The coefficients are limited, so the shortcut */
+        /* delivers the same result as the computation.  */
+        for (column = 1; column < 8; column++) {
+          block[index + column] = block[index];
+        } /* for */
+      } else {
+        idct8Scalar(&block[index], 1);
+      } /* if */
+    } /* for */
+    for (column = 0; column < 8; column++) {
+      idct8Scalar(&block[column], 8);
+    } /* for */
+    for (index = 0; index < JPG_BLOCK_SIZE; index += 8, dest += stride) {
+      for (column = 0; column < 8; column++) {
+        dest[column] = saturateInt16((int32Type) block[index + column]);
+      } /* for */
+    } /* for */
+  } /* idctBlockScalar */
+
+
+
+#if HAS_SSE2_INTRINSICS
+static inline __m128i mulConstSse2 (__m128i value, int32Type factor)
+
+  {
+    __m128i factors;
+    __m128i evenProducts;
+    __m128i oddProducts;
+
+  /* mulConstSse2 */
+    factors = _mm_set1_epi32(factor);
+    evenProducts = _mm_mul_epu32(value, factors);
+    oddProducts = _mm_mul_epu32(_mm_srli_epi64(value, 32), factors);
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+  } /* mulConstSse2 */
+
+
+
+static void idct8Sse2 (__m128i *a)
+
+  {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    const __m128i round128 = _mm_set1_epi32(128);
+
+  /* idct8Sse2 */
+    x0 = _mm_add_epi32(_mm_slli_epi32(a[0], 11), round128);
+    x1 = _mm_slli_epi32(a[4], 11);
+    x2 = a[6];
+    x3 = a[2];
+    x4 = a[1];
+    x5 = a[7];
+    x6 = a[5];
+    x7 = a[3];
+
+    /* First stage */
+    x8 = mulConstSse2(_mm_add_epi32(x4, x5), W7);
+    x4 = _mm_add_epi32(x8, mulConstSse2(x4, W1 - W7));
+    x5 = _mm_sub_epi32(x8, mulConstSse2(x5, W1 + W7));
+    x8 = mulConstSse2(_mm_add_epi32(x6, x7), W3);
+    x6 = _mm_sub_epi32(x8, mulConstSse2(x6, W3 - W5));
+    x7 = _mm_sub_epi32(x8, mulConstSse2(x7, W3 + W5));
+
+    /* Second stage */
+    x8 = _mm_add_epi32(x0, x1);
+    x0 = _mm_sub_epi32(x0, x1);
+    x1 = mulConstSse2(_mm_add_epi32(x3, x2), W6);
+    x2 = _mm_sub_epi32(x1, mulConstSse2(x2, W2 + W6));
+    x3 = _mm_add_epi32(x1, mulConstSse2(x3, W2 - W6));
+    x1 = _mm_add_epi32(x4, x6);
+    x4 = _mm_sub_epi32(x4, x6);
+    x6 = _mm_add_epi32(x5, x7);
+    x5 = _mm_sub_epi32(x5, x7);
+
+    /* Third stage */
+    x7 = _mm_add_epi32(x8, x3);
+    x8 = _mm_sub_epi32(x8, x3);
+    x3 = _mm_add_epi32(x0, x2);
+    x0 = _mm_sub_epi32(x0, x2);
+    x2 = _mm_srai_epi32(_mm_add_epi32(mulConstSse2(_mm_add_epi32(x4, x5), 181),
+                                      round128), 8);
+    x4 = _mm_srai_epi32(_mm_add_epi32(mulConstSse2(_mm_sub_epi32(x4, x5), 181),
+                                      round128), 8);
+
+    /* Fourth stage */
+    a[0] = _mm_srai_epi32(_mm_add_epi32(x7, x1), 11);
+    a[1] = _mm_srai_epi32(_mm_add_epi32(x3, x2), 11);
+    a[2] = _mm_srai_epi32(_mm_add_epi32(x0, x4), 11);
+    a[3] = _mm_srai_epi32(_mm_add_epi32(x8, x6), 11);
+    a[4] = _mm_srai_epi32(_mm_sub_epi32(x8, x6), 11);
+    a[5] = _mm_srai_epi32(_mm_sub_epi32(x0, x4), 11);
+    a[6] = _mm_srai_epi32(_mm_sub_epi32(x3, x2), 11);
+    a[7] = _mm_srai_epi32(_mm_sub_epi32(x7, x1), 11);
+  } /* idct8Sse2 */
+
+
+
+static inline void transpose4x4Sse2 (__m128i *r0, __m128i *r1, __m128i *r2, __m128i *r3)
+
+  {
+    __m128i t0, t1, t2, t3;
+
+  /* transpose4x4Sse2 */
+    t0 = _mm_unpacklo_epi32(*r0, *r1);
+    t1 = _mm_unpacklo_epi32(*r2, *r3);
+    t2 = _mm_unpackhi_epi32(*r0, *r1);
+    t3 = _mm_unpackhi_epi32(*r2, *r3);
+    *r0 = _mm_unpacklo_epi64(t0, t1);
+    *r1 = _mm_unpackhi_epi64(t0, t1);
+    *r2 = _mm_unpacklo_epi64(t2, t3);
+    *r3 = _mm_unpackhi_epi64(t2, t3);
+  } /* transpose4x4Sse2 */
+
+
+
+/**
+ *  Transpose a 8x8 matrix. Row n consists of left[n] (columns
+ *  0 to 3) and right[n] (columns 4 to 7).
+ */
+static void transpose8x8Sse2 (__m128i *left, __m128i *right)
+
+  {
+    __m128i swap;
+    int index;
+
+  /* transpose8x8Sse2 */
+    transpose4x4Sse2(&left[0], &left[1], &left[2], &left[3]);
+    transpose4x4Sse2(&right[0], &right[1], &right[2], &right[3]);
+    transpose4x4Sse2(&left[4], &left[5], &left[6], &left[7]);
+    transpose4x4Sse2(&right[4], &right[5], &right[6], &right[7]);
+    for (index = 0; index < 4; index++) {
+      swap = right[index];
+      right[index] = left[index + 4];
+      left[index + 4] = swap;
+    } /* for */
+  } /* transpose8x8Sse2 */
+
+
+
+static void idctBlockSse2 (const int32Type *coefficient, int16Type *dest,
+    memSizeType stride)
+
+  {
+    __m128i left[8];
+    __m128i right[8];
+    int index;
+
+  /* idctBlockSse2 */
+    for (index = 0; index < 8; index++) {
+      left[index] = _mm_loadu_si128((const __m128i *) &coefficient[8 * index]);
+      right[index] = _mm_loadu_si128((const __m128i *) &coefficient[8 * index + 4]);
+    } /* for */
+    /* Transform the rows: After the transposition each vector */
+    /* contains one column of four rows.                       */
+    transpose8x8Sse2(left, right);
+    idct8Sse2(left);
+    idct8Sse2(right);
+    transpose8x8Sse2(left, right);
+    /* Transform the columns: Each vector contains a part of a row. */
+    idct8Sse2(left);
+    idct8Sse2(right);
+    for (index = 0; index < 8; index++, dest += stride) {
+      _mm_storeu_si128((__m128i *) dest, _mm_packs_epi32(left[index], right[index]));
+    } /* for */
+  } /* idctBlockSse2 */
+
+
+
+/**
+ *  Convert a line of YCbCr samples to RGB.
+ *  The computation is identical to convertLineScalar().
+ */
+static void convertLineSse2 (const int16Type *luma, const int16Type *chromaBlue,
+    const int16Type *chromaRed, unsigned int horizontal, ucharType *rgb,
+    memSizeType width)
+
+  {
+    const __m128i offset128 = _mm_set1_epi16(128);
+    const __m128i redFactor = _mm_set1_epi16(359 * 32);
+    const __m128i blueFactor = _mm_set1_epi16(454 * 32);
+    const __m128i greenFactors = _mm_set1_epi32(183 << 16 | 88);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lumaVector;
+    __m128i blueVector;
+    __m128i redVector;
+    __m128i greenLow;
+    __m128i greenHigh;
+    __m128i red;
+    __m128i green;
+    __m128i blue;
+    __m128i redGreen;
+    __m128i blueZero;
+    __m128i pixels[2];
+    ucharType *pixelBytes;
+    memSizeType column = 0;
+    memSizeType chromaColumn;
+    int index;
+
+  /* convertLineSse2 */
+    for (; column + 8 <= width; column += 8) {
+      lumaVector = _mm_add_epi16(_mm_srai_epi16(
+          _mm_loadu_si128((const __m128i *) &luma[column]), 3), offset128);
+      if (horizontal == 1) {
+        blueVector = _mm_loadu_si128((const __m128i *) &chromaBlue[column]);
+        redVector = _mm_loadu_si128((const __m128i *) &chromaRed[column]);
+      } else {
+        chromaColumn = column >> 1;
+        blueVector = _mm_loadl_epi64((const __m128i *) &chromaBlue[chromaColumn]);
+        redVector = _mm_loadl_epi64((const __m128i *) &chromaRed[chromaColumn]);
+        blueVector = _mm_unpacklo_epi16(blueVector, blueVector);
+        redVector = _mm_unpacklo_epi16(redVector, redVector);
+      } /* if */
+      red = _mm_add_epi16(lumaVector, _mm_mulhi_epi16(redVector, redFactor));
+      blue = _mm_add_epi16(lumaVector, _mm_mulhi_epi16(blueVector, blueFactor));
+      greenLow = _mm_srai_epi32(_mm_madd_epi16(
+          _mm_unpacklo_epi16(blueVector, redVector), greenFactors), 11);
+      greenHigh = _mm_srai_epi32(_mm_madd_epi16(
+          _mm_unpackhi_epi16(blueVector, redVector), greenFactors), 11);
+      green = _mm_sub_epi16(lumaVector, _mm_packs_epi32(greenLow, greenHigh));
+      red = _mm_packus_epi16(red, red);
+      green = _mm_packus_epi16(green, green);
+      blue = _mm_packus_epi16(blue, blue);
+      redGreen = _mm_unpacklo_epi8(red, green);
+      blueZero = _mm_unpacklo_epi8(blue, zero);
+      pixels[0] = _mm_unpacklo_epi16(redGreen, blueZero);
+      pixels[1] = _mm_unpackhi_epi16(redGreen, blueZero);
+      pixelBytes = (ucharType *) pixels;
+      for (index = 0; index < 8; index++) {
+        rgb[0] = pixelBytes[0];
+        rgb[1] = pixelBytes[1];
+        rgb[2] = pixelBytes[2];
+        rgb += 3;
+        pixelBytes += 4;
+      } /* for */
+    } /* for */
+    for (; column < width; column++) {
+      int32Type lumaValue = (luma[column] >> 3) + 128;
+      int32Type blueValue = chromaBlue[column / horizontal];
+      int32Type redValue = chromaRed[column / horizontal];
+      int32Type value;
+      value = lumaValue + ((redValue * 359) >> 11);
+      rgb[0] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      value = lumaValue - ((blueValue * 88 + redValue * 183) >> 11);
+      rgb[1] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      value = lumaValue + ((blueValue * 454) >> 11);
+      rgb[2] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      rgb += 3;
+    } /* for */
+  } /* convertLineSse2 */
+#endif
+
+
+
+#if HAS_AVX2_INTRINSICS
+static boolType avx2InstructionsSupported (void)
+
+  { /* avx2InstructionsSupported */
+    if (avx2InstructionsPresent == -1) {
+      __builtin_cpu_init();
+      avx2InstructionsPresent = __builtin_cpu_supports("avx2") != 0;
+      logMessage(printf("avx2InstructionsSupported: %d\n",
+                        avx2InstructionsPresent););
+    } /* if */
+    return avx2InstructionsPresent;
+  } /* avx2InstructionsSupported */
+
+
+
+__attribute__((target("avx2")))
+static inline void transpose8x8Avx2 (__m256i *r)
+
+  {
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+    __m256i u0, u1, u2, u3, u4, u5, u6, u7;
+
+  /* transpose8x8Avx2 */
+    t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    u0 = _mm256_unpacklo_epi64(t0, t2);
+    u1 = _mm256_unpackhi_epi64(t0, t2);
+    u2 = _mm256_unpacklo_epi64(t1, t3);
+    u3 = _mm256_unpackhi_epi64(t1, t3);
+    u4 = _mm256_unpacklo_epi64(t4, t6);
+    u5 = _mm256_unpackhi_epi64(t4, t6);
+    u6 = _mm256_unpacklo_epi64(t5, t7);
+    u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+  } /* transpose8x8Avx2 */
+
+
+
+__attribute__((target("avx2")))
+static inline void idct8Avx2 (__m256i *a)
+
+  {
+    __m256i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    const __m256i round128 = _mm256_set1_epi32(128);
+
+  /* idct8Avx2 */
+    x0 = _mm256_add_epi32(_mm256_slli_epi32(a[0], 11), round128);
+    x1 = _mm256_slli_epi32(a[4], 11);
+    x2 = a[6];
+    x3 = a[2];
+    x4 = a[1];
+    x5 = a[7];
+    x6 = a[5];
+    x7 = a[3];
+
+    /* First stage */
+    x8 = _mm256_mullo_epi32(_mm256_add_epi32(x4, x5), _mm256_set1_epi32(W7));
+    x4 = _mm256_add_epi32(x8, _mm256_mullo_epi32(x4, _mm256_set1_epi32(W1 - W7)));
+    x5 = _mm256_sub_epi32(x8, _mm256_mullo_epi32(x5, _mm256_set1_epi32(W1 + W7)));
+    x8 = _mm256_mullo_epi32(_mm256_add_epi32(x6, x7), _mm256_set1_epi32(W3));
+    x6 = _mm256_sub_epi32(x8, _mm256_mullo_epi32(x6, _mm256_set1_epi32(W3 - W5)));
+    x7 = _mm256_sub_epi32(x8, _mm256_mullo_epi32(x7, _mm256_set1_epi32(W3 + W5)));
+
+    /* Second stage */
+    x8 = _mm256_add_epi32(x0, x1);
+    x0 = _mm256_sub_epi32(x0, x1);
+    x1 = _mm256_mullo_epi32(_mm256_add_epi32(x3, x2), _mm256_set1_epi32(W6));
+    x2 = _mm256_sub_epi32(x1, _mm256_mullo_epi32(x2, _mm256_set1_epi32(W2 + W6)));
+    x3 = _mm256_add_epi32(x1, _mm256_mullo_epi32(x3, _mm256_set1_epi32(W2 - W6)));
+    x1 = _mm256_add_epi32(x4, x6);
+    x4 = _mm256_sub_epi32(x4, x6);
+    x6 = _mm256_add_epi32(x5, x7);
+    x5 = _mm256_sub_epi32(x5, x7);
+
+    /* Third stage */
+    x7 = _mm256_add_epi32(x8, x3);
+    x8 = _mm256_sub_epi32(x8, x3);
+    x3 = _mm256_add_epi32(x0, x2);
+    x0 = _mm256_sub_epi32(x0, x2);
+    x2 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(
+        _mm256_add_epi32(x4, x5), _mm256_set1_epi32(181)), round128), 8);
+    x4 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(
+        _mm256_sub_epi32(x4, x5), _mm256_set1_epi32(181)), round128), 8);
+
+    /* Fourth stage */
+    a[0] = _mm256_srai_epi32(_mm256_add_epi32(x7, x1), 11);
+    a[1] = _mm256_srai_epi32(_mm256_add_epi32(x3, x2), 11);
+    a[2] = _mm256_srai_epi32(_mm256_add_epi32(x0, x4), 11);
+    a[3] = _mm256_srai_epi32(_mm256_add_epi32(x8, x6), 11);
+    a[4] = _mm256_srai_epi32(_mm256_sub_epi32(x8, x6), 11);
+    a[5] = _mm256_srai_epi32(_mm256_sub_epi32(x0, x4), 11);
+    a[6] = _mm256_srai_epi32(_mm256_sub_epi32(x3, x2), 11);
+    a[7] = _mm256_srai_epi32(_mm256_sub_epi32(x7, x1), 11);
+  } /* idct8Avx2 */
+
+
+
+__attribute__((target("avx2")))
+static void idctBlockAvx2 (const int32Type *coefficient, int16Type *dest,
+    memSizeType stride)
+
+  {
+    __m256i row[8];
+    int index;
+
+  /* idctBlockAvx2 */
+    for (index = 0; index < 8; index++) {
+      row[index] = _mm256_loadu_si256((const __m256i *) &coefficient[8 * index]);
+    } /* for */
+    transpose8x8Avx2(row);
+    idct8Avx2(row);
+    transpose8x8Avx2(row);
+    idct8Avx2(row);
+    for (index = 0; index < 8; index++, dest += stride) {
+      _mm_storeu_si128((__m128i *) dest,
+                       _mm_packs_epi32(_mm256_castsi256_si128(row[index]),
+                                       _mm256_extracti128_si256(row[index], 1)));
+    } /* for */
+  } /* idctBlockAvx2 */
+#endif
+
+
+
+/**
+ *  Compute a reduced IDCT with 'size' x 'size' output samples.
+ *  Only the 'size' x 'size' low frequency coefficients are used.
+ *  Every output sample is the average of a 'scale' x 'scale' area
+ *  of the full IDCT (ignoring the high frequencies). The result is
+ *  scaled with factor 8 like the result of the full IDCT.
+ */
+static void idctBlockReduced (const int32Type *coefficient, int16Type *dest,
+    memSizeType stride, unsigned int size)
+
+  {
+    const int32Type *basis;
+    int32Type rows[4][4];
+    int32Type sum;
+    unsigned int line;
+    unsigned int column;
+    unsigned int index;
+
+  /* idctBlockReduced */
+    if (size == 1) {
+      dest[0] = (int16Type) coefficient[0];
+    } else {
+      basis = size == 4 ? &reducedBasis4[0][0] : &reducedBasis2[0][0];
+      for (line = 0; line < size; line++) {
+        for (column = 0; column < size; column++) {
+          sum = 1024;
+          for (index = 0; index < size; index++) {
+            sum += basis[column * size + index] * coefficient[8 * line + index];
+          } /* for */
+          rows[line][column] = sum >> 11;
+        } /* for */
+      } /* for */
+      for (line = 0; line < size; line++, dest += stride) {
+        for (column = 0; column < size; column++) {
+          sum = 1024;
+          for (index = 0; index < size; index++) {
+            sum += basis[line * size + index] * rows[index][column];
+          } /* for */
+          dest[column] = saturateInt16(sum >> 11);
+        } /* for */
+      } /* for */
+    } /* if */
+  } /* idctBlockReduced */
+
+
+
+/**
+ *  Convert a line of YCbCr samples to RGB.
+ *  The luma samples are scaled with factor 8 and centered around 0.
+ *  The chroma samples are scaled with factor 8 (range -1024 .. 1023).
+ *  @param horizontal Number of luma samples per chroma sample (1 or 2).
+ */
+static void convertLineScalar (const int16Type *luma, const int16Type *chromaBlue,
+    const int16Type *chromaRed, unsigned int horizontal, ucharType *rgb,
+    memSizeType width)
+
+  {
+    memSizeType column;
+    int32Type lumaValue;
+    int32Type blueValue;
+    int32Type redValue;
+    int32Type value;
+
+  /* convertLineScalar */
+    for (column = 0; column < width; column++) {
+      lumaValue = (luma[column] >> 3) + 128;
+      blueValue = chromaBlue[column / horizontal];
+      redValue = chromaRed[column / horizontal];
+      value = lumaValue + ((redValue * 359) >> 11);
+      rgb[0] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      value = lumaValue - ((blueValue * 88 + redValue * 183) >> 11);
+      rgb[1] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      value = lumaValue + ((blueValue * 454) >> 11);
+      rgb[2] = (ucharType) (value < 0 ? 0 : (value > 255 ? 255 : value));
+      rgb += 3;
+    } /* for */
+  } /* convertLineScalar */
+
+
+
+static void convertGrayLine (const int16Type *luma, ucharType *rgb,
+    memSizeType width)
+
+  {
+    memSizeType column;
+    int32Type value;
+
+  /* convertGrayLine */
+    for (column = 0; column < width; column++) {
+      value = (luma[column] >> 3) + 128;
+      value = value < 0 ? 0 : (value > 255 ? 255 : value);
+      rgb[0] = (ucharType) value;
+      rgb[1] = (ucharType) value;
+      rgb[2] = (ucharType) value;
+      rgb += 3;
+    } /* for */
+  } /* convertGrayLine */
+
+
+
+/**
+ *  Change the orientation of an RGB image as requested by an
+ *  Exif orientation value (2 to 8).
+ */
+static void changeOrientation (const ucharType *source, ucharType *dest,
+    memSizeType width, memSizeType height, unsigned int orientation)
+
+  {
+    memSizeType line;
+    memSizeType column;
+    memSizeType destLine;
+    memSizeType destColumn;
+    memSizeType destWidth;
+    ucharType *pixel;
+
+  /* changeOrientation */
+    destWidth = orientation >= 5 ? height : width;
+    for (line = 0; line < height; line++) {
+      for (column = 0; column < width; column++) {
+        switch (orientation) {
+          case 2:  destColumn = width - 1 - column;  destLine = line;               break;
+          case 3:  destColumn = width - 1 - column;  destLine = height - 1 - line;  break;
+          case 4:  destColumn = column;              destLine = height - 1 - line;  break;
+          case 5:  destColumn = line;                destLine = column;             break;
+          case 6:  destColumn = height - 1 - line;   destLine = column;             break;
+          case 7:  destColumn = height - 1 - line;   destLine = width - 1 - column; break;
+          default: destColumn = line;                destLine = width - 1 - column; break;
+        } /* switch */
+        pixel = &dest[3 * (destLine * destWidth + destColumn)];
+        pixel[0] = source[0];
+        pixel[1] = source[1];
+        pixel[2] = source[2];
+        source += 3;
+      } /* for */
+    } /* for */
+  } /* changeOrientation */
+
+
+
+/**
+ *  Read the decoder parameters from 'parameters'.
+ *  @return TRUE if the parameters are valid, FALSE otherwise.
+ */
+static boolType getDecoderParameters (decoderType *decoder,
+    const const_striType parameters)
+
+  {
+    const strElemType *param;
+    memSizeType pos;
+    memSizeType specSize;
+    unsigned int index;
+    unsigned int number;
+
+  /* getDecoderParameters */
+    if (parameters->size < JPG_PARAMETER_HEADER_SIZE) {
+      return FALSE;
+    } /* if */
+    param = parameters->mem;
+    decoder->width = param[0];
+    decoder->height = param[1];
+    decoder->numComponents = param[2];
+    decoder->horizontal = param[3];
+    decoder->vertical = param[4];
+    decoder->restartInterval = param[5];
+    decoder->scale = param[6];
+    decoder->orientation = param[7];
+    if (decoder->width == 0 || decoder->width > 65535 ||
+        decoder->height == 0 || decoder->height > 65535 ||
+        (decoder->numComponents != 1 && decoder->numComponents != 3) ||
+        decoder->horizontal < 1 || decoder->horizontal > 2 ||
+        decoder->vertical < 1 || decoder->vertical > 2 ||
+        decoder->restartInterval > 65535 ||
+        (decoder->scale != 1 && decoder->scale != 2 &&
+         decoder->scale != 4 && decoder->scale != 8) ||
+        decoder->orientation < 1 || decoder->orientation > 8) {
+      return FALSE;
+    } /* if */
+    if (decoder->numComponents == 1) {
+      decoder->horizontal = 1;
+      decoder->vertical = 1;
+    } /* if */
+    pos = JPG_PARAMETER_HEADER_SIZE;
+    for (number = 0; number < decoder->numComponents; number++) {
+      if (parameters->size - pos < JPG_BLOCK_SIZE) {
+        return FALSE;
+      } /* if */
+      for (index = 0; index < JPG_BLOCK_SIZE; index++) {
+        if (param[pos + index] > 65535) {
+          return FALSE;
+        } /* if */
+        decoder->component[number].quantization[index] = (int32Type) param[pos + index];
+      } /* for */
+      pos += JPG_BLOCK_SIZE;
+      specSize = buildHuffmanTable(&decoder->component[number].dcTable,
+                                   &param[pos], parameters->size - pos);
+      if (specSize == 0) {
+        return FALSE;
+      } /* if */
+      pos += specSize;
+      specSize = buildHuffmanTable(&decoder->component[number].acTable,
+                                   &param[pos], parameters->size - pos);
+      if (specSize == 0) {
+        return FALSE;
+      } /* if */
+      buildFastAcTable(&decoder->component[number].acTable);
+      pos += specSize;
+      decoder->component[number].dcPredictor = 0;
+    } /* for */
+    return pos == parameters->size;
+  } /* getDecoderParameters */
+
+
+
+/**
+ *  Decode the entropy coded data and write the RGB samples to 'rgb'.
+ *  @return TRUE if the data could be decoded, FALSE otherwise.
+ */
+static boolType decodeScan (decoderType *decoder, const const_striType scanData,
+    ucharType *rgb, memSizeType outWidth, memSizeType outHeight)
+
+  {
+    bitReaderType reader;
+    unsigned int blockSize;
+    memSizeType mcuColumns;
+    memSizeType mcuRows;
+    memSizeType lumaStride;
+    memSizeType chromaStride;
+    unsigned int lumaLines;
+    int16Type *sampleBuffer;
+    int16Type *lumaBuffer;
+    int16Type *chromaBuffer[2];
+    int32Type coefficient[JPG_BLOCK_SIZE];
+    memSizeType mcuRow;
+    memSizeType mcuColumn;
+    memSizeType restartCount;
+    memSizeType outLine;
+    unsigned int line;
+    unsigned int blockNum;
+    unsigned int number;
+    int lastIndex;
+    int16Type *dest;
+    idctFuncType idctBlock = idctBlockScalar;
+    convertFuncType convertLine = convertLineScalar;
+    boolType okay = TRUE;
+
+  /* decodeScan */
+#if HAS_SSE2_INTRINSICS
+    idctBlock = idctBlockSse2;
+    convertLine = convertLineSse2;
+#endif
+#if HAS_AVX2_INTRINSICS
+    if (avx2InstructionsSupported()) {
+      idctBlock = idctBlockAvx2;
+    } /* if */
+#endif
+    blockSize = 8 / decoder->scale;
+    mcuColumns = (decoder->width + 8 * decoder->horizontal - 1) / (8 * decoder->horizontal);
+    mcuRows = (decoder->height + 8 * decoder->vertical - 1) / (8 * decoder->vertical);
+    lumaStride = mcuColumns * decoder->horizontal * blockSize;
+    chromaStride = mcuColumns * blockSize;
+    lumaLines = decoder->vertical * blockSize;
+    sampleBuffer = (int16Type *) malloc(((lumaStride * lumaLines +
+        2 * chromaStride * blockSize) + 3 * JPG_BUFFER_PADDING) * sizeof(int16Type));
+    if (unlikely(sampleBuffer == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return FALSE;
+    } /* if */
+    lumaBuffer = sampleBuffer;
+    chromaBuffer[0] = &lumaBuffer[lumaStride * lumaLines + JPG_BUFFER_PADDING];
+    chromaBuffer[1] = &chromaBuffer[0][chromaStride * blockSize + JPG_BUFFER_PADDING];
+    initBitReader(&reader, scanData);
+    restartCount = decoder->restartInterval;
+    for (mcuRow = 0; okay && mcuRow < mcuRows; mcuRow++) {
+      for (mcuColumn = 0; okay && mcuColumn < mcuColumns; mcuColumn++) {
+        if (decoder->restartInterval != 0) {
+          if (restartCount == 0) {
+            processRestartMarker(&reader);
+            for (number = 0; number < decoder->numComponents; number++) {
+              decoder->component[number].dcPredictor = 0;
+            } /* for */
+            restartCount = decoder->restartInterval;
+          } /* if */
+          restartCount--;
+        } /* if */
+        for (blockNum = 0; okay && blockNum < decoder->horizontal * decoder->vertical +
+             decoder->numComponents - 1; blockNum++) {
+          if (blockNum < decoder->horizontal * decoder->vertical) {
+            number = 0;
+            dest = &lumaBuffer[(blockNum / decoder->horizontal) * blockSize * lumaStride +
+                (mcuColumn * decoder->horizontal + blockNum % decoder->horizontal) * blockSize];
+          } else {
+            number = blockNum - decoder->horizontal * decoder->vertical + 1;
+            dest = &chromaBuffer[number - 1][mcuColumn * blockSize];
+          } /* if */
+          memset(coefficient, 0, sizeof(coefficient));
+          lastIndex = decodeBlock(&reader, &decoder->component[number], coefficient);
+          if (unlikely(lastIndex < 0)) {
+            okay = FALSE;
+          } else if (blockSize != 8) {
+            idctBlockReduced(coefficient, dest,
+                number == 0 ? lumaStride : chromaStride, blockSize);
+          } else if (lastIndex == 0) {
+            /* Only the DC coefficient is present. */
+            for (line = 0; line < 8; line++) {
+              dest[0] = dest[1] = dest[2] = dest[3] = dest[4] = dest[5] =
+                  dest[6] = dest[7] = (int16Type) coefficient[0];
+              dest += number == 0 ? lumaStride : chromaStride;
+            } /* for */
+          } else {
+            idctBlock(coefficient, dest, number == 0 ? lumaStride : chromaStride);
+          } /* if */
+        } /* for */
+      } /* for */
+      for (line = 0; okay && line < lumaLines; line++) {
+        outLine = mcuRow * lumaLines + line;
+        if (outLine < outHeight) {
+          if (decoder->numComponents == 1) {
+            convertGrayLine(&lumaBuffer[line * lumaStride],
+                            &rgb[3 * outLine * outWidth], outWidth);
+          } else {
+            convertLine(&lumaBuffer[line * lumaStride],
+                        &chromaBuffer[0][(line / decoder->vertical) * chromaStride],
+                        &chromaBuffer[1][(line / decoder->vertical) * chromaStride],
+                        decoder->horizontal, &rgb[3 * outLine * outWidth], outWidth);
+          } /* if */
+        } /* if */
+      } /* for */
+    } /* for */
+    free(sampleBuffer);
+    return okay;
+  } /* decodeScan */
+
+
+
+/**
+ *  Decode the entropy coded data of a baseline JPEG scan.
+ *  The 'parameters' describe the frame and the scan:
+ *   1: Width of the image
+ *   2: Height of the image
+ *   3: Number of components in the scan (1 or 3)
+ *   4: Horizontal sampling factor of the luma component (1 or 2)
+ *   5: Vertical sampling factor of the luma component (1 or 2)
+ *   6: Restart interval (0 if there are no restart markers)
+ *   7: Scale factor (1, 2, 4 or 8)
+ *   8: Exif orientation (1 to 8)
+ *  For every component (luma, chroma blue, chroma red) follow
+ *  64 elements of the quantization table (in zigzag order) and
+ *  the specifications of the DC and the AC Huffman table (16
+ *  counts of codes with the lengths 1 to 16 followed by the
+ *  symbols).
+ *  @param parameters Description of the frame and the scan.
+ *  @param scanData Entropy coded data including restart markers.
+ *  @return the image as RGB data with 3 bytes per pixel. The width
+ *          and height of the image are divided by the scale factor
+ *          (rounded up) and swapped for the orientations 5 to 8.
+ *  @exception RANGE_ERROR If the parameters are not valid or if
+ *             the entropy coded data is corrupted.
+ */
+bstriType jpgDecode (const const_striType parameters, const const_striType scanData)
+
+  {
+    decoderType decoder;
+    memSizeType outWidth;
+    memSizeType outHeight;
+    memSizeType rgbSize;
+    ucharType *rgb;
+    ucharType *orientedRgb;
+    bstriType result;
+
+  /* jpgDecode */
+    logFunction(printf("jpgDecode(*, \"" FMT_U_MEM " chars\")\n",
+                       scanData->size););
+    if (unlikely(!getDecoderParameters(&decoder, parameters))) {
+      logError(printf("jpgDecode(*, *): Illegal parameters.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      outWidth = (decoder.width + decoder.scale - 1) / decoder.scale;
+      outHeight = (decoder.height + decoder.scale - 1) / decoder.scale;
+      rgbSize = 3 * outWidth * outHeight;
+      if (unlikely(!ALLOC_BSTRI_CHECK_SIZE(result, rgbSize))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = rgbSize;
+        if (decoder.orientation == 1) {
+          rgb = result->mem;
+        } else if (unlikely((rgb = (ucharType *) malloc(rgbSize)) == NULL)) {
+          FREE_BSTRI(result, rgbSize);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+        if (unlikely(!decodeScan(&decoder, scanData, rgb, outWidth, outHeight))) {
+          if (rgb != result->mem) {
+            free(rgb);
+          } /* if */
+          FREE_BSTRI(result, rgbSize);
+          logError(printf("jpgDecode(*, *): Corrupted data.\n"););
+          raise_error(RANGE_ERROR);
+          result = NULL;
+        } else if (rgb != result->mem) {
+          orientedRgb = result->mem;
+          changeOrientation(rgb, orientedRgb, outWidth, outHeight,
+                            decoder.orientation);
+          free(rgb);
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("jpgDecode --> " FMT_U_MEM " bytes\n",
+                       result != NULL ? result->size : 0););
+    return result;
+  } /* jpgDecode */
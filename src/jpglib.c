@@ -0,0 +1,64 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/jpglib.c                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions to decode JPEG images.           */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "jpg_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "jpglib.h"
+
+
+
+/**
+ *  Decode the entropy coded data arg_2 of a baseline JPEG scan.
+ *  The frame and scan parameters are described by arg_1.
+ *  @return the image as RGB data with 3 bytes per pixel.
+ *  @exception RANGE_ERROR If the parameters are not valid or if
+ *             the entropy coded data is corrupted.
+ */
+objectType jpg_decode (listType arguments)
+
+  { /* jpg_decode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_bstri_temp(
+        jpgDecode(take_stri(arg_1(arguments)),
+                  take_stri(arg_2(arguments))));
+  } /* jpg_decode */
@@ -33,6 +33,8 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "sys/types.h"
+#include "sys/stat.h"
 
 #include "common.h"
 #include "data.h"
@@ -85,6 +87,76 @@ void shutIncludeFileHash (const const_rtlHashType includeFileHash)
 
 
 
+/**
+ *  Determine the modification time of a file.
+ *  @return the modification time in seconds since 1970-01-01 or
+ *          0 if the file does not exist or is not a regular file.
+ */
+intType fileModificationTime (const const_striType filePath)
+
+  {
+    os_striType os_path;
+    os_stat_struct stat_buf;
+    int path_info = PATH_IS_NORMAL;
+    errInfoType err_info = OKAY_NO_ERROR;
+    intType modificationTime = 0;
+
+  /* fileModificationTime */
+    logFunction(printf("fileModificationTime(\"%s\")\n",
+                       striAsUnquotedCStri(filePath)););
+    os_path = cp_to_os_path(filePath, &path_info, &err_info);
+    if (likely(os_path != NULL)) {
+      if (os_stat(os_path, &stat_buf) == 0 && S_ISREG(stat_buf.st_mode)) {
+        modificationTime = (intType) stat_buf.st_mtime;
+      } /* if */
+      os_stri_free(os_path);
+    } /* if */
+    logFunction(printf("fileModificationTime --> " FMT_D "\n",
+                       modificationTime););
+    return modificationTime;
+  } /* fileModificationTime */
+
+
+
+/**
+ *  Determine the newest modification time of the source files.
+ *  The source files are the main file ''programPath'' and all
+ *  files in ''includeFileHash''.
+ *  @return the newest modification time in seconds since 1970-01-01.
+ */
+intType newestSourceFileTime (const const_rtlHashType includeFileHash,
+    const const_striType programPath)
+
+  {
+    rtlArrayType includeFiles;
+    memSizeType arraySize;
+    memSizeType pos;
+    intType modificationTime;
+    intType newestTime;
+
+  /* newestSourceFileTime */
+    logFunction(printf("newestSourceFileTime(" FMT_U_MEM ", \"%s\")\n",
+                       (memSizeType) includeFileHash,
+                       striAsUnquotedCStri(programPath)););
+    newestTime = fileModificationTime(programPath);
+    includeFiles = hshKeys(includeFileHash, &strCreateGeneric, &strDestrGeneric);
+    if (includeFiles != NULL) {
+      arraySize = arraySize(includeFiles);
+      for (pos = 0; pos < arraySize; pos++) {
+        modificationTime = fileModificationTime(includeFiles->arr[pos].value.striValue);
+        if (modificationTime > newestTime) {
+          newestTime = modificationTime;
+        } /* if */
+        strDestr(includeFiles->arr[pos].value.striValue);
+      } /* for */
+      FREE_RTL_ARRAY(includeFiles, arraySize);
+    } /* if */
+    logFunction(printf("newestSourceFileTime --> " FMT_D "\n", newestTime););
+    return newestTime;
+  } /* newestSourceFileTime */
+
+
+
 static includeResultType openIncludeFile (const rtlHashType includeFileHash,
     const_striType includeFileName, errInfoType *err_info)
 
@@ -32,6 +32,9 @@ typedef enum {
 
 rtlHashType initIncludeFileHash (void);
 void shutIncludeFileHash (const const_rtlHashType includeFileHash);
+intType fileModificationTime (const const_striType filePath);
+intType newestSourceFileTime (const const_rtlHashType includeFileHash,
+    const const_striType programPath);
 includeResultType findIncludeFile (const rtlHashType includeFileHash,
     const_striType includeFileName, errInfoType *err_info);
 void appendToLibPath (const_striType path, errInfoType *err_info);
@@ -0,0 +1,1250 @@
+/********************************************************************/
+/*                                                                  */
+/*  msd_rtl.c     Primitive actions for message digests.            */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/msd_rtl.c                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions for message digests.                 */
+/*                                                                  */
+/*  The message digest algorithms MD4, MD5, RIPEMD-160, SHA-1,      */
+/*  SHA-224, SHA-256, SHA-384 and SHA-512 are implemented here.     */
+/*  The state of a digest computation is kept in a bstring. This    */
+/*  allows that a message is processed in pieces. If the C compiler */
+/*  and the CPU support the SHA extensions of x86 they are used     */
+/*  for SHA-1, SHA-224 and SHA-256. The CRC-32 checksum is computed */
+/*  with eight tables (slicing-by-8).                               */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_SHA_INTRINSICS
+#include "immintrin.h"
+#include "cpuid.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "msd_rtl.h"
+
+
+/* The digest algorithms use the ordinal numbers */
+/* of the enumeration type digestAlgorithm.      */
+#define DIGEST_NO_DIGEST 0
+#define DIGEST_MD4       1
+#define DIGEST_MD5       2
+#define DIGEST_RIPEMD160 3
+#define DIGEST_SHA1      4
+#define DIGEST_SHA224    5
+#define DIGEST_SHA256    6
+#define DIGEST_SHA384    7
+#define DIGEST_SHA512    8
+
+#define MAX_DIGEST_BLOCK_SIZE 128
+#define UPDATE_BUFFER_SIZE   4096
+
+typedef struct {
+    intType digestAlg;
+    uint64Type length;
+    memSizeType bufferLength;
+    union {
+      uint32Type word32[8];
+      uint64Type word64[8];
+    } hash;
+    ucharType buffer[MAX_DIGEST_BLOCK_SIZE];
+  } msdContextRecord, *msdContextType;
+
+typedef const msdContextRecord *const_msdContextType;
+
+#define rotLeft32(x, n) ((uint32Type) (((x) << (n)) | ((x) >> (32 - (n)))))
+#define rotRight32(x, n) ((uint32Type) (((x) >> (n)) | ((x) << (32 - (n)))))
+#define rotRight64(x, n) ((uint64Type) (((x) >> (n)) | ((x) << (64 - (n)))))
+
+#define getUInt32Le(mem) ((uint32Type) (mem)[0] | \
+                         ((uint32Type) (mem)[1] <<  8) | \
+                         ((uint32Type) (mem)[2] << 16) | \
+                         ((uint32Type) (mem)[3] << 24))
+#define getUInt32Be(mem) (((uint32Type) (mem)[0] << 24) | \
+                          ((uint32Type) (mem)[1] << 16) | \
+                          ((uint32Type) (mem)[2] <<  8) | \
+                           (uint32Type) (mem)[3])
+#define getUInt64Be(mem) (((uint64Type) getUInt32Be(mem) << 32) | \
+                           (uint64Type) getUInt32Be(&(mem)[4]))
+
+static const uint32Type sha256Constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static const uint64Type sha512Constants[80] = {
+    UINT64_SUFFIX(0x428a2f98d728ae22), UINT64_SUFFIX(0x7137449123ef65cd),
+    UINT64_SUFFIX(0xb5c0fbcfec4d3b2f), UINT64_SUFFIX(0xe9b5dba58189dbbc),
+    UINT64_SUFFIX(0x3956c25bf348b538), UINT64_SUFFIX(0x59f111f1b605d019),
+    UINT64_SUFFIX(0x923f82a4af194f9b), UINT64_SUFFIX(0xab1c5ed5da6d8118),
+    UINT64_SUFFIX(0xd807aa98a3030242), UINT64_SUFFIX(0x12835b0145706fbe),
+    UINT64_SUFFIX(0x243185be4ee4b28c), UINT64_SUFFIX(0x550c7dc3d5ffb4e2),
+    UINT64_SUFFIX(0x72be5d74f27b896f), UINT64_SUFFIX(0x80deb1fe3b1696b1),
+    UINT64_SUFFIX(0x9bdc06a725c71235), UINT64_SUFFIX(0xc19bf174cf692694),
+    UINT64_SUFFIX(0xe49b69c19ef14ad2), UINT64_SUFFIX(0xefbe4786384f25e3),
+    UINT64_SUFFIX(0x0fc19dc68b8cd5b5), UINT64_SUFFIX(0x240ca1cc77ac9c65),
+    UINT64_SUFFIX(0x2de92c6f592b0275), UINT64_SUFFIX(0x4a7484aa6ea6e483),
+    UINT64_SUFFIX(0x5cb0a9dcbd41fbd4), UINT64_SUFFIX(0x76f988da831153b5),
+    UINT64_SUFFIX(0x983e5152ee66dfab), UINT64_SUFFIX(0xa831c66d2db43210),
+    UINT64_SUFFIX(0xb00327c898fb213f), UINT64_SUFFIX(0xbf597fc7beef0ee4),
+    UINT64_SUFFIX(0xc6e00bf33da88fc2), UINT64_SUFFIX(0xd5a79147930aa725),
+    UINT64_SUFFIX(0x06ca6351e003826f), UINT64_SUFFIX(0x142929670a0e6e70),
+    UINT64_SUFFIX(0x27b70a8546d22ffc), UINT64_SUFFIX(0x2e1b21385c26c926),
+    UINT64_SUFFIX(0x4d2c6dfc5ac42aed), UINT64_SUFFIX(0x53380d139d95b3df),
+    UINT64_SUFFIX(0x650a73548baf63de), UINT64_SUFFIX(0x766a0abb3c77b2a8),
+    UINT64_SUFFIX(0x81c2c92e47edaee6), UINT64_SUFFIX(0x92722c851482353b),
+    UINT64_SUFFIX(0xa2bfe8a14cf10364), UINT64_SUFFIX(0xa81a664bbc423001),
+    UINT64_SUFFIX(0xc24b8b70d0f89791), UINT64_SUFFIX(0xc76c51a30654be30),
+    UINT64_SUFFIX(0xd192e819d6ef5218), UINT64_SUFFIX(0xd69906245565a910),
+    UINT64_SUFFIX(0xf40e35855771202a), UINT64_SUFFIX(0x106aa07032bbd1b8),
+    UINT64_SUFFIX(0x19a4c116b8d2d0c8), UINT64_SUFFIX(0x1e376c085141ab53),
+    UINT64_SUFFIX(0x2748774cdf8eeb99), UINT64_SUFFIX(0x34b0bcb5e19b48a8),
+    UINT64_SUFFIX(0x391c0cb3c5c95a63), UINT64_SUFFIX(0x4ed8aa4ae3418acb),
+    UINT64_SUFFIX(0x5b9cca4f7763e373), UINT64_SUFFIX(0x682e6ff3d6b2b8a3),
+    UINT64_SUFFIX(0x748f82ee5defb2fc), UINT64_SUFFIX(0x78a5636f43172f60),
+    UINT64_SUFFIX(0x84c87814a1f0ab72), UINT64_SUFFIX(0x8cc702081a6439ec),
+    UINT64_SUFFIX(0x90befffa23631e28), UINT64_SUFFIX(0xa4506cebde82bde9),
+    UINT64_SUFFIX(0xbef9a3f7b2c67915), UINT64_SUFFIX(0xc67178f2e372532b),
+    UINT64_SUFFIX(0xca273eceea26619c), UINT64_SUFFIX(0xd186b8c721c0c207),
+    UINT64_SUFFIX(0xeada7dd6cde0eb1e), UINT64_SUFFIX(0xf57d4f7fee6ed178),
+    UINT64_SUFFIX(0x06f067aa72176fba), UINT64_SUFFIX(0x0a637dc5a2c898a6),
+    UINT64_SUFFIX(0x113f9804bef90dae), UINT64_SUFFIX(0x1b710b35131c471b),
+    UINT64_SUFFIX(0x28db77f523047d84), UINT64_SUFFIX(0x32caab7b40c72493),
+    UINT64_SUFFIX(0x3c9ebe0a15c9bebc), UINT64_SUFFIX(0x431d67c49c100d4c),
+    UINT64_SUFFIX(0x4cc5d4becb3e42b6), UINT64_SUFFIX(0x597f299cfc657e2a),
+    UINT64_SUFFIX(0x5fcb6fab3ad6faec), UINT64_SUFFIX(0x6c44198c4a475817)};
+
+static const uint32Type md5Constants[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+static const unsigned char md5Shift[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+static const unsigned char md4Shift[48] = {
+    3,  7, 11, 19,  3,  7, 11, 19,  3,  7, 11, 19,  3,  7, 11, 19,
+    3,  5,  9, 13,  3,  5,  9, 13,  3,  5,  9, 13,  3,  5,  9, 13,
+    3,  9, 11, 15,  3,  9, 11, 15,  3,  9, 11, 15,  3,  9, 11, 15};
+
+static const unsigned char md4Index[48] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+    0,  4,  8, 12,  1,  5,  9, 13,  2,  6, 10, 14,  3,  7, 11, 15,
+    0,  8,  4, 12,  2, 10,  6, 14,  1,  9,  5, 13,  3, 11,  7, 15};
+
+static const unsigned char ripemd160LeftIndex[80] = {
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+     7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+     3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+     1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+     4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13};
+
+static const unsigned char ripemd160RightIndex[80] = {
+     5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+     6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+    15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+     8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+    12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11};
+
+static const unsigned char ripemd160LeftShift[80] = {
+    11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+     7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+    11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+    11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+     9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6};
+
+static const unsigned char ripemd160RightShift[80] = {
+     8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+     9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+     9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+    15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+     8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11};
+
+static const uint32Type ripemd160LeftConstants[5] = {
+    0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+
+static const uint32Type ripemd160RightConstants[5] = {
+    0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+#if HAS_SHA_INTRINSICS
+static int shaInstructionsPresent = -1;
+#endif
+
+static boolType crc32TablesInitialized = FALSE;
+static uint32Type crc32Tables[8][256];
+
+
+
+static void md4Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type m[16];
+    uint32Type a, b, c, d, f, k, temp;
+    int index;
+
+  /* md4Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (index = 0; index < 16; index++) {
+        m[index] = getUInt32Le(&data[4 * index]);
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      for (index = 0; index < 48; index++) {
+        if (index < 16) {
+          f = d ^ (b & (c ^ d));
+          k = 0;
+        } else if (index < 32) {
+          f = (b & (c | d)) | (c & d);
+          k = 0x5a827999;
+        } else {
+          f = b ^ c ^ d;
+          k = 0x6ed9eba1;
+        } /* if */
+        temp = d;
+        d = c;
+        c = b;
+        b = a + f + k + m[md4Index[index]];
+        b = rotLeft32(b, md4Shift[index]);
+        a = temp;
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+    } /* for */
+  } /* md4Blocks */
+
+
+
+static void md5Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type m[16];
+    uint32Type a, b, c, d, f, temp;
+    int g;
+    int index;
+
+  /* md5Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (index = 0; index < 16; index++) {
+        m[index] = getUInt32Le(&data[4 * index]);
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      for (index = 0; index < 64; index++) {
+        if (index < 16) {
+          f = d ^ (b & (c ^ d));
+          g = index;
+        } else if (index < 32) {
+          f = c ^ (d & (b ^ c));
+          g = (5 * index + 1) & 15;
+        } else if (index < 48) {
+          f = b ^ c ^ d;
+          g = (3 * index + 5) & 15;
+        } else {
+          f = c ^ (b | ~d);
+          g = (7 * index) & 15;
+        } /* if */
+        temp = d;
+        d = c;
+        c = b;
+        f = a + f + md5Constants[index] + m[g];
+        b = b + rotLeft32(f, md5Shift[index]);
+        a = temp;
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+    } /* for */
+  } /* md5Blocks */
+
+
+
+static uint32Type ripemd160Function (int round, uint32Type x,
+    uint32Type y, uint32Type z)
+
+  {
+    uint32Type result;
+
+  /* ripemd160Function */
+    switch (round) {
+      case 0:  result = x ^ y ^ z;          break;
+      case 1:  result = (x & y) | (~x & z); break;
+      case 2:  result = (x | ~y) ^ z;       break;
+      case 3:  result = (x & z) | (y & ~z); break;
+      default: result = x ^ (y | ~z);       break;
+    } /* switch */
+    return result;
+  } /* ripemd160Function */
+
+
+
+static void ripemd160Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type m[16];
+    uint32Type al, bl, cl, dl, el;
+    uint32Type ar, br, cr, dr, er;
+    uint32Type temp;
+    int index;
+
+  /* ripemd160Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (index = 0; index < 16; index++) {
+        m[index] = getUInt32Le(&data[4 * index]);
+      } /* for */
+      al = ar = hash[0];
+      bl = br = hash[1];
+      cl = cr = hash[2];
+      dl = dr = hash[3];
+      el = er = hash[4];
+      for (index = 0; index < 80; index++) {
+        temp = al + ripemd160Function(index >> 4, bl, cl, dl) +
+            m[ripemd160LeftIndex[index]] + ripemd160LeftConstants[index >> 4];
+        temp = rotLeft32(temp, ripemd160LeftShift[index]) + el;
+        al = el;
+        el = dl;
+        dl = rotLeft32(cl, 10);
+        cl = bl;
+        bl = temp;
+        temp = ar + ripemd160Function(4 - (index >> 4), br, cr, dr) +
+            m[ripemd160RightIndex[index]] + ripemd160RightConstants[index >> 4];
+        temp = rotLeft32(temp, ripemd160RightShift[index]) + er;
+        ar = er;
+        er = dr;
+        dr = rotLeft32(cr, 10);
+        cr = br;
+        br = temp;
+      } /* for */
+      temp = hash[1] + cl + dr;
+      hash[1] = hash[2] + dl + er;
+      hash[2] = hash[3] + el + ar;
+      hash[3] = hash[4] + al + br;
+      hash[4] = hash[0] + bl + cr;
+      hash[0] = temp;
+    } /* for */
+  } /* ripemd160Blocks */
+
+
+
+static void sha1Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type w[80];
+    uint32Type a, b, c, d, e, f, k, temp;
+    int index;
+
+  /* sha1Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (index = 0; index < 16; index++) {
+        w[index] = getUInt32Be(&data[4 * index]);
+      } /* for */
+      for (index = 16; index < 80; index++) {
+        temp = w[index - 3] ^ w[index - 8] ^ w[index - 14] ^ w[index - 16];
+        w[index] = rotLeft32(temp, 1);
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      for (index = 0; index < 80; index++) {
+        if (index < 20) {
+          f = d ^ (b & (c ^ d));
+          k = 0x5a827999;
+        } else if (index < 40) {
+          f = b ^ c ^ d;
+          k = 0x6ed9eba1;
+        } else if (index < 60) {
+          f = (b & c) | (d & (b | c));
+          k = 0x8f1bbcdc;
+        } else {
+          f = b ^ c ^ d;
+          k = 0xca62c1d6;
+        } /* if */
+        temp = rotLeft32(a, 5) + f + e + k + w[index];
+        e = d;
+        d = c;
+        c = rotLeft32(b, 30);
+        b = a;
+        a = temp;
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+    } /* for */
+  } /* sha1Blocks */
+
+
+
+static void sha256Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type w[64];
+    uint32Type a, b, c, d, e, f, g, h;
+    uint32Type s0, s1, temp1, temp2;
+    int index;
+
+  /* sha256Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (index = 0; index < 16; index++) {
+        w[index] = getUInt32Be(&data[4 * index]);
+      } /* for */
+      for (index = 16; index < 64; index++) {
+        s0 = rotRight32(w[index - 15], 7) ^ rotRight32(w[index - 15], 18) ^
+             (w[index - 15] >> 3);
+        s1 = rotRight32(w[index - 2], 17) ^ rotRight32(w[index - 2], 19) ^
+             (w[index - 2] >> 10);
+        w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      f = hash[5];
+      g = hash[6];
+      h = hash[7];
+      for (index = 0; index < 64; index++) {
+        s1 = rotRight32(e, 6) ^ rotRight32(e, 11) ^ rotRight32(e, 25);
+        temp1 = h + s1 + (g ^ (e & (f ^ g))) + sha256Constants[index] + w[index];
+        s0 = rotRight32(a, 2) ^ rotRight32(a, 13) ^ rotRight32(a, 22);
+        temp2 = s0 + ((a & b) | (c & (a | b)));
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+      hash[5] += f;
+      hash[6] += g;
+      hash[7] += h;
+    } /* for */
+  } /* sha256Blocks */
+
+
+
+static void sha512Blocks (uint64Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint64Type w[80];
+    uint64Type a, b, c, d, e, f, g, h;
+    uint64Type s0, s1, temp1, temp2;
+    int index;
+
+  /* sha512Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 128) {
+      for (index = 0; index < 16; index++) {
+        w[index] = getUInt64Be(&data[8 * index]);
+      } /* for */
+      for (index = 16; index < 80; index++) {
+        s0 = rotRight64(w[index - 15], 1) ^ rotRight64(w[index - 15], 8) ^
+             (w[index - 15] >> 7);
+        s1 = rotRight64(w[index - 2], 19) ^ rotRight64(w[index - 2], 61) ^
+             (w[index - 2] >> 6);
+        w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      f = hash[5];
+      g = hash[6];
+      h = hash[7];
+      for (index = 0; index < 80; index++) {
+        s1 = rotRight64(e, 14) ^ rotRight64(e, 18) ^ rotRight64(e, 41);
+        temp1 = h + s1 + (g ^ (e & (f ^ g))) + sha512Constants[index] + w[index];
+        s0 = rotRight64(a, 28) ^ rotRight64(a, 34) ^ rotRight64(a, 39);
+        temp2 = s0 + ((a & b) | (c & (a | b)));
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+      hash[5] += f;
+      hash[6] += g;
+      hash[7] += h;
+    } /* for */
+  } /* sha512Blocks */
+
+
+
+#if HAS_SHA_INTRINSICS
+static boolType shaInstructionsSupported (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+
+  /* shaInstructionsSupported */
+    if (shaInstructionsPresent == -1) {
+      shaInstructionsPresent = 0;
+      if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+          (ecx & bit_SSE4_1) != 0 && (ecx & bit_SSSE3) != 0 &&
+          __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+          (ebx & (1 << 29)) != 0) {
+        shaInstructionsPresent = 1;
+      } /* if */
+      logMessage(printf("shaInstructionsSupported: %d\n",
+                        shaInstructionsPresent););
+    } /* if */
+    return shaInstructionsPresent;
+  } /* shaInstructionsSupported */
+
+
+
+/**
+ *  Process SHA-1 blocks with the SHA extensions of x86.
+ *  The rounds are processed in groups of four. The message
+ *  schedule of group n+1 is computed while group n is processed.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha1BlocksShaNi (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0001020304050607LL,
+                                                0x08090a0b0c0d0e0fLL);
+    __m128i abcd, abcdSave, e0, e0Save, e1;
+    __m128i msg0, msg1, msg2, msg3;
+
+  /* sha1BlocksShaNi */
+    abcd = _mm_loadu_si128((const __m128i *) hash);
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    e0 = _mm_set_epi32((int) hash[4], 0, 0, 0);
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      abcdSave = abcd;
+      e0Save = e0;
+
+#define SHA1_LOAD(msg, offset) \
+      msg = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[offset]), \
+                             byteSwapMask);
+#define SHA1_ROUNDS(eUsed, eOther, msg, func) \
+      eUsed = _mm_sha1nexte_epu32(eUsed, msg); \
+      eOther = abcd; \
+      abcd = _mm_sha1rnds4_epu32(abcd, eUsed, func);
+#define SHA1_ROUNDS_AND_SCHEDULE(eUsed, eOther, msg, prev1, prev2, prev3, func) \
+      eUsed = _mm_sha1nexte_epu32(eUsed, msg); \
+      eOther = abcd; \
+      prev3 = _mm_sha1msg2_epu32(prev3, msg); \
+      abcd = _mm_sha1rnds4_epu32(abcd, eUsed, func); \
+      prev1 = _mm_sha1msg1_epu32(prev1, msg); \
+      prev2 = _mm_xor_si128(prev2, msg);
+
+      /* Rounds 0 - 3 */
+      SHA1_LOAD(msg0, 0);
+      e0 = _mm_add_epi32(e0, msg0);
+      e1 = abcd;
+      abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+      /* Rounds 4 - 7 */
+      SHA1_LOAD(msg1, 16);
+      SHA1_ROUNDS(e1, e0, msg1, 0);
+      msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+      /* Rounds 8 - 11 */
+      SHA1_LOAD(msg2, 32);
+      SHA1_ROUNDS(e0, e1, msg2, 0);
+      msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+      msg0 = _mm_xor_si128(msg0, msg2);
+      /* Rounds 12 - 15 */
+      SHA1_LOAD(msg3, 48);
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg3, msg2, msg1, msg0, 0);
+      /* Rounds 16 - 19 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg0, msg3, msg2, msg1, 0);
+      /* Rounds 20 - 23 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg1, msg0, msg3, msg2, 1);
+      /* Rounds 24 - 27 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg2, msg1, msg0, msg3, 1);
+      /* Rounds 28 - 31 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg3, msg2, msg1, msg0, 1);
+      /* Rounds 32 - 35 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg0, msg3, msg2, msg1, 1);
+      /* Rounds 36 - 39 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg1, msg0, msg3, msg2, 1);
+      /* Rounds 40 - 43 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg2, msg1, msg0, msg3, 2);
+      /* Rounds 44 - 47 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg3, msg2, msg1, msg0, 2);
+      /* Rounds 48 - 51 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg0, msg3, msg2, msg1, 2);
+      /* Rounds 52 - 55 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg1, msg0, msg3, msg2, 2);
+      /* Rounds 56 - 59 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg2, msg1, msg0, msg3, 2);
+      /* Rounds 60 - 63 */
+      SHA1_ROUNDS_AND_SCHEDULE(e1, e0, msg3, msg2, msg1, msg0, 3);
+      /* Rounds 64 - 67 */
+      SHA1_ROUNDS_AND_SCHEDULE(e0, e1, msg0, msg3, msg2, msg1, 3);
+      /* Rounds 68 - 71 */
+      e1 = _mm_sha1nexte_epu32(e1, msg1);
+      e0 = abcd;
+      msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+      abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+      msg3 = _mm_xor_si128(msg3, msg1);
+      /* Rounds 72 - 75 */
+      e0 = _mm_sha1nexte_epu32(e0, msg2);
+      e1 = abcd;
+      msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+      abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+      /* Rounds 76 - 79 */
+      SHA1_ROUNDS(e1, e0, msg3, 3);
+
+#undef SHA1_LOAD
+#undef SHA1_ROUNDS
+#undef SHA1_ROUNDS_AND_SCHEDULE
+
+      e0 = _mm_sha1nexte_epu32(e0, e0Save);
+      abcd = _mm_add_epi32(abcd, abcdSave);
+    } /* for */
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    _mm_storeu_si128((__m128i *) hash, abcd);
+    hash[4] = (uint32Type) _mm_extract_epi32(e0, 3);
+  } /* sha1BlocksShaNi */
+
+
+
+/**
+ *  Process SHA-256 blocks with the SHA extensions of x86.
+ *  The state is kept in the ABEF/CDGH order required by the
+ *  sha256rnds2 instruction.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256BlocksShaNi (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bLL,
+                                                0x0405060700010203LL);
+    __m128i state0, state1, abefSave, cdghSave, temp;
+    __m128i msg0, msg1, msg2, msg3;
+
+  /* sha256BlocksShaNi */
+    temp = _mm_loadu_si128((const __m128i *) &hash[0]);
+    state1 = _mm_loadu_si128((const __m128i *) &hash[4]);
+    temp = _mm_shuffle_epi32(temp, 0xb1);          /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1b);      /* EFGH */
+    state0 = _mm_alignr_epi8(temp, state1, 8);     /* ABEF */
+    state1 = _mm_blend_epi16(state1, temp, 0xf0);  /* CDGH */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      abefSave = state0;
+      cdghSave = state1;
+
+#define SHA256_ROUNDS(msg, group) \
+      temp = _mm_add_epi32(msg, _mm_loadu_si128( \
+          (const __m128i *) &sha256Constants[4 * (group)])); \
+      state1 = _mm_sha256rnds2_epu32(state1, state0, temp); \
+      temp = _mm_shuffle_epi32(temp, 0x0e); \
+      state0 = _mm_sha256rnds2_epu32(state0, state1, temp);
+#define SHA256_SCHEDULE(msg, next1, next2, next3) \
+      msg = _mm_sha256msg1_epu32(msg, next1); \
+      msg = _mm_add_epi32(msg, _mm_alignr_epi8(next3, next2, 4)); \
+      msg = _mm_sha256msg2_epu32(msg, next3);
+
+      msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[0]), byteSwapMask);
+      msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[16]), byteSwapMask);
+      msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[32]), byteSwapMask);
+      msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &data[48]), byteSwapMask);
+      SHA256_ROUNDS(msg0, 0);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg1, 1);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg2, 2);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg3, 3);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg0, 4);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg1, 5);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg2, 6);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg3, 7);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg0, 8);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg1, 9);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg2, 10);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg3, 11);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg0, 12);
+      SHA256_ROUNDS(msg1, 13);
+      SHA256_ROUNDS(msg2, 14);
+      SHA256_ROUNDS(msg3, 15);
+
+#undef SHA256_ROUNDS
+#undef SHA256_SCHEDULE
+
+      state0 = _mm_add_epi32(state0, abefSave);
+      state1 = _mm_add_epi32(state1, cdghSave);
+    } /* for */
+    temp = _mm_shuffle_epi32(state0, 0x1b);        /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xb1);      /* DCHG */
+    state0 = _mm_blend_epi16(temp, state1, 0xf0);  /* DCBA */
+    state1 = _mm_alignr_epi8(state1, temp, 8);     /* ABEF */
+    _mm_storeu_si128((__m128i *) &hash[0], state0);
+    _mm_storeu_si128((__m128i *) &hash[4], state1);
+  } /* sha256BlocksShaNi */
+#endif
+
+
+
+static void initCrc32Tables (void)
+
+  {
+    uint32Type crc;
+    unsigned int index;
+    unsigned int bit;
+    unsigned int table;
+
+  /* initCrc32Tables */
+    for (index = 0; index < 256; index++) {
+      crc = index;
+      for (bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+      } /* for */
+      crc32Tables[0][index] = crc;
+    } /* for */
+    for (index = 0; index < 256; index++) {
+      crc = crc32Tables[0][index];
+      for (table = 1; table < 8; table++) {
+        crc = crc32Tables[0][crc & 0xff] ^ (crc >> 8);
+        crc32Tables[table][index] = crc;
+      } /* for */
+    } /* for */
+    crc32TablesInitialized = TRUE;
+  } /* initCrc32Tables */
+
+
+
+/**
+ *  Compute the CRC-32 of 'data' (as used by PNG, gzip and zip).
+ *  @param crc CRC-32 of the previous data or 0 at the start.
+ *  @return the CRC-32 of the previous data followed by 'data'.
+ */
+uint32Type msdCrc32Bytes (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  {
+    uint32Type low;
+    uint32Type high;
+
+  /* msdCrc32Bytes */
+    if (unlikely(!crc32TablesInitialized)) {
+      initCrc32Tables();
+    } /* if */
+    crc = ~crc;
+    while (length >= 8) {
+      low = crc ^ ((uint32Type) data[0] | (uint32Type) data[1] << 8 |
+                   (uint32Type) data[2] << 16 | (uint32Type) data[3] << 24);
+      high = (uint32Type) data[4] | (uint32Type) data[5] << 8 |
+             (uint32Type) data[6] << 16 | (uint32Type) data[7] << 24;
+      crc = crc32Tables[7][low & 0xff] ^
+            crc32Tables[6][(low >> 8) & 0xff] ^
+            crc32Tables[5][(low >> 16) & 0xff] ^
+            crc32Tables[4][low >> 24] ^
+            crc32Tables[3][high & 0xff] ^
+            crc32Tables[2][(high >> 8) & 0xff] ^
+            crc32Tables[1][(high >> 16) & 0xff] ^
+            crc32Tables[0][high >> 24];
+      data += 8;
+      length -= 8;
+    } /* while */
+    while (length != 0) {
+      crc = crc32Tables[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+      data++;
+      length--;
+    } /* while */
+    return ~crc;
+  } /* msdCrc32Bytes */
+
+
+
+static memSizeType blockSize (intType digestAlg)
+
+  { /* blockSize */
+    return digestAlg == DIGEST_SHA384 || digestAlg == DIGEST_SHA512 ? 128 : 64;
+  } /* blockSize */
+
+
+
+static void processBlocks (const msdContextType context,
+    const ucharType *data, memSizeType numBlocks)
+
+  { /* processBlocks */
+    switch (context->digestAlg) {
+      case DIGEST_MD4:
+        md4Blocks(context->hash.word32, data, numBlocks);
+        break;
+      case DIGEST_MD5:
+        md5Blocks(context->hash.word32, data, numBlocks);
+        break;
+      case DIGEST_RIPEMD160:
+        ripemd160Blocks(context->hash.word32, data, numBlocks);
+        break;
+      case DIGEST_SHA1:
+#if HAS_SHA_INTRINSICS
+        if (shaInstructionsSupported()) {
+          sha1BlocksShaNi(context->hash.word32, data, numBlocks);
+        } else
+#endif
+        sha1Blocks(context->hash.word32, data, numBlocks);
+        break;
+      case DIGEST_SHA224:
+      case DIGEST_SHA256:
+#if HAS_SHA_INTRINSICS
+        if (shaInstructionsSupported()) {
+          sha256BlocksShaNi(context->hash.word32, data, numBlocks);
+        } else
+#endif
+        sha256Blocks(context->hash.word32, data, numBlocks);
+        break;
+      case DIGEST_SHA384:
+      case DIGEST_SHA512:
+        sha512Blocks(context->hash.word64, data, numBlocks);
+        break;
+    } /* switch */
+  } /* processBlocks */
+
+
+
+/**
+ *  Add the bytes in 'data' to the digest computation in 'context'.
+ *  Complete blocks are processed directly from 'data'. Bytes that
+ *  do not fill a complete block are kept in the buffer of 'context'.
+ */
+static void updateBytes (const msdContextType context,
+    const ucharType *data, memSizeType length)
+
+  {
+    memSizeType blockLength;
+    memSizeType bytesToCopy;
+
+  /* updateBytes */
+    blockLength = blockSize(context->digestAlg);
+    context->length += length;
+    if (context->bufferLength != 0) {
+      bytesToCopy = blockLength - context->bufferLength;
+      if (bytesToCopy > length) {
+        bytesToCopy = length;
+      } /* if */
+      memcpy(&context->buffer[context->bufferLength], data, bytesToCopy);
+      context->bufferLength += bytesToCopy;
+      data += bytesToCopy;
+      length -= bytesToCopy;
+      if (context->bufferLength == blockLength) {
+        processBlocks(context, context->buffer, 1);
+        context->bufferLength = 0;
+      } /* if */
+    } /* if */
+    if (length >= blockLength) {
+      processBlocks(context, data, length / blockLength);
+      data += length - length % blockLength;
+      length %= blockLength;
+    } /* if */
+    if (length != 0) {
+      memcpy(context->buffer, data, length);
+      context->bufferLength = length;
+    } /* if */
+  } /* updateBytes */
+
+
+
+static boolType getContext (const const_bstriType contextBstri,
+    const msdContextType context)
+
+  {
+    boolType okay = TRUE;
+
+  /* getContext */
+    if (contextBstri->size == 0) {
+      context->digestAlg = DIGEST_NO_DIGEST;
+    } else if (unlikely(contextBstri->size != sizeof(msdContextRecord))) {
+      okay = FALSE;
+    } else {
+      memcpy(context, contextBstri->mem, sizeof(msdContextRecord));
+      if (unlikely(context->digestAlg < DIGEST_MD4 ||
+                   context->digestAlg > DIGEST_SHA512 ||
+                   context->bufferLength >= blockSize(context->digestAlg))) {
+        okay = FALSE;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* getContext */
+
+
+
+/**
+ *  Compute the message digest of the data processed so far.
+ *  The digest computation in 'context' is not changed. This way
+ *  more data can be added to 'context' afterwards.
+ *  @param context State of a digest computation created with msdInit.
+ *  @return the message digest (a string with characters from '\0;'
+ *          to '\255;').
+ *  @exception RANGE_ERROR If 'context' is not a valid digest state.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType msdFinal (const const_bstriType context)
+
+  {
+    msdContextRecord ctx;
+    memSizeType blockLength;
+    memSizeType lengthPos;
+    uint64Type bitLength;
+    ucharType digest[64];
+    memSizeType digestSize;
+    memSizeType pos;
+    striType result;
+
+  /* msdFinal */
+    logFunction(printf("msdFinal(\"%s\")\n", bstriAsUnquotedCStri(context)););
+    if (unlikely(!getContext(context, &ctx))) {
+      logError(printf("msdFinal(\"%s\"): Illegal digest state.\n",
+                      bstriAsUnquotedCStri(context)););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      if (ctx.digestAlg == DIGEST_NO_DIGEST) {
+        digestSize = 0;
+      } else {
+        blockLength = blockSize(ctx.digestAlg);
+        lengthPos = blockLength == 128 ? 112 : 56;
+        bitLength = ctx.length << 3;
+        ctx.buffer[ctx.bufferLength] = 0x80;
+        ctx.bufferLength++;
+        if (ctx.bufferLength > lengthPos) {
+          memset(&ctx.buffer[ctx.bufferLength], 0, blockLength - ctx.bufferLength);
+          processBlocks(&ctx, ctx.buffer, 1);
+          ctx.bufferLength = 0;
+        } /* if */
+        memset(&ctx.buffer[ctx.bufferLength], 0, blockLength - ctx.bufferLength);
+        if (ctx.digestAlg <= DIGEST_RIPEMD160) {
+          for (pos = 0; pos < 8; pos++) {
+            ctx.buffer[lengthPos + pos] = (ucharType) (bitLength >> (8 * pos));
+          } /* for */
+        } else {
+          if (blockLength == 128) {
+            /* The upper 64 bits of the 128-bit length. */
+            ctx.buffer[lengthPos + 7] = (ucharType) (ctx.length >> 61);
+            lengthPos += 8;
+          } /* if */
+          for (pos = 0; pos < 8; pos++) {
+            ctx.buffer[lengthPos + pos] = (ucharType) (bitLength >> (8 * (7 - pos)));
+          } /* for */
+        } /* if */
+        processBlocks(&ctx, ctx.buffer, 1);
+        switch (ctx.digestAlg) {
+          case DIGEST_MD4:
+          case DIGEST_MD5:       digestSize = 16; break;
+          case DIGEST_RIPEMD160:
+          case DIGEST_SHA1:      digestSize = 20; break;
+          case DIGEST_SHA224:    digestSize = 28; break;
+          case DIGEST_SHA256:    digestSize = 32; break;
+          case DIGEST_SHA384:    digestSize = 48; break;
+          default:               digestSize = 64; break;
+        } /* switch */
+        if (ctx.digestAlg <= DIGEST_RIPEMD160) {
+          for (pos = 0; pos < digestSize; pos++) {
+            digest[pos] = (ucharType) (ctx.hash.word32[pos >> 2] >> (8 * (pos & 3)));
+          } /* for */
+        } else if (blockLength == 64) {
+          for (pos = 0; pos < digestSize; pos++) {
+            digest[pos] = (ucharType) (ctx.hash.word32[pos >> 2] >> (8 * (3 - (pos & 3))));
+          } /* for */
+        } else {
+          for (pos = 0; pos < digestSize; pos++) {
+            digest[pos] = (ucharType) (ctx.hash.word64[pos >> 3] >> (8 * (7 - (pos & 7))));
+          } /* for */
+        } /* if */
+      } /* if */
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, digestSize))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = digestSize;
+        memcpy_to_strelem(result->mem, digest, digestSize);
+      } /* if */
+    } /* if */
+    logFunction(printf("msdFinal --> \"%s\"\n", striAsUnquotedCStri(result)););
+    return result;
+  } /* msdFinal */
+
+
+
+/**
+ *  Create the initial state of a message digest computation.
+ *  @param digestAlg Ordinal number of the digest algorithm
+ *         (NO_DIGEST, MD4, MD5, RIPEMD160, SHA1, SHA224, SHA256,
+ *         SHA384 or SHA512).
+ *  @return a bstring with the state of the digest computation.
+ *  @exception RANGE_ERROR If 'digestAlg' is not a digest algorithm.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType msdInit (intType digestAlg)
+
+  {
+    static const uint32Type sha224Init[8] = {
+        0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+        0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4};
+    static const uint32Type sha256Init[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    static const uint64Type sha384Init[8] = {
+        UINT64_SUFFIX(0xcbbb9d5dc1059ed8), UINT64_SUFFIX(0x629a292a367cd507),
+        UINT64_SUFFIX(0x9159015a3070dd17), UINT64_SUFFIX(0x152fecd8f70e5939),
+        UINT64_SUFFIX(0x67332667ffc00b31), UINT64_SUFFIX(0x8eb44a8768581511),
+        UINT64_SUFFIX(0xdb0c2e0d64f98fa7), UINT64_SUFFIX(0x47b5481dbefa4fa4)};
+    static const uint64Type sha512Init[8] = {
+        UINT64_SUFFIX(0x6a09e667f3bcc908), UINT64_SUFFIX(0xbb67ae8584caa73b),
+        UINT64_SUFFIX(0x3c6ef372fe94f82b), UINT64_SUFFIX(0xa54ff53a5f1d36f1),
+        UINT64_SUFFIX(0x510e527fade682d1), UINT64_SUFFIX(0x9b05688c2b3e6c1f),
+        UINT64_SUFFIX(0x1f83d9abfb41bd6b), UINT64_SUFFIX(0x5be0cd19137e2179)};
+    msdContextRecord ctx;
+    bstriType result;
+
+  /* msdInit */
+    logFunction(printf("msdInit(" FMT_D ")\n", digestAlg););
+    if (unlikely(digestAlg < DIGEST_NO_DIGEST || digestAlg > DIGEST_SHA512)) {
+      logError(printf("msdInit(" FMT_D "): Illegal digest algorithm.\n",
+                      digestAlg););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (digestAlg == DIGEST_NO_DIGEST) {
+      if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, 0))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = 0;
+      } /* if */
+    } else {
+      memset(&ctx, 0, sizeof(msdContextRecord));
+      ctx.digestAlg = digestAlg;
+      switch (digestAlg) {
+        case DIGEST_RIPEMD160:
+        case DIGEST_SHA1:
+          ctx.hash.word32[4] = 0xc3d2e1f0;
+          /* fall through */
+        case DIGEST_MD4:
+        case DIGEST_MD5:
+          ctx.hash.word32[0] = 0x67452301;
+          ctx.hash.word32[1] = 0xefcdab89;
+          ctx.hash.word32[2] = 0x98badcfe;
+          ctx.hash.word32[3] = 0x10325476;
+          break;
+        case DIGEST_SHA224:
+          memcpy(ctx.hash.word32, sha224Init, sizeof(sha224Init));
+          break;
+        case DIGEST_SHA256:
+          memcpy(ctx.hash.word32, sha256Init, sizeof(sha256Init));
+          break;
+        case DIGEST_SHA384:
+          memcpy(ctx.hash.word64, sha384Init, sizeof(sha384Init));
+          break;
+        case DIGEST_SHA512:
+          memcpy(ctx.hash.word64, sha512Init, sizeof(sha512Init));
+          break;
+      } /* switch */
+      if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, sizeof(msdContextRecord)))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = sizeof(msdContextRecord);
+        memcpy(result->mem, &ctx, sizeof(msdContextRecord));
+      } /* if */
+    } /* if */
+    logFunction(printf("msdInit --> \"%s\"\n", bstriAsUnquotedCStri(result)););
+    return result;
+  } /* msdInit */
+
+
+
+/**
+ *  Add the characters of 'data' to the digest computation in 'context'.
+ *  The characters are converted to bytes in pieces. This way the
+ *  memory needed does not depend on the length of 'data'.
+ *  @param context State of a digest computation created with msdInit.
+ *  @param data Data to be added to the digest computation.
+ *  @exception RANGE_ERROR If 'context' is not a valid digest state or
+ *             if 'data' contains a character beyond '\255;'.
+ */
+void msdUpdate (bstriType context, const const_striType data)
+
+  {
+    msdContextRecord ctx;
+    ucharType buffer[UPDATE_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType length;
+    memSizeType chunkLength;
+
+  /* msdUpdate */
+    logFunction(printf("msdUpdate(\"%s\", \"%s\")\n",
+                       bstriAsUnquotedCStri(context),
+                       striAsUnquotedCStri(data)););
+    if (unlikely(!getContext(context, &ctx))) {
+      logError(printf("msdUpdate(\"%s\", \"%s\"): Illegal digest state.\n",
+                      bstriAsUnquotedCStri(context),
+                      striAsUnquotedCStri(data)););
+      raise_error(RANGE_ERROR);
+    } else if (ctx.digestAlg != DIGEST_NO_DIGEST) {
+      mem = data->mem;
+      length = data->size;
+      while (length != 0) {
+        chunkLength = length > UPDATE_BUFFER_SIZE ? UPDATE_BUFFER_SIZE : length;
+        if (unlikely(memcpy_from_strelem(buffer, mem, chunkLength))) {
+          logError(printf("msdUpdate(\"%s\", \"%s\"): "
+                          "Character beyond '\\255;' present.\n",
+                          bstriAsUnquotedCStri(context),
+                          striAsUnquotedCStri(data)););
+          raise_error(RANGE_ERROR);
+          return;
+        } /* if */
+        updateBytes(&ctx, buffer, chunkLength);
+        mem += chunkLength;
+        length -= chunkLength;
+      } /* while */
+      memcpy(context->mem, &ctx, sizeof(msdContextRecord));
+    } /* if */
+  } /* msdUpdate */
+
+
+
+/**
+ *  Add the bytes of 'data' to the digest computation in 'context'.
+ *  @param context State of a digest computation created with msdInit.
+ *  @param data Data to be added to the digest computation.
+ *  @exception RANGE_ERROR If 'context' is not a valid digest state.
+ */
+void msdUpdateBstri (bstriType context, const const_bstriType data)
+
+  {
+    msdContextRecord ctx;
+
+  /* msdUpdateBstri */
+    logFunction(printf("msdUpdateBstri(\"%s\", \"%s\")\n",
+                       bstriAsUnquotedCStri(context),
+                       bstriAsUnquotedCStri(data)););
+    if (unlikely(!getContext(context, &ctx))) {
+      logError(printf("msdUpdateBstri(\"%s\", \"%s\"): Illegal digest state.\n",
+                      bstriAsUnquotedCStri(context),
+                      bstriAsUnquotedCStri(data)););
+      raise_error(RANGE_ERROR);
+    } else if (ctx.digestAlg != DIGEST_NO_DIGEST) {
+      updateBytes(&ctx, data->mem, data->size);
+      memcpy(context->mem, &ctx, sizeof(msdContextRecord));
+    } /* if */
+  } /* msdUpdateBstri */
+
+
+
+/**
+ *  Compute the CRC-32 cyclic redundancy check code of 'data'.
+ *  Only the lower eight bits of the characters are used.
+ *  @param data Data to be checked.
+ *  @param oldCrc CRC-32 of the previous data or 0 at the start.
+ *  @return the CRC-32 of the previous data followed by 'data'.
+ */
+uintType msdCrc32 (const const_striType data, uintType oldCrc)
+
+  {
+    ucharType buffer[UPDATE_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType length;
+    memSizeType chunkLength;
+    memSizeType index;
+    uint32Type crc;
+
+  /* msdCrc32 */
+    logFunction(printf("msdCrc32(\"%s\", " FMT_U ")\n",
+                       striAsUnquotedCStri(data), oldCrc););
+    crc = (uint32Type) oldCrc;
+    mem = data->mem;
+    length = data->size;
+    while (length != 0) {
+      chunkLength = length > UPDATE_BUFFER_SIZE ? UPDATE_BUFFER_SIZE : length;
+      for (index = 0; index < chunkLength; index++) {
+        buffer[index] = (ucharType) mem[index];
+      } /* for */
+      crc = msdCrc32Bytes(crc, buffer, chunkLength);
+      mem += chunkLength;
+      length -= chunkLength;
+    } /* while */
+    logFunction(printf("msdCrc32 --> " FMT_U "\n", (uintType) crc););
+    return (uintType) crc;
+  } /* msdCrc32 */
@@ -0,0 +1,38 @@
+/********************************************************************/
+/*                                                                  */
+/*  msd_rtl.h     Primitive actions for message digests.            */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/msd_rtl.h                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions for message digests.                 */
+/*                                                                  */
+/********************************************************************/
+
+uint32Type msdCrc32Bytes (uint32Type crc, const ucharType *data,
+    memSizeType length);
+uintType msdCrc32 (const const_striType data, uintType oldCrc);
+striType msdFinal (const const_bstriType context);
+bstriType msdInit (intType digestAlg);
+void msdUpdate (bstriType context, const const_striType data);
+void msdUpdateBstri (bstriType context, const const_bstriType data);
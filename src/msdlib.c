@@ -0,0 +1,136 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/msdlib.c                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for message digests.             */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "msd_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "msdlib.h"
+
+
+
+/**
+ *  Compute the CRC-32 cyclic redundancy check code of arg_1.
+ *  The CRC-32 of the data before arg_1 is given by arg_2.
+ *  @return the CRC-32 of the data before arg_1 followed by arg_1.
+ */
+objectType msd_crc32 (listType arguments)
+
+  { /* msd_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        msdCrc32(take_stri(arg_1(arguments)),
+                 take_binary(arg_2(arguments))));
+  } /* msd_crc32 */
+
+
+
+/**
+ *  Compute the message digest of the data processed so far.
+ *  The digest state in arg_1 is not changed.
+ *  @return the message digest (a string with characters from '\0;'
+ *          to '\255;').
+ *  @exception RANGE_ERROR If arg_1 is not a valid digest state.
+ */
+objectType msd_final (listType arguments)
+
+  { /* msd_final */
+    isit_bstri(arg_1(arguments));
+    return bld_stri_temp(
+        msdFinal(take_bstri(arg_1(arguments))));
+  } /* msd_final */
+
+
+
+/**
+ *  Create the initial state of a message digest computation.
+ *  @return a bstring with the state of the digest computation.
+ *  @exception RANGE_ERROR If arg_1 is not the ordinal number of
+ *             a digest algorithm.
+ */
+objectType msd_init (listType arguments)
+
+  { /* msd_init */
+    isit_int(arg_1(arguments));
+    return bld_bstri_temp(
+        msdInit(take_int(arg_1(arguments))));
+  } /* msd_init */
+
+
+
+/**
+ *  Add the characters of the string arg_2 to the digest state arg_1.
+ *  @exception RANGE_ERROR If arg_1 is not a valid digest state or
+ *             if arg_2 contains a character beyond '\255;'.
+ */
+objectType msd_update (listType arguments)
+
+  {
+    objectType context;
+
+  /* msd_update */
+    context = arg_1(arguments);
+    isit_bstri(context);
+    is_variable(context);
+    isit_stri(arg_2(arguments));
+    msdUpdate(take_bstri(context), take_stri(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* msd_update */
+
+
+
+/**
+ *  Add the bytes of the bstring arg_2 to the digest state arg_1.
+ *  @exception RANGE_ERROR If arg_1 is not a valid digest state.
+ */
+objectType msd_update_bstri (listType arguments)
+
+  {
+    objectType context;
+
+  /* msd_update_bstri */
+    context = arg_1(arguments);
+    isit_bstri(context);
+    is_variable(context);
+    isit_bstri(arg_2(arguments));
+    msdUpdateBstri(take_bstri(context), take_bstri(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* msd_update_bstri */
@@ -0,0 +1,1230 @@
+/********************************************************************/
+/*                                                                  */
+/*  png_rtl.c     Primitive actions for PNG images.                 */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/png_rtl.c                                       */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: Primitive actions for PNG images.                      */
+/*                                                                  */
+/*  The image data of a PNG file is decoded row by row. The data    */
+/*  of the IDAT chunks is inflated as it arrives. Every completed   */
+/*  row is unfiltered and converted to RGB immediately. This way    */
+/*  only two rows of filtered data are kept in memory. The encoder  */
+/*  filters every row with the filter that minimizes the sum of     */
+/*  absolute differences and deflates it. The encoder delivers the  */
+/*  image data in IDAT chunks of limited size. The states of the    */
+/*  decoder and the encoder are kept in bstrings. Filtering and     */
+/*  unfiltering use SSE2 if the C compiler and the CPU support it.  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "msd_rtl.h"
+#include "dfl_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "png_rtl.h"
+
+
+#define PNG_DECODER_MAGIC   0x504e4744
+#define PNG_ENCODER_MAGIC   0x504e4745
+#define PNG_STATE_ALIGNMENT 16
+#define PNG_ROW_PADDING     16
+#define PNG_IDAT_SIZE       65536
+/* A call of dflDeflate() with PNG_DEFLATE_PIECE bytes writes less   */
+/* than four blocks of at most DFL_DEFLATE_BUFFER_SIZE stored bytes. */
+#define PNG_DEFLATE_PIECE    4096
+#define PNG_IDAT_BUFFER_SIZE (PNG_IDAT_SIZE + 4 * DFL_DEFLATE_BUFFER_SIZE)
+#define PNG_DEFLATE_LEVEL       6
+#define PNG_NUM_FILTERS         5
+
+#define FILTER_NONE    0
+#define FILTER_SUB     1
+#define FILTER_UP      2
+#define FILTER_AVERAGE 3
+#define FILTER_PAETH   4
+
+#define COLOR_TYPE_GRAYSCALE       0
+#define COLOR_TYPE_RGB             2
+#define COLOR_TYPE_PALETTE         3
+#define COLOR_TYPE_GRAYSCALE_ALPHA 4
+#define COLOR_TYPE_RGB_ALPHA       6
+
+typedef struct {
+    uint32Type magic;
+    memSizeType width;
+    memSizeType height;
+    unsigned int bitDepth;
+    unsigned int colorType;
+    unsigned int channels;
+    unsigned int filterBpp;
+    boolType interlaced;
+    boolType dataError;
+    boolType complete;
+    unsigned int pass;
+    unsigned int currentRow;
+    unsigned int filterType;
+    memSizeType passWidth;
+    memSizeType passHeight;
+    memSizeType passRowBytes;
+    memSizeType passRow;
+    memSizeType rowFill;
+    memSizeType maxRowBytes;
+    ucharType palette[3 * 256];
+    dflInflateRecord inflater;
+  } pngDecoderRecord, *pngDecoderType;
+
+typedef struct {
+    uint32Type magic;
+    memSizeType width;
+    memSizeType height;
+    memSizeType rowBytes;
+    memSizeType row;
+    memSizeType rowFill;
+    unsigned int filterType;
+    boolType finished;
+    memSizeType idatLength;
+    dflDeflateRecord deflater;
+    ucharType idat[PNG_IDAT_BUFFER_SIZE];
+  } pngEncoderRecord, *pngEncoderType;
+
+typedef struct {
+    pngDecoderType decoder;
+    ucharType *rgb;
+  } pngOutputRecord;
+
+/* Adam7 interlacing: Start and increment of the columns and rows. */
+static const unsigned int adam7StartX[7] = {0, 4, 0, 2, 0, 1, 0};
+static const unsigned int adam7StartY[7] = {0, 0, 4, 0, 2, 0, 1};
+static const unsigned int adam7DeltaX[7] = {8, 8, 4, 4, 2, 2, 1};
+static const unsigned int adam7DeltaY[7] = {8, 8, 8, 4, 4, 2, 2};
+
+
+
+/**
+ *  Get a pointer to the aligned state in 'stateBstri'.
+ *  The first byte of the bstring contains the offset of the state.
+ *  If the bstring has been moved in memory (e.g. by copying it)
+ *  the state is moved to the correct alignment.
+ *  @return the aligned state or NULL if 'stateBstri' is too small.
+ */
+static void *alignedState (bstriType stateBstri, memSizeType stateSize)
+
+  {
+    unsigned int offset;
+    unsigned int wantedOffset;
+
+  /* alignedState */
+    if (unlikely(stateBstri->size < PNG_STATE_ALIGNMENT + stateSize)) {
+      return NULL;
+    } /* if */
+    offset = stateBstri->mem[0];
+    wantedOffset = PNG_STATE_ALIGNMENT - (unsigned int)
+        ((memSizeType) stateBstri->mem & (PNG_STATE_ALIGNMENT - 1));
+    if (unlikely(offset < 1 || offset > PNG_STATE_ALIGNMENT)) {
+      return NULL;
+    } else if (offset != wantedOffset) {
+      memmove(&stateBstri->mem[wantedOffset], &stateBstri->mem[offset],
+              stateBstri->size - PNG_STATE_ALIGNMENT);
+      stateBstri->mem[0] = (ucharType) wantedOffset;
+    } /* if */
+    return &stateBstri->mem[wantedOffset];
+  } /* alignedState */
+
+
+
+/**
+ *  Create a bstring for a state of 'size' bytes.
+ *  The state is initialized with zero bytes.
+ */
+static bstriType newStateBstri (memSizeType size, void **state)
+
+  {
+    bstriType stateBstri;
+    unsigned int offset;
+
+  /* newStateBstri */
+    if (unlikely(size > MAX_BSTRI_LEN - PNG_STATE_ALIGNMENT ||
+                 !ALLOC_BSTRI_SIZE_OK(stateBstri, PNG_STATE_ALIGNMENT + size))) {
+      return NULL;
+    } else {
+      stateBstri->size = PNG_STATE_ALIGNMENT + size;
+      memset(stateBstri->mem, 0, PNG_STATE_ALIGNMENT + size);
+      offset = PNG_STATE_ALIGNMENT - (unsigned int)
+          ((memSizeType) stateBstri->mem & (PNG_STATE_ALIGNMENT - 1));
+      stateBstri->mem[0] = (ucharType) offset;
+      *state = &stateBstri->mem[offset];
+    } /* if */
+    return stateBstri;
+  } /* newStateBstri */
+
+
+
+static inline unsigned int paethPredictor (unsigned int left,
+    unsigned int up, unsigned int upLeft)
+
+  {
+    int pa;
+    int pb;
+    int pc;
+
+  /* paethPredictor */
+    pa = (int) up - (int) upLeft;
+    pb = (int) left - (int) upLeft;
+    pc = pa + pb;
+    pa = pa < 0 ? -pa : pa;
+    pb = pb < 0 ? -pb : pb;
+    pc = pc < 0 ? -pc : pc;
+    if (pa <= pb && pa <= pc) {
+      return left;
+    } else if (pb <= pc) {
+      return up;
+    } else {
+      return upLeft;
+    } /* if */
+  } /* paethPredictor */
+
+
+
+#if HAS_SSE2_INTRINSICS
+static inline __m128i loadPixel (const ucharType *pixel, unsigned int bpp)
+
+  {
+    int32Type value = 0;
+
+  /* loadPixel */
+    memcpy(&value, pixel, bpp);
+    return _mm_cvtsi32_si128(value);
+  } /* loadPixel */
+
+
+
+static inline void storePixel (ucharType *pixel, __m128i value,
+    unsigned int bpp)
+
+  {
+    int32Type data;
+
+  /* storePixel */
+    data = _mm_cvtsi128_si32(value);
+    memcpy(pixel, &data, bpp);
+  } /* storePixel */
+
+
+
+static inline __m128i absDifference16 (__m128i value)
+
+  { /* absDifference16 */
+    return _mm_max_epi16(value, _mm_sub_epi16(_mm_setzero_si128(), value));
+  } /* absDifference16 */
+
+
+
+/**
+ *  Compute the Paeth predictors for 16-bit lanes.
+ */
+static inline __m128i paethPredictor16 (__m128i left, __m128i up,
+    __m128i upLeft)
+
+  {
+    __m128i pa;
+    __m128i pb;
+    __m128i pc;
+    __m128i smallest;
+    __m128i isA;
+    __m128i isB;
+
+  /* paethPredictor16 */
+    pa = _mm_sub_epi16(up, upLeft);
+    pb = _mm_sub_epi16(left, upLeft);
+    pc = _mm_add_epi16(pa, pb);
+    pa = absDifference16(pa);
+    pb = absDifference16(pb);
+    pc = absDifference16(pc);
+    smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    /* Ties are broken in favor of left, then up. */
+    isA = _mm_cmpeq_epi16(smallest, pa);
+    isB = _mm_andnot_si128(isA, _mm_cmpeq_epi16(smallest, pb));
+    return _mm_or_si128(_mm_and_si128(isA, left),
+        _mm_or_si128(_mm_and_si128(isB, up),
+                     _mm_andnot_si128(_mm_or_si128(isA, isB), upLeft)));
+  } /* paethPredictor16 */
+#endif
+
+
+
+/**
+ *  Reverse the filtering of a row.
+ *  The row above 'prior' contains zero bytes for the first row.
+ *  @return TRUE if the row could be unfiltered, FALSE if the
+ *          filter type is not valid.
+ */
+static boolType unfilterRow (unsigned int filterType, ucharType *row,
+    const ucharType *prior, memSizeType length, unsigned int bpp)
+
+  {
+    memSizeType index;
+#if HAS_SSE2_INTRINSICS
+    __m128i left;
+    __m128i up;
+    __m128i upLeft;
+    __m128i current;
+    __m128i zero;
+    __m128i one;
+    __m128i average;
+#endif
+
+  /* unfilterRow */
+    switch (filterType) {
+      case FILTER_NONE:
+        break;
+      case FILTER_SUB:
+#if HAS_SSE2_INTRINSICS
+        if (bpp == 3 || bpp == 4) {
+          left = _mm_setzero_si128();
+          for (index = 0; index < length; index += bpp) {
+            current = _mm_add_epi8(loadPixel(&row[index], bpp), left);
+            storePixel(&row[index], current, bpp);
+            left = current;
+          } /* for */
+          break;
+        } /* if */
+#endif
+        for (index = bpp; index < length; index++) {
+          row[index] = (ucharType) (row[index] + row[index - bpp]);
+        } /* for */
+        break;
+      case FILTER_UP:
+        index = 0;
+#if HAS_SSE2_INTRINSICS
+        for (; index + 16 <= length; index += 16) {
+          _mm_storeu_si128((__m128i *) &row[index], _mm_add_epi8(
+              _mm_loadu_si128((const __m128i *) &row[index]),
+              _mm_loadu_si128((const __m128i *) &prior[index])));
+        } /* for */
+#endif
+        for (; index < length; index++) {
+          row[index] = (ucharType) (row[index] + prior[index]);
+        } /* for */
+        break;
+      case FILTER_AVERAGE:
+#if HAS_SSE2_INTRINSICS
+        if (bpp == 3 || bpp == 4) {
+          left = _mm_setzero_si128();
+          one = _mm_set1_epi8(1);
+          for (index = 0; index < length; index += bpp) {
+            up = loadPixel(&prior[index], bpp);
+            /* _mm_avg_epu8 rounds up: Subtract the rounding bit. */
+            average = _mm_sub_epi8(_mm_avg_epu8(left, up),
+                _mm_and_si128(_mm_xor_si128(left, up), one));
+            current = _mm_add_epi8(loadPixel(&row[index], bpp), average);
+            storePixel(&row[index], current, bpp);
+            left = current;
+          } /* for */
+          break;
+        } /* if */
+#endif
+        for (index = 0; index < bpp && index < length; index++) {
+          row[index] = (ucharType) (row[index] + (prior[index] >> 1));
+        } /* for */
+        for (; index < length; index++) {
+          row[index] = (ucharType) (row[index] +
+              (((unsigned int) row[index - bpp] + prior[index]) >> 1));
+        } /* for */
+        break;
+      case FILTER_PAETH:
+#if HAS_SSE2_INTRINSICS
+        if (bpp == 3 || bpp == 4) {
+          zero = _mm_setzero_si128();
+          left = zero;
+          upLeft = zero;
+          for (index = 0; index < length; index += bpp) {
+            up = _mm_unpacklo_epi8(loadPixel(&prior[index], bpp), zero);
+            current = _mm_add_epi8(loadPixel(&row[index], bpp),
+                _mm_packus_epi16(paethPredictor16(left, up, upLeft), zero));
+            storePixel(&row[index], current, bpp);
+            left = _mm_unpacklo_epi8(current, zero);
+            upLeft = up;
+          } /* for */
+          break;
+        } /* if */
+#endif
+        for (index = 0; index < bpp && index < length; index++) {
+          row[index] = (ucharType) (row[index] + prior[index]);
+        } /* for */
+        for (; index < length; index++) {
+          row[index] = (ucharType) (row[index] +
+              paethPredictor(row[index - bpp], prior[index],
+                             prior[index - bpp]));
+        } /* for */
+        break;
+      default:
+        return FALSE;
+    } /* switch */
+    return TRUE;
+  } /* unfilterRow */
+
+
+
+/**
+ *  Convert an unfiltered row to RGB.
+ *  The pixels are written to 'rgb' with a distance of 'step' bytes.
+ */
+static void convertRow (const pngDecoderRecord *decoder,
+    const ucharType *row, memSizeType numPixels, ucharType *rgb,
+    memSizeType step)
+
+  {
+    memSizeType column;
+    unsigned int bitDepth;
+    unsigned int sampleBytes;
+    unsigned int pixelBytes;
+    unsigned int shift;
+    unsigned int index;
+    const ucharType *entry;
+
+  /* convertRow */
+    bitDepth = decoder->bitDepth;
+    if (bitDepth < 8) {
+      /* Palette or grayscale: The palette contains the gray levels. */
+      for (column = 0; column < numPixels; column++) {
+        shift = 8 - bitDepth - (unsigned int) ((column * bitDepth) & 7);
+        index = (row[(column * bitDepth) >> 3] >> shift) &
+                ((1 << bitDepth) - 1);
+        entry = &decoder->palette[3 * index];
+        rgb[0] = entry[0];
+        rgb[1] = entry[1];
+        rgb[2] = entry[2];
+        rgb += step;
+      } /* for */
+    } else if (decoder->colorType == COLOR_TYPE_PALETTE) {
+      for (column = 0; column < numPixels; column++) {
+        entry = &decoder->palette[3 * row[column]];
+        rgb[0] = entry[0];
+        rgb[1] = entry[1];
+        rgb[2] = entry[2];
+        rgb += step;
+      } /* for */
+    } else {
+      /* For 16-bit samples the most significant byte is used. */
+      sampleBytes = bitDepth >> 3;
+      pixelBytes = decoder->channels * sampleBytes;
+      if (decoder->colorType == COLOR_TYPE_RGB ||
+          decoder->colorType == COLOR_TYPE_RGB_ALPHA) {
+        if (pixelBytes == 3 && step == 3) {
+          memcpy(rgb, row, 3 * numPixels);
+        } else {
+          for (column = 0; column < numPixels; column++) {
+            rgb[0] = row[0];
+            rgb[1] = row[sampleBytes];
+            rgb[2] = row[2 * sampleBytes];
+            row += pixelBytes;
+            rgb += step;
+          } /* for */
+        } /* if */
+      } else {
+        for (column = 0; column < numPixels; column++) {
+          rgb[0] = row[0];
+          rgb[1] = row[0];
+          rgb[2] = row[0];
+          row += pixelBytes;
+          rgb += step;
+        } /* for */
+      } /* if */
+    } /* if */
+  } /* convertRow */
+
+
+
+static inline memSizeType rowBytes (const pngDecoderRecord *decoder,
+    memSizeType numPixels)
+
+  { /* rowBytes */
+    return (numPixels * decoder->channels * decoder->bitDepth + 7) >> 3;
+  } /* rowBytes */
+
+
+
+static inline ucharType *decoderRow (pngDecoderType decoder,
+    unsigned int rowNumber)
+
+  { /* decoderRow */
+    return (ucharType *) &decoder[1] +
+        rowNumber * (decoder->maxRowBytes + 2 * PNG_ROW_PADDING) +
+        PNG_ROW_PADDING;
+  } /* decoderRow */
+
+
+
+/**
+ *  Determine the dimensions of the next pass that contains pixels.
+ *  For non interlaced images there is just one pass.
+ */
+static void startPass (pngDecoderType decoder, unsigned int pass)
+
+  { /* startPass */
+    decoder->passWidth = 0;
+    decoder->passHeight = 0;
+    if (!decoder->interlaced) {
+      if (pass == 0) {
+        decoder->passWidth = decoder->width;
+        decoder->passHeight = decoder->height;
+      } /* if */
+    } else {
+      while (pass < 7 && (decoder->width <= adam7StartX[pass] ||
+                          decoder->height <= adam7StartY[pass])) {
+        pass++;
+      } /* while */
+      if (pass < 7) {
+        decoder->passWidth = (decoder->width - adam7StartX[pass] +
+                              adam7DeltaX[pass] - 1) / adam7DeltaX[pass];
+        decoder->passHeight = (decoder->height - adam7StartY[pass] +
+                               adam7DeltaY[pass] - 1) / adam7DeltaY[pass];
+      } /* if */
+    } /* if */
+    decoder->pass = pass;
+    decoder->passRow = 0;
+    decoder->rowFill = 0;
+    if (decoder->passWidth == 0) {
+      decoder->complete = TRUE;
+      decoder->passRowBytes = 0;
+    } else {
+      decoder->passRowBytes = rowBytes(decoder, decoder->passWidth);
+      memset(decoderRow(decoder, 1 - decoder->currentRow), 0,
+             decoder->passRowBytes);
+    } /* if */
+  } /* startPass */
+
+
+
+/**
+ *  Take the inflated image data. This function is called by dflInflate().
+ *  Completed rows are unfiltered and written to the RGB data.
+ */
+static boolType takeInflatedData (const ucharType *data, memSizeType length,
+    void *outputData)
+
+  {
+    pngDecoderType decoder;
+    ucharType *row;
+    ucharType *rgb;
+    memSizeType rowEnd;
+    memSizeType chunkLength;
+    memSizeType line;
+    memSizeType column;
+
+  /* takeInflatedData */
+    decoder = ((pngOutputRecord *) outputData)->decoder;
+    rgb = ((pngOutputRecord *) outputData)->rgb;
+    while (length != 0 && !decoder->complete) {
+      if (decoder->rowFill == 0) {
+        decoder->filterType = *data;
+        data++;
+        length--;
+        decoder->rowFill = 1;
+      } else {
+        row = decoderRow(decoder, decoder->currentRow);
+        rowEnd = decoder->passRowBytes + 1;
+        chunkLength = rowEnd - decoder->rowFill;
+        if (chunkLength > length) {
+          chunkLength = length;
+        } /* if */
+        memcpy(&row[decoder->rowFill - 1], data, chunkLength);
+        data += chunkLength;
+        length -= chunkLength;
+        decoder->rowFill += chunkLength;
+        if (decoder->rowFill == rowEnd) {
+          if (unlikely(!unfilterRow(decoder->filterType, row,
+                                    decoderRow(decoder, 1 - decoder->currentRow),
+                                    decoder->passRowBytes, decoder->filterBpp))) {
+            logError(printf("takeInflatedData: Illegal filter type: %u\n",
+                            decoder->filterType););
+            decoder->dataError = TRUE;
+            return FALSE;
+          } /* if */
+          if (decoder->interlaced) {
+            line = adam7StartY[decoder->pass] +
+                   decoder->passRow * adam7DeltaY[decoder->pass];
+            column = adam7StartX[decoder->pass];
+            convertRow(decoder, row, decoder->passWidth,
+                       &rgb[3 * (line * decoder->width + column)],
+                       3 * adam7DeltaX[decoder->pass]);
+          } else {
+            convertRow(decoder, row, decoder->passWidth,
+                       &rgb[3 * decoder->passRow * decoder->width], 3);
+          } /* if */
+          decoder->currentRow = 1 - decoder->currentRow;
+          decoder->rowFill = 0;
+          decoder->passRow++;
+          if (decoder->passRow == decoder->passHeight) {
+            startPass(decoder, decoder->pass + 1);
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* while */
+    return TRUE;
+  } /* takeInflatedData */
+
+
+
+static boolType setupDecoder (pngDecoderType decoder, intType width,
+    intType height, intType bitDepth, intType colorType, intType interlaceMethod)
+
+  {
+    boolType okay;
+
+  /* setupDecoder */
+    switch (colorType) {
+      case COLOR_TYPE_GRAYSCALE:
+        okay = bitDepth == 1 || bitDepth == 2 || bitDepth == 4 ||
+               bitDepth == 8 || bitDepth == 16;
+        decoder->channels = 1;
+        break;
+      case COLOR_TYPE_PALETTE:
+        okay = bitDepth == 1 || bitDepth == 2 || bitDepth == 4 ||
+               bitDepth == 8;
+        decoder->channels = 1;
+        break;
+      case COLOR_TYPE_RGB:
+      case COLOR_TYPE_GRAYSCALE_ALPHA:
+      case COLOR_TYPE_RGB_ALPHA:
+        okay = bitDepth == 8 || bitDepth == 16;
+        decoder->channels = colorType == COLOR_TYPE_RGB ? 3 :
+            (colorType == COLOR_TYPE_RGB_ALPHA ? 4 : 2);
+        break;
+      default:
+        okay = FALSE;
+        break;
+    } /* switch */
+    if (okay && width > 0 && height > 0 &&
+        (interlaceMethod == 0 || interlaceMethod == 1) &&
+        (uintType) width <= (MAX_MEMSIZETYPE - 4 * PNG_ROW_PADDING) / 64 &&
+        (uintType) height <= MAX_MEMSIZETYPE / 3 / (uintType) width) {
+      decoder->magic = PNG_DECODER_MAGIC;
+      decoder->width = (memSizeType) width;
+      decoder->height = (memSizeType) height;
+      decoder->bitDepth = (unsigned int) bitDepth;
+      decoder->colorType = (unsigned int) colorType;
+      decoder->filterBpp = (decoder->channels * decoder->bitDepth + 7) >> 3;
+      decoder->interlaced = interlaceMethod == 1;
+      decoder->maxRowBytes = rowBytes(decoder, decoder->width);
+    } else {
+      okay = FALSE;
+    } /* if */
+    return okay;
+  } /* setupDecoder */
+
+
+
+/**
+ *  Check the state of a decoder.
+ *  @return the decoder or NULL if 'decoderBstri' is not valid.
+ */
+static pngDecoderType getDecoder (bstriType decoderBstri)
+
+  {
+    pngDecoderType decoder;
+    pngDecoderRecord expected;
+
+  /* getDecoder */
+    decoder = (pngDecoderType) alignedState(decoderBstri, sizeof(pngDecoderRecord));
+    if (decoder == NULL || decoder->magic != PNG_DECODER_MAGIC) {
+      return NULL;
+    } /* if */
+    memset(&expected, 0, sizeof(pngDecoderRecord));
+    if (!setupDecoder(&expected, (intType) decoder->width,
+                      (intType) decoder->height, (intType) decoder->bitDepth,
+                      (intType) decoder->colorType, decoder->interlaced) ||
+        expected.channels != decoder->channels ||
+        expected.filterBpp != decoder->filterBpp ||
+        expected.maxRowBytes != decoder->maxRowBytes ||
+        decoderBstri->size != PNG_STATE_ALIGNMENT + sizeof(pngDecoderRecord) +
+            2 * (decoder->maxRowBytes + 2 * PNG_ROW_PADDING) ||
+        decoder->pass > 7 || decoder->currentRow > 1 ||
+        decoder->passWidth > decoder->width ||
+        decoder->passHeight > decoder->height ||
+        decoder->passRowBytes != rowBytes(decoder, decoder->passWidth) ||
+        decoder->passRow > decoder->passHeight ||
+        decoder->rowFill > decoder->passRowBytes + 1 ||
+        !dflInflateIsValid(&decoder->inflater)) {
+      return NULL;
+    } /* if */
+    return decoder;
+  } /* getDecoder */
+
+
+
+/**
+ *  Decode the data of an IDAT chunk of a PNG image.
+ *  The image data of all IDAT chunks is one zlib stream. The IDAT
+ *  chunks are given to pngDecode() in the order of the file. With
+ *  the first call the RGB data is created (with black pixels).
+ *  @param decoder State of the decoding created with pngDecodeInit.
+ *  @param idatData Data of an IDAT chunk.
+ *  @param rgbData RGB data of the image with 3 bytes per pixel.
+ *  @return TRUE if all pixels of the image have been decoded,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If 'decoder' is not a valid decoder state
+ *             or if the image data is corrupted.
+ *  @exception MEMORY_ERROR Not enough memory for the RGB data.
+ */
+boolType pngDecode (bstriType decoderBstri, const const_striType idatData,
+    bstriType *const rgbData)
+
+  {
+    pngDecoderType decoder;
+    memSizeType rgbSize;
+    bstriType rgbBstri;
+    ucharType *data;
+    pngOutputRecord outputRecord;
+    int inflateResult;
+
+  /* pngDecode */
+    logFunction(printf("pngDecode(*, \"" FMT_U_MEM " chars\", *)\n",
+                       idatData->size););
+    if (unlikely((decoder = getDecoder(decoderBstri)) == NULL)) {
+      logError(printf("pngDecode: Illegal decoder state.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    rgbSize = 3 * decoder->width * decoder->height;
+    rgbBstri = *rgbData;
+    if (rgbBstri->size != rgbSize) {
+      if (unlikely(rgbBstri->size != 0)) {
+        logError(printf("pngDecode: Size of RGB data does not fit.\n"););
+        raise_error(RANGE_ERROR);
+        return FALSE;
+      } else if (unlikely(!ALLOC_BSTRI_CHECK_SIZE(rgbBstri, rgbSize))) {
+        raise_error(MEMORY_ERROR);
+        return FALSE;
+      } /* if */
+      rgbBstri->size = rgbSize;
+      memset(rgbBstri->mem, 0, rgbSize);
+      FREE_BSTRI(*rgbData, (*rgbData)->size);
+      *rgbData = rgbBstri;
+    } /* if */
+    if (!decoder->complete && idatData->size != 0) {
+      if (unlikely((data = (ucharType *) malloc(idatData->size)) == NULL)) {
+        raise_error(MEMORY_ERROR);
+        return FALSE;
+      } else if (unlikely(memcpy_from_strelem(data, idatData->mem,
+                                              idatData->size))) {
+        free(data);
+        logError(printf("pngDecode: Character beyond '\\255;' present.\n"););
+        raise_error(RANGE_ERROR);
+        return FALSE;
+      } /* if */
+      outputRecord.decoder = decoder;
+      outputRecord.rgb = rgbBstri->mem;
+      inflateResult = dflInflate(&decoder->inflater, data, idatData->size,
+                                 takeInflatedData, &outputRecord);
+      free(data);
+      if (unlikely(inflateResult == DFL_DATA_ERROR || decoder->dataError)) {
+        logError(printf("pngDecode: Corrupted image data.\n"););
+        raise_error(RANGE_ERROR);
+        return FALSE;
+      } else if (unlikely(inflateResult == DFL_OUTPUT_ERROR)) {
+        raise_error(MEMORY_ERROR);
+        return FALSE;
+      } /* if */
+    } /* if */
+    logFunction(printf("pngDecode --> %d\n", decoder->complete););
+    return decoder->complete;
+  } /* pngDecode */
+
+
+
+/**
+ *  Create the state to decode the image data of a PNG image.
+ *  @param width Width of the image (from the IHDR chunk).
+ *  @param height Height of the image (from the IHDR chunk).
+ *  @param bitDepth Bit depth of the image (from the IHDR chunk).
+ *  @param colorType Color type of the image (from the IHDR chunk).
+ *  @param interlaceMethod 0 (no interlace) or 1 (Adam7 interlace).
+ *  @param palette Data of the PLTE chunk or "" if there is none.
+ *  @return the state of the decoding.
+ *  @exception RANGE_ERROR If the parameters are not valid.
+ *  @exception MEMORY_ERROR Not enough memory for the decoder state.
+ */
+bstriType pngDecodeInit (intType width, intType height, intType bitDepth,
+    intType colorType, intType interlaceMethod, const const_striType palette)
+
+  {
+    pngDecoderRecord header;
+    pngDecoderType decoder;
+    unsigned int numEntries;
+    unsigned int index;
+    unsigned int maxValue;
+    bstriType result;
+
+  /* pngDecodeInit */
+    logFunction(printf("pngDecodeInit(" FMT_D ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", \"" FMT_U_MEM " chars\")\n",
+                       width, height, bitDepth, colorType, interlaceMethod,
+                       palette->size););
+    memset(&header, 0, sizeof(pngDecoderRecord));
+    if (unlikely(!setupDecoder(&header, width, height, bitDepth, colorType,
+                               interlaceMethod))) {
+      logError(printf("pngDecodeInit: Illegal image parameters.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely((result = newStateBstri(sizeof(pngDecoderRecord) +
+        2 * (header.maxRowBytes + 2 * PNG_ROW_PADDING),
+        (void **) &decoder)) == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memcpy(decoder, &header, sizeof(pngDecoderRecord));
+      if (colorType == COLOR_TYPE_PALETTE) {
+        numEntries = palette->size >= 3 * 256 ? 256 :
+            (unsigned int) (palette->size / 3);
+        /* Entries missing in the palette stay black. */
+        for (index = 0; index < 3 * numEntries; index++) {
+          decoder->palette[index] = (ucharType) palette->mem[index];
+        } /* for */
+      } else if (bitDepth < 8) {
+        maxValue = (1U << bitDepth) - 1;
+        for (index = 0; index <= maxValue; index++) {
+          memset(&decoder->palette[3 * index], (int) (255 * index / maxValue), 3);
+        } /* for */
+      } /* if */
+      dflInflateInit(&decoder->inflater, TRUE);
+      startPass(decoder, 0);
+    } /* if */
+    logFunction(printf("pngDecodeInit --> \"" FMT_U_MEM " bytes\"\n",
+                       result != NULL ? result->size : 0););
+    return result;
+  } /* pngDecodeInit */
+
+
+
+/**
+ *  Compute the sum of the absolute values of the bytes in 'row'.
+ *  The bytes are interpreted as signed values.
+ */
+static uint64Type sumOfAbsoluteValues (const ucharType *row,
+    memSizeType length)
+
+  {
+    memSizeType index = 0;
+    uint64Type sum = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i zero;
+    __m128i data;
+    __m128i sums;
+    uint64Type laneSums[2];
+#endif
+
+  /* sumOfAbsoluteValues */
+#if HAS_SSE2_INTRINSICS
+    zero = _mm_setzero_si128();
+    sums = zero;
+    for (; index + 16 <= length; index += 16) {
+      data = _mm_loadu_si128((const __m128i *) &row[index]);
+      data = _mm_min_epu8(data, _mm_sub_epi8(zero, data));
+      sums = _mm_add_epi64(sums, _mm_sad_epu8(data, zero));
+    } /* for */
+    _mm_storeu_si128((__m128i *) laneSums, sums);
+    sum = laneSums[0] + laneSums[1];
+#endif
+    for (; index < length; index++) {
+      sum += row[index] < 128 ? row[index] : 256 - row[index];
+    } /* for */
+    return sum;
+  } /* sumOfAbsoluteValues */
+
+
+
+/**
+ *  Apply the filter 'filterType' to 'row' and write the result to 'filtered'.
+ *  The rows 'row' and 'prior' are preceded by 'bpp' zero bytes.
+ */
+static void filterRow (unsigned int filterType, const ucharType *row,
+    const ucharType *prior, ucharType *filtered, memSizeType length,
+    unsigned int bpp)
+
+  {
+    memSizeType index = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i zero;
+    __m128i one;
+    __m128i left;
+    __m128i up;
+    __m128i upLeft;
+#endif
+
+  /* filterRow */
+    switch (filterType) {
+      case FILTER_SUB:
+#if HAS_SSE2_INTRINSICS
+        for (; index + 16 <= length; index += 16) {
+          _mm_storeu_si128((__m128i *) &filtered[index], _mm_sub_epi8(
+              _mm_loadu_si128((const __m128i *) &row[index]),
+              _mm_loadu_si128((const __m128i *) &row[index - bpp])));
+        } /* for */
+#endif
+        for (; index < length; index++) {
+          filtered[index] = (ucharType) (row[index] - row[index - bpp]);
+        } /* for */
+        break;
+      case FILTER_UP:
+#if HAS_SSE2_INTRINSICS
+        for (; index + 16 <= length; index += 16) {
+          _mm_storeu_si128((__m128i *) &filtered[index], _mm_sub_epi8(
+              _mm_loadu_si128((const __m128i *) &row[index]),
+              _mm_loadu_si128((const __m128i *) &prior[index])));
+        } /* for */
+#endif
+        for (; index < length; index++) {
+          filtered[index] = (ucharType) (row[index] - prior[index]);
+        } /* for */
+        break;
+      case FILTER_AVERAGE:
+#if HAS_SSE2_INTRINSICS
+        one = _mm_set1_epi8(1);
+        for (; index + 16 <= length; index += 16) {
+          left = _mm_loadu_si128((const __m128i *) &row[index - bpp]);
+          up = _mm_loadu_si128((const __m128i *) &prior[index]);
+          _mm_storeu_si128((__m128i *) &filtered[index], _mm_sub_epi8(
+              _mm_loadu_si128((const __m128i *) &row[index]),
+              _mm_sub_epi8(_mm_avg_epu8(left, up),
+                           _mm_and_si128(_mm_xor_si128(left, up), one))));
+        } /* for */
+#endif
+        for (; index < length; index++) {
+          filtered[index] = (ucharType) (row[index] -
+              (((unsigned int) row[index - bpp] + prior[index]) >> 1));
+        } /* for */
+        break;
+      case FILTER_PAETH:
+#if HAS_SSE2_INTRINSICS
+        zero = _mm_setzero_si128();
+        for (; index + 8 <= length; index += 8) {
+          left = _mm_unpacklo_epi8(
+              _mm_loadl_epi64((const __m128i *) &row[index - bpp]), zero);
+          up = _mm_unpacklo_epi8(
+              _mm_loadl_epi64((const __m128i *) &prior[index]), zero);
+          upLeft = _mm_unpacklo_epi8(
+              _mm_loadl_epi64((const __m128i *) &prior[index - bpp]), zero);
+          _mm_storel_epi64((__m128i *) &filtered[index], _mm_sub_epi8(
+              _mm_loadl_epi64((const __m128i *) &row[index]),
+              _mm_packus_epi16(paethPredictor16(left, up, upLeft), zero)));
+        } /* for */
+#endif
+        for (; index < length; index++) {
+          filtered[index] = (ucharType) (row[index] -
+              paethPredictor(row[index - bpp], prior[index], prior[index - bpp]));
+        } /* for */
+        break;
+      default:
+        memcpy(filtered, row, length);
+        break;
+    } /* switch */
+  } /* filterRow */
+
+
+
+static inline ucharType *encoderRow (pngEncoderType encoder,
+    unsigned int rowNumber)
+
+  { /* encoderRow */
+    return (ucharType *) &encoder[1] +
+        rowNumber * (encoder->rowBytes + 2 * PNG_ROW_PADDING) +
+        PNG_ROW_PADDING;
+  } /* encoderRow */
+
+
+
+/**
+ *  Take the deflated image data. This function is called by dflDeflate().
+ */
+static boolType takeDeflatedData (const ucharType *data, memSizeType length,
+    void *outputData)
+
+  {
+    pngEncoderType encoder;
+
+  /* takeDeflatedData */
+    encoder = (pngEncoderType) outputData;
+    if (unlikely(length > PNG_IDAT_BUFFER_SIZE - encoder->idatLength)) {
+      return FALSE;
+    } /* if */
+    memcpy(&encoder->idat[encoder->idatLength], data, length);
+    encoder->idatLength += length;
+    return TRUE;
+  } /* takeDeflatedData */
+
+
+
+/**
+ *  Filter the next row of the image and choose the filter with
+ *  the minimum sum of absolute values (as recommended by the PNG
+ *  specification). Row 0 contains the filtered row and rows 1 and 2
+ *  contain the current and the previous row of the image.
+ */
+static void prepareRow (pngEncoderType encoder, const ucharType *rgb)
+
+  {
+    ucharType *filtered;
+    ucharType *current;
+    ucharType *prior;
+    ucharType *candidate;
+    unsigned int filterType;
+    uint64Type sum;
+    uint64Type bestSum;
+
+  /* prepareRow */
+    filtered = encoderRow(encoder, 0);
+    current = encoderRow(encoder, 1 + (encoder->row & 1));
+    prior = encoderRow(encoder, 2 - (encoder->row & 1));
+    candidate = encoderRow(encoder, 3);
+    memcpy(current, &rgb[encoder->row * encoder->rowBytes], encoder->rowBytes);
+    if (encoder->row == 0) {
+      memset(prior, 0, encoder->rowBytes);
+    } /* if */
+    memcpy(filtered, current, encoder->rowBytes);
+    encoder->filterType = FILTER_NONE;
+    bestSum = sumOfAbsoluteValues(filtered, encoder->rowBytes);
+    for (filterType = FILTER_SUB; filterType < PNG_NUM_FILTERS; filterType++) {
+      filterRow(filterType, current, prior, candidate, encoder->rowBytes, 3);
+      sum = sumOfAbsoluteValues(candidate, encoder->rowBytes);
+      if (sum < bestSum) {
+        bestSum = sum;
+        encoder->filterType = filterType;
+        memcpy(filtered, candidate, encoder->rowBytes);
+      } /* if */
+    } /* for */
+    /* The filter type byte precedes the filtered row. */
+    filtered[-1] = (ucharType) encoder->filterType;
+  } /* prepareRow */
+
+
+
+/**
+ *  Check the state of an encoder.
+ *  @return the encoder or NULL if 'encoderBstri' is not valid.
+ */
+static pngEncoderType getEncoder (bstriType encoderBstri)
+
+  {
+    pngEncoderType encoder;
+
+  /* getEncoder */
+    encoder = (pngEncoderType) alignedState(encoderBstri, sizeof(pngEncoderRecord));
+    if (encoder == NULL || encoder->magic != PNG_ENCODER_MAGIC ||
+        encoder->width == 0 || encoder->height == 0 ||
+        encoder->width > (MAX_MEMSIZETYPE - 4 * PNG_ROW_PADDING) / 3 / 4 ||
+        encoder->rowBytes != 3 * encoder->width ||
+        encoder->height > MAX_MEMSIZETYPE / encoder->rowBytes ||
+        encoderBstri->size != PNG_STATE_ALIGNMENT + sizeof(pngEncoderRecord) +
+            4 * (encoder->rowBytes + 2 * PNG_ROW_PADDING) ||
+        encoder->row > encoder->height ||
+        encoder->rowFill > encoder->rowBytes + 1 ||
+        encoder->filterType >= PNG_NUM_FILTERS ||
+        encoder->idatLength > PNG_IDAT_BUFFER_SIZE ||
+        !dflDeflateIsValid(&encoder->deflater)) {
+      return NULL;
+    } /* if */
+    return encoder;
+  } /* getEncoder */
+
+
+
+/**
+ *  Create an IDAT chunk (length, chunk type, data and CRC-32).
+ *  The data is taken from the start of the IDAT buffer.
+ */
+static striType idatChunk (pngEncoderType encoder, memSizeType length)
+
+  {
+    ucharType header[8];
+    uint32Type crc;
+    strElemType *chunkChars;
+    striType result;
+
+  /* idatChunk */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, length + 12))) {
+      return NULL;
+    } else {
+      result->size = length + 12;
+      chunkChars = result->mem;
+      header[0] = (ucharType) (length >> 24);
+      header[1] = (ucharType) (length >> 16);
+      header[2] = (ucharType) (length >> 8);
+      header[3] = (ucharType) length;
+      memcpy(&header[4], "IDAT", 4);
+      memcpy_to_strelem(chunkChars, header, 8);
+      memcpy_to_strelem(&chunkChars[8], encoder->idat, length);
+      crc = msdCrc32Bytes(0, &header[4], 4);
+      crc = msdCrc32Bytes(crc, encoder->idat, length);
+      chunkChars[length + 8] = (strElemType) (crc >> 24);
+      chunkChars[length + 9] = (strElemType) ((crc >> 16) & 0xff);
+      chunkChars[length + 10] = (strElemType) ((crc >> 8) & 0xff);
+      chunkChars[length + 11] = (strElemType) (crc & 0xff);
+      encoder->idatLength -= length;
+      memmove(encoder->idat, &encoder->idat[length], encoder->idatLength);
+    } /* if */
+    return result;
+  } /* idatChunk */
+
+
+
+/**
+ *  Encode the image data of a PNG image and return the next IDAT chunk.
+ *  Every call encodes just enough rows to fill an IDAT chunk. This
+ *  way the compressed image is never completely in memory. The
+ *  function must be called until it returns "".
+ *  @param encoder State of the encoding created with pngEncodeInit.
+ *  @param rgbData RGB data of the image with 3 bytes per pixel.
+ *  @return the next IDAT chunk (including length and CRC) or ""
+ *          if the whole image has been encoded.
+ *  @exception RANGE_ERROR If 'encoder' is not a valid encoder state
+ *             or if the size of 'rgbData' does not fit.
+ *  @exception MEMORY_ERROR Not enough memory to create the chunk.
+ */
+striType pngEncode (bstriType encoderBstri, const const_bstriType rgbData)
+
+  {
+    pngEncoderType encoder;
+    memSizeType pieceLength;
+    boolType lastPiece;
+    striType result;
+
+  /* pngEncode */
+    logFunction(printf("pngEncode(*, \"" FMT_U_MEM " bytes\")\n",
+                       rgbData->size););
+    if (unlikely((encoder = getEncoder(encoderBstri)) == NULL ||
+                 rgbData->size != encoder->rowBytes * encoder->height)) {
+      logError(printf("pngEncode: Illegal encoder state or RGB data.\n"););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    while (encoder->idatLength < PNG_IDAT_SIZE && !encoder->finished) {
+      if (encoder->rowFill == encoder->rowBytes + 1) {
+        encoder->row++;
+        encoder->rowFill = 0;
+      } /* if */
+      if (encoder->rowFill == 0) {
+        prepareRow(encoder, rgbData->mem);
+      } /* if */
+      pieceLength = encoder->rowBytes + 1 - encoder->rowFill;
+      if (pieceLength > PNG_DEFLATE_PIECE) {
+        pieceLength = PNG_DEFLATE_PIECE;
+      } /* if */
+      lastPiece = encoder->row == encoder->height - 1 &&
+                  encoder->rowFill + pieceLength == encoder->rowBytes + 1;
+      if (unlikely(!dflDeflate(&encoder->deflater,
+                               encoderRow(encoder, 0) - 1 + encoder->rowFill,
+                               pieceLength, lastPiece, takeDeflatedData,
+                               encoder))) {
+        logError(printf("pngEncode: IDAT buffer overflow.\n"););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+      encoder->rowFill += pieceLength;
+      encoder->finished = lastPiece;
+    } /* while */
+    if (encoder->idatLength == 0) {
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, 0))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = 0;
+      } /* if */
+    } else if (unlikely((result = idatChunk(encoder,
+        encoder->idatLength > PNG_IDAT_SIZE ?
+        PNG_IDAT_SIZE : encoder->idatLength)) == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } /* if */
+    logFunction(printf("pngEncode --> \"" FMT_U_MEM " chars\"\n",
+                       result != NULL ? result->size : 0););
+    return result;
+  } /* pngEncode */
+
+
+
+/**
+ *  Create the state to encode an image as 8-bit RGB PNG image.
+ *  The image data is not interlaced.
+ *  @param width Width of the image.
+ *  @param height Height of the image.
+ *  @param level Compression level from 0 (no compression) to
+ *         9 (best compression). A negative level selects the default.
+ *  @return the state of the encoding.
+ *  @exception RANGE_ERROR If width or height are not positive.
+ *  @exception MEMORY_ERROR Not enough memory for the encoder state.
+ */
+bstriType pngEncodeInit (intType width, intType height, intType level)
+
+  {
+    pngEncoderType encoder;
+    memSizeType rowLength;
+    bstriType result;
+
+  /* pngEncodeInit */
+    logFunction(printf("pngEncodeInit(" FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       width, height, level););
+    if (unlikely(width <= 0 || height <= 0 ||
+                 (uintType) width > (MAX_MEMSIZETYPE - 4 * PNG_ROW_PADDING) / 3 / 4 ||
+                 (uintType) height > MAX_MEMSIZETYPE / 3 / (uintType) width)) {
+      logError(printf("pngEncodeInit: Illegal image size.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      rowLength = 3 * (memSizeType) width + 2 * PNG_ROW_PADDING;
+      if (unlikely(rowLength > (MAX_BSTRI_LEN - sizeof(pngEncoderRecord)) / 4 ||
+                   (result = newStateBstri(sizeof(pngEncoderRecord) +
+                                           4 * rowLength,
+                                           (void **) &encoder)) == NULL)) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        encoder->magic = PNG_ENCODER_MAGIC;
+        encoder->width = (memSizeType) width;
+        encoder->height = (memSizeType) height;
+        encoder->rowBytes = 3 * (memSizeType) width;
+        dflDeflateInit(&encoder->deflater,
+                       level < 0 || level > 9 ? PNG_DEFLATE_LEVEL : (int) level,
+                       TRUE);
+      } /* if */
+    } /* if */
+    logFunction(printf("pngEncodeInit --> \"" FMT_U_MEM " bytes\"\n",
+                       result != NULL ? result->size : 0););
+    return result;
+  } /* pngEncodeInit */
@@ -0,0 +1,148 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2024  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/pnglib.c                                        */
+/*  Changes: 2024  Thomas Mertes                                    */
+/*  Content: All primitive actions for PNG images.                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "png_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "pnglib.h"
+
+
+
+/**
+ *  Decode the data arg_2 of an IDAT chunk with the decoder state arg_1.
+ *  The decoded pixels are written to the RGB data arg_3.
+ *  @return TRUE if all pixels of the image have been decoded,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If arg_1 is not a valid decoder state or
+ *             if the image data is corrupted.
+ */
+objectType png_decode (listType arguments)
+
+  {
+    objectType decoder;
+    objectType rgbData;
+
+  /* png_decode */
+    decoder = arg_1(arguments);
+    isit_bstri(decoder);
+    is_variable(decoder);
+    isit_stri(arg_2(arguments));
+    rgbData = arg_3(arguments);
+    isit_bstri(rgbData);
+    is_variable(rgbData);
+    if (pngDecode(take_bstri(decoder), take_stri(arg_2(arguments)),
+                  &rgbData->value.bstriValue)) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* png_decode */
+
+
+
+/**
+ *  Create the state to decode the image data of a PNG image.
+ *  The parameters arg_1 to arg_5 are width, height, bit depth,
+ *  color type and interlace method from the IHDR chunk.
+ *  The palette (PLTE chunk) is given by arg_6.
+ *  @return the state of the decoding.
+ *  @exception RANGE_ERROR If the parameters are not valid.
+ */
+objectType png_decode_init (listType arguments)
+
+  { /* png_decode_init */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_stri(arg_6(arguments));
+    return bld_bstri_temp(
+        pngDecodeInit(take_int(arg_1(arguments)),
+                      take_int(arg_2(arguments)),
+                      take_int(arg_3(arguments)),
+                      take_int(arg_4(arguments)),
+                      take_int(arg_5(arguments)),
+                      take_stri(arg_6(arguments))));
+  } /* png_decode_init */
+
+
+
+/**
+ *  Encode the RGB data arg_2 with the encoder state arg_1.
+ *  @return the next IDAT chunk or "" if the whole image has
+ *          been encoded.
+ *  @exception RANGE_ERROR If arg_1 is not a valid encoder state or
+ *             if the size of the RGB data does not fit.
+ */
+objectType png_encode (listType arguments)
+
+  {
+    objectType encoder;
+
+  /* png_encode */
+    encoder = arg_1(arguments);
+    isit_bstri(encoder);
+    is_variable(encoder);
+    isit_bstri(arg_2(arguments));
+    return bld_stri_temp(
+        pngEncode(take_bstri(encoder), take_bstri(arg_2(arguments))));
+  } /* png_encode */
+
+
+
+/**
+ *  Create the state to encode an image with the width arg_1 and
+ *  the height arg_2 as PNG image. The compression level is arg_3.
+ *  @return the state of the encoding.
+ *  @exception RANGE_ERROR If width or height are not positive.
+ */
+objectType png_encode_init (listType arguments)
+
+  { /* png_encode_init */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_bstri_temp(
+        pngEncodeInit(take_int(arg_1(arguments)),
+                      take_int(arg_2(arguments)),
+                      take_int(arg_3(arguments))));
+  } /* png_encode_init */
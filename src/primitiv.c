@@ -41,7 +41,9 @@
 #include "chrlib.h"
 #include "cmdlib.h"
 #include "conlib.h"
+#include "crylib.h"
 #include "dcllib.h"
+#include "dfllib.h"
 #include "drwlib.h"
 #include "enulib.h"
 #include "fillib.h"
@@ -49,9 +51,12 @@
 #include "hshlib.h"
 #include "intlib.h"
 #include "itflib.h"
+#include "jpglib.h"
 #include "kbdlib.h"
 #include "lstlib.h"
+#include "msdlib.h"
 #include "pcslib.h"
+#include "pnglib.h"
 #include "pollib.h"
 #include "prclib.h"
 #include "prglib.h"
@@ -315,6 +320,11 @@ static const actEntryRecord actEntryTable[] = {
     { "CON_WIDTH",                    con_width,                    },
     { "CON_WRITE",                    con_write,                    },
 
+    { "CRY_CHACHA20_POLY1305_DECODE", cry_chacha20_poly1305_decode, },
+    { "CRY_CHACHA20_POLY1305_ENCODE", cry_chacha20_poly1305_encode, },
+    { "CRY_P256_MULT",                cry_p256_mult,                },
+    { "CRY_X25519",                   cry_x25519,                   },
+
     { "DCL_ATTR",                     dcl_attr,                     },
     { "DCL_CONST",                    dcl_const,                    },
     { "DCL_ELEMENTS",                 dcl_elements,                 },
@@ -337,6 +347,10 @@ static const actEntryRecord actEntryTable[] = {
     { "DCL_VAL1",                     dcl_val1,                     },
     { "DCL_VAL2",                     dcl_val2,                     },
     { "DCL_VAR",                      dcl_var,                      },
+    { "DFL_DEFLATE",                  dfl_deflate,                  },
+    { "DFL_DEFLATE_ARRAY",            dfl_deflate_array,            },
+    { "DFL_INFLATE",                  dfl_inflate,                  },
+    { "DFL_INFLATE_ARRAY",            dfl_inflate_array,            },
 
 #if WITH_DRAW
     { "DRW_ARC",                      drw_arc,                      },
@@ -369,6 +383,8 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_GET_PIXEL_DATA_FROM_ARRAY",drw_get_pixel_data_from_array,},
     { "DRW_GET_PIXMAP",               drw_get_pixmap,               },
     { "DRW_GET_PIXMAP_FROM_PIXELS",   drw_get_pixmap_from_pixels,   },
+    { "DRW_GET_PIXMAP_FROM_RGB",      drw_get_pixmap_from_rgb,      },
+    { "DRW_GET_RGB",                  drw_get_rgb,                  },
     { "DRW_HASHCODE",                 drw_hashcode,                 },
     { "DRW_HEIGHT",                   drw_height,                   },
     { "DRW_LINE",                     drw_line,                     },
@@ -457,6 +473,7 @@ static const actEntryRecord actEntryTable[] = {
     { "FIL_SEEK",                     fil_seek,                     },
     { "FIL_SEEKABLE",                 fil_seekable,                 },
     { "FIL_SETBUF",                   fil_setbuf,                   },
+    { "FIL_SET_READ",                 fil_set_read,                 },
     { "FIL_TELL",                     fil_tell,                     },
     { "FIL_TERMINATED_READ",          fil_terminated_read,          },
     { "FIL_TRUNCATE",                 fil_truncate,                 },
@@ -643,6 +660,8 @@ static const actEntryRecord actEntryTable[] = {
     { "ITF_SELECT",                   itf_select,                   },
     { "ITF_TO_INTERFACE",             itf_to_interface,             },
 
+    { "JPG_DECODE",                   jpg_decode,                   },
+
     { "KBD_GETC",                     kbd_getc,                     },
     { "KBD_GETS",                     kbd_gets,                     },
     { "KBD_INPUT_READY",              kbd_input_ready,              },
@@ -663,6 +682,12 @@ static const actEntryRecord actEntryTable[] = {
     { "LST_RANGE",                    lst_range,                    },
     { "LST_TAIL",                     lst_tail,                     },
 
+    { "MSD_CRC32",                    msd_crc32,                    },
+    { "MSD_FINAL",                    msd_final,                    },
+    { "MSD_INIT",                     msd_init,                     },
+    { "MSD_UPDATE",                   msd_update,                   },
+    { "MSD_UPDATE_BSTRI",             msd_update_bstri,             },
+
     { "PCS_CHILD_STDERR",             pcs_child_stderr,             },
     { "PCS_CHILD_STDIN",              pcs_child_stdin,              },
     { "PCS_CHILD_STDOUT",             pcs_child_stdout,             },
@@ -696,6 +721,10 @@ static const actEntryRecord actEntryTable[] = {
     { "PLT_NE",                       plt_ne,                       },
     { "PLT_POINT_LIST",               plt_point_list,               },
     { "PLT_VALUE",                    plt_value,                    },
+    { "PNG_DECODE",                   png_decode,                   },
+    { "PNG_DECODE_INIT",              png_decode_init,              },
+    { "PNG_ENCODE",                   png_encode,                   },
+    { "PNG_ENCODE_INIT",              png_encode_init,              },
 #endif
 
     { "POL_ADD_CHECK",                pol_add_check,                },
@@ -947,29 +976,41 @@ static const actEntryRecord actEntryTable[] = {
     { "SOC_WRITE",                    soc_write,                    },
 
 #if WITH_SQL
+    { "SQL_BIND_BATCH_ROW",           sql_bind_batch_row,           },
     { "SQL_BIND_BIGINT",              sql_bind_bigint,              },
     { "SQL_BIND_BIGRAT",              sql_bind_bigrat,              },
     { "SQL_BIND_BOOL",                sql_bind_bool,                },
     { "SQL_BIND_BSTRI",               sql_bind_bstri,               },
     { "SQL_BIND_DURATION",            sql_bind_duration,            },
     { "SQL_BIND_FLOAT",               sql_bind_float,               },
+    { "SQL_BIND_FLOAT_ARRAY",         sql_bind_float_array,         },
     { "SQL_BIND_INT",                 sql_bind_int,                 },
+    { "SQL_BIND_INT_ARRAY",           sql_bind_int_array,           },
     { "SQL_BIND_NULL",                sql_bind_null,                },
     { "SQL_BIND_STRI",                sql_bind_stri,                },
+    { "SQL_BIND_STRI_ARRAY",          sql_bind_stri_array,          },
     { "SQL_BIND_TIME",                sql_bind_time,                },
     { "SQL_CLOSE",                    sql_close,                    },
     { "SQL_CMP_DB",                   sql_cmp_db,                   },
     { "SQL_CMP_STMT",                 sql_cmp_stmt,                 },
+    { "SQL_COLLECT_COLUMN",           sql_collect_column,           },
     { "SQL_COLUMN_BIGINT",            sql_column_bigint,            },
     { "SQL_COLUMN_BIGRAT",            sql_column_bigrat,            },
     { "SQL_COLUMN_BOOL",              sql_column_bool,              },
     { "SQL_COLUMN_BSTRI",             sql_column_bstri,             },
     { "SQL_COLUMN_DURATION",          sql_column_duration,          },
     { "SQL_COLUMN_FLOAT",             sql_column_float,             },
+    { "SQL_COLUMN_FLOAT_ARRAY",       sql_column_float_array,       },
     { "SQL_COLUMN_INT",               sql_column_int,               },
+    { "SQL_COLUMN_INT_ARRAY",         sql_column_int_array,         },
     { "SQL_COLUMN_STRI",              sql_column_stri,              },
+    { "SQL_COLUMN_STRI_ARRAY",        sql_column_stri_array,        },
     { "SQL_COLUMN_TIME",              sql_column_time,              },
     { "SQL_COMMIT",                   sql_commit,                   },
+    { "SQL_COPY_END",                 sql_copy_end,                 },
+    { "SQL_COPY_GET",                 sql_copy_get,                 },
+    { "SQL_COPY_PUT",                 sql_copy_put,                 },
+    { "SQL_COPY_START",               sql_copy_start,               },
     { "SQL_CPY_DB",                   sql_cpy_db,                   },
     { "SQL_CPY_STMT",                 sql_cpy_stmt,                 },
     { "SQL_CREATE_DB",                sql_create_db,                },
@@ -986,7 +1027,9 @@ static const actEntryRecord actEntryTable[] = {
     { "SQL_ERR_LIB_FUNC",             sql_err_lib_func,             },
     { "SQL_ERR_MESSAGE",              sql_err_message,              },
     { "SQL_EXECUTE",                  sql_execute,                  },
+    { "SQL_EXECUTE_BATCH",            sql_execute_batch,            },
     { "SQL_FETCH",                    sql_fetch,                    },
+    { "SQL_FETCH_ROWS",               sql_fetch_rows,               },
     { "SQL_GET_AUTO_COMMIT",          sql_get_auto_commit,          },
     { "SQL_IS_NULL",                  sql_is_null,                  },
     { "SQL_NE_DB",                    sql_ne_db,                    },
@@ -1009,6 +1052,7 @@ static const actEntryRecord actEntryTable[] = {
 #endif
 
     { "STR_APPEND",                   str_append,                   },
+    { "STR_APPEND_INT",               str_append_int,               },
     { "STR_CAT",                      str_cat,                      },
     { "STR_CHIPOS",                   str_chipos,                   },
     { "STR_CHPOS",                    str_chpos,                    },
@@ -1018,6 +1062,7 @@ static const actEntryRecord actEntryTable[] = {
  /* { "STR_CNT",                      str_cnt,                      }, */
     { "STR_CPY",                      str_cpy,                      },
     { "STR_CREATE",                   str_create,                   },
+    { "STR_CSV_FIELDS",               str_csv_fields,               },
     { "STR_DESTR",                    str_destr,                    },
     { "STR_ELEMCPY",                  str_elemcpy,                  },
     { "STR_EQ",                       str_eq,                       },
@@ -1031,6 +1076,8 @@ static const actEntryRecord actEntryTable[] = {
     { "STR_HEAD",                     str_head,                     },
     { "STR_IDX",                      str_idx,                      },
     { "STR_IPOS",                     str_ipos,                     },
+    { "STR_JSON_NUMBER_END",          str_json_number_end,          },
+    { "STR_JSON_STRING_END",          str_json_string_end,          },
     { "STR_LE",                       str_le,                       },
     { "STR_LIT",                      str_lit,                      },
     { "STR_LNG",                      str_lng,                      },
@@ -1098,6 +1145,7 @@ static const actEntryRecord actEntryTable[] = {
     { "UT8_GETS",                     ut8_gets,                     },
     { "UT8_LINE_READ",                ut8_line_read,                },
     { "UT8_SEEK",                     ut8_seek,                     },
+    { "UT8_SET_READ",                 ut8_set_read,                 },
     { "UT8_WORD_READ",                ut8_word_read,                },
     { "UT8_WRITE",                    ut8_write,                    },
   };
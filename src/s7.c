@@ -59,11 +59,16 @@
 #include "flt_rtl.h"
 #include "arr_rtl.h"
 #include "cmd_rtl.h"
+#include "cmd_drv.h"
 #include "str_rtl.h"
 #include "sql_rtl.h"
 #include "con_rtl.h"
 #include "con_drv.h"
+#include "fil_rtl.h"
 #include "fil_drv.h"
+#include "pcs_rtl.h"
+#include "pcs_drv.h"
+#include "libpath.h"
 #include "big_drv.h"
 #include "drw_drv.h"
 
@@ -74,6 +79,16 @@ typedef struct {
 typedef HINSTANCE__ *HINSTANCE;
 #endif
 
+#ifndef EXECUTABLE_FILE_EXTENSION
+#define EXECUTABLE_FILE_EXTENSION ""
+#endif
+#ifndef LINKED_PROGRAM_EXTENSION
+#define LINKED_PROGRAM_EXTENSION EXECUTABLE_FILE_EXTENSION
+#endif
+
+#define SOURCE_FILE_EXTENSION "sd7"
+#define NATIVE_TIER_COMPILER  "s7c"
+
 #define VERSION_INFO "SEED7 INTERPRETER Version 5.2.%d  Copyright (c) 1990-2024 Thomas Mertes\n"
 
 
@@ -108,6 +123,9 @@ static void writeHelp (void)
     printf("  -d   Equivalent to -da\n");
     printf("  -i   Show the identifier table after the analysis phase.\n");
     printf("  -l   Add a directory to the include library search path (e.g.: -l ../lib).\n");
+    printf("  -n   Tiered execution: Execute the compiled program, if it is up to date.\n");
+    printf("       Otherwise interpret the program and compile it in the background,\n");
+    printf("       when a function has been called often.\n");
     printf("  -p   Specify a protocol file, for trace output (e.g.: -p prot.txt).\n");
     printf("  -q   Compile quiet. Line and file information and compilation\n");
     printf("       statistics are suppressed.\n");
@@ -131,6 +149,254 @@ static void writeHelp (void)
 
 
 
+static striType nativeCompiler = NULL;
+static rtlArrayType nativeCompilerParams = NULL;
+
+
+
+/**
+ *  Create the path of a file in the directory of ''path''.
+ *  The name of the new file consists of ''prefix'', the file name
+ *  of ''path'' without its last ''extensionLength'' characters and
+ *  ''suffix''. If ''extensionLength'' is greater than the length of
+ *  the file name the file name of ''path'' is omitted.
+ *  @return the new path or NULL if there is not enough memory.
+ */
+static striType derivedFilePath (const const_striType path,
+    memSizeType extensionLength, const const_cstriType prefix,
+    const const_cstriType suffix)
+
+  {
+    memSizeType dirLength;
+    memSizeType nameLength;
+    memSizeType prefixLength;
+    memSizeType suffixLength;
+    memSizeType length;
+    striType filePath;
+
+  /* derivedFilePath */
+    dirLength = path->size;
+    while (dirLength > 0 && path->mem[dirLength - 1] != '/') {
+      dirLength--;
+    } /* while */
+    if (path->size - dirLength <= extensionLength) {
+      nameLength = 0;
+    } else {
+      nameLength = path->size - dirLength - extensionLength;
+    } /* if */
+    prefixLength = strlen(prefix);
+    suffixLength = strlen(suffix);
+    length = dirLength + prefixLength + nameLength + suffixLength;
+    if (ALLOC_STRI_CHECK_SIZE(filePath, length)) {
+      filePath->size = length;
+      memcpy(filePath->mem, path->mem, dirLength * sizeof(strElemType));
+      memcpy_to_strelem(&filePath->mem[dirLength],
+                        (const_ustriType) prefix, prefixLength);
+      memcpy(&filePath->mem[dirLength + prefixLength], &path->mem[dirLength],
+             nameLength * sizeof(strElemType));
+      memcpy_to_strelem(&filePath->mem[dirLength + prefixLength + nameLength],
+                        (const_ustriType) suffix, suffixLength);
+    } /* if */
+    return filePath;
+  } /* derivedFilePath */
+
+
+
+static boolType hasSourceFileExtension (const const_striType path)
+
+  {
+    memSizeType extensionStart;
+    memSizeType pos;
+    boolType hasExtension = FALSE;
+
+  /* hasSourceFileExtension */
+    if (path->size > STRLEN("." SOURCE_FILE_EXTENSION)) {
+      extensionStart = path->size - STRLEN(SOURCE_FILE_EXTENSION);
+      hasExtension = path->mem[extensionStart - 1] == '.';
+      for (pos = 0; hasExtension && pos < STRLEN(SOURCE_FILE_EXTENSION); pos++) {
+        hasExtension = path->mem[extensionStart + pos] ==
+                       (strElemType) SOURCE_FILE_EXTENSION[pos];
+      } /* for */
+    } /* if */
+    return hasExtension;
+  } /* hasSourceFileExtension */
+
+
+
+static boolType fileExists (const const_striType path, const const_cstriType prefix,
+    const const_cstriType suffix)
+
+  {
+    striType filePath;
+    boolType exists = FALSE;
+
+  /* fileExists */
+    filePath = derivedFilePath(path, STRLEN("." SOURCE_FILE_EXTENSION), prefix, suffix);
+    if (filePath != NULL) {
+      exists = fileModificationTime(filePath) != 0;
+      FREE_STRI(filePath, filePath->size);
+    } /* if */
+    return exists;
+  } /* fileExists */
+
+
+
+/**
+ *  Determine if the compiler can write the compiled program.
+ *  The error files of the C compiler and the linker exist while
+ *  they are running. When the compilation succeeded they are removed.
+ *  @return TRUE if no compilation of the program is running or failed.
+ */
+static boolType nativeTierBuildFinished (const const_striType programPath)
+
+  { /* nativeTierBuildFinished */
+    return !fileExists(programPath, "tmp_", ".cerrs") &&
+           !fileExists(programPath, "tmp_", ".lerrs");
+  } /* nativeTierBuildFinished */
+
+
+
+/**
+ *  Start the compilation of the program in the background.
+ *  This function is called by the interpreter, when a function
+ *  has been called HOT_FUNCTION_CALLS times. The compiler writes
+ *  the executable to the directory of the program. Later runs of
+ *  the program with the option -n execute it.
+ */
+static void startNativeCompile (const_objectType hotFunction)
+
+  {
+    const_striType programPath;
+    striType cSourceFile;
+    boolType buildRunning = FALSE;
+    fileRecord nullFile = {NULL, 0, FALSE, FALSE};
+    processType process;
+
+  /* startNativeCompile */
+    logFunction(printf("startNativeCompile\n"););
+    programPath = prog->program_path;
+    cSourceFile = derivedFilePath(programPath, STRLEN("." SOURCE_FILE_EXTENSION),
+                                  "tmp_", ".c");
+    if (cSourceFile != NULL) {
+      /* A C file newer than the program is written by a running compiler. */
+      buildRunning = fileModificationTime(cSourceFile) > prog->source_time;
+      FREE_STRI(cSourceFile, cSourceFile->size);
+    } /* if */
+    if (!buildRunning && nativeCompiler != NULL && nativeCompilerParams != NULL &&
+        fileModificationTime(nativeCompiler) != 0 &&
+        nativeTierBuildFinished(programPath)) {
+      process = pcsStart(nativeCompiler, nativeCompilerParams,
+                         &nullFile, &nullFile, &nullFile);
+      if (process != NULL) {
+        /* The compiler keeps running when the interpreter terminates. */
+        pcsDestr(process);
+      } /* if */
+      if (fail_flag) {
+        /* The program is interpreted, if the compiler cannot be started. */
+        leaveExceptionHandling();
+      } /* if */
+    } /* if */
+    logFunction(printf("startNativeCompile -->\n"););
+  } /* startNativeCompile */
+
+
+
+/**
+ *  Prepare the tiered execution of the program.
+ *  The compiled program is executed, if it is newer than the
+ *  source files of the program and no compilation is running.
+ *  Otherwise the command to compile the program is prepared and
+ *  FALSE is returned. In this case the program is interpreted.
+ *  @param arg_0 Name of the interpreter as given in the command line.
+ *  @param exitValue Address to which the exit value of the compiled
+ *         program is assigned.
+ *  @return TRUE if the compiled program has been executed,
+ *          FALSE otherwise.
+ */
+static boolType executeNativeTier (const const_progType currentProg,
+    const optionType option, const const_striType arg_0, int *exitValue)
+
+  {
+    const_striType programPath;
+    striType nativeProgram;
+    striType interpreterPath;
+    memSizeType argc;
+    memSizeType numLibraryDirs;
+    memSizeType pos;
+    processType process;
+    rtlArrayType parameters;
+    boolType executed = FALSE;
+
+  /* executeNativeTier */
+    logFunction(printf("executeNativeTier\n"););
+    programPath = currentProg->program_path;
+    if (hasSourceFileExtension(programPath)) {
+      nativeProgram = derivedFilePath(programPath, STRLEN("." SOURCE_FILE_EXTENSION),
+                                      "", LINKED_PROGRAM_EXTENSION);
+      if (nativeProgram != NULL) {
+        if (fileModificationTime(nativeProgram) > currentProg->source_time &&
+            nativeTierBuildFinished(programPath)) {
+          if (option->argv != NULL) {
+            argc = arraySize(option->argv) - option->argvStart;
+          } else {
+            argc = 0;
+          } /* if */
+          if (ALLOC_RTL_ARRAY(parameters, argc)) {
+            parameters->min_position = 1;
+            parameters->max_position = (intType) argc;
+            if (argc != 0) {
+              /* The strings are not copied. They belong to option->argv. */
+              memcpy(parameters->arr, &option->argv->arr[option->argvStart],
+                     argc * sizeof(rtlObjectType));
+            } /* if */
+            fflush(stdout);
+            process = pcsStart(nativeProgram, parameters, &stdinFileRecord,
+                               &stdoutFileRecord, &stderrFileRecord);
+            if (process != NULL) {
+              pcsWaitFor(process);
+              *exitValue = (int) pcsExitValue(process);
+              pcsDestr(process);
+              executed = !fail_flag;
+            } /* if */
+            if (fail_flag) {
+              leaveExceptionHandling();
+            } /* if */
+            FREE_RTL_ARRAY(parameters, argc);
+          } /* if */
+        } /* if */
+        FREE_STRI(nativeProgram, nativeProgram->size);
+      } /* if */
+      if (!executed && arg_0 != NULL &&
+          (interpreterPath = getExecutablePath(arg_0)) != NULL) {
+        /* The compiler is in the directory of the interpreter. */
+        nativeCompiler = derivedFilePath(interpreterPath, interpreterPath->size,
+            NATIVE_TIER_COMPILER EXECUTABLE_FILE_EXTENSION, "");
+        FREE_STRI(interpreterPath, interpreterPath->size);
+        numLibraryDirs = option->libraryDirs != NULL ?
+                         arraySize(option->libraryDirs) : 0;
+        if (nativeCompiler != NULL &&
+            ALLOC_RTL_ARRAY(nativeCompilerParams, 2 * numLibraryDirs + 3)) {
+          nativeCompilerParams->min_position = 1;
+          nativeCompilerParams->max_position = (intType) (2 * numLibraryDirs + 3);
+          nativeCompilerParams->arr[0].value.striValue = cstri_to_stri("-O2");
+          nativeCompilerParams->arr[1].value.striValue = cstri_to_stri("-oc3");
+          for (pos = 0; pos < numLibraryDirs; pos++) {
+            nativeCompilerParams->arr[2 * pos + 2].value.striValue = cstri_to_stri("-l");
+            nativeCompilerParams->arr[2 * pos + 3].value.striValue =
+                strCreate(option->libraryDirs->arr[pos].value.striValue);
+          } /* for */
+          nativeCompilerParams->arr[2 * numLibraryDirs + 2].value.striValue =
+              strCreate(programPath);
+          hotFunctionHandler = &startNativeCompile;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("executeNativeTier --> %d\n", executed););
+    return executed;
+  } /* executeNativeTier */
+
+
+
 #if ANY_LOG_ACTIVE
 static void printArray (const const_rtlArrayType array)
 
@@ -250,6 +516,10 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
             case 'i':
               option->parserOptions |= SHOW_IDENT_TABLE;
               break;
+            case 'n':
+              option->parserOptions |= TIERED_EXECUTION;
+              option->execOptions   |= TIERED_EXECUTION;
+              break;
             case 'p':
               if (position < arg_v->max_position - 1) {
                 arg_v->arr[position].value.striValue = NULL;
@@ -392,7 +662,9 @@ int main (int argc, char **argv)
 
   {
     rtlArrayType arg_v;
+    striType arg_0 = NULL;
     progType currentProg;
+    int exitValue = 0;
     optionRecord option = {
         NULL,  /* sourceFileArgument */
         NULL,  /* protFileName       */
@@ -413,9 +685,9 @@ int main (int argc, char **argv)
     setupFiles();
     set_protfile_name(NULL);
 #ifdef USE_WINMAIN
-    arg_v = getArgv(0, NULL, NULL, NULL, NULL);
+    arg_v = getArgv(0, NULL, &arg_0, NULL, NULL);
 #else
-    arg_v = getArgv(argc, argv, NULL, NULL, NULL);
+    arg_v = getArgv(argc, argv, &arg_0, NULL, NULL);
 #endif
     if (arg_v == NULL) {
       printf(VERSION_INFO, LEVEL);
@@ -458,6 +730,11 @@ int main (int argc, char **argv)
               if (currentProg->main_object == NULL ||
                   CATEGORY_OF_OBJ(currentProg->main_object) == FORWARDOBJECT) {
                 printf("*** Declaration for main missing\n");
+              } else if ((option.execOptions & TIERED_EXECUTION) != 0 &&
+                         currentProg->error_count == 0 &&
+                         executeNativeTier(currentProg, &option, arg_0,
+                                           &exitValue)) {
+                /* The compiled program has been executed. */
               } else {
                 interpret(currentProg, option.argv, option.argvStart,
                           option.execOptions, option.protFileName);
@@ -483,14 +760,17 @@ int main (int argc, char **argv)
         freeOptions(&option);
       } /* if */
     } /* if */
+    if (arg_0 != NULL) {
+      FREE_STRI(arg_0, arg_0->size);
+    } /* if */
     /* getchar(); */
     /* heapStatistic(); */
 #if CHECK_STACK
     printf("max_stack_size: " FMT_U_MEM "\n", getMaxStackSize());
 #endif
-    logFunction(printf("main --> 0\n"););
+    logFunction(printf("main --> %d\n", exitValue););
 #ifdef USE_DO_EXIT
-    doExit(0);
+    doExit(exitValue);
 #endif
-    return 0;
+    return exitValue;
   } /* main */
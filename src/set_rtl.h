@@ -39,6 +39,14 @@
 #define bitset_pos(number) ((number)<0?~(~(number)>>bitset_shift):(number)>>bitset_shift)
 #endif
 
+/* Check if the character ch is an element of aSet without a call */
+/* of setElem(). The character must not be EOF.                    */
+#define charIsSetElem(ch, aSet) \
+    ((intType) ((ch) >> bitset_shift) >= (aSet)->min_position && \
+     (intType) ((ch) >> bitset_shift) <= (aSet)->max_position && \
+     ((aSet)->bitset[bitsetIndex(aSet, (ch) >> bitset_shift)] >> \
+      ((ch) & bitset_mask) & 1) != 0)
+
 #if TWOS_COMPLEMENT_INTTYPE
 #define lowestBitsetPosAsInteger(bitset_pos) ((bitset_pos) << bitset_shift)
 #else
@@ -68,6 +68,13 @@ typedef struct {
     SQLLEN       length;
   } resultDataRecordCli, *resultDataType;
 
+typedef struct {
+    SQLSMALLINT  c_type;
+    memSizeType  element_size;
+    void        *buffer;
+    SQLLEN      *length;
+  } batchDataRecordCli, *batchDataType;
+
 
 typedef struct fetchDataStruct *fetchDataType;
 
@@ -80,6 +87,8 @@ typedef struct fetchDataStruct {
 typedef struct {
     uintType        usage_count;
     sqlFuncType     sqlFunc;
+    sqlBatchRecord  batch;
+    sqlBatchRecord  fetched;
     dbType          db;
     SQLHSTMT        ppStmt;
     memSizeType     param_array_size;
@@ -156,6 +165,11 @@ static sqlFuncType sqlFunc = NULL;
 #ifndef SQL_XML
 #define SQL_XML -370
 #endif
+#ifndef SQL_ATTR_PARAMSET_SIZE
+#define SQL_ATTR_PARAM_BIND_TYPE 18
+#define SQL_ATTR_PARAMSET_SIZE 22
+#define SQL_PARAM_BIND_BY_COLUMN 0UL
+#endif
 
 typedef struct {
     SQLUSMALLINT hour;
@@ -326,6 +340,10 @@ typedef SQLRETURN (STDCALL *tp_SQLSetEnvAttr) (SQLHENV    environmentHandle,
                                                SQLINTEGER attribute,
                                                SQLPOINTER value,
                                                SQLINTEGER stringLength);
+typedef SQLRETURN (STDCALL *tp_SQLSetStmtAttrW) (SQLHSTMT   statementHandle,
+                                                 SQLINTEGER attribute,
+                                                 SQLPOINTER value,
+                                                 SQLINTEGER stringLength);
 
 static tp_SQLAllocHandle     ptr_SQLAllocHandle;
 static tp_SQLBindCol         ptr_SQLBindCol;
@@ -356,6 +374,7 @@ static tp_SQLPrepareW        ptr_SQLPrepareW;
 static tp_SQLSetConnectAttrW ptr_SQLSetConnectAttrW;
 static tp_SQLSetDescFieldW   ptr_SQLSetDescFieldW;
 static tp_SQLSetEnvAttr      ptr_SQLSetEnvAttr;
+static tp_SQLSetStmtAttrW    ptr_SQLSetStmtAttrW;
 
 #define SQLAllocHandle     ptr_SQLAllocHandle
 #define SQLBindCol         ptr_SQLBindCol
@@ -386,6 +405,7 @@ static tp_SQLSetEnvAttr      ptr_SQLSetEnvAttr;
 #define SQLSetConnectAttrW ptr_SQLSetConnectAttrW
 #define SQLSetDescFieldW   ptr_SQLSetDescFieldW
 #define SQLSetEnvAttr      ptr_SQLSetEnvAttr
+#define SQLSetStmtAttrW    ptr_SQLSetStmtAttrW
 
 
 
@@ -440,7 +460,8 @@ static boolType setupDll (const char *dllName)
             (SQLPrepareW        = (tp_SQLPrepareW)        dllFunc(dbDll, "SQLPrepareW"))        == NULL ||
             (SQLSetConnectAttrW = (tp_SQLSetConnectAttrW) dllFunc(dbDll, "SQLSetConnectAttrW")) == NULL ||
             (SQLSetDescFieldW   = (tp_SQLSetDescFieldW)   dllFunc(dbDll, "SQLSetDescFieldW"))   == NULL ||
-            (SQLSetEnvAttr      = (tp_SQLSetEnvAttr)      dllFunc(dbDll, "SQLSetEnvAttr"))      == NULL) {
+            (SQLSetEnvAttr      = (tp_SQLSetEnvAttr)      dllFunc(dbDll, "SQLSetEnvAttr"))      == NULL ||
+            (SQLSetStmtAttrW    = (tp_SQLSetStmtAttrW)    dllFunc(dbDll, "SQLSetStmtAttrW"),    FALSE)) {
           dbDll = NULL;
         } /* if */
       } /* if */
@@ -5212,6 +5233,272 @@ static void sqlExecute (sqlStmtType sqlStatement)
 
 
 
+static boolType batchColumnFitsParam (const sqlBatchColumnRecord *batchColumn,
+    SQLSMALLINT dataType)
+
+  {
+    boolType fits;
+
+  /* batchColumnFitsParam */
+    switch (dataType) {
+      case SQL_BIT:
+      case SQL_TINYINT:
+      case SQL_SMALLINT:
+      case SQL_INTEGER:
+      case SQL_BIGINT:
+        fits = batchColumn->type == SQL_BATCH_INT;
+        break;
+      case SQL_REAL:
+      case SQL_FLOAT:
+      case SQL_DOUBLE:
+      case SQL_DECIMAL:
+      case SQL_NUMERIC:
+        fits = batchColumn->type == SQL_BATCH_INT ||
+               batchColumn->type == SQL_BATCH_FLOAT;
+        break;
+      case SQL_CHAR:
+      case SQL_VARCHAR:
+      case SQL_LONGVARCHAR:
+      case SQL_WCHAR:
+      case SQL_WVARCHAR:
+      case SQL_WLONGVARCHAR:
+      case SQL_CLOB:
+        fits = batchColumn->type == SQL_BATCH_STRI;
+        break;
+      default:
+        fits = FALSE;
+        break;
+    } /* switch */
+    return fits;
+  } /* batchColumnFitsParam */
+
+
+
+static void freeBatchData (batchDataType batchData, memSizeType numColumns,
+    memSizeType numRows)
+
+  {
+    memSizeType column;
+
+  /* freeBatchData */
+    for (column = 0; column < numColumns; column++) {
+      free(batchData[column].buffer);
+      if (batchData[column].length != NULL) {
+        FREE_TABLE(batchData[column].length, SQLLEN, numRows);
+      } /* if */
+    } /* for */
+    FREE_TABLE(batchData, batchDataRecordCli, numColumns);
+  } /* freeBatchData */
+
+
+
+/**
+ *  Copy the values of a batch column into a column-wise parameter array.
+ */
+static errInfoType fillBatchData (batchDataType batchData,
+    const sqlBatchColumnRecord *batchColumn, memSizeType numRows)
+
+  {
+    memSizeType row;
+    memSizeType maxSize = 0;
+    memSizeType length;
+    SQLWCHAR *wstri;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* fillBatchData */
+    switch (batchColumn->type) {
+      case SQL_BATCH_INT:
+        batchData->c_type = SQL_C_SBIGINT;
+        batchData->element_size = sizeof(int64Type);
+        if (unlikely(numRows > MAX_MEMSIZETYPE / sizeof(int64Type) ||
+                     (batchData->buffer = malloc(numRows * sizeof(int64Type))) == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          for (row = 0; row < numRows; row++) {
+            ((int64Type *) batchData->buffer)[row] =
+                (int64Type) batchColumn->data.intValues[row];
+          } /* for */
+        } /* if */
+        break;
+      case SQL_BATCH_FLOAT:
+        batchData->c_type = SQL_C_DOUBLE;
+        batchData->element_size = sizeof(double);
+        if (unlikely(numRows > MAX_MEMSIZETYPE / sizeof(double) ||
+                     (batchData->buffer = malloc(numRows * sizeof(double))) == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          for (row = 0; row < numRows; row++) {
+            ((double *) batchData->buffer)[row] =
+                (double) batchColumn->data.floatValues[row];
+          } /* for */
+        } /* if */
+        break;
+      case SQL_BATCH_STRI:
+        batchData->c_type = SQL_C_WCHAR;
+        for (row = 0; row < numRows; row++) {
+          if (batchColumn->data.striValues[row]->size > maxSize) {
+            maxSize = batchColumn->data.striValues[row]->size;
+          } /* if */
+        } /* for */
+        if (unlikely(maxSize > MAX_SQLWSTRI_LEN / SURROGATE_PAIR_FACTOR - 1 ||
+                     SIZ_SQLWSTRI(SURROGATE_PAIR_FACTOR * maxSize + 1) >
+                         (memSizeType) SQLLEN_MAX)) {
+          /* It is not possible to compute the memory size. */
+          err_info = MEMORY_ERROR;
+        } else {
+          batchData->element_size = SIZ_SQLWSTRI(SURROGATE_PAIR_FACTOR * maxSize + 1);
+          if (unlikely(numRows > MAX_MEMSIZETYPE / batchData->element_size ||
+                       (batchData->buffer = malloc(numRows * batchData->element_size)) == NULL ||
+                       !ALLOC_TABLE(batchData->length, SQLLEN, numRows))) {
+            err_info = MEMORY_ERROR;
+          } else {
+            for (row = 0; row < numRows && err_info == OKAY_NO_ERROR; row++) {
+              wstri = (SQLWCHAR *) &((char *) batchData->buffer)[row * batchData->element_size];
+              length = copy_to_sqlwstri(wstri, batchColumn->data.striValues[row], &err_info);
+              wstri[length] = '\0';
+              batchData->length[row] = (SQLLEN) (length * sizeof(SQLWCHAR));
+            } /* for */
+          } /* if */
+        } /* if */
+        break;
+      default:
+        err_info = RANGE_ERROR;
+        break;
+    } /* switch */
+    return err_info;
+  } /* fillBatchData */
+
+
+
+/**
+ *  Execute a prepared statement for every row of a batch.
+ *  The batch is bound as column-wise parameter arrays and sent to
+ *  the database with a single SQLExecute(). After the batch has been
+ *  executed the parameters are unbound.
+ *  @return TRUE if the batch has been executed, or
+ *          FALSE if the batch cannot be bound as parameter arrays.
+ */
+static boolType sqlExecuteBatch (sqlStmtType sqlStatement,
+    const_sqlBatchType batch)
+
+  {
+    preparedStmtType preparedStmt;
+    memSizeType column;
+    batchDataType batchData = NULL;
+    bindDataType param;
+    SQLRETURN execute_result;
+    boolType executed = TRUE;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlExecuteBatch */
+    logFunction(printf("sqlExecuteBatch(" FMT_U_MEM ", " FMT_U_MEM " rows)\n",
+                       (memSizeType) sqlStatement, batch->numRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (!FUNCTION_PRESENT(SQLSetStmtAttrW) ||
+        batch->numColumns != preparedStmt->param_array_size ||
+        batch->numRows > (memSizeType) SQLLEN_MAX) {
+      executed = FALSE;
+    } else {
+      for (column = 0; column < batch->numColumns && executed; column++) {
+        executed = batchColumnFitsParam(&batch->columns[column],
+            preparedStmt->param_array[column].dataType);
+      } /* for */
+    } /* if */
+    if (executed) {
+      if (preparedStmt->executeSuccessful) {
+        if (unlikely(SQLFreeStmt(preparedStmt->ppStmt, SQL_CLOSE) != SQL_SUCCESS)) {
+          setDbErrorMsg("sqlExecuteBatch", "SQLFreeStmt",
+                        SQL_HANDLE_STMT, preparedStmt->ppStmt);
+          logError(printf("sqlExecuteBatch: SQLFreeStmt SQL_CLOSE:\n%s\n",
+                          dbError.message););
+          err_info = DATABASE_ERROR;
+        } else {
+          preparedStmt->executeSuccessful = FALSE;
+          freePrefetched(preparedStmt);
+        } /* if */
+      } /* if */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        if (unlikely(!ALLOC_TABLE(batchData, batchDataRecordCli, batch->numColumns))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          memset(batchData, 0, batch->numColumns * sizeof(batchDataRecordCli));
+          for (column = 0; column < batch->numColumns &&
+               err_info == OKAY_NO_ERROR; column++) {
+            err_info = fillBatchData(&batchData[column], &batch->columns[column],
+                                     batch->numRows);
+            if (likely(err_info == OKAY_NO_ERROR)) {
+              param = &preparedStmt->param_array[column];
+              if (unlikely(SQLBindParameter(preparedStmt->ppStmt,
+                                            (SQLUSMALLINT) (column + 1),
+                                            SQL_PARAM_INPUT,
+                                            batchData[column].c_type,
+                                            param->dataType,
+                                            param->paramSize,
+                                            param->decimalDigits,
+                                            batchData[column].buffer,
+                                            (SQLLEN) batchData[column].element_size,
+                                            batchData[column].length) != SQL_SUCCESS)) {
+                setDbErrorMsg("sqlExecuteBatch", "SQLBindParameter",
+                              SQL_HANDLE_STMT, preparedStmt->ppStmt);
+                logError(printf("sqlExecuteBatch: SQLBindParameter:\n%s\n",
+                                dbError.message););
+                err_info = DATABASE_ERROR;
+              } /* if */
+            } /* if */
+          } /* for */
+          if (likely(err_info == OKAY_NO_ERROR)) {
+            if (unlikely(SQLSetStmtAttrW(preparedStmt->ppStmt,
+                                         SQL_ATTR_PARAM_BIND_TYPE,
+                                         (SQLPOINTER) SQL_PARAM_BIND_BY_COLUMN,
+                                         0) != SQL_SUCCESS ||
+                         SQLSetStmtAttrW(preparedStmt->ppStmt,
+                                         SQL_ATTR_PARAMSET_SIZE,
+                                         (SQLPOINTER) (SQLULEN) batch->numRows,
+                                         0) != SQL_SUCCESS)) {
+              setDbErrorMsg("sqlExecuteBatch", "SQLSetStmtAttrW",
+                            SQL_HANDLE_STMT, preparedStmt->ppStmt);
+              logError(printf("sqlExecuteBatch: SQLSetStmtAttrW:\n%s\n",
+                              dbError.message););
+              err_info = DATABASE_ERROR;
+            } else {
+              preparedStmt->fetchOkay = FALSE;
+              execute_result = SQLExecute(preparedStmt->ppStmt);
+#ifdef ALLOW_EXECUTE_SUCCESS_WITH_INFO
+              if (execute_result == SQL_SUCCESS_WITH_INFO) {
+                execute_result = SQL_SUCCESS;
+              } /*if */
+#endif
+              if (unlikely(execute_result != SQL_NO_DATA &&
+                           execute_result != SQL_SUCCESS)) {
+                setDbErrorMsg("sqlExecuteBatch", "SQLExecute",
+                              SQL_HANDLE_STMT, preparedStmt->ppStmt);
+                logError(printf("sqlExecuteBatch: SQLExecute execute_result: %d:\n%s\n",
+                                execute_result, dbError.message););
+                err_info = DATABASE_ERROR;
+              } /* if */
+              SQLFreeStmt(preparedStmt->ppStmt, SQL_CLOSE);
+              SQLSetStmtAttrW(preparedStmt->ppStmt, SQL_ATTR_PARAMSET_SIZE,
+                              (SQLPOINTER) (SQLULEN) 1, 0);
+            } /* if */
+          } /* if */
+          /* The parameter arrays are freed, so the parameters must be unbound. */
+          SQLFreeStmt(preparedStmt->ppStmt, SQL_RESET_PARAMS);
+          for (column = 0; column < preparedStmt->param_array_size; column++) {
+            preparedStmt->param_array[column].bound = FALSE;
+          } /* for */
+          freeBatchData(batchData, batch->numColumns, batch->numRows);
+        } /* if */
+      } /* if */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        raise_error(err_info);
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlExecuteBatch --> %d\n", executed););
+    return executed;
+  } /* sqlExecuteBatch */
+
+
+
 static boolType sqlFetch (sqlStmtType sqlStatement)
 
   {
@@ -5620,6 +5907,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlColumnTime      = &sqlColumnTime;
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
+        sqlFunc->sqlExecuteBatch    = &sqlExecuteBatch;
         sqlFunc->sqlFetch           = &sqlFetch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
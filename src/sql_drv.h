@@ -29,6 +29,38 @@
 /*                                                                  */
 /********************************************************************/
 
+/* Types of the columns of a batch: */
+#define SQL_BATCH_UNBOUND 0
+#define SQL_BATCH_INT     1
+#define SQL_BATCH_FLOAT   2
+#define SQL_BATCH_STRI    3
+
+/* A batch holds one array of values per bind variable. */
+/* Row r of the batch consists of element r of every    */
+/* column. Columns of type SQL_BATCH_UNBOUND keep the   */
+/* value bound with the scalar bind functions. A batch  */
+/* is also used to collect the result columns of        */
+/* several fetched rows. In this case 'capacity' is the */
+/* number of rows allocated for every collected column. */
+typedef struct {
+    int type;
+    union {
+      intType   *intValues;
+      floatType *floatValues;
+      striType  *striValues;
+    } data;
+  } sqlBatchColumnRecord, *sqlBatchColumnType;
+
+typedef struct {
+    memSizeType        numRows;
+    memSizeType        capacity;
+    memSizeType        numColumns;
+    boolType           executed;
+    sqlBatchColumnType columns;
+  } sqlBatchRecord, *sqlBatchType;
+
+typedef const sqlBatchRecord *const_sqlBatchType;
+
 typedef struct {
     void (*freeDatabase) (databaseType database);
     void (*freePreparedStmt) (sqlStmtType sqlStatement);
@@ -69,7 +101,14 @@ typedef struct {
                            intType *minute, intType *second, intType *micro_second,
                            intType *time_zone, boolType *is_dst);
     void (*sqlCommit) (databaseType database);
+    void (*sqlCopyEnd) (databaseType database);
+    striType (*sqlCopyGet) (databaseType database);
+    void (*sqlCopyPut) (databaseType database, const const_striType data);
+    boolType (*sqlCopyStart) (databaseType database,
+                              const const_striType copyStatement);
     void (*sqlExecute) (sqlStmtType sqlStatement);
+    boolType (*sqlExecuteBatch) (sqlStmtType sqlStatement,
+                                 const_sqlBatchType batch);
     boolType (*sqlFetch) (sqlStmtType sqlStatement);
     boolType (*sqlGetAutoCommit) (databaseType database);
     boolType (*sqlIsNull) (sqlStmtType sqlStatement, intType column);
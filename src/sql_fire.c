@@ -76,6 +76,8 @@ typedef struct {
 typedef struct {
     uintType        usage_count;
     sqlFuncType     sqlFunc;
+    sqlBatchRecord  batch;
+    sqlBatchRecord  fetched;
     dbType          db;
     isc_stmt_handle ppStmt;
     XSQLDA         *in_sqlda;
@@ -76,6 +76,8 @@ typedef struct {
 typedef struct {
     uintType      usage_count;
     sqlFuncType   sqlFunc;
+    sqlBatchRecord batch;
+    sqlBatchRecord fetched;
     sqlite3_stmt *ppStmt;
     memSizeType   param_array_size;
     bindDataType  param_array;
@@ -2006,6 +2008,165 @@ static void sqlExecute (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Execute a prepared statement for every row of a batch.
+ *  The rows are processed with a prepared loop. If the connection
+ *  is in auto-commit mode the loop is wrapped into a transaction,
+ *  because SQLite would commit every single row otherwise.
+ *  @return TRUE, because SQLite can always execute a batch.
+ */
+static boolType sqlExecuteBatch (sqlStmtType sqlStatement,
+    const_sqlBatchType batch)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlite3 *connection;
+    boolType ownTransaction = FALSE;
+    memSizeType row;
+    memSizeType column;
+    memSizeType param_index;
+    const sqlBatchColumnRecord *batchColumn;
+    cstriType stri8;
+    memSizeType length;
+    int bind_result = SQLITE_OK;
+    int step_result;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlExecuteBatch */
+    logFunction(printf("sqlExecuteBatch(" FMT_U_MEM ", " FMT_U_MEM " rows)\n",
+                       (memSizeType) sqlStatement, batch->numRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    connection = sqlite3_db_handle(preparedStmt->ppStmt);
+    if (unlikely(batch->numColumns > preparedStmt->param_array_size)) {
+      logError(printf("sqlExecuteBatch: Batch columns: " FMT_U_MEM
+                      ", max pos: " FMT_U_MEM ".\n",
+                      batch->numColumns, preparedStmt->param_array_size););
+      err_info = RANGE_ERROR;
+    } else {
+      for (param_index = 0; param_index < preparedStmt->param_array_size;
+           param_index++) {
+        if (unlikely(!preparedStmt->param_array[param_index].bound &&
+                     (param_index >= batch->numColumns ||
+                      batch->columns[param_index].type == SQL_BATCH_UNBOUND))) {
+          logError(printf("sqlExecuteBatch: Unbound parameter " FMT_U_MEM ".\n",
+                          param_index + 1););
+          err_info = DATABASE_ERROR;
+        } /* if */
+      } /* for */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        dbLibError("sqlExecuteBatch", "sqlite3_step",
+                   "Unbound statement parameter(s).\n");
+      } else if (unlikely(sqlite3_reset(preparedStmt->ppStmt) != SQLITE_OK &&
+                          preparedStmt->executeSuccessful)) {
+        setDbErrorMsg("sqlExecuteBatch", "sqlite3_reset", connection);
+        logError(printf("sqlExecuteBatch: sqlite3_reset error: %s\n",
+                        sqlite3_errmsg(connection)););
+        err_info = DATABASE_ERROR;
+      } else {
+        preparedStmt->executeSuccessful = FALSE;
+        preparedStmt->fetchOkay = FALSE;
+        if (sqlite3_get_autocommit(connection) != 0) {
+          if (unlikely(sqlite3_exec(connection, "BEGIN", NULL, NULL, NULL) != SQLITE_OK)) {
+            setDbErrorMsg("sqlExecuteBatch", "sqlite3_exec", connection);
+            logError(printf("sqlExecuteBatch: sqlite3_exec BEGIN error: %s\n",
+                            sqlite3_errmsg(connection)););
+            err_info = DATABASE_ERROR;
+          } else {
+            ownTransaction = TRUE;
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* if */
+    for (row = 0; row < batch->numRows && err_info == OKAY_NO_ERROR; row++) {
+      for (column = 0; column < batch->numColumns &&
+           err_info == OKAY_NO_ERROR; column++) {
+        batchColumn = &batch->columns[column];
+        switch (batchColumn->type) {
+          case SQL_BATCH_INT:
+#if INTTYPE_SIZE == 32
+            bind_result = sqlite3_bind_int(preparedStmt->ppStmt,
+                                           (int) column + 1,
+                                           (int) batchColumn->data.intValues[row]);
+#elif INTTYPE_SIZE == 64
+            bind_result = sqlite3_bind_int64(preparedStmt->ppStmt,
+                                             (int) column + 1,
+                                             (sqlite3_int64) batchColumn->data.intValues[row]);
+#endif
+            break;
+          case SQL_BATCH_FLOAT:
+            bind_result = sqlite3_bind_double(preparedStmt->ppStmt,
+                                              (int) column + 1,
+                                              (double) batchColumn->data.floatValues[row]);
+            break;
+          case SQL_BATCH_STRI:
+            stri8 = stri_to_cstri8_buf(batchColumn->data.striValues[row], &length);
+            if (unlikely(stri8 == NULL)) {
+              err_info = MEMORY_ERROR;
+            } else if (unlikely(length > INT_MAX)) {
+              /* It is not possible to cast length to int. */
+              free_cstri8(stri8, batchColumn->data.striValues[row]);
+              err_info = MEMORY_ERROR;
+            } else {
+              /* The destructor (freeText) is called to dispose */
+              /* the string even if sqlite3_bind_text() fails.  */
+              bind_result = sqlite3_bind_text(preparedStmt->ppStmt,
+                                              (int) column + 1,
+                                              stri8,
+                                              (int) length,
+                                              &freeText);
+            } /* if */
+            break;
+          default:
+            bind_result = SQLITE_OK;
+            break;
+        } /* switch */
+        if (unlikely(err_info == OKAY_NO_ERROR && bind_result != SQLITE_OK)) {
+          setDbErrorMsg("sqlExecuteBatch", "sqlite3_bind", connection);
+          logError(printf("sqlExecuteBatch: sqlite3_bind error: %s\n",
+                          sqlite3_errmsg(connection)););
+          err_info = DATABASE_ERROR;
+        } /* if */
+      } /* for */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        step_result = sqlite3_step(preparedStmt->ppStmt);
+        if (unlikely(step_result != SQLITE_DONE && step_result != SQLITE_ROW)) {
+          setDbErrorMsg("sqlExecuteBatch", "sqlite3_step", connection);
+          logError(printf("sqlExecuteBatch: sqlite3_step error: %s\n",
+                          sqlite3_errmsg(connection)););
+          err_info = DATABASE_ERROR;
+        } /* if */
+        sqlite3_reset(preparedStmt->ppStmt);
+      } /* if */
+    } /* for */
+    if (err_info == OKAY_NO_ERROR) {
+      for (column = 0; column < batch->numColumns; column++) {
+        if (batch->columns[column].type != SQL_BATCH_UNBOUND) {
+          preparedStmt->param_array[column].bound = TRUE;
+        } /* if */
+      } /* for */
+    } /* if */
+    if (ownTransaction) {
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        if (unlikely(sqlite3_exec(connection, "COMMIT", NULL, NULL, NULL) != SQLITE_OK)) {
+          setDbErrorMsg("sqlExecuteBatch", "sqlite3_exec", connection);
+          logError(printf("sqlExecuteBatch: sqlite3_exec COMMIT error: %s\n",
+                          sqlite3_errmsg(connection)););
+          err_info = DATABASE_ERROR;
+          sqlite3_exec(connection, "ROLLBACK", NULL, NULL, NULL);
+        } /* if */
+      } else {
+        sqlite3_exec(connection, "ROLLBACK", NULL, NULL, NULL);
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("sqlExecuteBatch -->\n"););
+    return TRUE;
+  } /* sqlExecuteBatch */
+
+
+
 static boolType sqlFetch (sqlStmtType sqlStatement)
 
   {
@@ -2328,6 +2489,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlColumnTime      = &sqlColumnTime;
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
+        sqlFunc->sqlExecuteBatch    = &sqlExecuteBatch;
         sqlFunc->sqlFetch           = &sqlFetch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
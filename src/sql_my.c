@@ -83,6 +83,9 @@ typedef struct {
 typedef struct {
     uintType       usage_count;
     sqlFuncType    sqlFunc;
+    sqlBatchRecord batch;
+    sqlBatchRecord fetched;
+    dbType         db;
     MYSQL_STMT    *ppStmt;
     memSizeType    param_array_size;
     MYSQL_BIND    *param_array;
@@ -361,6 +364,13 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
       FREE_TABLE(preparedStmt->result_data_array, resultDataRecordMy, preparedStmt->result_array_size);
     } /* if */
     mysql_stmt_close(preparedStmt->ppStmt);
+    if (preparedStmt->db->usage_count != 0) {
+      preparedStmt->db->usage_count--;
+      if (preparedStmt->db->usage_count == 0) {
+        logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) preparedStmt->db););
+        freeDatabase((databaseType) preparedStmt->db);
+      } /* if */
+    } /* if */
     FREE_RECORD2(preparedStmt, preparedStmtRecordMy,
                  count.prepared_stmt, count.prepared_stmt_bytes);
     logFunction(printf("freePreparedStmt -->\n"););
@@ -2390,6 +2400,148 @@ static void sqlExecute (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Execute a prepared statement for every row of a batch.
+ *  The rows are bound directly from the batch and executed inside
+ *  of a transaction. In auto-commit mode the auto-commit is switched
+ *  off while the batch is executed. If a row fails the transaction
+ *  is rolled back.
+ *  @return TRUE if the batch has been executed, or
+ *          FALSE if the statement returns a result.
+ */
+static boolType sqlExecuteBatch (sqlStmtType sqlStatement,
+    const_sqlBatchType batch)
+
+  {
+    preparedStmtType preparedStmt;
+    MYSQL *connection;
+    MYSQL_BIND *batchBind;
+    const sqlBatchColumnRecord *batchColumn;
+    memSizeType column;
+    memSizeType row;
+    memSizeType length;
+    boolType executed = TRUE;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlExecuteBatch */
+    logFunction(printf("sqlExecuteBatch(" FMT_U_MEM ", " FMT_U_MEM " rows)\n",
+                       (memSizeType) sqlStatement, batch->numRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    connection = preparedStmt->db->connection;
+    if (preparedStmt->result_array_size != 0 ||
+        batch->numColumns != preparedStmt->param_array_size) {
+      executed = FALSE;
+    } else if (unlikely(connection == NULL)) {
+      logError(printf("sqlExecuteBatch: Database is not open.\n"););
+      raise_error(RANGE_ERROR);
+    } else {
+      for (column = 0; column < batch->numColumns; column++) {
+        if (unlikely(batch->columns[column].type == SQL_BATCH_UNBOUND)) {
+          err_info = DATABASE_ERROR;
+        } /* if */
+      } /* for */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        dbLibError("sqlExecuteBatch", "SQLExecute",
+                   "Unbound statement parameter(s).\n");
+      } else if (unlikely(!ALLOC_TABLE(batchBind, MYSQL_BIND, batch->numColumns))) {
+        err_info = MEMORY_ERROR;
+      } else {
+        memset(batchBind, 0, batch->numColumns * sizeof(MYSQL_BIND));
+        preparedStmt->executeSuccessful = FALSE;
+        preparedStmt->fetchOkay = FALSE;
+        if (preparedStmt->db->autoCommit &&
+            unlikely(mysql_autocommit(connection, 0) != 0)) {
+          setDbErrorMsg("sqlExecuteBatch", "mysql_autocommit",
+                        mysql_errno(connection),
+                        mysql_error(connection));
+          err_info = DATABASE_ERROR;
+        } /* if */
+        for (row = 0; row < batch->numRows && err_info == OKAY_NO_ERROR; row++) {
+          for (column = 0; column < batch->numColumns &&
+               err_info == OKAY_NO_ERROR; column++) {
+            batchColumn = &batch->columns[column];
+            switch (batchColumn->type) {
+              case SQL_BATCH_INT:
+#if INTTYPE_SIZE == 32
+                batchBind[column].buffer_type = MYSQL_TYPE_LONG;
+#elif INTTYPE_SIZE == 64
+                batchBind[column].buffer_type = MYSQL_TYPE_LONGLONG;
+#endif
+                batchBind[column].buffer = &batchColumn->data.intValues[row];
+                break;
+              case SQL_BATCH_FLOAT:
+#if FLOATTYPE_SIZE == 32
+                batchBind[column].buffer_type = MYSQL_TYPE_FLOAT;
+#elif FLOATTYPE_SIZE == 64
+                batchBind[column].buffer_type = MYSQL_TYPE_DOUBLE;
+#endif
+                batchBind[column].buffer = &batchColumn->data.floatValues[row];
+                break;
+              case SQL_BATCH_STRI:
+                free(batchBind[column].buffer);
+                batchBind[column].buffer_type = MYSQL_TYPE_STRING;
+                batchBind[column].buffer =
+                    stri_to_cstri8_buf(batchColumn->data.striValues[row], &length);
+                if (unlikely(batchBind[column].buffer == NULL)) {
+                  err_info = MEMORY_ERROR;
+                } else if (unlikely(length > ULONG_MAX)) {
+                  /* It is not possible to cast length to unsigned long. */
+                  err_info = MEMORY_ERROR;
+                } else {
+                  batchBind[column].buffer_length = (unsigned long) length;
+                } /* if */
+                break;
+            } /* switch */
+          } /* for */
+          if (unlikely(err_info != OKAY_NO_ERROR)) {
+            ;
+          } else if (unlikely(mysql_stmt_bind_param(preparedStmt->ppStmt,
+                                                    batchBind) != 0)) {
+            setDbErrorMsg("sqlExecuteBatch", "mysql_stmt_bind_param",
+                          mysql_stmt_errno(preparedStmt->ppStmt),
+                          mysql_stmt_error(preparedStmt->ppStmt));
+            logError(printf("sqlExecuteBatch: mysql_stmt_bind_param error: %s\n",
+                            mysql_stmt_error(preparedStmt->ppStmt)););
+            err_info = DATABASE_ERROR;
+          } else if (unlikely(mysql_stmt_execute(preparedStmt->ppStmt) != 0)) {
+            setDbErrorMsg("sqlExecuteBatch", "mysql_stmt_execute",
+                          mysql_stmt_errno(preparedStmt->ppStmt),
+                          mysql_stmt_error(preparedStmt->ppStmt));
+            logError(printf("sqlExecuteBatch: mysql_stmt_execute error: %s\n",
+                            mysql_stmt_error(preparedStmt->ppStmt)););
+            err_info = DATABASE_ERROR;
+          } /* if */
+        } /* for */
+        for (column = 0; column < batch->numColumns; column++) {
+          if (batchBind[column].buffer_type == MYSQL_TYPE_STRING) {
+            free(batchBind[column].buffer);
+          } /* if */
+        } /* for */
+        FREE_TABLE(batchBind, MYSQL_BIND, batch->numColumns);
+        if (preparedStmt->db->autoCommit) {
+          if (err_info == OKAY_NO_ERROR) {
+            if (unlikely(mysql_commit(connection) != 0)) {
+              setDbErrorMsg("sqlExecuteBatch", "mysql_commit",
+                            mysql_errno(connection),
+                            mysql_error(connection));
+              err_info = DATABASE_ERROR;
+            } /* if */
+          } else {
+            mysql_rollback(connection);
+          } /* if */
+          mysql_autocommit(connection, 1);
+        } /* if */
+      } /* if */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        raise_error(err_info);
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlExecuteBatch --> %d\n", executed););
+    return executed;
+  } /* sqlExecuteBatch */
+
+
+
 static boolType sqlFetch (sqlStmtType sqlStatement)
 
   {
@@ -2556,6 +2708,10 @@ static sqlStmtType sqlPrepare (databaseType database,
               } else {
                 preparedStmt->usage_count = 1;
                 preparedStmt->sqlFunc = db->sqlFunc;
+                preparedStmt->db = db;
+                if (db->usage_count != 0) {
+                  db->usage_count++;
+                } /* if */
                 preparedStmt->executeSuccessful = FALSE;
                 preparedStmt->fetchOkay = FALSE;
                 preparedStmt->fetchFinished = TRUE;
@@ -2808,6 +2964,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlColumnTime      = &sqlColumnTime;
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
+        sqlFunc->sqlExecuteBatch    = &sqlExecuteBatch;
         sqlFunc->sqlFetch           = &sqlFetch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
@@ -103,9 +103,18 @@ typedef struct {
     int16Type    indicator;
   } resultDataRecordOci, *resultDataType;
 
+typedef struct {
+    uint16Type   buffer_type;
+    memSizeType  element_size;
+    void        *buffer;
+    ub2         *length;
+  } batchDataRecordOci, *batchDataType;
+
 typedef struct {
     uintType       usage_count;
     sqlFuncType    sqlFunc;
+    sqlBatchRecord batch;
+    sqlBatchRecord fetched;
     dbType         db;
     OCIEnv        *oci_environment;
     OCIError      *oci_error;
@@ -4209,6 +4218,224 @@ static void sqlExecute (sqlStmtType sqlStatement)
 
 
 
+static void freeBatchData (batchDataType batchData, memSizeType numColumns,
+    memSizeType numRows)
+
+  {
+    memSizeType column;
+
+  /* freeBatchData */
+    for (column = 0; column < numColumns; column++) {
+      free(batchData[column].buffer);
+      if (batchData[column].length != NULL) {
+        FREE_TABLE(batchData[column].length, ub2, numRows);
+      } /* if */
+    } /* for */
+    FREE_TABLE(batchData, batchDataRecordOci, numColumns);
+  } /* freeBatchData */
+
+
+
+/**
+ *  Copy the values of a batch column into an OCI bind array.
+ *  @return OKAY_NO_ERROR if the bind array could be filled,
+ *          RANGE_ERROR if the column cannot be bound as array or
+ *          MEMORY_ERROR if there is not enough memory.
+ */
+static errInfoType fillBatchData (batchDataType batchData,
+    const sqlBatchColumnRecord *batchColumn, memSizeType numRows)
+
+  {
+    memSizeType row;
+    memSizeType converted;
+    cstriType *stri8;
+    memSizeType maxLength = 0;
+    memSizeType length;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* fillBatchData */
+    switch (batchColumn->type) {
+      case SQL_BATCH_INT:
+        batchData->buffer_type = SQLT_INT;
+        batchData->element_size = sizeof(int64Type);
+        if (unlikely(numRows > MAX_MEMSIZETYPE / sizeof(int64Type) ||
+                     (batchData->buffer = malloc(numRows * sizeof(int64Type))) == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          for (row = 0; row < numRows; row++) {
+            ((int64Type *) batchData->buffer)[row] =
+                (int64Type) batchColumn->data.intValues[row];
+          } /* for */
+        } /* if */
+        break;
+#ifdef SQLT_BFLOAT
+      case SQL_BATCH_FLOAT:
+#if FLOATTYPE_SIZE == 32
+        batchData->buffer_type = SQLT_BFLOAT;
+#elif FLOATTYPE_SIZE == 64
+        batchData->buffer_type = SQLT_BDOUBLE;
+#endif
+        batchData->element_size = sizeof(floatType);
+        if (unlikely(numRows > MAX_MEMSIZETYPE / sizeof(floatType) ||
+                     (batchData->buffer = malloc(numRows * sizeof(floatType))) == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          memcpy(batchData->buffer, batchColumn->data.floatValues,
+                 numRows * sizeof(floatType));
+        } /* if */
+        break;
+#endif
+      case SQL_BATCH_STRI:
+        /* SQLT_AFC is used to keep trailing blanks and NULLs. */
+        batchData->buffer_type = SQLT_AFC;
+        if (unlikely(!ALLOC_TABLE(stri8, cstriType, numRows))) {
+          err_info = MEMORY_ERROR;
+        } else if (unlikely(!ALLOC_TABLE(batchData->length, ub2, numRows))) {
+          FREE_TABLE(stri8, cstriType, numRows);
+          err_info = MEMORY_ERROR;
+        } else {
+          for (converted = 0; converted < numRows &&
+               err_info == OKAY_NO_ERROR; converted++) {
+            stri8[converted] = stri_to_cstri8_buf(
+                batchColumn->data.striValues[converted], &length);
+            if (unlikely(stri8[converted] == NULL)) {
+              err_info = MEMORY_ERROR;
+            } else if (unlikely(length > UINT16TYPE_MAX)) {
+              /* The lengths of an OCI bind array are ub2 values. */
+              free(stri8[converted]);
+              err_info = RANGE_ERROR;
+            } else {
+              batchData->length[converted] = (ub2) length;
+              if (length > maxLength) {
+                maxLength = length;
+              } /* if */
+            } /* if */
+          } /* for */
+          if (err_info != OKAY_NO_ERROR) {
+            /* The last conversion failed. */
+            converted--;
+          } else {
+            batchData->element_size = maxLength == 0 ? 1 : maxLength;
+            if (unlikely(numRows > MAX_MEMSIZETYPE / batchData->element_size ||
+                         (batchData->buffer = malloc(numRows * batchData->element_size)) == NULL)) {
+              err_info = MEMORY_ERROR;
+            } else {
+              for (row = 0; row < numRows; row++) {
+                memcpy(&((char *) batchData->buffer)[row * batchData->element_size],
+                       stri8[row], batchData->length[row]);
+              } /* for */
+            } /* if */
+          } /* if */
+          for (row = 0; row < converted; row++) {
+            free(stri8[row]);
+          } /* for */
+          FREE_TABLE(stri8, cstriType, numRows);
+        } /* if */
+        break;
+      default:
+        err_info = RANGE_ERROR;
+        break;
+    } /* switch */
+    return err_info;
+  } /* fillBatchData */
+
+
+
+/**
+ *  Execute a prepared statement for every row of a batch.
+ *  The batch is bound as OCI bind arrays and executed with a single
+ *  OCIStmtExecute() call (array DML). After the batch has been
+ *  executed the parameters are unbound.
+ *  @return TRUE if the batch has been executed, or
+ *          FALSE if the batch cannot be bound as bind arrays.
+ */
+static boolType sqlExecuteBatch (sqlStmtType sqlStatement,
+    const_sqlBatchType batch)
+
+  {
+    preparedStmtType preparedStmt;
+    memSizeType column;
+    batchDataType batchData;
+    bindDataType param;
+    ub4 executeMode;
+    boolType executed = TRUE;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlExecuteBatch */
+    logFunction(printf("sqlExecuteBatch(" FMT_U_MEM ", " FMT_U_MEM " rows)\n",
+                       (memSizeType) sqlStatement, batch->numRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (preparedStmt->statementType == OCI_STMT_SELECT ||
+        batch->numColumns != preparedStmt->param_array_size ||
+        batch->numRows > UINT32TYPE_MAX) {
+      executed = FALSE;
+    } else if (unlikely(!ALLOC_TABLE(batchData, batchDataRecordOci, batch->numColumns))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(batchData, 0, batch->numColumns * sizeof(batchDataRecordOci));
+      for (column = 0; column < batch->numColumns &&
+           err_info == OKAY_NO_ERROR; column++) {
+        err_info = fillBatchData(&batchData[column], &batch->columns[column],
+                                 batch->numRows);
+      } /* for */
+      if (err_info == RANGE_ERROR) {
+        /* At least one column cannot be bound as bind array. */
+        executed = FALSE;
+      } else if (likely(err_info == OKAY_NO_ERROR)) {
+        for (column = 0; column < batch->numColumns &&
+             err_info == OKAY_NO_ERROR; column++) {
+          param = &preparedStmt->param_array[column];
+          /* The bind handle refers to the batch data, which is freed */
+          /* below. The parameter must be bound again before the next */
+          /* sqlExecute().                                            */
+          param->bound = FALSE;
+          if (unlikely(OCIBindByPos(preparedStmt->ppStmt,
+                                    &param->bind_handle,
+                                    preparedStmt->oci_error,
+                                    (ub4) (column + 1),
+                                    batchData[column].buffer,
+                                    (sb4) batchData[column].element_size,
+                                    batchData[column].buffer_type,
+                                    NULL,
+                                    batchData[column].length,
+                                    NULL, 0, NULL,
+                                    OCI_DEFAULT) != OCI_SUCCESS)) {
+            setDbErrorMsg("sqlExecuteBatch", "OCIBindByPos",
+                          preparedStmt->oci_error);
+            logError(printf("sqlExecuteBatch: OCIBindByPos:\n%s\n",
+                            dbError.message););
+            err_info = DATABASE_ERROR;
+          } /* if */
+        } /* for */
+        if (likely(err_info == OKAY_NO_ERROR)) {
+          preparedStmt->fetchOkay = FALSE;
+          executeMode = preparedStmt->db->autoCommit ? OCI_COMMIT_ON_SUCCESS : OCI_DEFAULT;
+          if (unlikely(OCIStmtExecute(preparedStmt->oci_service_context,
+                                      preparedStmt->ppStmt,
+                                      preparedStmt->oci_error,
+                                      (ub4) batch->numRows, /* iters */
+                                      0, NULL, NULL,
+                                      executeMode) != OCI_SUCCESS)) {
+            setDbErrorMsg("sqlExecuteBatch", "OCIStmtExecute",
+                          preparedStmt->oci_error);
+            logError(printf("sqlExecuteBatch: OCIStmtExecute:\n%s\n",
+                            dbError.message););
+            err_info = DATABASE_ERROR;
+          } /* if */
+          preparedStmt->executeSuccessful = FALSE;
+        } /* if */
+      } /* if */
+      freeBatchData(batchData, batch->numColumns, batch->numRows);
+      if (unlikely(executed && err_info != OKAY_NO_ERROR)) {
+        raise_error(err_info);
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlExecuteBatch --> %d\n", executed););
+    return executed;
+  } /* sqlExecuteBatch */
+
+
+
 static boolType sqlFetch (sqlStmtType sqlStatement)
 
   {
@@ -4624,6 +4851,7 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlColumnTime      = &sqlColumnTime;
         sqlFunc->sqlCommit          = &sqlCommit;
         sqlFunc->sqlExecute         = &sqlExecute;
+        sqlFunc->sqlExecuteBatch    = &sqlExecuteBatch;
         sqlFunc->sqlFetch           = &sqlFetch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
         sqlFunc->sqlIsNull          = &sqlIsNull;
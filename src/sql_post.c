@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_post.c                                      */
-/*  Changes: 2014, 2015, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2014, 2015, 2017 - 2020, 2024  Thomas Mertes           */
 /*  Content: Database access functions for PostgreSQL.              */
 /*                                                                  */
 /********************************************************************/
@@ -87,6 +87,8 @@ typedef struct {
     boolType     integerDatetimes;
     uintType     nextStmtNum;
     boolType     autoCommit;
+    sqlStmtType  streamingStmt;
+    ExecStatusType copyStatus;
   } dbRecordPost, *dbType;
 
 typedef struct {
@@ -97,6 +99,8 @@ typedef struct {
 typedef struct {
     uintType       usage_count;
     sqlFuncType    sqlFunc;
+    sqlBatchRecord batch;
+    sqlBatchRecord fetched;
     dbType         db;
     boolType       integerDatetimes;
     boolType       implicitCommit;
@@ -116,6 +120,12 @@ typedef struct {
     int            num_tuples;
     int            fetch_index;
     boolType       increment_index;
+    boolType       streaming;
+    boolType       pendingLost;
+    PGresult     **pendingResults;
+    memSizeType    pendingCapacity;
+    memSizeType    pendingCount;
+    memSizeType    pendingIndex;
   } preparedStmtRecordPost, *preparedStmtType;
 
 static sqlFuncType sqlFunc = NULL;
@@ -127,6 +137,8 @@ static sqlFuncType sqlFunc = NULL;
 /* Seconds between 1970-01-01 and 2000-01-01 */
 #define SECONDS_FROM_1970_TO_2000 INT64_SUFFIX(946684800)
 #define DEFAULT_DECIMAL_SCALE 1000
+#define MIN_PENDING_RESULTS 64
+#define COPY_BUFFER_SIZE 8192
 #define SHOW_DETAILS 0
 
 
@@ -152,10 +164,13 @@ typedef PGresult *(CDECL *tp_PQexecPrepared) (PGconn *conn,
                                               const int *paramFormats,
                                               int resultFormat);
 typedef void (CDECL *tp_PQfinish) (PGconn *conn);
+typedef void (CDECL *tp_PQfreemem) (void *ptr);
 typedef char *(CDECL *tp_PQfname) (const PGresult *res, int field_num);
 typedef Oid (CDECL *tp_PQftype) (const PGresult *res, int field_num);
+typedef int (CDECL *tp_PQgetCopyData) (PGconn *conn, char **buffer, int async);
 typedef int (CDECL *tp_PQgetisnull) (const PGresult *res, int tup_num, int field_num);
 typedef int (CDECL *tp_PQgetlength) (const PGresult *res, int tup_num, int field_num);
+typedef PGresult *(CDECL *tp_PQgetResult) (PGconn *conn);
 typedef char *(CDECL *tp_PQgetvalue) (const PGresult *res, int tup_num, int field_num);
 typedef int (CDECL *tp_PQnfields) (const PGresult *res);
 typedef int (CDECL *tp_PQnparams) (const PGresult *res);
@@ -165,14 +180,24 @@ typedef Oid (CDECL *tp_PQparamtype) (const PGresult *res, int param_num);
 typedef PGresult *(CDECL *tp_PQprepare) (PGconn *conn, const char *stmtName,
                                          const char *query, int nParams,
                                          const Oid *paramTypes);
+typedef int (CDECL *tp_PQputCopyData) (PGconn *conn, const char *buffer, int nbytes);
+typedef int (CDECL *tp_PQputCopyEnd) (PGconn *conn, const char *errormsg);
 typedef char *(CDECL *tp_PQresStatus) (ExecStatusType status);
 typedef char *(CDECL *tp_PQresultErrorMessage) (const PGresult *res);
 typedef ExecStatusType (CDECL *tp_PQresultStatus) (const PGresult *res);
+typedef int (CDECL *tp_PQsendQueryPrepared) (PGconn *conn,
+                                             const char *stmtName,
+                                             int nParams,
+                                             const char *const * paramValues,
+                                             const int *paramLengths,
+                                             const int *paramFormats,
+                                             int resultFormat);
 typedef int (CDECL *tp_PQsetClientEncoding) (PGconn *conn, const char *encoding);
 typedef PGconn *(CDECL *tp_PQsetdbLogin) (const char *pghost, const char *pgport,
                                           const char *pgoptions, const char *pgtty,
                                           const char *dbName,
                                           const char *login, const char *pwd);
+typedef int (CDECL *tp_PQsetSingleRowMode) (PGconn *conn);
 typedef ConnStatusType (CDECL *tp_PQstatus) (const PGconn *conn);
 
 static tp_PQclear              ptr_PQclear;
@@ -181,10 +206,13 @@ static tp_PQerrorMessage       ptr_PQerrorMessage;
 static tp_PQexec               ptr_PQexec;
 static tp_PQexecPrepared       ptr_PQexecPrepared;
 static tp_PQfinish             ptr_PQfinish;
+static tp_PQfreemem            ptr_PQfreemem;
 static tp_PQfname              ptr_PQfname;
 static tp_PQftype              ptr_PQftype;
+static tp_PQgetCopyData        ptr_PQgetCopyData;
 static tp_PQgetisnull          ptr_PQgetisnull;
 static tp_PQgetlength          ptr_PQgetlength;
+static tp_PQgetResult          ptr_PQgetResult;
 static tp_PQgetvalue           ptr_PQgetvalue;
 static tp_PQnfields            ptr_PQnfields;
 static tp_PQnparams            ptr_PQnparams;
@@ -192,11 +220,15 @@ static tp_PQntuples            ptr_PQntuples;
 static tp_PQparameterStatus    ptr_PQparameterStatus;
 static tp_PQparamtype          ptr_PQparamtype;
 static tp_PQprepare            ptr_PQprepare;
+static tp_PQputCopyData        ptr_PQputCopyData;
+static tp_PQputCopyEnd         ptr_PQputCopyEnd;
 static tp_PQresStatus          ptr_PQresStatus;
 static tp_PQresultErrorMessage ptr_PQresultErrorMessage;
 static tp_PQresultStatus       ptr_PQresultStatus;
+static tp_PQsendQueryPrepared  ptr_PQsendQueryPrepared;
 static tp_PQsetClientEncoding  ptr_PQsetClientEncoding;
 static tp_PQsetdbLogin         ptr_PQsetdbLogin;
+static tp_PQsetSingleRowMode   ptr_PQsetSingleRowMode;
 static tp_PQstatus             ptr_PQstatus;
 
 #define PQclear              ptr_PQclear
@@ -205,10 +237,13 @@ static tp_PQstatus             ptr_PQstatus;
 #define PQexec               ptr_PQexec
 #define PQexecPrepared       ptr_PQexecPrepared
 #define PQfinish             ptr_PQfinish
+#define PQfreemem            ptr_PQfreemem
 #define PQfname              ptr_PQfname
 #define PQftype              ptr_PQftype
+#define PQgetCopyData        ptr_PQgetCopyData
 #define PQgetisnull          ptr_PQgetisnull
 #define PQgetlength          ptr_PQgetlength
+#define PQgetResult          ptr_PQgetResult
 #define PQgetvalue           ptr_PQgetvalue
 #define PQnfields            ptr_PQnfields
 #define PQnparams            ptr_PQnparams
@@ -216,11 +251,17 @@ static tp_PQstatus             ptr_PQstatus;
 #define PQparameterStatus    ptr_PQparameterStatus
 #define PQparamtype          ptr_PQparamtype
 #define PQprepare            ptr_PQprepare
+#define PQputCopyData        ptr_PQputCopyData
+#define PQputCopyEnd         ptr_PQputCopyEnd
 #define PQresStatus          ptr_PQresStatus
 #define PQresultErrorMessage ptr_PQresultErrorMessage
 #define PQresultStatus       ptr_PQresultStatus
+#define PQsendQueryPrepared  ptr_PQsendQueryPrepared
 #define PQsetClientEncoding  ptr_PQsetClientEncoding
 #define PQsetdbLogin         ptr_PQsetdbLogin
+#define PQsetSingleRowMode   ptr_PQsetSingleRowMode
+
+#define FUNCTION_PRESENT(func) ((func) != NULL)
 #define PQstatus             ptr_PQstatus
 
 
@@ -311,6 +352,15 @@ static boolType setupDll (const char *dllName)
             (PQsetdbLogin         = (tp_PQsetdbLogin)         dllFunc(dbDll, "PQsetdbLogin"))         == NULL ||
             (PQstatus             = (tp_PQstatus)             dllFunc(dbDll, "PQstatus"))             == NULL) {
           dbDll = NULL;
+        } else {
+          /* Functions for streaming results and COPY are optional. */
+          PQfreemem           = (tp_PQfreemem)           dllFunc(dbDll, "PQfreemem");
+          PQgetCopyData       = (tp_PQgetCopyData)       dllFunc(dbDll, "PQgetCopyData");
+          PQgetResult         = (tp_PQgetResult)         dllFunc(dbDll, "PQgetResult");
+          PQputCopyData       = (tp_PQputCopyData)       dllFunc(dbDll, "PQputCopyData");
+          PQputCopyEnd        = (tp_PQputCopyEnd)        dllFunc(dbDll, "PQputCopyEnd");
+          PQsendQueryPrepared = (tp_PQsendQueryPrepared) dllFunc(dbDll, "PQsendQueryPrepared");
+          PQsetSingleRowMode  = (tp_PQsetSingleRowMode)  dllFunc(dbDll, "PQsetSingleRowMode");
         } /* if */
       } /* if */
     } /* if */
@@ -341,6 +391,7 @@ static boolType findDll (void)
 #else
 
 #define findDll() TRUE
+#define FUNCTION_PRESENT(func) TRUE
 
 #endif
 
@@ -522,6 +573,226 @@ static PGresult *PQdeallocate (PGconn *conn, const char *stmtName)
 
 
 
+static void setResultErrorMsg (const char *funcName, const char *dbFuncName,
+    const PGresult *result)
+
+  { /* setResultErrorMsg */
+    dbError.funcName = funcName;
+    dbError.dbFuncName = dbFuncName;
+    dbError.errorCode = 0;
+    snprintf(dbError.message, DB_ERR_MESSAGE_SIZE, "%s",
+             PQresultErrorMessage(result));
+  } /* setResultErrorMsg */
+
+
+
+static void clearPendingResults (preparedStmtType preparedStmt)
+
+  { /* clearPendingResults */
+    while (preparedStmt->pendingIndex < preparedStmt->pendingCount) {
+      PQclear(preparedStmt->pendingResults[preparedStmt->pendingIndex]);
+      preparedStmt->pendingIndex++;
+    } /* while */
+    if (preparedStmt->pendingResults != NULL) {
+      FREE_TABLE(preparedStmt->pendingResults, PGresult *,
+                 preparedStmt->pendingCapacity);
+      preparedStmt->pendingResults = NULL;
+    } /* if */
+    preparedStmt->pendingCapacity = 0;
+    preparedStmt->pendingCount = 0;
+    preparedStmt->pendingIndex = 0;
+    preparedStmt->pendingLost = FALSE;
+  } /* clearPendingResults */
+
+
+
+/**
+ *  Stop streaming the rows of 'preparedStmt' and discard the remaining rows.
+ *  If the rows are received from the connection the remaining results
+ *  are read, such that the connection can be used again.
+ */
+static void endStream (preparedStmtType preparedStmt)
+
+  {
+    PGresult *result;
+
+  /* endStream */
+    if (preparedStmt->streaming) {
+      if (preparedStmt->db->streamingStmt == (sqlStmtType) preparedStmt) {
+        while ((result = PQgetResult(preparedStmt->db->connection)) != NULL) {
+          PQclear(result);
+        } /* while */
+        preparedStmt->db->streamingStmt = NULL;
+      } /* if */
+      clearPendingResults(preparedStmt);
+      preparedStmt->streaming = FALSE;
+    } /* if */
+  } /* endStream */
+
+
+
+/**
+ *  Make the connection of 'db' available for other requests.
+ *  A connection processes one request at a time. If the rows of a
+ *  statement are streamed the remaining results are read from the
+ *  connection and buffered in the statement. Later fetches of this
+ *  statement take the rows from the buffer.
+ */
+static void suspendStreaming (dbType db)
+
+  {
+    preparedStmtType preparedStmt;
+    PGresult *result;
+    PGresult **resizedResults;
+    memSizeType newCapacity;
+
+  /* suspendStreaming */
+    if (db->streamingStmt != NULL) {
+      logFunction(printf("suspendStreaming(" FMT_U_MEM ")\n",
+                         (memSizeType) db););
+      preparedStmt = (preparedStmtType) db->streamingStmt;
+      db->streamingStmt = NULL;
+      while ((result = PQgetResult(db->connection)) != NULL) {
+        if (preparedStmt->pendingCount == preparedStmt->pendingCapacity &&
+            !preparedStmt->pendingLost) {
+          if (preparedStmt->pendingCapacity == 0) {
+            newCapacity = MIN_PENDING_RESULTS;
+          } else {
+            newCapacity = 2 * preparedStmt->pendingCapacity;
+          } /* if */
+          resizedResults = REALLOC_TABLE(preparedStmt->pendingResults, PGresult *,
+                                         preparedStmt->pendingCapacity, newCapacity);
+          if (unlikely(resizedResults == NULL)) {
+            preparedStmt->pendingLost = TRUE;
+          } else {
+            COUNT3_TABLE(PGresult *, preparedStmt->pendingCapacity, newCapacity);
+            preparedStmt->pendingResults = resizedResults;
+            preparedStmt->pendingCapacity = newCapacity;
+          } /* if */
+        } /* if */
+        if (unlikely(preparedStmt->pendingLost)) {
+          PQclear(result);
+        } else {
+          preparedStmt->pendingResults[preparedStmt->pendingCount] = result;
+          preparedStmt->pendingCount++;
+        } /* if */
+      } /* while */
+      logFunction(printf("suspendStreaming --> (pendingCount=" FMT_U_MEM ")\n",
+                         preparedStmt->pendingCount););
+    } /* if */
+  } /* suspendStreaming */
+
+
+
+/**
+ *  Execute 'preparedStmt' such that the rows are received one by one.
+ *  In single row mode every row is delivered as a separate result
+ *  with the status PGRES_SINGLE_TUPLE. The end of the rows is marked
+ *  with a result with the status PGRES_TUPLES_OK. If the single row
+ *  mode cannot be activated the whole result is delivered at once.
+ *  @return the first result, or NULL if the request failed.
+ */
+static PGresult *startStream (preparedStmtType preparedStmt,
+    errInfoType *err_info)
+
+  {
+    PGconn *connection;
+    PGresult *extraResult;
+    PGresult *result = NULL;
+
+  /* startStream */
+    connection = preparedStmt->db->connection;
+    if (unlikely(PQsendQueryPrepared(connection,
+                                     preparedStmt->stmtName,
+                                     (int) preparedStmt->param_array_size,
+                                     (const const_cstriType *) preparedStmt->paramValues,
+                                     preparedStmt->paramLengths,
+                                     preparedStmt->paramFormats,
+                                     1) == 0)) {
+      setDbErrorMsg("sqlExecute", "PQsendQueryPrepared", connection);
+      logError(printf("sqlExecute: PQsendQueryPrepared failed:\n%s",
+                      dbError.message););
+      *err_info = DATABASE_ERROR;
+    } else {
+      /* If PQsetSingleRowMode fails the whole result is received. */
+      PQsetSingleRowMode(connection);
+      result = PQgetResult(connection);
+      if (unlikely(result == NULL)) {
+        logError(printf("sqlExecute: PQgetResult returns NULL\n"););
+        *err_info = MEMORY_ERROR;
+      } else if (PQresultStatus(result) != PGRES_SINGLE_TUPLE) {
+        /* Read the end of the request. */
+        while ((extraResult = PQgetResult(connection)) != NULL) {
+          PQclear(extraResult);
+        } /* while */
+      } /* if */
+    } /* if */
+    return result;
+  } /* startStream */
+
+
+
+/**
+ *  Receive the next streamed row of 'preparedStmt'.
+ *  @return TRUE if a row was received, FALSE if all rows were received.
+ */
+static boolType fetchStreamedRow (preparedStmtType preparedStmt)
+
+  {
+    ExecStatusType status;
+    boolType fetchOkay = FALSE;
+
+  /* fetchStreamedRow */
+    PQclear(preparedStmt->execute_result);
+    if (preparedStmt->pendingIndex < preparedStmt->pendingCount) {
+      preparedStmt->execute_result =
+          preparedStmt->pendingResults[preparedStmt->pendingIndex];
+      preparedStmt->pendingIndex++;
+    } else if (preparedStmt->db->streamingStmt == (sqlStmtType) preparedStmt) {
+      preparedStmt->execute_result = PQgetResult(preparedStmt->db->connection);
+    } else {
+      preparedStmt->execute_result = NULL;
+    } /* if */
+    if (unlikely(preparedStmt->execute_result == NULL)) {
+      preparedStmt->executeSuccessful = FALSE;
+      preparedStmt->execute_status = PGRES_FATAL_ERROR;
+      if (preparedStmt->pendingLost) {
+        endStream(preparedStmt);
+        raise_error(MEMORY_ERROR);
+      } else {
+        dbLibError("sqlFetch", "PQgetResult",
+                   "The rows of the statement are not available anymore.\n");
+        logError(printf("sqlFetch: No result from PQgetResult.\n"););
+        endStream(preparedStmt);
+        raise_error(DATABASE_ERROR);
+      } /* if */
+    } else {
+      status = PQresultStatus(preparedStmt->execute_result);
+      if (status == PGRES_SINGLE_TUPLE) {
+        preparedStmt->fetch_index = 0;
+        fetchOkay = TRUE;
+      } else if (status == PGRES_TUPLES_OK) {
+        /* All rows have been received. */
+        preparedStmt->execute_status = PGRES_TUPLES_OK;
+        preparedStmt->num_tuples = 0;
+        preparedStmt->fetch_index = 0;
+        endStream(preparedStmt);
+      } else {
+        setResultErrorMsg("sqlFetch", "PQgetResult",
+                          preparedStmt->execute_result);
+        logError(printf("sqlFetch: PQgetResult returns a status of %s:\n%s",
+                        PQresStatus(status), dbError.message););
+        preparedStmt->executeSuccessful = FALSE;
+        preparedStmt->execute_status = status;
+        endStream(preparedStmt);
+        raise_error(DATABASE_ERROR);
+      } /* if */
+    } /* if */
+    return fetchOkay;
+  } /* fetchStreamedRow */
+
+
+
 /**
  *  Closes a database and frees the memory used by it.
  */
@@ -573,9 +844,11 @@ static void freePreparedStmt (sqlStmtType sqlStatement)
     if (preparedStmt->paramFormats != NULL) {
       FREE_TABLE(preparedStmt->paramFormats, int, preparedStmt->param_array_size);
     } /* if */
+    endStream(preparedStmt);
     if (preparedStmt->execute_result != NULL) {
       PQclear(preparedStmt->execute_result);
     } /* if */
+    suspendStreaming(preparedStmt->db);
     deallocate_result = PQdeallocate(preparedStmt->db->connection, preparedStmt->stmtName);
     if (unlikely(deallocate_result != NULL)) {
       /* Ignore possible errors. */
@@ -2158,6 +2431,9 @@ static void sqlClose (databaseType database)
     logFunction(printf("sqlClose(" FMT_U_MEM ")\n",
                        (memSizeType) database););
     db = (dbType) database;
+    /* A statement, which streams rows, cannot receive further rows. */
+    db->streamingStmt = NULL;
+    db->copyStatus = PGRES_EMPTY_QUERY;
     if (db->connection != NULL) {
       PQfinish(db->connection);
       db->connection = NULL;
@@ -3171,6 +3447,7 @@ static void sqlCommit (databaseType database)
       logError(printf("sqlCommit: Database is not open.\n"););
       raise_error(RANGE_ERROR);
     } else if (!db->autoCommit) {
+      suspendStreaming(db);
       err_info = doExecSql(db->connection, "COMMIT", err_info);
       err_info = doExecSql(db->connection, "BEGIN TRANSACTION", err_info);
       if (unlikely(err_info != OKAY_NO_ERROR)) {
@@ -3182,6 +3459,233 @@ static void sqlCommit (databaseType database)
 
 
 
+/**
+ *  Read the results of a finished COPY and check that it succeeded.
+ */
+static errInfoType finishCopy (dbType db, const char *funcName)
+
+  {
+    PGresult *result;
+    ExecStatusType status;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* finishCopy */
+    db->copyStatus = PGRES_EMPTY_QUERY;
+    while ((result = PQgetResult(db->connection)) != NULL) {
+      status = PQresultStatus(result);
+      if (status != PGRES_COMMAND_OK && err_info == OKAY_NO_ERROR) {
+        setResultErrorMsg(funcName, "PQgetResult", result);
+        logError(printf("%s: PQgetResult returns a status of %s:\n%s",
+                        funcName, PQresStatus(status), dbError.message););
+        err_info = DATABASE_ERROR;
+      } /* if */
+      PQclear(result);
+    } /* while */
+    return err_info;
+  } /* finishCopy */
+
+
+
+static void sqlCopyEnd (databaseType database)
+
+  {
+    dbType db;
+    char *buffer;
+    int length;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlCopyEnd */
+    logFunction(printf("sqlCopyEnd(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    db = (dbType) database;
+    if (db->copyStatus == PGRES_COPY_IN) {
+      if (unlikely(PQputCopyEnd(db->connection, NULL) != 1)) {
+        setDbErrorMsg("sqlCopyEnd", "PQputCopyEnd", db->connection);
+        logError(printf("sqlCopyEnd: PQputCopyEnd failed:\n%s",
+                        dbError.message););
+        err_info = DATABASE_ERROR;
+        finishCopy(db, "sqlCopyEnd");
+      } else {
+        err_info = finishCopy(db, "sqlCopyEnd");
+      } /* if */
+    } else if (db->copyStatus == PGRES_COPY_OUT) {
+      /* Skip the data, which has not been read. */
+      while ((length = PQgetCopyData(db->connection, &buffer, 0)) > 0) {
+        PQfreemem(buffer);
+      } /* while */
+      err_info = finishCopy(db, "sqlCopyEnd");
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("sqlCopyEnd -->\n"););
+  } /* sqlCopyEnd */
+
+
+
+static striType sqlCopyGet (databaseType database)
+
+  {
+    dbType db;
+    char *buffer;
+    int length;
+    errInfoType err_info = OKAY_NO_ERROR;
+    striType data = NULL;
+
+  /* sqlCopyGet */
+    logFunction(printf("sqlCopyGet(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    db = (dbType) database;
+    if (unlikely(db->copyStatus != PGRES_COPY_OUT)) {
+      logError(printf("sqlCopyGet: No COPY TO STDOUT active.\n"););
+      err_info = RANGE_ERROR;
+    } else {
+      length = PQgetCopyData(db->connection, &buffer, 0);
+      if (length > 0) {
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(data, (memSizeType) length))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          memcpy_to_strelem(data->mem, (const_ustriType) buffer,
+                            (memSizeType) length);
+          data->size = (memSizeType) length;
+        } /* if */
+        PQfreemem(buffer);
+      } else {
+        if (length == -1) {
+          /* All data has been received. */
+          err_info = finishCopy(db, "sqlCopyGet");
+        } else {
+          setDbErrorMsg("sqlCopyGet", "PQgetCopyData", db->connection);
+          logError(printf("sqlCopyGet: PQgetCopyData failed:\n%s",
+                          dbError.message););
+          finishCopy(db, "sqlCopyGet");
+          err_info = DATABASE_ERROR;
+        } /* if */
+        if (likely(err_info == OKAY_NO_ERROR) &&
+            unlikely(!ALLOC_STRI_SIZE_OK(data, 0))) {
+          err_info = MEMORY_ERROR;
+        } else if (data != NULL) {
+          data->size = 0;
+        } /* if */
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+      data = NULL;
+    } /* if */
+    logFunction(printf("sqlCopyGet --> \"%s\"\n", striAsUnquotedCStri(data)););
+    return data;
+  } /* sqlCopyGet */
+
+
+
+static void sqlCopyPut (databaseType database, const const_striType data)
+
+  {
+    dbType db;
+    ucharType buffer[COPY_BUFFER_SIZE];
+    memSizeType position = 0;
+    memSizeType length;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlCopyPut */
+    logFunction(printf("sqlCopyPut(" FMT_U_MEM ", \"%s\")\n",
+                       (memSizeType) database, striAsUnquotedCStri(data)););
+    db = (dbType) database;
+    if (unlikely(db->copyStatus != PGRES_COPY_IN)) {
+      logError(printf("sqlCopyPut: No COPY FROM STDIN active.\n"););
+      err_info = RANGE_ERROR;
+    } else {
+      while (position < data->size && err_info == OKAY_NO_ERROR) {
+        length = data->size - position;
+        if (length > COPY_BUFFER_SIZE) {
+          length = COPY_BUFFER_SIZE;
+        } /* if */
+        if (unlikely(memcpy_from_strelem(buffer, &data->mem[position], length))) {
+          logError(printf("sqlCopyPut: Character beyond '\\255;' in data.\n"););
+          err_info = RANGE_ERROR;
+        } else if (unlikely(PQputCopyData(db->connection, (const char *) buffer,
+                                          (int) length) != 1)) {
+          setDbErrorMsg("sqlCopyPut", "PQputCopyData", db->connection);
+          logError(printf("sqlCopyPut: PQputCopyData failed:\n%s",
+                          dbError.message););
+          err_info = DATABASE_ERROR;
+        } else {
+          position += length;
+        } /* if */
+      } /* while */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("sqlCopyPut -->\n"););
+  } /* sqlCopyPut */
+
+
+
+static boolType sqlCopyStart (databaseType database,
+    const const_striType copyStatement)
+
+  {
+    dbType db;
+    cstriType query;
+    PGresult *copy_result;
+    ExecStatusType status;
+    errInfoType err_info = OKAY_NO_ERROR;
+    boolType copyIn = FALSE;
+
+  /* sqlCopyStart */
+    logFunction(printf("sqlCopyStart(" FMT_U_MEM ", \"%s\")\n",
+                       (memSizeType) database,
+                       striAsUnquotedCStri(copyStatement)););
+    db = (dbType) database;
+    if (unlikely(db->connection == NULL)) {
+      logError(printf("sqlCopyStart: Database is not open.\n"););
+      err_info = RANGE_ERROR;
+    } else if (unlikely(db->copyStatus != PGRES_EMPTY_QUERY)) {
+      logError(printf("sqlCopyStart: A COPY is already active.\n"););
+      err_info = RANGE_ERROR;
+    } else {
+      query = stri_to_cstri8(copyStatement, &err_info);
+      if (likely(query != NULL)) {
+        suspendStreaming(db);
+        copy_result = PQexec(db->connection, query);
+        if (unlikely(copy_result == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          status = PQresultStatus(copy_result);
+          if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT) {
+            db->copyStatus = status;
+            copyIn = status == PGRES_COPY_IN;
+          } else if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+            dbLibError("sqlCopyStart", "PQexec",
+                       "The statement is neither COPY FROM STDIN "
+                       "nor COPY TO STDOUT.\n");
+            logError(printf("sqlCopyStart: \"%s\" is not a COPY statement.\n",
+                            query););
+            err_info = DATABASE_ERROR;
+          } else {
+            setDbErrorMsg("sqlCopyStart", "PQexec", db->connection);
+            logError(printf("sqlCopyStart: PQexec(" FMT_U_MEM ", \"%s\") "
+                            "returns a status of %s:\n%s",
+                            (memSizeType) db->connection, query,
+                            PQresStatus(status), dbError.message););
+            err_info = DATABASE_ERROR;
+          } /* if */
+          PQclear(copy_result);
+        } /* if */
+        free_cstri8(query, copyStatement);
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("sqlCopyStart --> %d\n", copyIn););
+    return copyIn;
+  } /* sqlCopyStart */
+
+
+
 static void sqlExecute (sqlStmtType sqlStatement)
 
   {
@@ -3199,20 +3703,33 @@ static void sqlExecute (sqlStmtType sqlStatement)
       raise_error(DATABASE_ERROR);
     } else {
       preparedStmt->fetchOkay = FALSE;
+      endStream(preparedStmt);
+      suspendStreaming(preparedStmt->db);
       if (preparedStmt->execute_result != NULL) {
         PQclear(preparedStmt->execute_result);
       } /* if */
-      preparedStmt->execute_result = PQexecPrepared(preparedStmt->db->connection,
-                                                    preparedStmt->stmtName,
-                                                    (int) preparedStmt->param_array_size,
-                                                    (const const_cstriType *) preparedStmt->paramValues,
-                                                    preparedStmt->paramLengths,
-                                                    preparedStmt->paramFormats,
-                                                    1);
+      if (preparedStmt->result_column_count != 0 &&
+          FUNCTION_PRESENT(PQsendQueryPrepared) &&
+          FUNCTION_PRESENT(PQsetSingleRowMode) &&
+          FUNCTION_PRESENT(PQgetResult)) {
+        /* Rows are received one by one instead of all at once. */
+        preparedStmt->execute_result = startStream(preparedStmt, &err_info);
+      } else {
+        preparedStmt->execute_result = PQexecPrepared(preparedStmt->db->connection,
+                                                      preparedStmt->stmtName,
+                                                      (int) preparedStmt->param_array_size,
+                                                      (const const_cstriType *) preparedStmt->paramValues,
+                                                      preparedStmt->paramLengths,
+                                                      preparedStmt->paramFormats,
+                                                      1);
+        if (unlikely(preparedStmt->execute_result == NULL)) {
+          logError(printf("sqlExecute: PQexecPrepared returns NULL\n"););
+          err_info = MEMORY_ERROR;
+        } /* if */
+      } /* if */
       if (unlikely(preparedStmt->execute_result == NULL)) {
-        logError(printf("sqlExecute: PQexecPrepared returns NULL\n"););
         preparedStmt->executeSuccessful = FALSE;
-        raise_error(MEMORY_ERROR);
+        raise_error(err_info);
       } else {
         preparedStmt->execute_status = PQresultStatus(preparedStmt->execute_result);
         if (preparedStmt->execute_status == PGRES_COMMAND_OK) {
@@ -3246,6 +3763,15 @@ static void sqlExecute (sqlStmtType sqlStatement)
             preparedStmt->fetch_index = 0;
             preparedStmt->increment_index = FALSE;
           } /* if */
+        } else if (preparedStmt->execute_status == PGRES_SINGLE_TUPLE) {
+          /* The result contains the first row. Further rows are */
+          /* received by sqlFetch.                              */
+          preparedStmt->executeSuccessful = TRUE;
+          preparedStmt->streaming = TRUE;
+          preparedStmt->db->streamingStmt = sqlStatement;
+          preparedStmt->num_tuples = 1;
+          preparedStmt->fetch_index = 0;
+          preparedStmt->increment_index = FALSE;
         } else {
           setDbErrorMsg("sqlExecute", "PQexecPrepared", preparedStmt->db->connection);
           logError(printf("sqlExecute: PQexecPrepared returns a status of %s:\n%s",
@@ -3287,6 +3813,14 @@ static boolType sqlFetch (sqlStmtType sqlStatement)
       } /* if */
       preparedStmt->fetchOkay =
           preparedStmt->fetch_index < preparedStmt->num_tuples;
+    } else if (preparedStmt->execute_status == PGRES_SINGLE_TUPLE) {
+      if (!preparedStmt->increment_index) {
+        /* The first row was received by sqlExecute. */
+        preparedStmt->increment_index = TRUE;
+        preparedStmt->fetchOkay = TRUE;
+      } else {
+        preparedStmt->fetchOkay = fetchStreamedRow(preparedStmt);
+      } /* if */
     } else {
       preparedStmt->fetchOkay = FALSE;
     } /* if */
@@ -3382,6 +3916,7 @@ static sqlStmtType sqlPrepare (databaseType database,
             err_info = MEMORY_ERROR;
           } else {
             memset(preparedStmt, 0, sizeof(preparedStmtRecordPost));
+            suspendStreaming(db);
             preparedStmt->stmtNum = db->nextStmtNum;
             db->nextStmtNum++;
             sprintf(preparedStmt->stmtName, "prepstat_" FMT_U, preparedStmt->stmtNum);
@@ -3451,6 +3986,7 @@ static void sqlRollback (databaseType database)
       logError(printf("sqlRollback: Database is not open.\n"););
       raise_error(RANGE_ERROR);
     } else if (!db->autoCommit) {
+      suspendStreaming(db);
       err_info = doExecSql(db->connection, "ROLLBACK", err_info);
       err_info = doExecSql(db->connection, "BEGIN TRANSACTION", err_info);
       if (unlikely(err_info != OKAY_NO_ERROR)) {
@@ -3477,6 +4013,7 @@ static void sqlSetAutoCommit (databaseType database, boolType autoCommit)
       raise_error(RANGE_ERROR);
     } else {
       if (db->autoCommit != autoCommit) {
+        suspendStreaming(db);
         if (autoCommit) {
           err_info = doExecSql(db->connection, "COMMIT", err_info);
         } else {
@@ -3589,6 +4126,16 @@ static boolType setupFuncTable (void)
         sqlFunc->sqlColumnStri      = &sqlColumnStri;
         sqlFunc->sqlColumnTime      = &sqlColumnTime;
         sqlFunc->sqlCommit          = &sqlCommit;
+        if (FUNCTION_PRESENT(PQfreemem) &&
+            FUNCTION_PRESENT(PQgetCopyData) &&
+            FUNCTION_PRESENT(PQgetResult) &&
+            FUNCTION_PRESENT(PQputCopyData) &&
+            FUNCTION_PRESENT(PQputCopyEnd)) {
+          sqlFunc->sqlCopyEnd       = &sqlCopyEnd;
+          sqlFunc->sqlCopyGet       = &sqlCopyGet;
+          sqlFunc->sqlCopyPut       = &sqlCopyPut;
+          sqlFunc->sqlCopyStart     = &sqlCopyStart;
+        } /* if */
         sqlFunc->sqlExecute         = &sqlExecute;
         sqlFunc->sqlFetch           = &sqlFetch;
         sqlFunc->sqlGetAutoCommit   = &sqlGetAutoCommit;
@@ -24,7 +24,7 @@
 /*                                                                  */
 /*  Module: Seed7 Runtime Library                                   */
 /*  File: seed7/src/sql_rtl.c                                       */
-/*  Changes: 2014, 2015, 2017 - 2020  Thomas Mertes                 */
+/*  Changes: 2014, 2015, 2017 - 2020, 2024  Thomas Mertes           */
 /*  Content: Database access functions.                             */
 /*                                                                  */
 /********************************************************************/
@@ -36,11 +36,13 @@
 
 #include "stdlib.h"
 #include "stdio.h"
+#include "string.h"
 #include "math.h"
 #include "float.h"
 
 #include "common.h"
 #include "data_rtl.h"
+#include "heaputl.h"
 #include "striutl.h"
 #include "flt_rtl.h"
 #include "big_drv.h"
@@ -55,6 +57,7 @@
 
 #define ENCODE_INFINITY 0
 #define ENCODE_NAN 0
+#define MAX_BATCH_COLUMNS 65535
 
 
 typedef struct dbStruct {
@@ -66,10 +69,306 @@ typedef struct dbStruct {
 typedef struct preparedStmtStruct {
     uintType     usage_count;
     sqlFuncType  sqlFunc;
+    sqlBatchRecord batch;
+    sqlBatchRecord fetched;
   } preparedStmtRecord, *preparedStmtType;
 
 
 
+static void freeBatchColumn (sqlBatchColumnType column, memSizeType numRows)
+
+  {
+    memSizeType row;
+
+  /* freeBatchColumn */
+    if (numRows != 0) {
+      switch (column->type) {
+        case SQL_BATCH_INT:
+          FREE_TABLE(column->data.intValues, intType, numRows);
+          break;
+        case SQL_BATCH_FLOAT:
+          FREE_TABLE(column->data.floatValues, floatType, numRows);
+          break;
+        case SQL_BATCH_STRI:
+          for (row = 0; row < numRows; row++) {
+            if (column->data.striValues[row] != NULL) {
+              FREE_STRI(column->data.striValues[row],
+                        column->data.striValues[row]->size);
+            } /* if */
+          } /* for */
+          FREE_TABLE(column->data.striValues, striType, numRows);
+          break;
+      } /* switch */
+    } /* if */
+    column->type = SQL_BATCH_UNBOUND;
+  } /* freeBatchColumn */
+
+
+
+static void freeBatch (sqlBatchType batch)
+
+  {
+    memSizeType column;
+
+  /* freeBatch */
+    if (batch->numColumns != 0) {
+      for (column = 0; column < batch->numColumns; column++) {
+        freeBatchColumn(&batch->columns[column], batch->numRows);
+      } /* for */
+      FREE_TABLE(batch->columns, sqlBatchColumnRecord, batch->numColumns);
+    } /* if */
+    memset(batch, 0, sizeof(sqlBatchRecord));
+  } /* freeBatch */
+
+
+
+/**
+ *  Get the column 'pos' of the batch of 'preparedStmt'.
+ *  A batch that has already been executed is discarded and a new
+ *  batch is started. All columns of a batch must have the same
+ *  number of rows. A column that has already been bound is freed.
+ *  @return the unbound column, or NULL if an error occurred.
+ */
+static sqlBatchColumnType getBatchColumn (preparedStmtType preparedStmt,
+    intType pos, memSizeType numRows, errInfoType *err_info)
+
+  {
+    sqlBatchType batch;
+    sqlBatchColumnType resizedColumns;
+    sqlBatchColumnType column = NULL;
+
+  /* getBatchColumn */
+    batch = &preparedStmt->batch;
+    if (batch->executed) {
+      freeBatch(batch);
+    } /* if */
+    if (unlikely(pos < 1 || pos > MAX_BATCH_COLUMNS)) {
+      logError(printf("getBatchColumn: pos: " FMT_D " not in allowed range.\n",
+                      pos););
+      *err_info = RANGE_ERROR;
+    } else if (unlikely(batch->numColumns != 0 && batch->numRows != numRows)) {
+      logError(printf("getBatchColumn: Number of rows " FMT_U_MEM
+                      " differs from the batch size " FMT_U_MEM ".\n",
+                      numRows, batch->numRows););
+      *err_info = RANGE_ERROR;
+    } else {
+      if ((memSizeType) pos > batch->numColumns) {
+        resizedColumns = REALLOC_TABLE(batch->columns, sqlBatchColumnRecord,
+                                       batch->numColumns, (memSizeType) pos);
+        if (unlikely(resizedColumns == NULL)) {
+          *err_info = MEMORY_ERROR;
+        } else {
+          COUNT3_TABLE(sqlBatchColumnRecord, batch->numColumns, (memSizeType) pos);
+          memset(&resizedColumns[batch->numColumns], 0,
+                 ((memSizeType) pos - batch->numColumns) * sizeof(sqlBatchColumnRecord));
+          batch->columns = resizedColumns;
+          batch->numColumns = (memSizeType) pos;
+        } /* if */
+      } /* if */
+      if (likely(*err_info == OKAY_NO_ERROR)) {
+        batch->numRows = numRows;
+        column = &batch->columns[pos - 1];
+        freeBatchColumn(column, numRows);
+      } /* if */
+    } /* if */
+    return column;
+  } /* getBatchColumn */
+
+
+
+static void freeFetchedValues (sqlBatchType fetched)
+
+  {
+    memSizeType pos;
+    sqlBatchColumnType column;
+    memSizeType row;
+
+  /* freeFetchedValues */
+    if (fetched->capacity != 0) {
+      for (pos = 0; pos < fetched->numColumns; pos++) {
+        column = &fetched->columns[pos];
+        switch (column->type) {
+          case SQL_BATCH_INT:
+            FREE_TABLE(column->data.intValues, intType, fetched->capacity);
+            break;
+          case SQL_BATCH_FLOAT:
+            FREE_TABLE(column->data.floatValues, floatType, fetched->capacity);
+            break;
+          case SQL_BATCH_STRI:
+            for (row = 0; row < fetched->numRows; row++) {
+              if (column->data.striValues[row] != NULL) {
+                FREE_STRI(column->data.striValues[row],
+                          column->data.striValues[row]->size);
+              } /* if */
+            } /* for */
+            FREE_TABLE(column->data.striValues, striType, fetched->capacity);
+            break;
+        } /* switch */
+        column->data.intValues = NULL;
+      } /* for */
+    } /* if */
+    fetched->numRows = 0;
+    fetched->capacity = 0;
+  } /* freeFetchedValues */
+
+
+
+static void freeFetched (sqlBatchType fetched)
+
+  { /* freeFetched */
+    freeFetchedValues(fetched);
+    if (fetched->numColumns != 0) {
+      FREE_TABLE(fetched->columns, sqlBatchColumnRecord, fetched->numColumns);
+    } /* if */
+    memset(fetched, 0, sizeof(sqlBatchRecord));
+  } /* freeFetched */
+
+
+
+/**
+ *  Enlarge the collected columns of 'fetched' to 'capacity' rows.
+ *  The capacity is only changed if all columns could be enlarged.
+ */
+static errInfoType growFetched (sqlBatchType fetched, memSizeType capacity)
+
+  {
+    memSizeType pos;
+    sqlBatchColumnType column;
+    void *resized;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* growFetched */
+    for (pos = 0; pos < fetched->numColumns && err_info == OKAY_NO_ERROR; pos++) {
+      column = &fetched->columns[pos];
+      switch (column->type) {
+        case SQL_BATCH_INT:
+          resized = REALLOC_TABLE(column->data.intValues, intType,
+                                  fetched->capacity, capacity);
+          break;
+        case SQL_BATCH_FLOAT:
+          resized = REALLOC_TABLE(column->data.floatValues, floatType,
+                                  fetched->capacity, capacity);
+          break;
+        case SQL_BATCH_STRI:
+          resized = REALLOC_TABLE(column->data.striValues, striType,
+                                  fetched->capacity, capacity);
+          break;
+        default:
+          resized = column->data.intValues;
+          break;
+      } /* switch */
+      if (unlikely(resized == NULL && column->type != SQL_BATCH_UNBOUND)) {
+        err_info = MEMORY_ERROR;
+      } else {
+        column->data.intValues = (intType *) resized;
+      } /* if */
+    } /* for */
+    if (likely(err_info == OKAY_NO_ERROR)) {
+      COUNT3_TABLE(intType, fetched->capacity, capacity);
+      fetched->capacity = capacity;
+    } /* if */
+    return err_info;
+  } /* growFetched */
+
+
+
+/**
+ *  Get a collected column of the rows fetched with sqlFetchRows.
+ *  @return the collected column, or NULL if 'column' has not been
+ *          collected as 'columnType'.
+ */
+static const sqlBatchColumnRecord *getFetchedColumn (
+    const_sqlStmtType sqlStatement, intType column, int columnType)
+
+  {
+    const preparedStmtRecord *preparedStmt;
+    const sqlBatchColumnRecord *fetchedColumn = NULL;
+
+  /* getFetchedColumn */
+    preparedStmt = (const preparedStmtRecord *) sqlStatement;
+    if (unlikely(preparedStmt == NULL || column < 1 ||
+                 (uintType) column > preparedStmt->fetched.numColumns)) {
+      logError(printf("getFetchedColumn(" FMT_U_MEM ", " FMT_D "): "
+                      "Column not collected.\n",
+                      (memSizeType) sqlStatement, column););
+    } else {
+      fetchedColumn = &preparedStmt->fetched.columns[column - 1];
+      if (unlikely(fetchedColumn->type != columnType)) {
+        logError(printf("getFetchedColumn(" FMT_U_MEM ", " FMT_D "): "
+                        "Column collected with type %d instead of %d.\n",
+                        (memSizeType) sqlStatement, column,
+                        fetchedColumn->type, columnType););
+        fetchedColumn = NULL;
+      } /* if */
+    } /* if */
+    return fetchedColumn;
+  } /* getFetchedColumn */
+
+
+
+/**
+ *  Bind the values of one row of the batch to a prepared SQL statement.
+ *  This is used to execute a batch row by row, if the driver cannot
+ *  execute the whole batch at once (see sqlExecuteBatch).
+ *  @param sqlStatement Prepared statement.
+ *  @param row Row of the batch (starting with 1).
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'row' is not a row of the batch or
+ *                         if a value cannot be converted.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+void sqlBindBatchRow (sqlStmtType sqlStatement, intType row)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlBatchColumnType column;
+    memSizeType index;
+    memSizeType pos;
+
+  /* sqlBindBatchRow */
+    logFunction(printf("sqlBindBatchRow(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, row););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(preparedStmt == NULL ||
+                 preparedStmt->sqlFunc == NULL ||
+                 preparedStmt->sqlFunc->sqlBindFloat == NULL ||
+                 preparedStmt->sqlFunc->sqlBindInt == NULL ||
+                 preparedStmt->sqlFunc->sqlBindStri == NULL)) {
+      logError(printf("sqlBindBatchRow(" FMT_U_MEM ", " FMT_D "): "
+                      "SQL statement not okay.\n",
+                      (memSizeType) sqlStatement, row););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(row < 1 ||
+                        (uintType) row > preparedStmt->batch.numRows)) {
+      logError(printf("sqlBindBatchRow(" FMT_U_MEM ", " FMT_D "): "
+                      "Row not in batch of " FMT_U_MEM " rows.\n",
+                      (memSizeType) sqlStatement, row,
+                      preparedStmt->batch.numRows););
+      raise_error(RANGE_ERROR);
+    } else {
+      index = (memSizeType) row - 1;
+      for (pos = 1; pos <= preparedStmt->batch.numColumns; pos++) {
+        column = &preparedStmt->batch.columns[pos - 1];
+        switch (column->type) {
+          case SQL_BATCH_INT:
+            preparedStmt->sqlFunc->sqlBindInt(sqlStatement, (intType) pos,
+                column->data.intValues[index]);
+            break;
+          case SQL_BATCH_FLOAT:
+            preparedStmt->sqlFunc->sqlBindFloat(sqlStatement, (intType) pos,
+                column->data.floatValues[index]);
+            break;
+          case SQL_BATCH_STRI:
+            preparedStmt->sqlFunc->sqlBindStri(sqlStatement, (intType) pos,
+                column->data.striValues[index]);
+            break;
+        } /* switch */
+      } /* for */
+    } /* if */
+  } /* sqlBindBatchRow */
+
+
+
 /**
  *  Bind a bigInteger parameter to a prepared SQL statement.
  *  @param sqlStatement Prepared statement.
@@ -281,6 +580,79 @@ void sqlBindFloat (sqlStmtType sqlStatement, intType pos, floatType value)
 
 
 
+/**
+ *  Bind an array of float values to a bind variable of a prepared statement.
+ *  Element i of 'values' is used for row i of the batch. All arrays
+ *  bound to a batch must have the same length. The batch is executed
+ *  with sqlExecuteBatch. Binding an array after the batch has been
+ *  executed starts a new batch.
+ *  @param sqlStatement Prepared statement.
+ *  @param pos Position of the bind variable (starting with 1).
+ *  @param values Values for the rows of the batch.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'pos' is negative or too big or
+ *                         if the length of 'values' differs from the batch or
+ *                         if a value cannot be converted.
+ *  @exception MEMORY_ERROR Not enough memory to store the values.
+ */
+void sqlBindFloatArray (sqlStmtType sqlStatement, intType pos,
+    const const_rtlArrayType values)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlBatchColumnType column = NULL;
+    memSizeType numRows;
+    memSizeType row;
+    floatType *floatValues = NULL;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlBindFloatArray */
+    logFunction(printf("sqlBindFloatArray(" FMT_U_MEM ", " FMT_D ", *)\n",
+                       (memSizeType) sqlStatement, pos););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    numRows = arraySize(values);
+    if (unlikely(preparedStmt == NULL || preparedStmt->sqlFunc == NULL)) {
+      logError(printf("sqlBindFloatArray(" FMT_U_MEM ", " FMT_D ", *): "
+                      "SQL statement not okay.\n",
+                      (memSizeType) sqlStatement, pos););
+      err_info = RANGE_ERROR;
+    } else if (unlikely(numRows != 0 &&
+                        !ALLOC_TABLE(floatValues, floatType, numRows))) {
+      err_info = MEMORY_ERROR;
+    } else {
+      for (row = 0; row < numRows && err_info == OKAY_NO_ERROR; row++) {
+        floatValues[row] = values->arr[row].value.floatValue;
+#if !ENCODE_INFINITY
+        if (unlikely(floatValues[row] == POSITIVE_INFINITY ||
+                     floatValues[row] == NEGATIVE_INFINITY)) {
+          err_info = RANGE_ERROR;
+        } /* if */
+#endif
+#if !ENCODE_NAN
+        if (unlikely(os_isnan(floatValues[row]))) {
+          err_info = RANGE_ERROR;
+        } /* if */
+#endif
+      } /* for */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        column = getBatchColumn(preparedStmt, pos, numRows, &err_info);
+      } /* if */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        if (numRows != 0) {
+          FREE_TABLE(floatValues, floatType, numRows);
+        } /* if */
+      } else {
+        column->type = SQL_BATCH_FLOAT;
+        column->data.floatValues = floatValues;
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* sqlBindFloatArray */
+
+
+
 /**
  *  Bind an integer parameter to a prepared SQL statement.
  *  @param sqlStatement Prepared statement.
@@ -310,6 +682,65 @@ void sqlBindInt (sqlStmtType sqlStatement, intType pos, intType value)
 
 
 
+/**
+ *  Bind an array of integer values to a bind variable of a prepared statement.
+ *  Element i of 'values' is used for row i of the batch. All arrays
+ *  bound to a batch must have the same length. The batch is executed
+ *  with sqlExecuteBatch. Binding an array after the batch has been
+ *  executed starts a new batch.
+ *  @param sqlStatement Prepared statement.
+ *  @param pos Position of the bind variable (starting with 1).
+ *  @param values Values for the rows of the batch.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'pos' is negative or too big or
+ *                         if the length of 'values' differs from the batch.
+ *  @exception MEMORY_ERROR Not enough memory to store the values.
+ */
+void sqlBindIntArray (sqlStmtType sqlStatement, intType pos,
+    const const_rtlArrayType values)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlBatchColumnType column;
+    memSizeType numRows;
+    memSizeType row;
+    intType *intValues = NULL;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlBindIntArray */
+    logFunction(printf("sqlBindIntArray(" FMT_U_MEM ", " FMT_D ", *)\n",
+                       (memSizeType) sqlStatement, pos););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    numRows = arraySize(values);
+    if (unlikely(preparedStmt == NULL || preparedStmt->sqlFunc == NULL)) {
+      logError(printf("sqlBindIntArray(" FMT_U_MEM ", " FMT_D ", *): "
+                      "SQL statement not okay.\n",
+                      (memSizeType) sqlStatement, pos););
+      err_info = RANGE_ERROR;
+    } else if (unlikely(numRows != 0 &&
+                        !ALLOC_TABLE(intValues, intType, numRows))) {
+      err_info = MEMORY_ERROR;
+    } else {
+      for (row = 0; row < numRows; row++) {
+        intValues[row] = values->arr[row].value.intValue;
+      } /* for */
+      column = getBatchColumn(preparedStmt, pos, numRows, &err_info);
+      if (unlikely(column == NULL)) {
+        if (numRows != 0) {
+          FREE_TABLE(intValues, intType, numRows);
+        } /* if */
+      } else {
+        column->type = SQL_BATCH_INT;
+        column->data.intValues = intValues;
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* sqlBindIntArray */
+
+
+
 /**
  *  Bind a NULL parameter to a prepared SQL statement.
  *  @param sqlStatement Prepared statement.
@@ -367,6 +798,80 @@ void sqlBindStri (sqlStmtType sqlStatement, intType pos,
 
 
 
+/**
+ *  Bind an array of string values to a bind variable of a prepared statement.
+ *  Element i of 'values' is used for row i of the batch. All arrays
+ *  bound to a batch must have the same length. The batch is executed
+ *  with sqlExecuteBatch. Binding an array after the batch has been
+ *  executed starts a new batch.
+ *  @param sqlStatement Prepared statement.
+ *  @param pos Position of the bind variable (starting with 1).
+ *  @param values Values for the rows of the batch.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'pos' is negative or too big or
+ *                         if the length of 'values' differs from the batch.
+ *  @exception MEMORY_ERROR Not enough memory to store the values.
+ */
+void sqlBindStriArray (sqlStmtType sqlStatement, intType pos,
+    const const_rtlArrayType values)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlBatchColumnType column = NULL;
+    memSizeType numRows;
+    memSizeType row = 0;
+    const_striType stri;
+    striType *striValues = NULL;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlBindStriArray */
+    logFunction(printf("sqlBindStriArray(" FMT_U_MEM ", " FMT_D ", *)\n",
+                       (memSizeType) sqlStatement, pos););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    numRows = arraySize(values);
+    if (unlikely(preparedStmt == NULL || preparedStmt->sqlFunc == NULL)) {
+      logError(printf("sqlBindStriArray(" FMT_U_MEM ", " FMT_D ", *): "
+                      "SQL statement not okay.\n",
+                      (memSizeType) sqlStatement, pos););
+      err_info = RANGE_ERROR;
+    } else if (unlikely(numRows != 0 &&
+                        !ALLOC_TABLE(striValues, striType, numRows))) {
+      err_info = MEMORY_ERROR;
+    } else {
+      while (row < numRows && err_info == OKAY_NO_ERROR) {
+        stri = values->arr[row].value.striValue;
+        if (unlikely(!ALLOC_STRI_SIZE_OK(striValues[row], stri->size))) {
+          err_info = MEMORY_ERROR;
+        } else {
+          striValues[row]->size = stri->size;
+          memcpy(striValues[row]->mem, stri->mem,
+                 stri->size * sizeof(strElemType));
+          row++;
+        } /* if */
+      } /* while */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        column = getBatchColumn(preparedStmt, pos, numRows, &err_info);
+      } /* if */
+      if (unlikely(column == NULL)) {
+        while (row > 0) {
+          row--;
+          FREE_STRI(striValues[row], striValues[row]->size);
+        } /* while */
+        if (numRows != 0) {
+          FREE_TABLE(striValues, striType, numRows);
+        } /* if */
+      } else {
+        column->type = SQL_BATCH_STRI;
+        column->data.striValues = striValues;
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* sqlBindStriArray */
+
+
+
 /**
  *  Bind a time parameter to a prepared SQL statement.
  *  @param sqlStatement Prepared statement.
@@ -435,6 +940,70 @@ void sqlClose (databaseType database)
 
 
 
+/**
+ *  Declare that a column of the result data is collected by sqlFetchRows.
+ *  The collected values of the column can be obtained with
+ *  sqlColumnIntArray, sqlColumnFloatArray or sqlColumnStriArray.
+ *  Declaring a column discards the rows fetched so far.
+ *  @param sqlStatement Prepared statement.
+ *  @param column Number of the column (starting with 1).
+ *  @param columnType SQL_BATCH_INT, SQL_BATCH_FLOAT or SQL_BATCH_STRI.
+ *                    SQL_BATCH_UNBOUND stops collecting the column.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if 'column' is negative or too big or
+ *                         if 'columnType' is not allowed.
+ *  @exception MEMORY_ERROR Not enough memory to store the column.
+ */
+void sqlCollectColumn (sqlStmtType sqlStatement, intType column,
+    intType columnType)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlBatchType fetched;
+    sqlBatchColumnType resizedColumns;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* sqlCollectColumn */
+    logFunction(printf("sqlCollectColumn(" FMT_U_MEM ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column, columnType););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(preparedStmt == NULL || preparedStmt->sqlFunc == NULL ||
+                 column < 1 || column > MAX_BATCH_COLUMNS ||
+                 columnType < SQL_BATCH_UNBOUND ||
+                 columnType > SQL_BATCH_STRI)) {
+      logError(printf("sqlCollectColumn(" FMT_U_MEM ", " FMT_D ", " FMT_D "): "
+                      "SQL statement not okay or column not in allowed range.\n",
+                      (memSizeType) sqlStatement, column, columnType););
+      err_info = RANGE_ERROR;
+    } else {
+      fetched = &preparedStmt->fetched;
+      freeFetchedValues(fetched);
+      if ((memSizeType) column > fetched->numColumns) {
+        resizedColumns = REALLOC_TABLE(fetched->columns, sqlBatchColumnRecord,
+                                       fetched->numColumns, (memSizeType) column);
+        if (unlikely(resizedColumns == NULL)) {
+          err_info = MEMORY_ERROR;
+        } else {
+          COUNT3_TABLE(sqlBatchColumnRecord, fetched->numColumns,
+                       (memSizeType) column);
+          memset(&resizedColumns[fetched->numColumns], 0,
+                 ((memSizeType) column - fetched->numColumns) *
+                 sizeof(sqlBatchColumnRecord));
+          fetched->columns = resizedColumns;
+          fetched->numColumns = (memSizeType) column;
+        } /* if */
+      } /* if */
+      if (likely(err_info == OKAY_NO_ERROR)) {
+        fetched->columns[column - 1].type = (int) columnType;
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* sqlCollectColumn */
+
+
+
 /**
  *  Get the specified column of fetched data as bigInteger.
  *  If the column data is NULL it is interpreted as 0_.
@@ -689,6 +1258,53 @@ floatType sqlColumnFloat (sqlStmtType sqlStatement, intType column)
 
 
 
+/**
+ *  Get the values of a column collected by sqlFetchRows as array of float.
+ *  Element i of the result contains the column of row i.
+ *  NULL values are represented as 0.0.
+ *  @param sqlStatement Prepared statement for which rows were fetched.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column of all fetched rows.
+ *  @exception RANGE_ERROR If the column was not collected as float.
+ *  @exception MEMORY_ERROR Not enough memory to create the array.
+ */
+rtlArrayType sqlColumnFloatArray (sqlStmtType sqlStatement, intType column)
+
+  {
+    const sqlBatchColumnRecord *fetchedColumn;
+    memSizeType numRows;
+    memSizeType row;
+    rtlArrayType columnArray;
+
+  /* sqlColumnFloatArray */
+    logFunction(printf("sqlColumnFloatArray(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    fetchedColumn = getFetchedColumn(sqlStatement, column, SQL_BATCH_FLOAT);
+    if (unlikely(fetchedColumn == NULL)) {
+      raise_error(RANGE_ERROR);
+      columnArray = NULL;
+    } else {
+      numRows = ((const preparedStmtRecord *) sqlStatement)->fetched.numRows;
+      if (unlikely(numRows > MAX_RTL_ARR_LEN ||
+                   !ALLOC_RTL_ARRAY(columnArray, numRows))) {
+        raise_error(MEMORY_ERROR);
+        columnArray = NULL;
+      } else {
+        columnArray->min_position = 1;
+        columnArray->max_position = (intType) numRows;
+        for (row = 0; row < numRows; row++) {
+          columnArray->arr[row].value.floatValue =
+              fetchedColumn->data.floatValues[row];
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlColumnFloatArray --> " FMT_U_MEM "\n",
+                       (memSizeType) columnArray););
+    return columnArray;
+  } /* sqlColumnFloatArray */
+
+
+
 /**
  *  Get the specified column of fetched data as integer.
  *  If the column data is NULL it is interpreted as 0.
@@ -729,6 +1345,53 @@ intType sqlColumnInt (sqlStmtType sqlStatement, intType column)
 
 
 
+/**
+ *  Get the values of a column collected by sqlFetchRows as array of integer.
+ *  Element i of the result contains the column of row i.
+ *  NULL values are represented as 0.
+ *  @param sqlStatement Prepared statement for which rows were fetched.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column of all fetched rows.
+ *  @exception RANGE_ERROR If the column was not collected as integer.
+ *  @exception MEMORY_ERROR Not enough memory to create the array.
+ */
+rtlArrayType sqlColumnIntArray (sqlStmtType sqlStatement, intType column)
+
+  {
+    const sqlBatchColumnRecord *fetchedColumn;
+    memSizeType numRows;
+    memSizeType row;
+    rtlArrayType columnArray;
+
+  /* sqlColumnIntArray */
+    logFunction(printf("sqlColumnIntArray(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    fetchedColumn = getFetchedColumn(sqlStatement, column, SQL_BATCH_INT);
+    if (unlikely(fetchedColumn == NULL)) {
+      raise_error(RANGE_ERROR);
+      columnArray = NULL;
+    } else {
+      numRows = ((const preparedStmtRecord *) sqlStatement)->fetched.numRows;
+      if (unlikely(numRows > MAX_RTL_ARR_LEN ||
+                   !ALLOC_RTL_ARRAY(columnArray, numRows))) {
+        raise_error(MEMORY_ERROR);
+        columnArray = NULL;
+      } else {
+        columnArray->min_position = 1;
+        columnArray->max_position = (intType) numRows;
+        for (row = 0; row < numRows; row++) {
+          columnArray->arr[row].value.intValue =
+              fetchedColumn->data.intValues[row];
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlColumnIntArray --> " FMT_U_MEM "\n",
+                       (memSizeType) columnArray););
+    return columnArray;
+  } /* sqlColumnIntArray */
+
+
+
 /**
  *  Get the specified column of fetched data as string.
  *  If the column data is NULL it is interpreted as "".
@@ -769,6 +1432,68 @@ striType sqlColumnStri (sqlStmtType sqlStatement, intType column)
 
 
 
+/**
+ *  Get the values of a column collected by sqlFetchRows as array of string.
+ *  Element i of the result contains the column of row i.
+ *  NULL values are represented as "".
+ *  @param sqlStatement Prepared statement for which rows were fetched.
+ *  @param column Number of the column (starting with 1).
+ *  @return an array with the column of all fetched rows.
+ *  @exception RANGE_ERROR If the column was not collected as string.
+ *  @exception MEMORY_ERROR Not enough memory to create the array.
+ */
+rtlArrayType sqlColumnStriArray (sqlStmtType sqlStatement, intType column)
+
+  {
+    const sqlBatchColumnRecord *fetchedColumn;
+    memSizeType numRows;
+    memSizeType row;
+    const_striType stri;
+    striType copied;
+    rtlArrayType columnArray;
+
+  /* sqlColumnStriArray */
+    logFunction(printf("sqlColumnStriArray(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, column););
+    fetchedColumn = getFetchedColumn(sqlStatement, column, SQL_BATCH_STRI);
+    if (unlikely(fetchedColumn == NULL)) {
+      raise_error(RANGE_ERROR);
+      columnArray = NULL;
+    } else {
+      numRows = ((const preparedStmtRecord *) sqlStatement)->fetched.numRows;
+      if (unlikely(numRows > MAX_RTL_ARR_LEN ||
+                   !ALLOC_RTL_ARRAY(columnArray, numRows))) {
+        raise_error(MEMORY_ERROR);
+        columnArray = NULL;
+      } else {
+        columnArray->min_position = 1;
+        columnArray->max_position = (intType) numRows;
+        for (row = 0; row < numRows && columnArray != NULL; row++) {
+          stri = fetchedColumn->data.striValues[row];
+          if (unlikely(!ALLOC_STRI_SIZE_OK(copied, stri->size))) {
+            while (row > 0) {
+              row--;
+              FREE_STRI(columnArray->arr[row].value.striValue,
+                        columnArray->arr[row].value.striValue->size);
+            } /* while */
+            FREE_RTL_ARRAY(columnArray, numRows);
+            raise_error(MEMORY_ERROR);
+            columnArray = NULL;
+          } else {
+            copied->size = stri->size;
+            memcpy(copied->mem, stri->mem, stri->size * sizeof(strElemType));
+            columnArray->arr[row].value.striValue = copied;
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlColumnStriArray --> " FMT_U_MEM "\n",
+                       (memSizeType) columnArray););
+    return columnArray;
+  } /* sqlColumnStriArray */
+
+
+
 /**
  *  Get the specified column of fetched data as time.
  *  If the column data is NULL it is interpreted as 0-01-01 00:00:00.
@@ -834,6 +1559,131 @@ void sqlCommit (databaseType database)
 
 
 
+/**
+ *  Finish the COPY started with sqlCopyStart.
+ *  If data is sent to the database the end of the data is signaled
+ *  and the result of the COPY is checked. If data is received from
+ *  the database the remaining data is skipped.
+ *  @exception RANGE_ERROR If the database does not support COPY.
+ *  @exception DATABASE_ERROR If the COPY failed.
+ */
+void sqlCopyEnd (databaseType database)
+
+  { /* sqlCopyEnd */
+    logFunction(printf("sqlCopyEnd(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    if (unlikely(database == NULL ||
+                 ((dbType) database)->sqlFunc == NULL ||
+                 ((dbType) database)->sqlFunc->sqlCopyEnd == NULL)) {
+      logError(printf("sqlCopyEnd(" FMT_U_MEM "): Database not okay.\n",
+                      (memSizeType) database););
+      raise_error(RANGE_ERROR);
+    } else {
+      ((dbType) database)->sqlFunc->sqlCopyEnd(database);
+    } /* if */
+    logFunction(printf("sqlCopyEnd -->\n"););
+  } /* sqlCopyEnd */
+
+
+
+/**
+ *  Receive the next piece of data of a COPY TO STDOUT.
+ *  In text format every piece contains one row.
+ *  @return the data received, or "" if all data has been received.
+ *  @exception RANGE_ERROR If the database does not support COPY or
+ *                         if no COPY TO STDOUT is active.
+ *  @exception DATABASE_ERROR If the COPY failed.
+ */
+striType sqlCopyGet (databaseType database)
+
+  {
+    striType data;
+
+  /* sqlCopyGet */
+    logFunction(printf("sqlCopyGet(" FMT_U_MEM ")\n",
+                       (memSizeType) database););
+    if (unlikely(database == NULL ||
+                 ((dbType) database)->sqlFunc == NULL ||
+                 ((dbType) database)->sqlFunc->sqlCopyGet == NULL)) {
+      logError(printf("sqlCopyGet(" FMT_U_MEM "): Database not okay.\n",
+                      (memSizeType) database););
+      raise_error(RANGE_ERROR);
+      data = NULL;
+    } else {
+      data = ((dbType) database)->sqlFunc->sqlCopyGet(database);
+    } /* if */
+    logFunction(printf("sqlCopyGet --> \"%s\"\n", striAsUnquotedCStri(data)););
+    return data;
+  } /* sqlCopyGet */
+
+
+
+/**
+ *  Send data of a COPY FROM STDIN to the database.
+ *  The data is sent as bytes. It does not need to end at a row boundary.
+ *  @exception RANGE_ERROR If the database does not support COPY or
+ *                         if no COPY FROM STDIN is active or
+ *                         if 'data' contains a character beyond '\255;'.
+ *  @exception DATABASE_ERROR If the data could not be sent.
+ */
+void sqlCopyPut (databaseType database, const const_striType data)
+
+  { /* sqlCopyPut */
+    logFunction(printf("sqlCopyPut(" FMT_U_MEM ", \"%s\")\n",
+                       (memSizeType) database, striAsUnquotedCStri(data)););
+    if (unlikely(database == NULL ||
+                 ((dbType) database)->sqlFunc == NULL ||
+                 ((dbType) database)->sqlFunc->sqlCopyPut == NULL)) {
+      logError(printf("sqlCopyPut(" FMT_U_MEM "): Database not okay.\n",
+                      (memSizeType) database););
+      raise_error(RANGE_ERROR);
+    } else {
+      ((dbType) database)->sqlFunc->sqlCopyPut(database, data);
+    } /* if */
+    logFunction(printf("sqlCopyPut -->\n"););
+  } /* sqlCopyPut */
+
+
+
+/**
+ *  Start a bulk transfer with a COPY statement.
+ *  The statement is either a COPY FROM STDIN, which sends data to the
+ *  database with sqlCopyPut, or a COPY TO STDOUT, which receives data
+ *  from the database with sqlCopyGet. The transfer is finished with
+ *  sqlCopyEnd.
+ *  @return TRUE if data is sent to the database (COPY FROM STDIN),
+ *          FALSE if data is received from the database (COPY TO STDOUT).
+ *  @exception RANGE_ERROR If the database does not support COPY.
+ *  @exception DATABASE_ERROR If the statement fails or
+ *                            if it is not a COPY statement.
+ */
+boolType sqlCopyStart (databaseType database, const const_striType copyStatement)
+
+  {
+    boolType copyIn;
+
+  /* sqlCopyStart */
+    logFunction(printf("sqlCopyStart(" FMT_U_MEM ", \"%s\")\n",
+                       (memSizeType) database,
+                       striAsUnquotedCStri(copyStatement)););
+    if (unlikely(database == NULL ||
+                 ((dbType) database)->sqlFunc == NULL ||
+                 ((dbType) database)->sqlFunc->sqlCopyStart == NULL)) {
+      logError(printf("sqlCopyStart(" FMT_U_MEM ", \"%s\"): "
+                      "Database not okay or COPY not supported.\n",
+                      (memSizeType) database,
+                      striAsUnquotedCStri(copyStatement)););
+      raise_error(RANGE_ERROR);
+      copyIn = FALSE;
+    } else {
+      copyIn = ((dbType) database)->sqlFunc->sqlCopyStart(database, copyStatement);
+    } /* if */
+    logFunction(printf("sqlCopyStart --> %d\n", copyIn););
+    return copyIn;
+  } /* sqlCopyStart */
+
+
+
 /**
  *  Assign source to *dest.
  *  A copy function assumes that *dest contains a legal value.
@@ -925,6 +1775,8 @@ void sqlCpyStmt (sqlStmtType *const dest, const sqlStmtType source)
           statement_dest->sqlFunc != NULL &&
           statement_dest->sqlFunc->freePreparedStmt != NULL) {
         logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) statement_dest););
+        freeBatch(&statement_dest->batch);
+        freeFetched(&statement_dest->fetched);
         statement_dest->sqlFunc->freePreparedStmt((sqlStmtType) statement_dest);
       } /* if */
     } /* if */
@@ -1108,6 +1960,8 @@ void sqlDestrStmt (const sqlStmtType old_stmt)
           old_statement->sqlFunc != NULL &&
           old_statement->sqlFunc->freePreparedStmt != NULL) {
         logMessage(printf("FREE " FMT_U_MEM "\n", (memSizeType) old_statement););
+        freeBatch(&old_statement->batch);
+        freeFetched(&old_statement->fetched);
         old_statement->sqlFunc->freePreparedStmt((sqlStmtType) old_statement);
         old_statement = NULL;
       } /* if */
@@ -1233,6 +2087,54 @@ void sqlExecute (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Execute a prepared SQL statement once for every row of its batch.
+ *  The batch is defined with sqlBindIntArray, sqlBindFloatArray and
+ *  sqlBindStriArray. Bind variables without an array keep the value
+ *  bound with the scalar bind functions. If the driver supports bulk
+ *  execution all rows are sent to the database at once. Otherwise
+ *  the caller must bind and execute every row with sqlBindBatchRow
+ *  and sqlExecute.
+ *  @param sqlStatement Prepared statement, which should be executed.
+ *  @return 0 if the driver executed the whole batch, or
+ *          the number of rows which must be executed by the caller.
+ *  @exception RANGE_ERROR If the statement was not prepared or
+ *                         if no array has been bound to it or
+ *                         if a value cannot be converted.
+ *  @exception DATABASE_ERROR If a database function fails.
+ */
+intType sqlExecuteBatch (sqlStmtType sqlStatement)
+
+  {
+    preparedStmtType preparedStmt;
+    intType rowsLeft = 0;
+
+  /* sqlExecuteBatch */
+    logFunction(printf("sqlExecuteBatch(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(preparedStmt == NULL ||
+                 preparedStmt->sqlFunc == NULL ||
+                 preparedStmt->batch.numColumns == 0)) {
+      logError(printf("sqlExecuteBatch(" FMT_U_MEM "): "
+                      "SQL statement or batch not okay.\n",
+                      (memSizeType) sqlStatement););
+      raise_error(RANGE_ERROR);
+    } else {
+      preparedStmt->batch.executed = TRUE;
+      if (preparedStmt->batch.numRows != 0 &&
+          (preparedStmt->sqlFunc->sqlExecuteBatch == NULL ||
+           !preparedStmt->sqlFunc->sqlExecuteBatch(sqlStatement,
+                                                   &preparedStmt->batch))) {
+        rowsLeft = (intType) preparedStmt->batch.numRows;
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlExecuteBatch --> " FMT_D "\n", rowsLeft););
+    return rowsLeft;
+  } /* sqlExecuteBatch */
+
+
+
 /**
  *  Fetch a row from the result data of an executed 'sqlStatement'.
  *  After the 'sqlStatement' has been executed successfully the
@@ -1267,6 +2169,163 @@ boolType sqlFetch (sqlStmtType sqlStatement)
 
 
 
+/**
+ *  Discard the rows collected by a previous sqlFetchRows.
+ *  The declared columns stay collected. Together with
+ *  sqlFetchRowsNext this allows fetching rows step by step.
+ */
+void sqlFetchRowsStart (sqlStmtType sqlStatement)
+
+  { /* sqlFetchRowsStart */
+    logFunction(printf("sqlFetchRowsStart(" FMT_U_MEM ")\n",
+                       (memSizeType) sqlStatement););
+    if (sqlStatement != NULL) {
+      freeFetchedValues(&((preparedStmtType) sqlStatement)->fetched);
+    } /* if */
+  } /* sqlFetchRowsStart */
+
+
+
+/**
+ *  Fetch one row and append its collected columns to the fetched rows.
+ *  @param sqlStatement Prepared statement, which has been executed.
+ *  @param maxRows Maximum number of rows collected since sqlFetchRowsStart.
+ *  @return TRUE if a row was fetched and collected,
+ *          FALSE if 'maxRows' rows have been collected or
+ *          if no more result data is available.
+ *  @exception RANGE_ERROR If the statement was not prepared.
+ *  @exception DATABASE_ERROR If a database function fails.
+ *  @exception MEMORY_ERROR Not enough memory to store the row.
+ */
+boolType sqlFetchRowsNext (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    preparedStmtType preparedStmt;
+    sqlFuncType sqlFunc;
+    sqlBatchType fetched;
+    sqlBatchColumnType column;
+    memSizeType capacity;
+    memSizeType pos;
+    striType stri;
+    boolType fetchOkay;
+
+  /* sqlFetchRowsNext */
+    logFunction(printf("sqlFetchRowsNext(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    preparedStmt = (preparedStmtType) sqlStatement;
+    if (unlikely(preparedStmt == NULL || preparedStmt->sqlFunc == NULL ||
+                 preparedStmt->sqlFunc->sqlFetch == NULL ||
+                 preparedStmt->sqlFunc->sqlColumnInt == NULL ||
+                 preparedStmt->sqlFunc->sqlColumnFloat == NULL ||
+                 preparedStmt->sqlFunc->sqlColumnStri == NULL)) {
+      logError(printf("sqlFetchRowsNext(" FMT_U_MEM ", " FMT_D "): "
+                      "SQL statement not okay.\n",
+                      (memSizeType) sqlStatement, maxRows););
+      raise_error(RANGE_ERROR);
+      fetchOkay = FALSE;
+    } else {
+      sqlFunc = preparedStmt->sqlFunc;
+      fetched = &preparedStmt->fetched;
+      if (fetched->numRows == fetched->capacity) {
+        if (fetched->capacity == 0) {
+          capacity = 256;
+        } else if (fetched->capacity > MAX_RTL_ARR_LEN / 2) {
+          capacity = MAX_RTL_ARR_LEN;
+        } else {
+          capacity = 2 * fetched->capacity;
+        } /* if */
+        if (maxRows > 0 && (uintType) maxRows < capacity) {
+          capacity = (memSizeType) maxRows;
+        } /* if */
+      } else {
+        capacity = fetched->capacity;
+      } /* if */
+      if (maxRows <= 0 || fetched->numRows >= (uintType) maxRows) {
+        fetchOkay = FALSE;
+      } else if (unlikely(fetched->numRows == capacity ||
+                          (capacity != fetched->capacity &&
+                           growFetched(fetched, capacity) != OKAY_NO_ERROR))) {
+        raise_error(MEMORY_ERROR);
+        fetchOkay = FALSE;
+      } else {
+        fetchOkay = sqlFunc->sqlFetch(sqlStatement);
+        pos = 0;
+        while (fetchOkay && pos < fetched->numColumns) {
+          column = &fetched->columns[pos];
+          pos++;
+          switch (column->type) {
+            case SQL_BATCH_INT:
+              column->data.intValues[fetched->numRows] =
+                  sqlFunc->sqlColumnInt(sqlStatement, (intType) pos);
+              break;
+            case SQL_BATCH_FLOAT:
+              column->data.floatValues[fetched->numRows] =
+                  sqlFunc->sqlColumnFloat(sqlStatement, (intType) pos);
+              break;
+            case SQL_BATCH_STRI:
+              stri = sqlFunc->sqlColumnStri(sqlStatement, (intType) pos);
+              if (unlikely(stri == NULL)) {
+                /* The column function raised an exception. Free the */
+                /* strings of the preceding columns of this row.      */
+                fetchOkay = FALSE;
+                pos--;
+                while (pos > 0) {
+                  pos--;
+                  column = &fetched->columns[pos];
+                  if (column->type == SQL_BATCH_STRI) {
+                    FREE_STRI(column->data.striValues[fetched->numRows],
+                              column->data.striValues[fetched->numRows]->size);
+                  } /* if */
+                } /* while */
+              } else {
+                column->data.striValues[fetched->numRows] = stri;
+              } /* if */
+              break;
+          } /* switch */
+        } /* while */
+        if (fetchOkay) {
+          fetched->numRows++;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("sqlFetchRowsNext --> %d\n", fetchOkay););
+    return fetchOkay;
+  } /* sqlFetchRowsNext */
+
+
+
+/**
+ *  Fetch up to 'maxRows' rows and collect their declared columns.
+ *  The columns which are collected are declared with sqlCollectColumn.
+ *  Afterwards the collected values can be obtained with
+ *  sqlColumnIntArray, sqlColumnFloatArray and sqlColumnStriArray.
+ *  A further call of sqlFetchRows fetches the next rows.
+ *  @param sqlStatement Prepared statement, which has been executed.
+ *  @param maxRows Maximum number of rows to be fetched.
+ *  @return the number of fetched rows. If it is less than 'maxRows'
+ *          no more result data is available.
+ *  @exception RANGE_ERROR If the statement was not prepared.
+ *  @exception DATABASE_ERROR If a database function fails.
+ *  @exception MEMORY_ERROR Not enough memory to store the rows.
+ */
+intType sqlFetchRows (sqlStmtType sqlStatement, intType maxRows)
+
+  {
+    intType numRows = 0;
+
+  /* sqlFetchRows */
+    logFunction(printf("sqlFetchRows(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) sqlStatement, maxRows););
+    sqlFetchRowsStart(sqlStatement);
+    while (sqlFetchRowsNext(sqlStatement, maxRows)) {
+      numRows++;
+    } /* while */
+    logFunction(printf("sqlFetchRows --> " FMT_D "\n", numRows););
+    return numRows;
+  } /* sqlFetchRows */
+
+
+
 /**
  *  Get the current auto-commit mode for the specified database 'database'.
  */
@@ -29,6 +29,7 @@
 /*                                                                  */
 /********************************************************************/
 
+void sqlBindBatchRow (sqlStmtType sqlStatement, intType row);
 void sqlBindBigInt (sqlStmtType sqlStatement, intType pos,
                     const const_bigIntType value);
 void sqlBindBigRat (sqlStmtType sqlStatement, intType pos,
@@ -41,15 +42,23 @@ void sqlBindDuration (sqlStmtType sqlStatement, intType pos,
                       intType year, intType month, intType day, intType hour,
                       intType minute, intType second, intType micro_second);
 void sqlBindFloat (sqlStmtType sqlStatement, intType pos, floatType value);
+void sqlBindFloatArray (sqlStmtType sqlStatement, intType pos,
+                        const const_rtlArrayType values);
 void sqlBindInt (sqlStmtType sqlStatement, intType pos, intType value);
+void sqlBindIntArray (sqlStmtType sqlStatement, intType pos,
+                      const const_rtlArrayType values);
 void sqlBindNull (sqlStmtType sqlStatement, intType pos);
 void sqlBindStri (sqlStmtType sqlStatement, intType pos,
                   const const_striType stri);
+void sqlBindStriArray (sqlStmtType sqlStatement, intType pos,
+                       const const_rtlArrayType values);
 void sqlBindTime (sqlStmtType sqlStatement, intType pos,
                   intType year, intType month, intType day, intType hour,
                   intType min, intType sec, intType micro_sec,
                   intType time_zone);
 void sqlClose (databaseType database);
+void sqlCollectColumn (sqlStmtType sqlStatement, intType column,
+    intType columnType);
 bigIntType sqlColumnBigInt (sqlStmtType sqlStatement, intType column);
 void sqlColumnBigRat (sqlStmtType sqlStatement, intType column,
                       bigIntType *numerator, bigIntType *denominator);
@@ -59,13 +68,20 @@ void sqlColumnDuration (sqlStmtType sqlStatement, intType column,
                         intType *year, intType *month, intType *day, intType *hour,
                         intType *minute, intType *second, intType *micro_second);
 floatType sqlColumnFloat (sqlStmtType sqlStatement, intType column);
+rtlArrayType sqlColumnFloatArray (sqlStmtType sqlStatement, intType column);
 intType sqlColumnInt (sqlStmtType sqlStatement, intType column);
+rtlArrayType sqlColumnIntArray (sqlStmtType sqlStatement, intType column);
 striType sqlColumnStri (sqlStmtType sqlStatement, intType column);
+rtlArrayType sqlColumnStriArray (sqlStmtType sqlStatement, intType column);
 void sqlColumnTime (sqlStmtType sqlStatement, intType column,
                     intType *year, intType *month, intType *day, intType *hour,
                     intType *minute, intType *second, intType *micro_second,
                     intType *time_zone, boolType *is_dst);
 void sqlCommit (databaseType database);
+void sqlCopyEnd (databaseType database);
+striType sqlCopyGet (databaseType database);
+void sqlCopyPut (databaseType database, const const_striType data);
+boolType sqlCopyStart (databaseType database, const const_striType copyStatement);
 void sqlCpyDb (databaseType *const db_to, const databaseType db_from);
 void sqlCpyStmt (sqlStmtType *const stmt_to, const sqlStmtType stmt_from);
 databaseType sqlCreateDb (const databaseType db_from);
@@ -78,7 +94,11 @@ striType sqlErrDbFunc (void);
 striType sqlErrLibFunc (void);
 striType sqlErrMessage (void);
 void sqlExecute (sqlStmtType sqlStatement);
+intType sqlExecuteBatch (sqlStmtType sqlStatement);
 boolType sqlFetch (sqlStmtType sqlStatement);
+void sqlFetchRowsStart (sqlStmtType sqlStatement);
+boolType sqlFetchRowsNext (sqlStmtType sqlStatement, intType maxRows);
+intType sqlFetchRows (sqlStmtType sqlStatement, intType maxRows);
 boolType sqlGetAutoCommit (databaseType database);
 boolType sqlIsNull (sqlStmtType sqlStatement, intType column);
 sqlStmtType sqlPrepare (databaseType database,
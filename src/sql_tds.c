@@ -85,6 +85,8 @@ typedef struct {
 typedef struct {
     uintType        usage_count;
     sqlFuncType     sqlFunc;
+    sqlBatchRecord  batch;
+    sqlBatchRecord  fetched;
     DBPROCESS      *dbproc;
     striType       *stmtPartArray;
     memSizeType     stmtPartArrayCharCount;
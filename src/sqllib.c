@@ -27,18 +27,91 @@
 
 #include "version.h"
 
+#include "stdlib.h"
 #include "stdio.h"
 
 #include "common.h"
 #include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
 #include "syvarutl.h"
 #include "objutl.h"
 #include "runerr.h"
+#include "str_rtl.h"
 #include "sql_rtl.h"
 #include "sql_drv.h"
 
 
 
+/**
+ *  Convert a column collected by sqlFetchRows to an array object.
+ *  The elements of 'anRtlArray' are moved to the array object.
+ */
+static objectType columnToArrayType (rtlArrayType anRtlArray,
+    typeType elementType, int category)
+
+  {
+    memSizeType arraySize;
+    memSizeType pos;
+    arrayType anArray;
+    objectType element;
+    objectType result;
+
+  /* columnToArrayType */
+    if (unlikely(anRtlArray == NULL)) {
+      /* Assume that an exception was already raised */
+      result = NULL;
+    } else {
+      arraySize = arraySize(anRtlArray);
+      if (unlikely(!ALLOC_ARRAY(anArray, arraySize))) {
+        if (category == STRIOBJECT) {
+          for (pos = 0; pos < arraySize; pos++) {
+            strDestr(anRtlArray->arr[pos].value.striValue);
+          } /* for */
+        } /* if */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        anArray->min_position = anRtlArray->min_position;
+        anArray->max_position = anRtlArray->max_position;
+        for (pos = 0; pos < arraySize; pos++) {
+          element = &anArray->arr[pos];
+          element->type_of = elementType;
+          element->descriptor.property = NULL;
+          switch (category) {
+            case INTOBJECT:
+              element->value.intValue = anRtlArray->arr[pos].value.intValue;
+              break;
+            case FLOATOBJECT:
+              element->value.floatValue = anRtlArray->arr[pos].value.floatValue;
+              break;
+            default:
+              element->value.striValue = anRtlArray->arr[pos].value.striValue;
+              break;
+          } /* switch */
+          INIT_CATEGORY_OF_VAR(element, category);
+        } /* for */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = bld_array_temp(anArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* columnToArrayType */
+
+
+
+objectType sql_bind_batch_row (listType arguments)
+
+  { /* sql_bind_batch_row */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    sqlBindBatchRow(take_sqlstmt(arg_1(arguments)),
+                    take_int(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_bind_batch_row */
+
+
+
 objectType sql_bind_bigint (listType arguments)
 
   { /* sql_bind_bigint */
@@ -137,6 +210,37 @@ objectType sql_bind_float (listType arguments)
 
 
 
+objectType sql_bind_float_array (listType arguments)
+
+  {
+    arrayType values;
+    memSizeType length;
+    memSizeType pos;
+    rtlArrayType rtlValues;
+
+  /* sql_bind_float_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    values = take_array(arg_3(arguments));
+    length = arraySize(values);
+    if (unlikely(!ALLOC_RTL_ARRAY(rtlValues, length))) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      rtlValues->min_position = values->min_position;
+      rtlValues->max_position = values->max_position;
+      for (pos = 0; pos < length; pos++) {
+        rtlValues->arr[pos].value.floatValue = take_float(&values->arr[pos]);
+      } /* for */
+      sqlBindFloatArray(take_sqlstmt(arg_1(arguments)),
+                        take_int(arg_2(arguments)), rtlValues);
+      FREE_RTL_ARRAY(rtlValues, length);
+      return SYS_EMPTY_OBJECT;
+    } /* if */
+  } /* sql_bind_float_array */
+
+
+
 objectType sql_bind_int (listType arguments)
 
   { /* sql_bind_int */
@@ -151,6 +255,37 @@ objectType sql_bind_int (listType arguments)
 
 
 
+objectType sql_bind_int_array (listType arguments)
+
+  {
+    arrayType values;
+    memSizeType length;
+    memSizeType pos;
+    rtlArrayType rtlValues;
+
+  /* sql_bind_int_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    values = take_array(arg_3(arguments));
+    length = arraySize(values);
+    if (unlikely(!ALLOC_RTL_ARRAY(rtlValues, length))) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      rtlValues->min_position = values->min_position;
+      rtlValues->max_position = values->max_position;
+      for (pos = 0; pos < length; pos++) {
+        rtlValues->arr[pos].value.intValue = take_int(&values->arr[pos]);
+      } /* for */
+      sqlBindIntArray(take_sqlstmt(arg_1(arguments)),
+                      take_int(arg_2(arguments)), rtlValues);
+      FREE_RTL_ARRAY(rtlValues, length);
+      return SYS_EMPTY_OBJECT;
+    } /* if */
+  } /* sql_bind_int_array */
+
+
+
 objectType sql_bind_null (listType arguments)
 
   { /* sql_bind_null */
@@ -177,6 +312,37 @@ objectType sql_bind_stri (listType arguments)
 
 
 
+objectType sql_bind_stri_array (listType arguments)
+
+  {
+    arrayType values;
+    memSizeType length;
+    memSizeType pos;
+    rtlArrayType rtlValues;
+
+  /* sql_bind_stri_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    values = take_array(arg_3(arguments));
+    length = arraySize(values);
+    if (unlikely(!ALLOC_RTL_ARRAY(rtlValues, length))) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      rtlValues->min_position = values->min_position;
+      rtlValues->max_position = values->max_position;
+      for (pos = 0; pos < length; pos++) {
+        rtlValues->arr[pos].value.striValue = take_stri(&values->arr[pos]);
+      } /* for */
+      sqlBindStriArray(take_sqlstmt(arg_1(arguments)),
+                       take_int(arg_2(arguments)), rtlValues);
+      FREE_RTL_ARRAY(rtlValues, length);
+      return SYS_EMPTY_OBJECT;
+    } /* if */
+  } /* sql_bind_stri_array */
+
+
+
 objectType sql_bind_time (listType arguments)
 
   { /* sql_bind_time */
@@ -294,6 +460,24 @@ objectType sql_cmp_stmt (listType arguments)
 
 
 
+/**
+ *  Declare that column arg_2 of sqlStatement/arg_1 is collected by
+ *  sql_fetch_rows. The column is collected with the type code arg_3.
+ */
+objectType sql_collect_column (listType arguments)
+
+  { /* sql_collect_column */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    sqlCollectColumn(take_sqlstmt(arg_1(arguments)),
+                     take_int(arg_2(arguments)),
+                     take_int(arg_3(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_collect_column */
+
+
+
 objectType sql_column_bool (listType arguments)
 
   { /* sql_column_bool */
@@ -365,6 +549,19 @@ objectType sql_column_float (listType arguments)
 
 
 
+objectType sql_column_float_array (listType arguments)
+
+  { /* sql_column_float_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return columnToArrayType(
+        sqlColumnFloatArray(take_sqlstmt(arg_1(arguments)),
+                            take_int(arg_2(arguments))),
+        take_type(SYS_FLT_TYPE), FLOATOBJECT);
+  } /* sql_column_float_array */
+
+
+
 objectType sql_column_int (listType arguments)
 
   {
@@ -380,6 +577,19 @@ objectType sql_column_int (listType arguments)
 
 
 
+objectType sql_column_int_array (listType arguments)
+
+  { /* sql_column_int_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return columnToArrayType(
+        sqlColumnIntArray(take_sqlstmt(arg_1(arguments)),
+                          take_int(arg_2(arguments))),
+        take_type(SYS_INT_TYPE), INTOBJECT);
+  } /* sql_column_int_array */
+
+
+
 objectType sql_column_stri (listType arguments)
 
   {
@@ -395,6 +605,19 @@ objectType sql_column_stri (listType arguments)
 
 
 
+objectType sql_column_stri_array (listType arguments)
+
+  { /* sql_column_stri_array */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return columnToArrayType(
+        sqlColumnStriArray(take_sqlstmt(arg_1(arguments)),
+                           take_int(arg_2(arguments))),
+        take_type(SYS_STRI_TYPE), STRIOBJECT);
+  } /* sql_column_stri_array */
+
+
+
 objectType sql_column_time (listType arguments)
 
   {
@@ -446,6 +669,70 @@ objectType sql_commit (listType arguments)
 
 
 
+/**
+ *  Finish a COPY command of the database/arg_1.
+ *  Data, which has not been read, is skipped. Does nothing if no
+ *  COPY command is active.
+ */
+objectType sql_copy_end (listType arguments)
+
+  { /* sql_copy_end */
+    isit_database(arg_1(arguments));
+    sqlCopyEnd(take_database(arg_1(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_copy_end */
+
+
+
+/**
+ *  Get the next chunk of data from a COPY TO STDOUT of database/arg_1.
+ *  @return the next chunk of data, or "" if all data has been received.
+ */
+objectType sql_copy_get (listType arguments)
+
+  { /* sql_copy_get */
+    isit_database(arg_1(arguments));
+    return bld_stri_temp(
+        sqlCopyGet(take_database(arg_1(arguments))));
+  } /* sql_copy_get */
+
+
+
+/**
+ *  Send data/arg_2 to a COPY FROM STDIN of database/arg_1.
+ */
+objectType sql_copy_put (listType arguments)
+
+  { /* sql_copy_put */
+    isit_database(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    sqlCopyPut(take_database(arg_1(arguments)),
+               take_stri(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* sql_copy_put */
+
+
+
+/**
+ *  Start the COPY command copyStatement/arg_2 of database/arg_1.
+ *  @return TRUE if a COPY FROM STDIN was started,
+ *          FALSE if a COPY TO STDOUT was started.
+ */
+objectType sql_copy_start (listType arguments)
+
+  { /* sql_copy_start */
+    isit_database(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    if (sqlCopyStart(take_database(arg_1(arguments)),
+                     take_stri(arg_2(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* sql_copy_start */
+
+
+
 /**
  *  Assign source/arg_3 to dest/arg_1.
  *  A copy function assumes that dest/arg_1 contains a legal value.
@@ -641,6 +928,19 @@ objectType sql_execute (listType arguments)
 
 
 
+objectType sql_execute_batch (listType arguments)
+
+  {
+    intType rowsLeft;
+
+  /* sql_execute_batch */
+    isit_sqlstmt(arg_1(arguments));
+    rowsLeft = sqlExecuteBatch(take_sqlstmt(arg_1(arguments)));
+    return bld_int_temp(rowsLeft);
+  } /* sql_execute_batch */
+
+
+
 objectType sql_fetch (listType arguments)
 
   {
@@ -658,6 +958,31 @@ objectType sql_fetch (listType arguments)
 
 
 
+/**
+ *  Fetch up to arg_2 rows of sqlStatement/arg_1 and collect their columns.
+ *  @return the number of fetched rows.
+ */
+objectType sql_fetch_rows (listType arguments)
+
+  {
+    sqlStmtType sqlStatement;
+    intType maxRows;
+    intType numRows = 0;
+
+  /* sql_fetch_rows */
+    isit_sqlstmt(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    sqlStatement = take_sqlstmt(arg_1(arguments));
+    maxRows = take_int(arg_2(arguments));
+    sqlFetchRowsStart(sqlStatement);
+    while (!fail_flag && sqlFetchRowsNext(sqlStatement, maxRows)) {
+      numRows++;
+    } /* while */
+    return bld_int_temp(numRows);
+  } /* sql_fetch_rows */
+
+
+
 /**
  *  Get the current auto-commit mode for database/arg_1.
  */
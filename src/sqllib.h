@@ -25,29 +25,41 @@
 /*                                                                  */
 /********************************************************************/
 
+objectType sql_bind_batch_row    (listType arguments);
 objectType sql_bind_bigint       (listType arguments);
 objectType sql_bind_bigrat       (listType arguments);
 objectType sql_bind_bool         (listType arguments);
 objectType sql_bind_bstri        (listType arguments);
 objectType sql_bind_duration     (listType arguments);
 objectType sql_bind_float        (listType arguments);
+objectType sql_bind_float_array  (listType arguments);
 objectType sql_bind_int          (listType arguments);
+objectType sql_bind_int_array    (listType arguments);
 objectType sql_bind_null         (listType arguments);
 objectType sql_bind_stri         (listType arguments);
+objectType sql_bind_stri_array   (listType arguments);
 objectType sql_bind_time         (listType arguments);
 objectType sql_close             (listType arguments);
 objectType sql_cmp_db            (listType arguments);
 objectType sql_cmp_stmt          (listType arguments);
+objectType sql_collect_column    (listType arguments);
 objectType sql_column_bigint     (listType arguments);
 objectType sql_column_bigrat     (listType arguments);
 objectType sql_column_bool       (listType arguments);
 objectType sql_column_bstri      (listType arguments);
 objectType sql_column_duration   (listType arguments);
 objectType sql_column_float      (listType arguments);
+objectType sql_column_float_array (listType arguments);
 objectType sql_column_int        (listType arguments);
+objectType sql_column_int_array  (listType arguments);
 objectType sql_column_stri       (listType arguments);
+objectType sql_column_stri_array (listType arguments);
 objectType sql_column_time       (listType arguments);
 objectType sql_commit            (listType arguments);
+objectType sql_copy_end          (listType arguments);
+objectType sql_copy_get          (listType arguments);
+objectType sql_copy_put          (listType arguments);
+objectType sql_copy_start        (listType arguments);
 objectType sql_cpy_db            (listType arguments);
 objectType sql_cpy_stmt          (listType arguments);
 objectType sql_create_db         (listType arguments);
@@ -64,7 +76,9 @@ objectType sql_err_db_func       (listType arguments);
 objectType sql_err_lib_func      (listType arguments);
 objectType sql_err_message       (listType arguments);
 objectType sql_execute           (listType arguments);
+objectType sql_execute_batch     (listType arguments);
 objectType sql_fetch             (listType arguments);
+objectType sql_fetch_rows        (listType arguments);
 objectType sql_get_auto_commit   (listType arguments);
 objectType sql_is_null           (listType arguments);
 objectType sql_ne_db             (listType arguments);
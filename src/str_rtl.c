@@ -38,12 +38,19 @@
 #include "stdio.h"
 #include "string.h"
 #include "wchar.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
+#if HAS_AVX2_INTRINSICS
+#include "immintrin.h"
+#endif
 
 #include "common.h"
 #include "data_rtl.h"
 #include "heaputl.h"
 #include "striutl.h"
 #include "arr_rtl.h"
+#include "int_rtl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -54,8 +61,10 @@
 #define CHAR_DELTA_BEYOND  128
 #define INITIAL_ARRAY_SIZE 256
 #define ARRAY_SIZE_FACTOR    2
+#define INITIAL_CSV_FIELDS  16
 #define BOYER_MOORE_SEARCHED_STRI_THRESHOLD    2
 #define BOYER_MOORE_MAIN_STRI_THRESHOLD     1400
+#define UTF8_BUFFER_SIZE                    4096
 
 /* memset_to_strelem is not used because it is */
 /* only better for lengths greater than 7.     */
@@ -67,6 +76,37 @@
 #define RESIZE_THRESHOLD 8
 #endif
 
+#if HAS_SSE2_INTRINSICS
+#define LATIN1_BLOCK_SIZE 8
+
+/**
+ *  Case mapping of ISO-8859-1 characters, that can be done with SIMD.
+ *  The characters from first1 to last1 and from first2 to last2
+ *  (except excluded) are changed by delta. Blocks with a special
+ *  character are converted without SIMD.
+ */
+typedef struct {
+    int32Type first1;
+    int32Type last1;
+    int32Type first2;
+    int32Type last2;
+    int32Type excluded;
+    int32Type special1;
+    int32Type special2;
+    int32Type delta;
+  } latin1CaseType;
+
+/* 0x100 is used as special character, if there is none. */
+static const latin1CaseType lowerLatin1 = {
+    'A', 'Z', 0xC0, 0xDE, 0xD7, 0x100, 0x100, 32};
+static const latin1CaseType upperLatin1 = {
+    'a', 'z', 0xE0, 0xFE, 0xF7, 0xB5, 0xFF, -32};
+#endif
+
+#if HAS_AVX2_INTRINSICS
+static int avx2InstructionsPresent = -1;
+#endif
+
 
 
 #if HAS_WMEMCMP && WCHAR_T_SIZE == 32
@@ -114,7 +154,30 @@ static inline const strElemType *search_strelem2 (const strElemType *mem,
 static inline const strElemType *rsearch_strelem (const strElemType *mem,
     const strElemType ch, size_t len)
 
-  { /* rsearch_strelem */
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i searched;
+    unsigned int mask;
+#endif
+
+  /* rsearch_strelem */
+#if HAS_SSE2_INTRINSICS
+    /* Compare blocks of 4 characters with SSE2 instructions. */
+    searched = _mm_set1_epi32((int32Type) ch);
+    while (len >= 4) {
+      mask = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(
+          _mm_loadu_si128((const __m128i *) (mem - 3)), searched)));
+      if (mask != 0) {
+        while ((mask & 8) == 0) {
+          mask <<= 1;
+          mem--;
+        } /* while */
+        return mem;
+      } /* if */
+      mem -= 4;
+      len -= 4;
+    } /* while */
+#endif
     for (; len > 0; mem--, len--) {
       if (*mem == ch) {
         return mem;
@@ -144,6 +207,534 @@ static inline const strElemType *rsearch_strelem2 (const strElemType *mem,
 
 
 
+#if HAS_SSE2_INTRINSICS
+/**
+ *  Search 'searched' among the start positions from 'pos' to 'lastPos'.
+ *  The first and the last character of 'searched' are compared
+ *  before the characters between them are compared.
+ */
+static inline const strElemType *searchStriScalar (const strElemType *mem,
+    memSizeType pos, memSizeType lastPos, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    strElemType ch_1;
+    strElemType ch_n;
+
+  /* searchStriScalar */
+    ch_1 = searched[0];
+    ch_n = searched[searchedSize - 1];
+    for (; pos <= lastPos; pos++) {
+      if (mem[pos] == ch_1 && mem[pos + searchedSize - 1] == ch_n &&
+          memcmp(&mem[pos + 1], &searched[1],
+                 (searchedSize - 2) * sizeof(strElemType)) == 0) {
+        return &mem[pos];
+      } /* if */
+    } /* for */
+    return NULL;
+  } /* searchStriScalar */
+
+
+
+/**
+ *  Search 'searched' in 'mem' with a SIMD filter and SSE2 instructions.
+ *  For 4 start positions at once the first and the last character of
+ *  'searched' are compared. Only at the start positions where both
+ *  characters match, the characters between them are compared.
+ *  @param mem Characters to be searched.
+ *  @param mainSize Number of characters in 'mem'.
+ *  @param searched String to be searched (at least 2 characters).
+ *  @param searchedSize Number of characters in 'searched'.
+ *  @return a pointer to the leftmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+static const strElemType *searchStriSse2 (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    __m128i ch_1;
+    __m128i ch_n;
+    unsigned int mask;
+    memSizeType lastPos;
+    memSizeType pos = 0;
+    memSizeType idx;
+    const strElemType *found = NULL;
+
+  /* searchStriSse2 */
+    lastPos = mainSize - searchedSize;
+    ch_1 = _mm_set1_epi32((int32Type) searched[0]);
+    ch_n = _mm_set1_epi32((int32Type) searched[searchedSize - 1]);
+    while (found == NULL && pos + 3 <= lastPos) {
+      mask = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+          _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos]), ch_1),
+          _mm_cmpeq_epi32(_mm_loadu_si128(
+              (const __m128i *) &mem[pos + searchedSize - 1]), ch_n))));
+      for (idx = pos; found == NULL && mask != 0; idx++, mask >>= 1) {
+        if ((mask & 1) != 0 && memcmp(&mem[idx + 1], &searched[1],
+            (searchedSize - 2) * sizeof(strElemType)) == 0) {
+          found = &mem[idx];
+        } /* if */
+      } /* for */
+      pos += 4;
+    } /* while */
+    if (found == NULL) {
+      found = searchStriScalar(mem, pos, lastPos, searched, searchedSize);
+    } /* if */
+    return found;
+  } /* searchStriSse2 */
+
+
+
+/**
+ *  Search 'searched' backward in 'mem' with SSE2 instructions.
+ *  Like searchStriSse2() the first and the last character of
+ *  'searched' are compared for 4 start positions at once.
+ *  @return a pointer to the rightmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+static const strElemType *rsearchStriSse2 (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    strElemType ch_1;
+    strElemType ch_n;
+    __m128i ch_1_block;
+    __m128i ch_n_block;
+    unsigned int mask;
+    memSizeType numPositions;
+    memSizeType idx;
+    const strElemType *found = NULL;
+
+  /* rsearchStriSse2 */
+    numPositions = mainSize - searchedSize + 1;
+    ch_1 = searched[0];
+    ch_n = searched[searchedSize - 1];
+    ch_1_block = _mm_set1_epi32((int32Type) ch_1);
+    ch_n_block = _mm_set1_epi32((int32Type) ch_n);
+    while (found == NULL && numPositions >= 4) {
+      numPositions -= 4;
+      mask = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+          _mm_cmpeq_epi32(_mm_loadu_si128(
+              (const __m128i *) &mem[numPositions]), ch_1_block),
+          _mm_cmpeq_epi32(_mm_loadu_si128(
+              (const __m128i *) &mem[numPositions + searchedSize - 1]), ch_n_block))));
+      for (idx = numPositions + 3; found == NULL && mask != 0; idx--, mask = (mask << 1) & 0xF) {
+        if ((mask & 8) != 0 && memcmp(&mem[idx + 1], &searched[1],
+            (searchedSize - 2) * sizeof(strElemType)) == 0) {
+          found = &mem[idx];
+        } /* if */
+      } /* for */
+    } /* while */
+    while (found == NULL && numPositions > 0) {
+      numPositions--;
+      if (mem[numPositions] == ch_1 &&
+          mem[numPositions + searchedSize - 1] == ch_n &&
+          memcmp(&mem[numPositions + 1], &searched[1],
+                 (searchedSize - 2) * sizeof(strElemType)) == 0) {
+        found = &mem[numPositions];
+      } /* if */
+    } /* while */
+    return found;
+  } /* rsearchStriSse2 */
+#endif
+
+
+
+#if HAS_SSE2_INTRINSICS && HAS_AVX2_INTRINSICS
+static boolType avx2InstructionsSupported (void)
+
+  { /* avx2InstructionsSupported */
+    if (avx2InstructionsPresent == -1) {
+      __builtin_cpu_init();
+      avx2InstructionsPresent = __builtin_cpu_supports("avx2") != 0;
+      logMessage(printf("avx2InstructionsSupported: %d\n",
+                        avx2InstructionsPresent););
+    } /* if */
+    return avx2InstructionsPresent;
+  } /* avx2InstructionsSupported */
+
+
+
+/**
+ *  Search 'searched' in 'mem' with a SIMD filter and AVX2 instructions.
+ *  This works like searchStriSse2() with 8 start positions at once.
+ *  @return a pointer to the leftmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+__attribute__((target("avx2")))
+static const strElemType *searchStriAvx2 (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    __m256i ch_1;
+    __m256i ch_n;
+    unsigned int mask;
+    unsigned int bit;
+    memSizeType lastPos;
+    memSizeType pos = 0;
+    const strElemType *found = NULL;
+
+  /* searchStriAvx2 */
+    lastPos = mainSize - searchedSize;
+    ch_1 = _mm256_set1_epi32((int32Type) searched[0]);
+    ch_n = _mm256_set1_epi32((int32Type) searched[searchedSize - 1]);
+    while (found == NULL && pos + 7 <= lastPos) {
+      mask = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(
+          _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[pos]), ch_1),
+          _mm256_cmpeq_epi32(_mm256_loadu_si256(
+              (const __m256i *) &mem[pos + searchedSize - 1]), ch_n))));
+      while (found == NULL && mask != 0) {
+        bit = (unsigned int) __builtin_ctz(mask);
+        if (memcmp(&mem[pos + bit + 1], &searched[1],
+            (searchedSize - 2) * sizeof(strElemType)) == 0) {
+          found = &mem[pos + bit];
+        } /* if */
+        mask &= mask - 1;
+      } /* while */
+      pos += 8;
+    } /* while */
+    if (found == NULL) {
+      found = searchStriScalar(mem, pos, lastPos, searched, searchedSize);
+    } /* if */
+    return found;
+  } /* searchStriAvx2 */
+
+
+
+/**
+ *  Search 'searched' backward in 'mem' with AVX2 instructions.
+ *  This works like rsearchStriSse2() with 8 start positions at once.
+ *  @return a pointer to the rightmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+__attribute__((target("avx2")))
+static const strElemType *rsearchStriAvx2 (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    __m256i ch_1;
+    __m256i ch_n;
+    unsigned int mask;
+    unsigned int bit;
+    memSizeType numPositions;
+    const strElemType *found = NULL;
+
+  /* rsearchStriAvx2 */
+    numPositions = mainSize - searchedSize + 1;
+    ch_1 = _mm256_set1_epi32((int32Type) searched[0]);
+    ch_n = _mm256_set1_epi32((int32Type) searched[searchedSize - 1]);
+    while (found == NULL && numPositions >= 8) {
+      numPositions -= 8;
+      mask = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(
+          _mm256_cmpeq_epi32(_mm256_loadu_si256(
+              (const __m256i *) &mem[numPositions]), ch_1),
+          _mm256_cmpeq_epi32(_mm256_loadu_si256(
+              (const __m256i *) &mem[numPositions + searchedSize - 1]), ch_n))));
+      while (found == NULL && mask != 0) {
+        bit = 31 - (unsigned int) __builtin_clz(mask);
+        if (memcmp(&mem[numPositions + bit + 1], &searched[1],
+            (searchedSize - 2) * sizeof(strElemType)) == 0) {
+          found = &mem[numPositions + bit];
+        } /* if */
+        mask &= ~(1U << bit);
+      } /* while */
+    } /* while */
+    if (found == NULL && numPositions > 0) {
+      found = rsearchStriSse2(mem, numPositions + searchedSize - 1,
+                              searched, searchedSize);
+    } /* if */
+    return found;
+  } /* rsearchStriAvx2 */
+#endif
+
+
+
+#if HAS_SSE2_INTRINSICS
+/**
+ *  Search the leftmost occurrence of 'searched' in 'mem'.
+ *  The AVX2 or the SSE2 search is selected at runtime.
+ *  @param searchedSize Number of characters in 'searched' (at least 2).
+ *  @return a pointer to the leftmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+static inline const strElemType *searchStri (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    const strElemType *found;
+
+  /* searchStri */
+    if (mainSize < searchedSize) {
+      found = NULL;
+#if HAS_AVX2_INTRINSICS
+    } else if (avx2InstructionsSupported()) {
+      found = searchStriAvx2(mem, mainSize, searched, searchedSize);
+#endif
+    } else {
+      found = searchStriSse2(mem, mainSize, searched, searchedSize);
+    } /* if */
+    return found;
+  } /* searchStri */
+
+
+
+/**
+ *  Search the rightmost occurrence of 'searched' in 'mem'.
+ *  The AVX2 or the SSE2 search is selected at runtime.
+ *  @param searchedSize Number of characters in 'searched' (at least 2).
+ *  @return a pointer to the rightmost occurrence of 'searched' or
+ *          NULL if 'mem' does not contain 'searched'.
+ */
+static inline const strElemType *rsearchStri (const strElemType *mem,
+    memSizeType mainSize, const strElemType *searched,
+    memSizeType searchedSize)
+
+  {
+    const strElemType *found;
+
+  /* rsearchStri */
+    if (mainSize < searchedSize) {
+      found = NULL;
+#if HAS_AVX2_INTRINSICS
+    } else if (avx2InstructionsSupported()) {
+      found = rsearchStriAvx2(mem, mainSize, searched, searchedSize);
+#endif
+    } else {
+      found = rsearchStriSse2(mem, mainSize, searched, searchedSize);
+    } /* if */
+    return found;
+  } /* rsearchStri */
+
+
+
+/**
+ *  Change the case of ISO-8859-1 characters with SSE2 instructions.
+ *  Blocks of 8 characters are converted as long as all characters
+ *  of a block are ISO-8859-1 characters, which are not special in
+ *  'caseMap'. At least one character is left unconverted.
+ *  The block is loaded before it is stored, so 'source' and 'dest'
+ *  may be identical.
+ *  @return the position of the first character that is not converted.
+ */
+static memSizeType changeLatin1CaseSse2 (const strElemType *const source,
+    memSizeType length, strElemType *const dest, memSizeType pos,
+    const latin1CaseType *const caseMap)
+
+  {
+    const __m128i notLatin1 = _mm_set1_epi32((int32Type) 0xFFFFFF00);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i below1;
+    __m128i beyond1;
+    __m128i below2;
+    __m128i beyond2;
+    __m128i excluded;
+    __m128i special1;
+    __m128i special2;
+    __m128i delta;
+    __m128i chars0;
+    __m128i chars1;
+    boolType converting = TRUE;
+
+  /* changeLatin1CaseSse2 */
+    below1 = _mm_set1_epi32(caseMap->first1 - 1);
+    beyond1 = _mm_set1_epi32(caseMap->last1 + 1);
+    below2 = _mm_set1_epi32(caseMap->first2 - 1);
+    beyond2 = _mm_set1_epi32(caseMap->last2 + 1);
+    excluded = _mm_set1_epi32(caseMap->excluded);
+    special1 = _mm_set1_epi32(caseMap->special1);
+    special2 = _mm_set1_epi32(caseMap->special2);
+    delta = _mm_set1_epi32(caseMap->delta);
+    while (converting && length - pos > LATIN1_BLOCK_SIZE) {
+      chars0 = _mm_loadu_si128((const __m128i *) &source[pos]);
+      chars1 = _mm_loadu_si128((const __m128i *) &source[pos + 4]);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(
+              _mm_or_si128(chars0, chars1), notLatin1), zero)) == 0xFFFF &&
+          _mm_movemask_epi8(_mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi32(chars0, special1),
+                           _mm_cmpeq_epi32(chars1, special1)),
+              _mm_or_si128(_mm_cmpeq_epi32(chars0, special2),
+                           _mm_cmpeq_epi32(chars1, special2)))) == 0) {
+        /* All characters are in the range 0 to 255. So the signed */
+        /* comparisons work like unsigned ones.                    */
+        chars0 = _mm_add_epi32(chars0, _mm_and_si128(delta, _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi32(chars0, below1),
+                          _mm_cmplt_epi32(chars0, beyond1)),
+            _mm_andnot_si128(_mm_cmpeq_epi32(chars0, excluded),
+                _mm_and_si128(_mm_cmpgt_epi32(chars0, below2),
+                              _mm_cmplt_epi32(chars0, beyond2))))));
+        chars1 = _mm_add_epi32(chars1, _mm_and_si128(delta, _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi32(chars1, below1),
+                          _mm_cmplt_epi32(chars1, beyond1)),
+            _mm_andnot_si128(_mm_cmpeq_epi32(chars1, excluded),
+                _mm_and_si128(_mm_cmpgt_epi32(chars1, below2),
+                              _mm_cmplt_epi32(chars1, beyond2))))));
+        _mm_storeu_si128((__m128i *) &dest[pos], chars0);
+        _mm_storeu_si128((__m128i *) &dest[pos + 4], chars1);
+        pos += LATIN1_BLOCK_SIZE;
+      } else {
+        converting = FALSE;
+      } /* if */
+    } /* while */
+    return pos;
+  } /* changeLatin1CaseSse2 */
+#endif
+
+
+
+/**
+ *  Determine the number of leading whitespace characters.
+ *  All characters less than or equal to ' ' (space) count as whitespace.
+ *  If SSE2 is available 4 characters are checked at once.
+ */
+static inline memSizeType leadingWhitespace (const strElemType *mem,
+    memSizeType size)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i signBit;
+    __m128i space;
+#endif
+
+  /* leadingWhitespace */
+#if HAS_SSE2_INTRINSICS
+    /* Flipping the sign bit allows an unsigned comparison. */
+    signBit = _mm_set1_epi32(INT32TYPE_MIN);
+    space = _mm_set1_epi32((int32Type) ' ' ^ INT32TYPE_MIN);
+    while (size - pos >= 4 && _mm_movemask_epi8(_mm_cmpgt_epi32(_mm_xor_si128(
+        _mm_loadu_si128((const __m128i *) &mem[pos]), signBit), space)) == 0) {
+      pos += 4;
+    } /* while */
+#endif
+    while (pos < size && mem[pos] <= ' ') {
+      pos++;
+    } /* while */
+    return pos;
+  } /* leadingWhitespace */
+
+
+
+/**
+ *  Determine the size without trailing whitespace characters.
+ *  All characters less than or equal to ' ' (space) count as whitespace.
+ *  If SSE2 is available 4 characters are checked at once.
+ */
+static inline memSizeType sizeWithoutTrailingWhitespace (
+    const strElemType *mem, memSizeType size)
+
+  {
+#if HAS_SSE2_INTRINSICS
+    __m128i signBit;
+    __m128i space;
+#endif
+
+  /* sizeWithoutTrailingWhitespace */
+#if HAS_SSE2_INTRINSICS
+    signBit = _mm_set1_epi32(INT32TYPE_MIN);
+    space = _mm_set1_epi32((int32Type) ' ' ^ INT32TYPE_MIN);
+    while (size >= 4 && _mm_movemask_epi8(_mm_cmpgt_epi32(_mm_xor_si128(
+        _mm_loadu_si128((const __m128i *) &mem[size - 4]), signBit), space)) == 0) {
+      size -= 4;
+    } /* while */
+#endif
+    while (size > 0 && mem[size - 1] <= ' ') {
+      size--;
+    } /* while */
+    return size;
+  } /* sizeWithoutTrailingWhitespace */
+
+
+
+/**
+ *  Determine the number of characters that can be taken unchanged
+ *  from the body of a JSON string. The body ends with a double quote,
+ *  a backslash or a control character (less than ' ' (space)).
+ *  If SSE2 is available 4 characters are checked at once.
+ */
+static inline memSizeType plainJsonStringChars (const strElemType *mem,
+    memSizeType size)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i signBit;
+    __m128i space;
+    __m128i quote;
+    __m128i backslash;
+    __m128i chars;
+#endif
+
+  /* plainJsonStringChars */
+#if HAS_SSE2_INTRINSICS
+    signBit = _mm_set1_epi32(INT32TYPE_MIN);
+    space = _mm_set1_epi32((int32Type) ' ' ^ INT32TYPE_MIN);
+    quote = _mm_set1_epi32('"');
+    backslash = _mm_set1_epi32('\\');
+    while (size - pos >= 4) {
+      chars = _mm_loadu_si128((const __m128i *) &mem[pos]);
+      if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(
+          _mm_cmpeq_epi32(chars, quote), _mm_cmpeq_epi32(chars, backslash)),
+          _mm_cmplt_epi32(_mm_xor_si128(chars, signBit), space))) != 0) {
+        break;
+      } /* if */
+      pos += 4;
+    } /* while */
+#endif
+    while (pos < size && mem[pos] != '"' && mem[pos] != '\\' &&
+           mem[pos] >= ' ') {
+      pos++;
+    } /* while */
+    return pos;
+  } /* plainJsonStringChars */
+
+
+
+/**
+ *  Determine the number of characters of an unquoted CSV field.
+ *  The field ends with the separator, a linefeed or a carriage return.
+ *  If SSE2 is available 4 characters are checked at once.
+ */
+static inline memSizeType plainCsvFieldChars (const strElemType *mem,
+    memSizeType size, const charType separator)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i sep;
+    __m128i linefeed;
+    __m128i carriageReturn;
+    __m128i chars;
+#endif
+
+  /* plainCsvFieldChars */
+#if HAS_SSE2_INTRINSICS
+    sep = _mm_set1_epi32((int32Type) separator);
+    linefeed = _mm_set1_epi32('\n');
+    carriageReturn = _mm_set1_epi32('\r');
+    while (size - pos >= 4) {
+      chars = _mm_loadu_si128((const __m128i *) &mem[pos]);
+      if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(
+          _mm_cmpeq_epi32(chars, sep), _mm_cmpeq_epi32(chars, linefeed)),
+          _mm_cmpeq_epi32(chars, carriageReturn))) != 0) {
+        break;
+      } /* if */
+      pos += 4;
+    } /* while */
+#endif
+    while (pos < size && mem[pos] != separator &&
+           mem[pos] != '\n' && mem[pos] != '\r') {
+      pos++;
+    } /* while */
+    return pos;
+  } /* plainCsvFieldChars */
+
+
+
 /**
  *  Copy 'source' character array to 'dest' as lower case characters.
  *  The conversion uses the default Unicode case mapping,
@@ -162,9 +753,19 @@ void toLower (const strElemType *const source, memSizeType length,
   {
     memSizeType pos;
     strElemType ch;
+#if HAS_SSE2_INTRINSICS
+    memSizeType vectorPos = 0;
+#endif
 
   /* toLower */
     for (pos = 0; pos < length; pos++) {
+#if HAS_SSE2_INTRINSICS
+      if (pos == vectorPos) {
+        /* At least one character is left for the conversion below. */
+        pos = changeLatin1CaseSse2(source, length, dest, pos, &lowerLatin1);
+        vectorPos = pos + LATIN1_BLOCK_SIZE;
+      } /* if */
+#endif
       ch = source[pos];
       switch (ch >> 8) {
         case 0:
@@ -489,9 +1090,19 @@ void toUpper (const strElemType *const source, memSizeType length,
   {
     memSizeType pos;
     strElemType ch;
+#if HAS_SSE2_INTRINSICS
+    memSizeType vectorPos = 0;
+#endif
 
   /* toUpper */
     for (pos = 0; pos < length; pos++) {
+#if HAS_SSE2_INTRINSICS
+      if (pos == vectorPos) {
+        /* At least one character is left for the conversion below. */
+        pos = changeLatin1CaseSse2(source, length, dest, pos, &upperLatin1);
+        vectorPos = pos + LATIN1_BLOCK_SIZE;
+      } /* if */
+#endif
       ch = source[pos];
       switch (ch >> 8) {
         case 0:
@@ -784,6 +1395,122 @@ void toUpper (const strElemType *const source, memSizeType length,
 
 
 
+/**
+ *  Read the CSV field that starts at mem[*pos].
+ *  A field is terminated with the separator, a linefeed or a
+ *  carriage return followed by a linefeed. A carriage return that
+ *  is not followed by a linefeed belongs to an unquoted field. A
+ *  field that starts with a double quote (") ends with the next
+ *  double quote that is not doubled. Inside of it separators and
+ *  linefeeds are allowed and doubled double quotes ("") stand for
+ *  one double quote. The characters of unquoted fields are scanned
+ *  with SSE2 instructions, if they are available.
+ *  @param pos Index of the field start in mem. When the function is
+ *         left it refers to the character after the terminator. If
+ *         mem does not contain the complete field it is unchanged.
+ *  @param endOfRecord Set to TRUE, if the field is terminated with
+ *         a linefeed, and to FALSE otherwise.
+ *  @param err_info Unchanged if the function succeeds, and
+ *                  MEMORY_ERROR if a memory allocation failed, and
+ *                  RANGE_ERROR if a quoted field is not followed by
+ *                  a terminator.
+ *  @return the field, or NULL if mem does not contain the complete
+ *          field and its terminator or if an error occurred.
+ */
+striType getCsvField (const strElemType *const mem, const memSizeType size,
+    memSizeType *const pos, const charType separator,
+    boolType *const endOfRecord, errInfoType *err_info)
+
+  {
+    memSizeType start;
+    memSizeType stop;
+    memSizeType search;
+    memSizeType fieldLength;
+    const strElemType *found;
+    strElemType *dest;
+    boolType complete = TRUE;
+    striType field = NULL;
+
+  /* getCsvField */
+    start = *pos;
+    if (start < size && mem[start] == '"') {
+      start++;
+      search = start;
+      fieldLength = 0;
+      do {
+        found = memchr_strelem(&mem[search], '"', size - search);
+        if (found == NULL || (memSizeType) (found - mem) + 1 >= size) {
+          complete = FALSE;
+          stop = size;
+        } else {
+          stop = (memSizeType) (found - mem);
+          fieldLength += stop - search;
+          if (mem[stop + 1] == '"') {
+            fieldLength++;
+            search = stop + 2;
+          } /* if */
+        } /* if */
+      } while (complete && mem[stop + 1] == '"');
+      if (complete) {
+        if (unlikely(!ALLOC_STRI_SIZE_OK(field, fieldLength))) {
+          *err_info = MEMORY_ERROR;
+        } else {
+          field->size = fieldLength;
+          dest = field->mem;
+          search = start;
+          while (search < stop) {
+            found = memchr_strelem(&mem[search], '"', stop - search);
+            fieldLength = found == NULL ? stop - search :
+                (memSizeType) (found - mem) + 1 - search;
+            memcpy(dest, &mem[search], fieldLength * sizeof(strElemType));
+            dest += fieldLength;
+            search += fieldLength + 1;
+          } /* while */
+        } /* if */
+        stop++;
+      } /* if */
+    } else {
+      stop = start + plainCsvFieldChars(&mem[start], size - start, separator);
+      while (stop + 1 < size && mem[stop] == '\r' && mem[stop + 1] != '\n') {
+        stop++;
+        stop += plainCsvFieldChars(&mem[stop], size - stop, separator);
+      } /* while */
+      if (stop >= size || (mem[stop] == '\r' && stop + 1 >= size)) {
+        complete = FALSE;
+      } else if (unlikely(!ALLOC_STRI_SIZE_OK(field, stop - start))) {
+        *err_info = MEMORY_ERROR;
+      } else {
+        field->size = stop - start;
+        memcpy(field->mem, &mem[start], field->size * sizeof(strElemType));
+      } /* if */
+    } /* if */
+    if (field != NULL) {
+      /* The character at mem[stop] exists. */
+      if (mem[stop] == separator) {
+        *endOfRecord = FALSE;
+        *pos = stop + 1;
+      } else if (mem[stop] == '\n') {
+        *endOfRecord = TRUE;
+        *pos = stop + 1;
+      } else if (mem[stop] == '\r' && stop + 1 < size && mem[stop + 1] == '\n') {
+        *endOfRecord = TRUE;
+        *pos = stop + 2;
+      } else {
+        FREE_STRI(field, field->size);
+        field = NULL;
+        if (mem[stop] != '\r') {
+          logError(printf("getCsvField: Illegal character after a "
+                          "quoted field at position " FMT_U_MEM ".\n",
+                          stop + 1););
+          *err_info = RANGE_ERROR;
+        } /* if */
+      } /* if */
+    } /* if */
+    return field;
+  } /* getCsvField */
+
+
+
 static rtlArrayType addCopiedStriToRtlArray (const strElemType *const stri_elems,
     const memSizeType length, rtlArrayType work_array, intType used_max_position)
 
@@ -1455,6 +2182,71 @@ void strAppendN (striType *const destination,
 
 
 
+/**
+ *  Append the decimal representation of 'number' to 'destination'.
+ *  The digits are written into a buffer on the stack and copied to
+ *  the capacity of 'destination'. This avoids the temporary string
+ *  of destination &:= str(number).
+ *  @exception MEMORY_ERROR Not enough memory for the concatenated
+ *             string.
+ */
+void strAppendInt (striType *const destination, const intType number)
+
+  {
+    strElemType buffer[INTTYPE_DECIMAL_SIZE];
+    strElemType *digits;
+    memSizeType length;
+    memSizeType new_size;
+    striType stri_dest;
+
+  /* strAppendInt */
+    logFunction(printf("strAppendInt(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(*destination), number);
+                fflush(stdout););
+    if (number < 0) {
+      /* The unsigned value is negated to avoid a signed integer */
+      /* overflow if the smallest signed integer is negated.     */
+      digits = uintDecimalDigits(-(uintType) number,
+                                 &buffer[INTTYPE_DECIMAL_SIZE]);
+      *(--digits) = (strElemType) '-';
+    } else {
+      digits = uintDecimalDigits((uintType) number,
+                                 &buffer[INTTYPE_DECIMAL_SIZE]);
+    } /* if */
+    length = (memSizeType) (&buffer[INTTYPE_DECIMAL_SIZE] - digits);
+    stri_dest = *destination;
+    new_size = stri_dest->size + length;
+#if WITH_STRI_CAPACITY
+    if (new_size > stri_dest->capacity) {
+      stri_dest = growStri(stri_dest, new_size);
+      if (unlikely(stri_dest == NULL)) {
+        raise_error(MEMORY_ERROR);
+        return;
+      } else {
+        *destination = stri_dest;
+      } /* if */
+    } /* if */
+    COUNT_GROW_STRI(stri_dest->size, new_size);
+    memcpy(&stri_dest->mem[stri_dest->size], digits,
+           length * sizeof(strElemType));
+    stri_dest->size = new_size;
+#else
+    GROW_STRI(stri_dest, stri_dest, stri_dest->size, new_size);
+    if (unlikely(stri_dest == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      COUNT_GROW_STRI(stri_dest->size, new_size);
+      memcpy(&stri_dest->mem[stri_dest->size], digits,
+             length * sizeof(strElemType));
+      stri_dest->size = new_size;
+      *destination = stri_dest;
+    } /* if */
+#endif
+    logFunctionResult(printf("\"%s\"\n", striAsUnquotedCStri(*destination)););
+  } /* strAppendInt */
+
+
+
 /**
  *  Append the string 'extension' to 'destination'.
  *  StrAppendTemp is used by the compiler if 'extension' is temporary
@@ -2165,6 +2957,63 @@ striType strConcatN (const const_striType striArray[], memSizeType arraySize)
 
 
 
+/**
+ *  Concatenate an arbitrary number of strings into a buffer.
+ *  StrConcatNBuf is used by the compiler for concatenations, whose
+ *  result is only used until the end of the current statement. A
+ *  result that fits into the buffer does not need a heap allocation.
+ *  The caller must free the result only if it differs from 'buffer'.
+ *  @param arraySize Number of strings in striArray (>= 2).
+ *  @param buffer Buffer with space for 'bufferCapacity' characters.
+ *  @return 'buffer' with the result of the concatenation, or
+ *          a new string if the result does not fit into 'buffer'.
+ */
+striType strConcatNBuf (const const_striType striArray[], memSizeType arraySize,
+    striType buffer, memSizeType bufferCapacity)
+
+  {
+    memSizeType pos;
+    memSizeType result_size = 0;
+    memSizeType elem_size;
+    strElemType *dest;
+    striType result;
+
+  /* strConcatNBuf */
+    logFunction(printf("strConcatNBuf(");
+                for (pos = 0; pos < arraySize; pos++) {
+                  printf("\"%s\", ",
+                         striAsUnquotedCStri(striArray[pos]));
+                } /* if */
+                printf(FMT_U_MEM ", *, " FMT_U_MEM ")",
+                       arraySize, bufferCapacity);
+                fflush(stdout););
+    for (pos = 0; pos < arraySize && result_size <= bufferCapacity; pos++) {
+      result_size += striArray[pos]->size;
+    } /* for */
+    if (result_size > bufferCapacity) {
+      result = strConcatN(striArray, arraySize);
+    } else {
+      result = buffer;
+#if ALLOW_STRITYPE_SLICES
+      result->mem = result->mem1;
+#endif
+#if WITH_STRI_CAPACITY
+      result->capacity = bufferCapacity;
+#endif
+      result->size = result_size;
+      dest = result->mem;
+      for (pos = 0; pos < arraySize; pos++) {
+        elem_size = striArray[pos]->size;
+        memcpy(dest, striArray[pos]->mem, elem_size * sizeof(strElemType));
+        dest += elem_size;
+      } /* for */
+      logFunctionResult(printf("\"%s\"\n", striAsUnquotedCStri(result)););
+    } /* if */
+    return result;
+  } /* strConcatNBuf */
+
+
+
 /**
  *  Concatenate two strings.
  *  The parameter 'stri1' is resized and 'stri2' is copied to the
@@ -2359,6 +3208,107 @@ genericType strCreateGeneric (const genericType source)
 
 
 
+/**
+ *  Read the fields of the CSV record that starts at 'position'.
+ *  CSV fields are separated by the 'separator' character. A CSV
+ *  record is terminated with '\n' or "\r\n". A CSV field might be
+ *  enclosed in double quotes ("). A double quoted CSV field might
+ *  contain 'separator' characters, double quotes (") or linefeed
+ *  characters. Double quotes inside a double quoted field are
+ *  represented by doubling them (e.g.: The double quoted field
+ *  "a""b" has the value a"b ). The first character in a string
+ *  has the position 1.
+ *   pos := 1;
+ *   csvFields("a,\"b,c\"\nd", pos, ',')  returns  []("a", "b,c")  and pos = 9
+ *   csvFields("d", pos, ',')             returns  0 times ""      and pos = 1
+ *  @param position Position of the record start. When the function is
+ *         left it refers to the character after the record. If 'stri'
+ *         does not contain the complete record 'position' is unchanged.
+ *  @return the array of CSV fields, or an empty array if 'stri' does
+ *          not contain the complete record.
+ *  @exception RANGE_ERROR 'position' <= 0 holds or a double quoted
+ *             field is not followed by a separator or a line end.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType strCsvFields (const const_striType stri, intType *const position,
+    const charType separator)
+
+  {
+    memSizeType pos;
+    striType field;
+    boolType endOfRecord = FALSE;
+    intType used_max_position = 0;
+    errInfoType err_info = OKAY_NO_ERROR;
+    rtlArrayType resized_work_array;
+    rtlArrayType result_array;
+
+  /* strCsvFields */
+    logFunction(printf("strCsvFields(\"%s\", " FMT_D ", '\\" FMT_U32 ";')\n",
+                       striAsUnquotedCStri(stri), *position, separator););
+    if (unlikely(*position <= 0)) {
+      logError(printf("strCsvFields(\"%s\", " FMT_D ", '\\" FMT_U32 ";'): "
+                      "Position <= 0.\n",
+                      striAsUnquotedCStri(stri), *position, separator););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } else if (unlikely(!ALLOC_RTL_ARRAY(result_array, INITIAL_CSV_FIELDS))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result_array->min_position = 1;
+    result_array->max_position = INITIAL_CSV_FIELDS;
+    pos = (memSizeType) *position - 1;
+    do {
+      field = getCsvField(stri->mem, stri->size, &pos, separator,
+                          &endOfRecord, &err_info);
+      if (field != NULL) {
+        if (used_max_position >= result_array->max_position) {
+          if (unlikely(result_array->max_position > (intType) (MAX_RTL_ARR_INDEX / ARRAY_SIZE_FACTOR) ||
+              (resized_work_array = REALLOC_RTL_ARRAY(result_array,
+                  (uintType) result_array->max_position,
+                  (uintType) result_array->max_position * ARRAY_SIZE_FACTOR)) == NULL)) {
+            FREE_STRI(field, field->size);
+            field = NULL;
+            err_info = MEMORY_ERROR;
+          } else {
+            result_array = resized_work_array;
+            COUNT3_RTL_ARRAY((uintType) result_array->max_position,
+                             (uintType) result_array->max_position * ARRAY_SIZE_FACTOR);
+            result_array->max_position *= ARRAY_SIZE_FACTOR;
+          } /* if */
+        } /* if */
+        if (field != NULL) {
+          result_array->arr[used_max_position].value.striValue = field;
+          used_max_position++;
+        } /* if */
+      } /* if */
+    } while (field != NULL && !endOfRecord);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      freeRtlStriArray(result_array, used_max_position);
+      raise_error(err_info);
+      result_array = NULL;
+    } else {
+      if (!endOfRecord) {
+        /* The record is not complete. */
+        while (used_max_position > 0) {
+          used_max_position--;
+          field = result_array->arr[used_max_position].value.striValue;
+          FREE_STRI(field, field->size);
+        } /* while */
+      } else {
+        *position = (intType) pos + 1;
+      } /* if */
+      result_array = completeRtlStriArray(result_array, used_max_position);
+      if (unlikely(result_array == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } /* if */
+    } /* if */
+    logFunction(printf("strCsvFields --> (position: " FMT_D ")\n", *position););
+    return result_array;
+  } /* strCsvFields */
+
+
+
 /**
  *  Free the memory referred by 'old_string'.
  *  After strDestr is left 'old_string' refers to not existing memory.
@@ -2432,6 +3382,11 @@ striType strFromUtf8 (const const_striType utf8)
     memSizeType utf8Size;
     memSizeType pos;
     const strElemType *utf8ptr;
+    ucharType buffer[UTF8_BUFFER_SIZE];
+    memSizeType chunkSize;
+    boolType notByte;
+    memSizeType charsConverted;
+    memSizeType unconverted;
     boolType okay = TRUE;
     striType resized_result;
     striType result;
@@ -2445,81 +3400,42 @@ striType strFromUtf8 (const const_striType utf8)
     } else {
       utf8ptr = &utf8->mem[0];
       pos = 0;
-      for (; utf8Size > 0; pos++, utf8Size--) {
-        if (*utf8ptr <= 0x7F) {
-          result->mem[pos] = *utf8ptr++;
-        } else if (utf8ptr[0] >= 0xC0 && utf8ptr[0] <= 0xDF && utf8Size >= 2 &&
-                   utf8ptr[1] >= 0x80 && utf8ptr[1] <= 0xBF) {
-          /* utf8ptr[0]   range 192 to 223 (leading bits 110.....) */
-          /* utf8ptr[1]   range 128 to 191 (leading bits 10......) */
-          result->mem[pos] = (utf8ptr[0] & 0x1F) << 6 |
-                             (utf8ptr[1] & 0x3F);
-          utf8ptr += 2;
-          utf8Size--;
-        } else if (utf8ptr[0] >= 0xE0 && utf8ptr[0] <= 0xEF && utf8Size >= 3 &&
-                   utf8ptr[1] >= 0x80 && utf8ptr[1] <= 0xBF &&
-                   utf8ptr[2] >= 0x80 && utf8ptr[2] <= 0xBF) {
-          /* utf8ptr[0]   range 224 to 239 (leading bits 1110....) */
-          /* utf8ptr[1..] range 128 to 191 (leading bits 10......) */
-          result->mem[pos] = (utf8ptr[0] & 0x0F) << 12 |
-                             (utf8ptr[1] & 0x3F) <<  6 |
-                             (utf8ptr[2] & 0x3F);
-          utf8ptr += 3;
-          utf8Size -= 2;
-        } else if (utf8ptr[0] >= 0xF0 && utf8ptr[0] <= 0xF7 && utf8Size >= 4 &&
-                   utf8ptr[1] >= 0x80 && utf8ptr[1] <= 0xBF &&
-                   utf8ptr[2] >= 0x80 && utf8ptr[2] <= 0xBF &&
-                   utf8ptr[3] >= 0x80 && utf8ptr[3] <= 0xBF) {
-          /* utf8ptr[0]   range 240 to 247 (leading bits 11110...) */
-          /* utf8ptr[1..] range 128 to 191 (leading bits 10......) */
-          result->mem[pos] = (utf8ptr[0] & 0x07) << 18 |
-                             (utf8ptr[1] & 0x3F) << 12 |
-                             (utf8ptr[2] & 0x3F) <<  6 |
-                             (utf8ptr[3] & 0x3F);
-          utf8ptr += 4;
-          utf8Size -= 3;
-        } else if (utf8ptr[0] >= 0xF8 && utf8ptr[0] <= 0xFB && utf8Size >= 5 &&
-                   utf8ptr[1] >= 0x80 && utf8ptr[1] <= 0xBF &&
-                   utf8ptr[2] >= 0x80 && utf8ptr[2] <= 0xBF &&
-                   utf8ptr[3] >= 0x80 && utf8ptr[3] <= 0xBF &&
-                   utf8ptr[4] >= 0x80 && utf8ptr[4] <= 0xBF) {
-          /* utf8ptr[0]   range 248 to 251 (leading bits 111110..) */
-          /* utf8ptr[1..] range 128 to 191 (leading bits 10......) */
-          result->mem[pos] = (utf8ptr[0] & 0x03) << 24 |
-                             (utf8ptr[1] & 0x3F) << 18 |
-                             (utf8ptr[2] & 0x3F) << 12 |
-                             (utf8ptr[3] & 0x3F) <<  6 |
-                             (utf8ptr[4] & 0x3F);
-          utf8ptr += 5;
-          utf8Size -= 4;
-        } else if (utf8ptr[0] >= 0xFC && utf8ptr[0] <= 0xFF && utf8Size >= 6 &&
-                   utf8ptr[1] >= 0x80 && utf8ptr[1] <= 0xBF &&
-                   utf8ptr[2] >= 0x80 && utf8ptr[2] <= 0xBF &&
-                   utf8ptr[3] >= 0x80 && utf8ptr[3] <= 0xBF &&
-                   utf8ptr[4] >= 0x80 && utf8ptr[4] <= 0xBF &&
-                   utf8ptr[5] >= 0x80 && utf8ptr[5] <= 0xBF) {
-          /* utf8ptr[0]   range 252 to 255 (leading bits 111111..) */
-          /* utf8ptr[1..] range 128 to 191 (leading bits 10......) */
-          result->mem[pos] = (utf8ptr[0] & 0x03) << 30 |
-                             (utf8ptr[1] & 0x3F) << 24 |
-                             (utf8ptr[2] & 0x3F) << 18 |
-                             (utf8ptr[3] & 0x3F) << 12 |
-                             (utf8ptr[4] & 0x3F) <<  6 |
-                             (utf8ptr[5] & 0x3F);
-          utf8ptr += 6;
-          utf8Size -= 5;
+      /* The bytes are copied to a buffer in chunks and converted */
+      /* with utf8_to_stri(), which uses SIMD instructions.       */
+      while (utf8Size > 0 && okay) {
+        chunkSize = utf8Size < UTF8_BUFFER_SIZE ? utf8Size : UTF8_BUFFER_SIZE;
+        notByte = memcpy_from_strelem(buffer, utf8ptr, chunkSize);
+        if (notByte) {
+          /* Convert only the bytes in front of the first */
+          /* character, which is not a byte.               */
+          chunkSize = 0;
+          while (utf8ptr[chunkSize] <= 0xFF) {
+            chunkSize++;
+          } /* while */
+        } /* if */
+        unconverted = utf8_to_stri(&result->mem[pos], &charsConverted,
+                                   buffer, chunkSize);
+        pos += charsConverted;
+        if (unconverted == 0 && !notByte) {
+          utf8ptr += chunkSize;
+          utf8Size -= chunkSize;
+        } else if (unconverted != 0 && !notByte &&
+                   chunkSize < utf8Size && chunkSize - unconverted != 0 &&
+                   utf8_bytes_missing(&buffer[chunkSize - unconverted],
+                                      unconverted) != 0) {
+          /* A byte sequence continues in the next chunk. */
+          utf8ptr += chunkSize - unconverted;
+          utf8Size -= chunkSize - unconverted;
         } else {
-          /* utf8ptr[0] not in range 0xC0 to 0xFF (192 to 255) */
-          /* or not enough continuation bytes found.           */
+          utf8ptr += chunkSize - unconverted;
           logError(printf("strFromUtf8: "
                           "Invalid byte sequence starting at position "
                           FMT_U_MEM ": \"\\" FMT_U32 ";\\ ...\".\n",
                           (memSizeType) (utf8ptr - &utf8->mem[0]),
                           utf8ptr[0]););
           okay = FALSE;
-          utf8Size = 1;
         } /* if */
-      } /* for */
+      } /* while */
       if (likely(okay)) {
         result->size = pos;
         if (pos != utf8->size) {
@@ -2988,6 +3904,173 @@ intType strIPos (const const_striType mainStri, const const_striType searched,
 
 
 
+/**
+ *  Determine the end of a JSON number that starts at 'start'.
+ *  The number is checked with the JSON syntax for numbers: An
+ *  optional minus sign, an integer part without leading zeros,
+ *  an optional fraction and an optional exponent.
+ *  The first character in a string has the position 1.
+ *  @return the position of the character after the number, or
+ *          0 if the number might continue after the end of 'stri'.
+ *  @exception RANGE_ERROR 'start' <= 0 holds or the number
+ *             starting at 'start' is not a valid JSON number.
+ */
+intType strJsonNumberEnd (const const_striType stri, const intType start)
+
+  {
+    const strElemType *mem;
+    memSizeType size;
+    memSizeType pos;
+    boolType okay = TRUE;
+
+  /* strJsonNumberEnd */
+    logFunction(printf("strJsonNumberEnd(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(stri), start););
+    if (unlikely(start <= 0)) {
+      logError(printf("strJsonNumberEnd(\"%s\", " FMT_D "): start <= 0.\n",
+                      striAsUnquotedCStri(stri), start););
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
+    mem = stri->mem;
+    size = stri->size;
+    pos = (memSizeType) start - 1;
+    if (pos < size && mem[pos] == '-') {
+      pos++;
+    } /* if */
+    if (pos >= size) {
+      return 0;
+    } else if (mem[pos] == '0') {
+      pos++;
+    } else if (mem[pos] >= '1' && mem[pos] <= '9') {
+      do {
+        pos++;
+      } while (pos < size && mem[pos] >= '0' && mem[pos] <= '9');
+    } else {
+      okay = FALSE;
+    } /* if */
+    if (okay && pos < size && mem[pos] == '.') {
+      pos++;
+      if (pos < size && mem[pos] >= '0' && mem[pos] <= '9') {
+        do {
+          pos++;
+        } while (pos < size && mem[pos] >= '0' && mem[pos] <= '9');
+      } else if (pos < size) {
+        okay = FALSE;
+      } /* if */
+    } /* if */
+    if (okay && pos < size && (mem[pos] == 'e' || mem[pos] == 'E')) {
+      pos++;
+      if (pos < size && (mem[pos] == '+' || mem[pos] == '-')) {
+        pos++;
+      } /* if */
+      if (pos < size && mem[pos] >= '0' && mem[pos] <= '9') {
+        do {
+          pos++;
+        } while (pos < size && mem[pos] >= '0' && mem[pos] <= '9');
+      } else if (pos < size) {
+        okay = FALSE;
+      } /* if */
+    } /* if */
+    if (unlikely(!okay)) {
+      logError(printf("strJsonNumberEnd(\"%s\", " FMT_D "): "
+                      "Illegal number at position " FMT_U_MEM ".\n",
+                      striAsUnquotedCStri(stri), start, pos + 1););
+      raise_error(RANGE_ERROR);
+      return 0;
+    } else if (pos >= size) {
+      return 0;
+    } else {
+      return (intType) pos + 1;
+    } /* if */
+  } /* strJsonNumberEnd */
+
+
+
+/**
+ *  Determine the end of a JSON string that starts at 'start'.
+ *  The character at 'start' is the introducing double quote (").
+ *  Escape sequences are checked, but not converted. The plain
+ *  characters between the escape sequences are skipped with
+ *  SSE2 instructions, if they are available.
+ *  The first character in a string has the position 1.
+ *  @return the position of the character after the closing double
+ *          quote, or 0 if the JSON string is not terminated in 'stri'.
+ *  @exception RANGE_ERROR 'start' <= 0 holds or the JSON string
+ *             contains a control character or an illegal escape sequence.
+ */
+intType strJsonStringEnd (const const_striType stri, const intType start)
+
+  {
+    const strElemType *mem;
+    memSizeType size;
+    memSizeType pos;
+    memSizeType digitPos;
+    strElemType ch;
+
+  /* strJsonStringEnd */
+    logFunction(printf("strJsonStringEnd(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(stri), start););
+    if (unlikely(start <= 0)) {
+      logError(printf("strJsonStringEnd(\"%s\", " FMT_D "): start <= 0.\n",
+                      striAsUnquotedCStri(stri), start););
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
+    mem = stri->mem;
+    size = stri->size;
+    pos = (memSizeType) start;
+    while (pos < size) {
+      pos += plainJsonStringChars(&mem[pos], size - pos);
+      if (pos < size) {
+        ch = mem[pos];
+        if (ch == '"') {
+          return (intType) pos + 2;
+        } else if (ch == '\\') {
+          pos++;
+          if (pos < size) {
+            ch = mem[pos];
+            if (ch == 'u') {
+              for (digitPos = pos + 1; digitPos <= pos + 4 && digitPos < size;
+                   digitPos++) {
+                ch = mem[digitPos];
+                if (unlikely(!((ch >= '0' && ch <= '9') ||
+                               (ch >= 'a' && ch <= 'f') ||
+                               (ch >= 'A' && ch <= 'F')))) {
+                  logError(printf("strJsonStringEnd(\"%s\", " FMT_D "): "
+                                  "Illegal \\u escape at position " FMT_U_MEM ".\n",
+                                  striAsUnquotedCStri(stri), start, pos););
+                  raise_error(RANGE_ERROR);
+                  return 0;
+                } /* if */
+              } /* for */
+              pos += 5;
+            } else if (likely(ch == '"' || ch == '\\' || ch == '/' ||
+                              ch == 'b' || ch == 'f' || ch == 'n' ||
+                              ch == 'r' || ch == 't')) {
+              pos++;
+            } else {
+              logError(printf("strJsonStringEnd(\"%s\", " FMT_D "): "
+                              "Illegal escape at position " FMT_U_MEM ".\n",
+                              striAsUnquotedCStri(stri), start, pos););
+              raise_error(RANGE_ERROR);
+              return 0;
+            } /* if */
+          } /* if */
+        } else {
+          logError(printf("strJsonStringEnd(\"%s\", " FMT_D "): "
+                          "Control character at position " FMT_U_MEM ".\n",
+                          striAsUnquotedCStri(stri), start, pos + 1););
+          raise_error(RANGE_ERROR);
+          return 0;
+        } /* if */
+      } /* if */
+    } /* while */
+    return 0;
+  } /* strJsonStringEnd */
+
+
+
 /**
  *  Check if stri1 is less than or equal to stri2.
  *  @return TRUE if stri1 is less than or equal to stri2,
@@ -3374,9 +4457,7 @@ striType strLtrim (const const_striType stri)
   /* strLtrim */
     striSize = stri->size;
     if (striSize >= 1) {
-      while (start < striSize && stri->mem[start] <= ' ') {
-        start++;
-      } /* while */
+      start = leadingWhitespace(stri->mem, striSize);
       striSize -= start;
     } /* if */
     if (unlikely(!ALLOC_STRI_SIZE_OK(result, striSize))) {
@@ -3545,6 +4626,9 @@ intType strPos (const const_striType mainStri, const const_striType searched)
     const strElemType *searched_mem;
     const strElemType *search_start;
     const strElemType *search_end;
+#if HAS_SSE2_INTRINSICS
+    const strElemType *found_pos;
+#endif
 
   /* strPos */
     logFunction(printf("strPos(\"%s\", ",
@@ -3554,6 +4638,17 @@ intType strPos (const const_striType mainStri, const const_striType searched)
     main_size = mainStri->size;
     searched_size = searched->size;
     if (searched_size != 0 && main_size >= searched_size) {
+#if HAS_SSE2_INTRINSICS
+      if (searched_size >= 2) {
+        main_mem = mainStri->mem;
+        found_pos = searchStri(main_mem, main_size, searched->mem, searched_size);
+        if (found_pos != NULL) {
+          return ((intType) (found_pos - main_mem)) + 1;
+        } else {
+          return 0;
+        } /* if */
+      } /* if */
+#endif
       if (searched_size >= BOYER_MOORE_SEARCHED_STRI_THRESHOLD &&
           main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
         return strPos2(mainStri, searched);
@@ -4246,6 +5341,9 @@ intType strRPos (const const_striType mainStri, const const_striType searched)
     const strElemType *searched_mem;
     const strElemType *search_start;
     const strElemType *search_end;
+#if HAS_SSE2_INTRINSICS
+    const strElemType *found_pos;
+#endif
 
   /* strRPos */
     logFunction(printf("strRPos(\"%s\", ",
@@ -4255,6 +5353,17 @@ intType strRPos (const const_striType mainStri, const const_striType searched)
     main_size = mainStri->size;
     searched_size = searched->size;
     if (searched_size != 0 && searched_size <= main_size) {
+#if HAS_SSE2_INTRINSICS
+      if (searched_size >= 2) {
+        main_mem = mainStri->mem;
+        found_pos = rsearchStri(main_mem, main_size, searched->mem, searched_size);
+        if (found_pos != NULL) {
+          return ((intType) (found_pos - main_mem)) + 1;
+        } else {
+          return 0;
+        } /* if */
+      } /* if */
+#endif
       if (searched_size >= BOYER_MOORE_SEARCHED_STRI_THRESHOLD &&
           main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
         return strRPos2(mainStri, searched);
@@ -4292,10 +5401,7 @@ striType strRtrim (const const_striType stri)
     striType result;
 
   /* strRtrim */
-    striSize = stri->size;
-    while (striSize > 0 && stri->mem[striSize - 1] <= ' ') {
-      striSize--;
-    } /* while */
+    striSize = sizeWithoutTrailingWhitespace(stri->mem, stri->size);
     if (unlikely(!ALLOC_STRI_SIZE_OK(result, striSize))) {
       raise_error(MEMORY_ERROR);
       return NULL;
@@ -4352,6 +5458,22 @@ rtlArrayType strSplit (const const_striType mainStri,
       delimiter_mem = delimiter->mem;
       search_start = mainStri->mem;
       segment_start = search_start;
+#if HAS_SSE2_INTRINSICS
+      if (delimiter_size >= 2 && mainStri->size >= delimiter_size) {
+        search_end = &mainStri->mem[mainStri->size];
+        while ((found_pos = searchStri(search_start,
+            (memSizeType) (search_end - search_start),
+            delimiter_mem, delimiter_size)) != NULL &&
+            result_array != NULL) {
+          result_array = addCopiedStriToRtlArray(segment_start,
+              (memSizeType) (found_pos - segment_start), result_array,
+              used_max_position);
+          used_max_position++;
+          search_start = found_pos + delimiter_size;
+          segment_start = search_start;
+        } /* while */
+      } else
+#endif
       if (delimiter_size != 0 && mainStri->size >= delimiter_size) {
         ch_1 = delimiter_mem[0];
         search_end = &mainStri->mem[mainStri->size - delimiter_size + 1];
@@ -4728,9 +5850,12 @@ striType strTailAssign (const striType stri, intType start)
 striType strToUtf8 (const const_striType stri)
 
   {
-    register strElemType *dest;
-    register strElemType ch;
-    register memSizeType pos;
+    strElemType *dest;
+    const strElemType *strelem;
+    memSizeType len;
+    memSizeType chunkSize;
+    memSizeType byteCount;
+    ucharType buffer[UTF8_BUFFER_SIZE];
     memSizeType result_size;
     striType resized_result;
     striType result;
@@ -4742,41 +5867,16 @@ striType strToUtf8 (const const_striType stri)
       result = NULL;
     } else {
       dest = result->mem;
-      for (pos = 0; pos < stri->size; pos++) {
-        ch = stri->mem[pos];
-        if (ch <= 0x7F) {
-          *dest++ = ch;
-        } else if (ch <= 0x7FF) {
-          dest[0] = 0xC0 | ( ch >>  6);
-          dest[1] = 0x80 | ( ch        & 0x3F);
-          dest += 2;
-        } else if (ch <= 0xFFFF) {
-          dest[0] = 0xE0 | ( ch >> 12);
-          dest[1] = 0x80 | ((ch >>  6) & 0x3F);
-          dest[2] = 0x80 | ( ch        & 0x3F);
-          dest += 3;
-        } else if (ch <= 0x1FFFFF) {
-          dest[0] = 0xF0 | ( ch >> 18);
-          dest[1] = 0x80 | ((ch >> 12) & 0x3F);
-          dest[2] = 0x80 | ((ch >>  6) & 0x3F);
-          dest[3] = 0x80 | ( ch        & 0x3F);
-          dest += 4;
-        } else if (ch <= 0x3FFFFFF) {
-          dest[0] = 0xF8 | ( ch >> 24);
-          dest[1] = 0x80 | ((ch >> 18) & 0x3F);
-          dest[2] = 0x80 | ((ch >> 12) & 0x3F);
-          dest[3] = 0x80 | ((ch >>  6) & 0x3F);
-          dest[4] = 0x80 | ( ch        & 0x3F);
-          dest += 5;
-        } else {
-          dest[0] = 0xFC | ( ch >> 30);
-          dest[1] = 0x80 | ((ch >> 24) & 0x3F);
-          dest[2] = 0x80 | ((ch >> 18) & 0x3F);
-          dest[3] = 0x80 | ((ch >> 12) & 0x3F);
-          dest[4] = 0x80 | ((ch >>  6) & 0x3F);
-          dest[5] = 0x80 | ( ch        & 0x3F);
-          dest += 6;
-        } /* if */
+      strelem = stri->mem;
+      /* The characters are converted in chunks with stri_to_utf8(), */
+      /* which uses SIMD instructions, and copied to the result.     */
+      for (len = stri->size; len > 0; len -= chunkSize) {
+        chunkSize = len < UTF8_BUFFER_SIZE / MAX_UTF8_EXPANSION_FACTOR ?
+            len : UTF8_BUFFER_SIZE / MAX_UTF8_EXPANSION_FACTOR;
+        byteCount = stri_to_utf8(buffer, strelem, chunkSize);
+        memcpy_to_strelem(dest, buffer, byteCount);
+        strelem += chunkSize;
+        dest += byteCount;
       } /* for */
       result_size = (memSizeType) (dest - result->mem);
       REALLOC_STRI_SIZE_SMALLER(resized_result, result, max_utf8_size(stri->size), result_size);
@@ -4810,13 +5910,9 @@ striType strTrim (const const_striType stri)
   /* strTrim */
     striSize = stri->size;
     if (striSize >= 1) {
-      while (start < striSize && stri->mem[start] <= ' ') {
-        start++;
-      } /* while */
-      while (striSize > start && stri->mem[striSize - 1] <= ' ') {
-        striSize--;
-      } /* while */
-      striSize -= start;
+      start = leadingWhitespace(stri->mem, striSize);
+      striSize = sizeWithoutTrailingWhitespace(&stri->mem[start],
+                                               striSize - start);
     } /* if */
     if (unlikely(!ALLOC_STRI_SIZE_OK(result, striSize))) {
       raise_error(MEMORY_ERROR);
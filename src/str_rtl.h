@@ -45,10 +45,14 @@ void toLower (const strElemType *const stri, memSizeType length,
     strElemType *const dest);
 void toUpper (const strElemType *const stri, memSizeType length,
     strElemType *const dest);
+striType getCsvField (const strElemType *const mem, const memSizeType size,
+    memSizeType *const pos, const charType separator,
+    boolType *const endOfRecord, errInfoType *err_info);
 striType concatPath (const const_striType absolutePath,
     const const_striType relativePath);
 striType straightenAbsolutePath (const const_striType absolutePath);
 void strAppend (striType *const destination, const_striType extension);
+void strAppendInt (striType *const destination, const intType number);
 void strAppendN (striType *const destination,
     const const_striType extensionArray[], memSizeType arraySize);
 void strAppendTemp (striType *const destination, const striType extension);
@@ -68,9 +72,13 @@ striType strConcat (const const_striType stri1, const const_striType stri2);
 striType strConcatChar (const const_striType stri1, const charType aChar);
 striType strConcatCharTemp (striType stri1, const charType aChar);
 striType strConcatN (const const_striType striArray[], memSizeType arraySize);
+striType strConcatNBuf (const const_striType striArray[], memSizeType arraySize,
+    striType buffer, memSizeType bufferCapacity);
 striType strConcatTemp (striType stri1, const const_striType stri2);
 void strCopy (striType *const dest, const const_striType source);
 striType strCreate (const const_striType source);
+/* rtlArrayType strCsvFields (const const_striType stri, intType *const position,
+    const charType separator); */
 void strDestr (const const_striType old_string);
 striType strEmpty (void);
 striType strFromUtf8 (const const_striType utf8);
@@ -85,6 +93,8 @@ striType strHeadAssign (const striType stri, const intType stop);
 striType strHeadTemp (const striType stri, const intType stop);
 intType strIPos (const const_striType mainStri, const const_striType searched,
     const intType fromIndex);
+intType strJsonNumberEnd (const const_striType stri, const intType start);
+intType strJsonStringEnd (const const_striType stri, const intType start);
 boolType strLe (const const_striType stri1, const const_striType stri2);
 striType strLit (const const_striType stri);
 striType strLow (const const_striType stri);
@@ -41,6 +41,12 @@
 #ifdef OS_STRI_WCHAR
 #include "wchar.h"
 #endif
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
+#if HAS_AVX2_INTRINSICS
+#include "immintrin.h"
+#endif
 
 #include "common.h"
 #include "heaputl.h"
@@ -102,6 +108,10 @@ const os_charType emulated_root[] = {'/', '\0'};
  */
 #define MAXIMUM_BYTE_ESCAPE_WIDTH STRLEN("\\255;")
 
+#if HAS_AVX2_INTRINSICS
+static int avx2InstructionsPresent = -1;
+#endif
+
 #ifdef OS_STRI_WCHAR
 
 #define MAX_OS_STRI_SIZE    (((MAX_MEMSIZETYPE / sizeof(os_charType)) - NULL_TERMINATION_LEN) / SURROGATE_PAIR_FACTOR)
@@ -328,8 +338,29 @@ void memcpy_to_strelem (register strElemType *const dest,
 
   {
     register memSizeType pos;
+#if HAS_SSE2_INTRINSICS
+    __m128i zero;
+    __m128i bytes;
+    __m128i words;
+#endif
 
   /* memcpy_to_strelem */
+#if HAS_SSE2_INTRINSICS
+    /* Blocks of 16 bytes are converted starting from the end. */
+    /* The block is loaded before the characters are stored.   */
+    /* So this works also if 'src' and 'dest' are the same.    */
+    zero = _mm_setzero_si128();
+    while (len >= 16) {
+      len -= 16;
+      bytes = _mm_loadu_si128((const __m128i *) &src[len]);
+      words = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[len + 12], _mm_unpackhi_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[len + 8], _mm_unpacklo_epi16(words, zero));
+      words = _mm_unpacklo_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[len + 4], _mm_unpackhi_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[len], _mm_unpacklo_epi16(words, zero));
+    } /* while */
+#endif
     if (len != 0) {
       pos = (len + 31) & ~(memSizeType) 31;
       switch (len & 31) {
@@ -451,8 +482,37 @@ boolType memcpy_from_strelem (register const ustriType dest,
   {
     register memSizeType pos;
     register strElemType check = 0;
+#if HAS_SSE2_INTRINSICS
+    __m128i lowByte;
+    __m128i checkBits;
+    __m128i chars0, chars1, chars2, chars3;
+    uint32Type checkParts[4];
+#endif
 
   /* memcpy_from_strelem */
+#if HAS_SSE2_INTRINSICS
+    /* Blocks of 16 characters are converted starting from the */
+    /* end. The low bytes of the characters are packed into 16 */
+    /* bytes and the characters are or-ed into checkBits.      */
+    lowByte = _mm_set1_epi32(0xFF);
+    checkBits = _mm_setzero_si128();
+    while (len >= 16) {
+      len -= 16;
+      chars0 = _mm_loadu_si128((const __m128i *) &src[len]);
+      chars1 = _mm_loadu_si128((const __m128i *) &src[len + 4]);
+      chars2 = _mm_loadu_si128((const __m128i *) &src[len + 8]);
+      chars3 = _mm_loadu_si128((const __m128i *) &src[len + 12]);
+      checkBits = _mm_or_si128(checkBits, _mm_or_si128(
+          _mm_or_si128(chars0, chars1), _mm_or_si128(chars2, chars3)));
+      _mm_storeu_si128((__m128i *) &dest[len], _mm_packus_epi16(
+          _mm_packs_epi32(_mm_and_si128(chars0, lowByte),
+                          _mm_and_si128(chars1, lowByte)),
+          _mm_packs_epi32(_mm_and_si128(chars2, lowByte),
+                          _mm_and_si128(chars3, lowByte))));
+    } /* while */
+    _mm_storeu_si128((__m128i *) checkParts, checkBits);
+    check = checkParts[0] | checkParts[1] | checkParts[2] | checkParts[3];
+#endif
     if (len != 0) {
       pos = (len + 31) & ~(memSizeType) 31;
       switch (len & 31) {
@@ -512,8 +572,29 @@ const strElemType *memchr_strelem (register const strElemType *mem,
 
   {
     register memSizeType blockCount;
+#if HAS_SSE2_INTRINSICS
+    __m128i searched;
+    unsigned int mask;
+#endif
 
   /* memchr_strelem */
+#if HAS_SSE2_INTRINSICS
+    /* Compare blocks of 4 characters with SSE2 instructions. */
+    searched = _mm_set1_epi32((int32Type) ch);
+    while (len >= 4) {
+      mask = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(
+          _mm_loadu_si128((const __m128i *) mem), searched)));
+      if (mask != 0) {
+        while ((mask & 1) == 0) {
+          mask >>= 1;
+          mem++;
+        } /* while */
+        return mem;
+      } /* if */
+      mem += 4;
+      len -= 4;
+    } /* while */
+#endif
     if (len != 0) {
       blockCount = (len + 31) >> 5;
       switch (len & 31) {
@@ -707,10 +788,221 @@ void heapFreeOsStri (const_os_striType var)
 
 
 
+#if HAS_AVX2_INTRINSICS
+static boolType avx2InstructionsSupported (void)
+
+  { /* avx2InstructionsSupported */
+    if (avx2InstructionsPresent == -1) {
+      __builtin_cpu_init();
+      avx2InstructionsPresent = __builtin_cpu_supports("avx2") != 0;
+      logMessage(printf("avx2InstructionsSupported: %d\n",
+                        avx2InstructionsPresent););
+    } /* if */
+    return avx2InstructionsPresent;
+  } /* avx2InstructionsSupported */
+#endif
+
+
+
+#if HAS_SSE2_INTRINSICS
+/**
+ *  Convert ASCII characters from UTF-8 to UTF-32 with SSE2 instructions.
+ *  Blocks of 16 bytes are converted as long as they contain only
+ *  ASCII bytes. The ASCII bytes in front of the first byte beyond
+ *  ASCII are also converted. At least one byte is left unconverted.
+ *  @param stri_ptr Place of the destination pointer (is advanced).
+ *  @param ustri UTF-8 encoded string to be converted.
+ *  @param len Number of bytes in ustri (must be greater than 16).
+ *  @return the number of bytes converted.
+ */
+static memSizeType utf8ToStriSse2 (strElemType **const stri_ptr,
+    const_ustriType ustri, memSizeType len)
+
+  {
+    strElemType *stri;
+    __m128i zero;
+    __m128i bytes;
+    __m128i words;
+    unsigned int mask = 0;
+    memSizeType pos = 0;
+
+  /* utf8ToStriSse2 */
+    stri = *stri_ptr;
+    zero = _mm_setzero_si128();
+    while (mask == 0 && len - pos > 16) {
+      bytes = _mm_loadu_si128((const __m128i *) &ustri[pos]);
+      mask = (unsigned int) _mm_movemask_epi8(bytes);
+      if (mask == 0) {
+        words = _mm_unpacklo_epi8(bytes, zero);
+        _mm_storeu_si128((__m128i *) &stri[0], _mm_unpacklo_epi16(words, zero));
+        _mm_storeu_si128((__m128i *) &stri[4], _mm_unpackhi_epi16(words, zero));
+        words = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128((__m128i *) &stri[8], _mm_unpacklo_epi16(words, zero));
+        _mm_storeu_si128((__m128i *) &stri[12], _mm_unpackhi_epi16(words, zero));
+        stri += 16;
+        pos += 16;
+      } else {
+        for (; (mask & 1) == 0; mask >>= 1) {
+          *stri++ = (strElemType) ustri[pos];
+          pos++;
+        } /* for */
+      } /* if */
+    } /* while */
+    *stri_ptr = stri;
+    return pos;
+  } /* utf8ToStriSse2 */
+#endif
+
+
+
+#if HAS_AVX2_INTRINSICS
+/**
+ *  Convert runs of UTF-8 characters to UTF-32 with AVX2 instructions.
+ *  Runs of ASCII characters are converted 32 bytes at a time.
+ *  Runs of 3-byte sequences (e.g.: CJK characters) are validated and
+ *  converted 24 bytes at a time and runs of 2-byte sequences (e.g.:
+ *  Latin, Greek and Cyrillic letters) are converted 32 bytes at a time.
+ *  The conversion stops at a byte sequence, that does not fit into
+ *  such a run. This sequence is left to the scalar conversion, which
+ *  also recognizes invalid sequences. At least one byte is left
+ *  unconverted.
+ *  @param stri_ptr Place of the destination pointer (is advanced).
+ *  @param ustri UTF-8 encoded string to be converted.
+ *  @param len Number of bytes in ustri (must be greater than 32).
+ *  @return the number of bytes converted.
+ */
+__attribute__((target("avx2")))
+static memSizeType utf8ToStriAvx2 (strElemType **const stri_ptr,
+    const_ustriType ustri, memSizeType len)
+
+  {
+    strElemType *stri;
+    const __m256i shuffle3 = _mm256_setr_epi8(
+        2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+        2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m256i shuffle2Low = _mm256_setr_epi8(
+        1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6, -1, -1,
+        1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6, -1, -1);
+    const __m256i shuffle2High = _mm256_setr_epi8(
+        9, 8, -1, -1, 11, 10, -1, -1, 13, 12, -1, -1, 15, 14, -1, -1,
+        9, 8, -1, -1, 11, 10, -1, -1, 13, 12, -1, -1, 15, 14, -1, -1);
+    const __m256i contBits = _mm256_set1_epi8((char) 0xC0);
+    const __m256i contMark = _mm256_set1_epi8((char) 0x80);
+    const __m256i low6Bits = _mm256_set1_epi32(0x3F);
+    __m256i bytes;
+    __m256i chars;
+    __m256i charsHigh;
+    unsigned int mask;
+    unsigned int leadMask;
+    unsigned int contMask;
+    unsigned int count;
+    boolType converting = TRUE;
+    memSizeType pos = 0;
+
+  /* utf8ToStriAvx2 */
+    stri = *stri_ptr;
+    while (converting && len - pos > 32) {
+      bytes = _mm256_loadu_si256((const __m256i *) &ustri[pos]);
+      mask = (unsigned int) _mm256_movemask_epi8(bytes);
+      if (mask == 0) {
+        /* 32 ASCII characters */
+        for (count = 0; count < 32; count += 8) {
+          _mm256_storeu_si256((__m256i *) &stri[count], _mm256_cvtepu8_epi32(
+              _mm_loadl_epi64((const __m128i *) &ustri[pos + count])));
+        } /* for */
+        stri += 32;
+        pos += 32;
+      } else if ((mask & 1) == 0) {
+        /* ASCII characters in front of the first non ASCII byte */
+        count = (unsigned int) __builtin_ctz(mask);
+        for (; count >= 8; count -= 8) {
+          _mm256_storeu_si256((__m256i *) stri, _mm256_cvtepu8_epi32(
+              _mm_loadl_epi64((const __m128i *) &ustri[pos])));
+          stri += 8;
+          pos += 8;
+        } /* for */
+        for (; count > 0; count--) {
+          *stri++ = (strElemType) ustri[pos];
+          pos++;
+        } /* for */
+      } else {
+        /* The lanes contain the bytes pos to pos + 15 and   */
+        /* pos + 12 to pos + 27. Every lane starts with four */
+        /* 3-byte sequences, if this is a run of them.       */
+        chars = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i *) &ustri[pos])),
+            _mm_loadu_si128((const __m128i *) &ustri[pos + 12]), 1);
+        leadMask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_and_si256(chars, _mm256_set1_epi8((char) 0xF0)),
+            _mm256_set1_epi8((char) 0xE0)));
+        contMask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_and_si256(chars, contBits), contMark));
+        if ((leadMask & 0xFFF) == 0x249 && (contMask & 0xFFF) == 0xDB6) {
+          /* Leading bits 1110.... at 0, 3, 6 and 9, 10...... elsewhere */
+          chars = _mm256_shuffle_epi8(chars, shuffle3);
+          chars = _mm256_or_si256(_mm256_or_si256(
+              _mm256_and_si256(chars, low6Bits),
+              _mm256_and_si256(_mm256_srli_epi32(chars, 2),
+                               _mm256_set1_epi32(0xFC0))),
+              _mm256_and_si256(_mm256_srli_epi32(chars, 4),
+                               _mm256_set1_epi32(0xF000)));
+          if ((leadMask & 0xFFF0000) == 0x2490000 &&
+              (contMask & 0xFFF0000) == 0xDB60000) {
+            _mm256_storeu_si256((__m256i *) stri, chars);
+            stri += 8;
+            pos += 24;
+          } else {
+            _mm_storeu_si128((__m128i *) stri, _mm256_castsi256_si128(chars));
+            stri += 4;
+            pos += 12;
+          } /* if */
+        } else {
+          leadMask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+              _mm256_and_si256(bytes, _mm256_set1_epi8((char) 0xE0)),
+              _mm256_set1_epi8((char) 0xC0)));
+          contMask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+              _mm256_and_si256(bytes, contBits), contMark));
+          if ((leadMask & 0xFFFF) == 0x5555 && (contMask & 0xFFFF) == 0xAAAA) {
+            /* Leading bits 110..... at even and 10...... at odd positions */
+            chars = _mm256_shuffle_epi8(bytes, shuffle2Low);
+            chars = _mm256_or_si256(_mm256_and_si256(chars, low6Bits),
+                _mm256_and_si256(_mm256_srli_epi32(chars, 2),
+                                 _mm256_set1_epi32(0x7C0)));
+            charsHigh = _mm256_shuffle_epi8(bytes, shuffle2High);
+            charsHigh = _mm256_or_si256(_mm256_and_si256(charsHigh, low6Bits),
+                _mm256_and_si256(_mm256_srli_epi32(charsHigh, 2),
+                                 _mm256_set1_epi32(0x7C0)));
+            _mm256_storeu_si256((__m256i *) stri,
+                _mm256_permute2x128_si256(chars, charsHigh, 0x20));
+            if (leadMask == 0x55555555 && contMask == 0xAAAAAAAA) {
+              _mm256_storeu_si256((__m256i *) &stri[8],
+                  _mm256_permute2x128_si256(chars, charsHigh, 0x31));
+              stri += 16;
+              pos += 32;
+            } else {
+              stri += 8;
+              pos += 16;
+            } /* if */
+          } else {
+            converting = FALSE;
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* while */
+    *stri_ptr = stri;
+    return pos;
+  } /* utf8ToStriAvx2 */
+#endif
+
+
+
 /**
  *  Convert an UTF-8 encoded string to an UTF-32 encoded string.
  *  The source and destination strings are not '\0' terminated.
  *  The memory for the destination dest_stri is not allocated.
+ *  Runs of ASCII characters and of 2-byte and 3-byte sequences are
+ *  converted with SIMD instructions, if they are available. All other
+ *  byte sequences are converted (and validated) one at a time.
  *  @param dest_stri Destination of the UTF-32 encoded string.
  *  @param dest_len Place to return the length of dest_stri.
  *  @param ustri UTF-8 encoded string to be converted.
@@ -723,12 +1015,31 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
 
   {
     strElemType *stri;
+#if HAS_SSE2_INTRINSICS || HAS_AVX2_INTRINSICS
+    memSizeType converted;
+#endif
 
   /* utf8_to_stri */
     stri = dest_stri;
-    for (; len > 0; len--) {
+    while (len > 0) {
+#if HAS_AVX2_INTRINSICS
+      if (len > 32 && avx2InstructionsSupported()) {
+        converted = utf8ToStriAvx2(&stri, ustri, len);
+        ustri += converted;
+        len -= converted;
+      } /* if */
+#endif
+#if HAS_SSE2_INTRINSICS
+      if (len > 16) {
+        converted = utf8ToStriSse2(&stri, ustri, len);
+        ustri += converted;
+        len -= converted;
+      } /* if */
+#endif
+      /* At least one byte is left for the scalar conversion. */
       if (*ustri <= 0x7F) {
         *stri++ = (strElemType) *ustri++;
+        len--;
       } else if (ustri[0] >= 0xC0 && ustri[0] <= 0xDF && len >= 2 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF) {
         /* ustri[0]   range 192 to 223 (leading bits 110.....) */
@@ -736,7 +1047,7 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
         *stri++ = (strElemType) (ustri[0] & 0x1F) << 6 |
                   (strElemType) (ustri[1] & 0x3F);
         ustri += 2;
-        len--;
+        len -= 2;
       } else if (ustri[0] >= 0xE0 && ustri[0] <= 0xEF && len >= 3 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF &&
                  ustri[2] >= 0x80 && ustri[2] <= 0xBF) {
@@ -746,7 +1057,7 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
                   (strElemType) (ustri[1] & 0x3F) <<  6 |
                   (strElemType) (ustri[2] & 0x3F);
         ustri += 3;
-        len -= 2;
+        len -= 3;
       } else if (ustri[0] >= 0xF0 && ustri[0] <= 0xF7 && len >= 4 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF &&
                  ustri[2] >= 0x80 && ustri[2] <= 0xBF &&
@@ -758,7 +1069,7 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
                   (strElemType) (ustri[2] & 0x3F) <<  6 |
                   (strElemType) (ustri[3] & 0x3F);
         ustri += 4;
-        len -= 3;
+        len -= 4;
       } else if (ustri[0] >= 0xF8 && ustri[0] <= 0xFB && len >= 5 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF &&
                  ustri[2] >= 0x80 && ustri[2] <= 0xBF &&
@@ -772,7 +1083,7 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
                   (strElemType) (ustri[3] & 0x3F) <<  6 |
                   (strElemType) (ustri[4] & 0x3F);
         ustri += 5;
-        len -= 4;
+        len -= 5;
       } else if (ustri[0] >= 0xFC && len >= 6 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF &&
                  ustri[2] >= 0x80 && ustri[2] <= 0xBF &&
@@ -788,14 +1099,14 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
                   (strElemType) (ustri[4] & 0x3F) <<  6 |
                   (strElemType) (ustri[5] & 0x3F);
         ustri += 6;
-        len -= 5;
+        len -= 6;
       } else {
         /* ustri[0] not in range 0xC0 to 0xFF (192 to 255) */
         /* or not enough continuation bytes found.         */
         *dest_len = (memSizeType) (stri - dest_stri);
         return len;
       } /* if */
-    } /* for */
+    } /* while */
     *dest_len = (memSizeType) (stri - dest_stri);
     return 0;
   } /* utf8_to_stri */
@@ -895,10 +1206,166 @@ memSizeType utf8_bytes_missing (const const_ustriType ustri, const memSizeType l
 
 
 
+#if HAS_SSE2_INTRINSICS
+/**
+ *  Convert ASCII characters from UTF-32 to UTF-8 with SSE2 instructions.
+ *  Blocks of 8 characters are converted as long as they contain only
+ *  ASCII characters. The ASCII characters in front of the first
+ *  character beyond ASCII are also converted. At least one character
+ *  is left unconverted.
+ *  @param ustri_ptr Place of the destination pointer (is advanced).
+ *  @param strelem UTF-32 encoded string to be converted.
+ *  @param len Number of UTF-32 characters in strelem (must be greater than 8).
+ *  @return the number of characters converted.
+ */
+static memSizeType striToUtf8Sse2 (ustriType *const ustri_ptr,
+    const strElemType *strelem, memSizeType len)
+
+  {
+    ustriType ustri;
+    __m128i zero;
+    __m128i notAscii;
+    __m128i low;
+    __m128i high;
+    boolType converting = TRUE;
+    memSizeType pos = 0;
+
+  /* striToUtf8Sse2 */
+    ustri = *ustri_ptr;
+    zero = _mm_setzero_si128();
+    notAscii = _mm_set1_epi32((int32Type) 0xFFFFFF80);
+    while (converting && len - pos > 8) {
+      low = _mm_loadu_si128((const __m128i *) &strelem[pos]);
+      high = _mm_loadu_si128((const __m128i *) &strelem[pos + 4]);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(
+          _mm_or_si128(low, high), notAscii), zero)) == 0xFFFF) {
+        _mm_storel_epi64((__m128i *) ustri,
+            _mm_packus_epi16(_mm_packs_epi32(low, high), zero));
+        ustri += 8;
+        pos += 8;
+      } else {
+        while (strelem[pos] <= 0x7F) {
+          *ustri++ = (ucharType) strelem[pos];
+          pos++;
+        } /* while */
+        converting = FALSE;
+      } /* if */
+    } /* while */
+    *ustri_ptr = ustri;
+    return pos;
+  } /* striToUtf8Sse2 */
+#endif
+
+
+
+#if HAS_AVX2_INTRINSICS
+/**
+ *  Convert runs of UTF-32 characters to UTF-8 with AVX2 instructions.
+ *  Runs of ASCII characters are converted 16 characters at a time.
+ *  Runs of characters from 0x800 to 0xFFFF (3-byte sequences) and
+ *  runs of characters from 0x80 to 0x7FF (2-byte sequences) are
+ *  converted 8 characters at a time. The conversion stops at a
+ *  character, that does not fit into such a run. At least one
+ *  character is left unconverted.
+ *  @param ustri_ptr Place of the destination pointer (is advanced).
+ *  @param strelem UTF-32 encoded string to be converted.
+ *  @param len Number of UTF-32 characters in strelem (must be greater than 16).
+ *  @return the number of characters converted.
+ */
+__attribute__((target("avx2")))
+static memSizeType striToUtf8Avx2 (ustriType *const ustri_ptr,
+    const strElemType *strelem, memSizeType len)
+
+  {
+    ustriType ustri;
+    const __m256i shuffle3 = _mm256_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i low6Bits = _mm256_set1_epi32(0x3F);
+    const __m256i contMark = _mm256_set1_epi32(0x80);
+    __m256i low;
+    __m256i high;
+    __m256i bytes;
+    __m128i upperBytes;
+    int32Type lastBytes;
+    unsigned int asciiMask;
+    boolType converting = TRUE;
+    memSizeType pos = 0;
+
+  /* striToUtf8Avx2 */
+    ustri = *ustri_ptr;
+    while (converting && len - pos > 16) {
+      low = _mm256_loadu_si256((const __m256i *) &strelem[pos]);
+      high = _mm256_loadu_si256((const __m256i *) &strelem[pos + 8]);
+      if (_mm256_testz_si256(_mm256_or_si256(low, high),
+                             _mm256_set1_epi32((int32Type) 0xFFFFFF80))) {
+        /* 16 ASCII characters */
+        bytes = _mm256_permute4x64_epi64(_mm256_packus_epi32(low, high), 0xD8);
+        _mm_storeu_si128((__m128i *) ustri, _mm_packus_epi16(
+            _mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1)));
+        ustri += 16;
+        pos += 16;
+      } else {
+        asciiMask = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(_mm256_and_si256(low,
+                _mm256_set1_epi32((int32Type) 0xFFFFFF80)),
+                _mm256_setzero_si256())));
+        if ((asciiMask & 1) != 0) {
+          /* ASCII characters in front of the first non ASCII character */
+          while (strelem[pos] <= 0x7F) {
+            *ustri++ = (ucharType) strelem[pos];
+            pos++;
+          } /* while */
+        } else if (_mm256_testz_si256(low, _mm256_set1_epi32((int32Type) 0xFFFF0000)) &&
+                   _mm256_movemask_epi8(_mm256_cmpgt_epi32(low,
+                       _mm256_set1_epi32(0x7FF))) == -1) {
+          /* 8 characters in the range 0x800 to 0xFFFF */
+          bytes = _mm256_or_si256(_mm256_or_si256(
+              _mm256_or_si256(_mm256_srli_epi32(low, 12), _mm256_set1_epi32(0xE0)),
+              _mm256_slli_epi32(_mm256_or_si256(_mm256_and_si256(
+                  _mm256_srli_epi32(low, 6), low6Bits), contMark), 8)),
+              _mm256_slli_epi32(_mm256_or_si256(
+                  _mm256_and_si256(low, low6Bits), contMark), 16));
+          bytes = _mm256_shuffle_epi8(bytes, shuffle3);
+          /* Every lane contains 12 bytes. Exactly 24 bytes are written. */
+          _mm_storeu_si128((__m128i *) ustri, _mm256_castsi256_si128(bytes));
+          upperBytes = _mm256_extracti128_si256(bytes, 1);
+          _mm_storel_epi64((__m128i *) &ustri[12], upperBytes);
+          lastBytes = _mm_cvtsi128_si32(_mm_srli_si128(upperBytes, 8));
+          memcpy(&ustri[20], &lastBytes, 4);
+          ustri += 24;
+          pos += 8;
+        } else if (_mm256_testz_si256(low, _mm256_set1_epi32((int32Type) 0xFFFFF800)) &&
+                   _mm256_movemask_epi8(_mm256_cmpgt_epi32(low,
+                       _mm256_set1_epi32(0x7F))) == -1) {
+          /* 8 characters in the range 0x80 to 0x7FF */
+          bytes = _mm256_or_si256(
+              _mm256_or_si256(_mm256_srli_epi32(low, 6), _mm256_set1_epi32(0xC0)),
+              _mm256_slli_epi32(_mm256_or_si256(
+                  _mm256_and_si256(low, low6Bits), contMark), 8));
+          bytes = _mm256_permute4x64_epi64(_mm256_packus_epi32(bytes, bytes), 0xD8);
+          _mm_storeu_si128((__m128i *) ustri, _mm256_castsi256_si128(bytes));
+          ustri += 16;
+          pos += 8;
+        } else {
+          converting = FALSE;
+        } /* if */
+      } /* if */
+    } /* while */
+    *ustri_ptr = ustri;
+    return pos;
+  } /* striToUtf8Avx2 */
+#endif
+
+
+
 /**
  *  Convert an UTF-32 encoded string to an UTF-8 encoded string.
  *  The source and destination strings are not '\0' terminated.
  *  The memory for the destination out_stri is not allocated.
+ *  Runs of ASCII characters and of characters, which are encoded with
+ *  2 or 3 bytes, are converted with SIMD instructions, if they are
+ *  available.
  *  @param out_stri Destination of the UTF-8 encoded string.
  *  @param strelem UTF-32 encoded string to be converted.
  *  @param len Number of UTF-32 characters in strelem.
@@ -908,12 +1375,30 @@ memSizeType stri_to_utf8 (const ustriType out_stri,
     const strElemType *strelem, memSizeType len)
 
   {
-    register ustriType ustri;
-    register strElemType ch;
+    ustriType ustri;
+    strElemType ch;
+#if HAS_SSE2_INTRINSICS || HAS_AVX2_INTRINSICS
+    memSizeType converted;
+#endif
 
   /* stri_to_utf8 */
     ustri = out_stri;
     for (; len > 0; strelem++, len--) {
+#if HAS_AVX2_INTRINSICS
+      if (len > 16 && avx2InstructionsSupported()) {
+        converted = striToUtf8Avx2(&ustri, strelem, len);
+        strelem += converted;
+        len -= converted;
+      } /* if */
+#endif
+#if HAS_SSE2_INTRINSICS
+      if (len > 8) {
+        converted = striToUtf8Sse2(&ustri, strelem, len);
+        strelem += converted;
+        len -= converted;
+      } /* if */
+#endif
+      /* At least one character is left for the scalar conversion. */
       ch = *strelem;
       if (ch <= 0x7F) {
         *ustri++ = (ucharType) ch;
@@ -56,6 +56,7 @@
 
 #define INITIAL_ARRAY_SIZE 256
 #define ARRAY_SIZE_FACTOR    2
+#define INITIAL_CSV_FIELDS  16
 
 
 
@@ -274,6 +275,88 @@ static arrayType strSplit (const const_striType mainStri,
 
 
 
+static arrayType strCsvFields (const const_striType stri, intType *const position,
+    const charType separator)
+
+  {
+    memSizeType pos;
+    striType field;
+    boolType endOfRecord = FALSE;
+    intType used_max_position = 0;
+    errInfoType err_info = OKAY_NO_ERROR;
+    arrayType resized_work_array;
+    arrayType result_array;
+
+  /* strCsvFields */
+    logFunction(printf("strCsvFields(\"%s\", " FMT_D ", '\\" FMT_U32 ";')\n",
+                       striAsUnquotedCStri(stri), *position, separator););
+    if (unlikely(*position <= 0)) {
+      logError(printf("strCsvFields(\"%s\", " FMT_D ", '\\" FMT_U32 ";'): "
+                      "Position <= 0.\n",
+                      striAsUnquotedCStri(stri), *position, separator););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } else if (unlikely(!ALLOC_ARRAY(result_array, INITIAL_CSV_FIELDS))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result_array->min_position = 1;
+    result_array->max_position = INITIAL_CSV_FIELDS;
+    pos = (memSizeType) *position - 1;
+    do {
+      field = getCsvField(stri->mem, stri->size, &pos, separator,
+                          &endOfRecord, &err_info);
+      if (field != NULL) {
+        if (used_max_position >= result_array->max_position) {
+          if (unlikely(result_array->max_position > (intType) (MAX_ARR_INDEX / ARRAY_SIZE_FACTOR) ||
+              (resized_work_array = REALLOC_ARRAY(result_array,
+                  (uintType) result_array->max_position,
+                  (uintType) result_array->max_position * ARRAY_SIZE_FACTOR)) == NULL)) {
+            FREE_STRI(field, field->size);
+            field = NULL;
+            err_info = MEMORY_ERROR;
+          } else {
+            result_array = resized_work_array;
+            COUNT3_ARRAY((uintType) result_array->max_position,
+                         (uintType) result_array->max_position * ARRAY_SIZE_FACTOR);
+            result_array->max_position *= ARRAY_SIZE_FACTOR;
+          } /* if */
+        } /* if */
+        if (field != NULL) {
+          result_array->arr[used_max_position].type_of = take_type(SYS_STRI_TYPE);
+          result_array->arr[used_max_position].descriptor.property = NULL;
+          result_array->arr[used_max_position].value.striValue = field;
+          INIT_CATEGORY_OF_VAR(&result_array->arr[used_max_position], STRIOBJECT);
+          used_max_position++;
+        } /* if */
+      } /* if */
+    } while (field != NULL && !endOfRecord);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      freeStriArray(result_array, used_max_position);
+      raise_error(err_info);
+      result_array = NULL;
+    } else {
+      if (!endOfRecord) {
+        /* The record is not complete. */
+        while (used_max_position > 0) {
+          used_max_position--;
+          field = result_array->arr[used_max_position].value.striValue;
+          FREE_STRI(field, field->size);
+        } /* while */
+      } else {
+        *position = (intType) pos + 1;
+      } /* if */
+      result_array = completeStriArray(result_array, used_max_position);
+      if (unlikely(result_array == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } /* if */
+    } /* if */
+    logFunction(printf("strCsvFields --> (position: " FMT_D ")\n", *position););
+    return result_array;
+  } /* strCsvFields */
+
+
+
 /**
  *  Append the string 'extension' to 'destination'.
  *  @exception MEMORY_ERROR Not enough memory for the concatenated
@@ -326,6 +409,27 @@ objectType str_append (listType arguments)
 
 
 
+/**
+ *  Append the decimal representation of 'number/arg_3' to 'str_to/arg_1'.
+ *  @exception MEMORY_ERROR Not enough memory for the concatenated
+ *             string.
+ */
+objectType str_append_int (listType arguments)
+
+  {
+    objectType str_variable;
+
+  /* str_append_int */
+    str_variable = arg_1(arguments);
+    isit_stri(str_variable);
+    is_variable(str_variable);
+    isit_int(arg_3(arguments));
+    strAppendInt(&str_variable->value.striValue, take_int(arg_3(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* str_append_int */
+
+
+
 /**
  *  Concatenate two strings.
  *  @return the result of the concatenation.
@@ -598,6 +702,40 @@ objectType str_create (listType arguments)
 
 
 
+/**
+ *  Read the fields of the CSV record that starts at 'position/arg_2'.
+ *  CSV fields are separated by the 'separator/arg_3' character.
+ *  A CSV record is terminated with '\n' or "\r\n". A CSV field might
+ *  be enclosed in double quotes ("). Double quotes inside a double
+ *  quoted field are represented by doubling them.
+ *  @param position/arg_2 Position of the record start. When the
+ *         function is left it refers to the character after the
+ *         record. If 'stri/arg_1' does not contain the complete
+ *         record 'position/arg_2' is unchanged.
+ *  @return the array of CSV fields, or an empty array if 'stri/arg_1'
+ *          does not contain the complete record.
+ *  @exception RANGE_ERROR 'position/arg_2' <= 0 holds or a double
+ *             quoted field is not followed by a separator or a line end.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+objectType str_csv_fields (listType arguments)
+
+  {
+    objectType position;
+
+  /* str_csv_fields */
+    isit_stri(arg_1(arguments));
+    position = arg_2(arguments);
+    isit_int(position);
+    is_variable(position);
+    isit_char(arg_3(arguments));
+    return bld_array_temp(
+        strCsvFields(take_stri(arg_1(arguments)), &position->value.intValue,
+                     take_char(arg_3(arguments))));
+  } /* str_csv_fields */
+
+
+
 /**
  *  Free the memory referred by 'old_string/arg_1'.
  *  After str_destr is left 'old_string/arg_1' is NULL.
@@ -988,6 +1126,42 @@ objectType str_ipos (listType arguments)
 
 
 
+/**
+ *  Determine the end of a JSON number that starts at 'start'.
+ *  @return the position of the character after the number, or
+ *          0 if the number might continue after the end of 'stri'.
+ *  @exception RANGE_ERROR 'start' <= 0 holds or the number
+ *             starting at 'start' is not a valid JSON number.
+ */
+objectType str_json_number_end (listType arguments)
+
+  { /* str_json_number_end */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        strJsonNumberEnd(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* str_json_number_end */
+
+
+
+/**
+ *  Determine the end of a JSON string that starts at 'start'.
+ *  @return the position of the character after the closing double
+ *          quote, or 0 if the JSON string is not terminated in 'stri'.
+ *  @exception RANGE_ERROR 'start' <= 0 holds or the JSON string
+ *             contains a control character or an illegal escape sequence.
+ */
+objectType str_json_string_end (listType arguments)
+
+  { /* str_json_string_end */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        strJsonStringEnd(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* str_json_string_end */
+
+
+
 /**
  *  Check if stri1 is less than or equal to stri2.
  *  @return TRUE if stri1 is less than or equal to stri2,
@@ -26,6 +26,7 @@
 /********************************************************************/
 
 objectType str_append        (listType arguments);
+objectType str_append_int    (listType arguments);
 objectType str_cat           (listType arguments);
 objectType str_chipos        (listType arguments);
 objectType str_chpos         (listType arguments);
@@ -34,6 +35,7 @@ objectType str_clit          (listType arguments);
 objectType str_cmp           (listType arguments);
 objectType str_cpy           (listType arguments);
 objectType str_create        (listType arguments);
+objectType str_csv_fields    (listType arguments);
 objectType str_destr         (listType arguments);
 objectType str_elemcpy       (listType arguments);
 objectType str_eq            (listType arguments);
@@ -47,6 +49,8 @@ objectType str_hashcode      (listType arguments);
 objectType str_head          (listType arguments);
 objectType str_idx           (listType arguments);
 objectType str_ipos          (listType arguments);
+objectType str_json_number_end (listType arguments);
+objectType str_json_string_end (listType arguments);
 objectType str_le            (listType arguments);
 objectType str_lit           (listType arguments);
 objectType str_lng           (listType arguments);
@@ -45,6 +45,7 @@
 #include "heaputl.h"
 #include "striutl.h"
 #include "fil_rtl.h"
+#include "set_rtl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -56,6 +57,7 @@
 #define GETS_DEFAULT_SIZE    1048576
 #define GETS_STRI_SIZE_DELTA    4096
 #define READ_STRI_INIT_SIZE      256
+#define READ_TOKEN_BUFFER_SIZE   256
 #define READ_STRI_SIZE_DELTA    2048
 #define WRITE_STRI_BLOCK_SIZE    512
 
@@ -261,6 +263,68 @@ static striType read_and_alloc_utf8_stri (cFileType inFile, memSizeType chars_mi
 
 
 
+/**
+ *  Read an UTF-8 encoded character from a locked C file.
+ *  ASCII characters are returned directly. For the lead byte of a
+ *  multi-byte sequence the continuation bytes are read and checked.
+ *  @param okay Variable that is set to FALSE if the file contains
+ *         an invalid encoding.
+ *  @return the character read, or EOF at the end of the file.
+ */
+static inline charType getUtf8CharUnlocked (cFileType cInFile, boolType *okay)
+
+  {
+    static const charType minimumValue[] = {0, 0, 0x80, 0x800, 0x10000,
+                                            0x200000, 0x4000000};
+    int character;
+    int length;
+    int index;
+    charType result;
+
+  /* getUtf8CharUnlocked */
+    character = getc_unlocked(cInFile);
+    if (character < 0x80) {
+      /* ASCII character or EOF */
+      result = (charType) character;
+    } else if (unlikely(character <= 0xBF)) {
+      /* Unexpected UTF-8 continuation byte */
+      *okay = FALSE;
+      result = 0;
+    } else {
+      if (character <= 0xDF) {
+        length = 2;
+        result = (charType) (character & 0x1F);
+      } else if (character <= 0xEF) {
+        length = 3;
+        result = (charType) (character & 0x0F);
+      } else if (character <= 0xF7) {
+        length = 4;
+        result = (charType) (character & 0x07);
+      } else if (character <= 0xFB) {
+        length = 5;
+        result = (charType) (character & 0x03);
+      } else {
+        length = 6;
+        result = (charType) (character & 0x01);
+      } /* if */
+      for (index = 1; index < length && *okay; index++) {
+        character = getc_unlocked(cInFile);
+        if (likely(character >= 0x80 && character <= 0xBF)) {
+          result = result << 6 | (charType) (character & 0x3F);
+        } else {
+          *okay = FALSE;
+        } /* if */
+      } /* for */
+      if (unlikely(result < minimumValue[length])) {
+        /* Overlong encodings are invalid. */
+        *okay = FALSE;
+      } /* if */
+    } /* if */
+    return result;
+  } /* getUtf8CharUnlocked */
+
+
+
 /**
  *  Read a character from an UTF-8 file.
  *  @return the character read, or EOF at the end of the file.
@@ -877,6 +941,150 @@ void ut8Seek (fileType aFile, intType position)
 
 
 
+/**
+ *  Read a string from an UTF-8 file as long as its characters are in 'charSet'.
+ *  The string starts with the character in 'terminationChar'. If this
+ *  character is not in 'charSet' nothing is read and "" is returned.
+ *  Otherwise characters are read until a character that is not in
+ *  'charSet' is found. This character is also read from 'inFile' and
+ *  assigned to 'terminationChar'. At the end of the file EOF is assigned
+ *  to 'terminationChar'. The characters are decoded directly from the
+ *  buffer of the C file, such that scanners can read a sequence of
+ *  digits, letters or whitespace with one call.
+ *  @param inFile File from which the string is read.
+ *  @param charSet Set of the characters that are accepted.
+ *  @param terminationChar Variable with the first character of the
+ *         string, which receives the first character which is not
+ *         in 'charSet' (or EOF).
+ *  @return the string read without the termination character.
+ *  @exception RANGE_ERROR The file contains an invalid encoding.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ *  @exception FILE_ERROR A system function returns an error.
+ */
+striType ut8SetRead (fileType inFile, const const_setType charSet,
+    charType *terminationChar)
+
+  {
+    cFileType cInFile;
+    charType ch;
+    boolType okay = TRUE;
+    register memSizeType position;
+    strElemType buffer[READ_TOKEN_BUFFER_SIZE];
+    strElemType *memory;
+    memSizeType memlength;
+    memSizeType newmemlength;
+    striType resized_result;
+    striType result = NULL;
+
+  /* ut8SetRead */
+    logFunction(printf("ut8SetRead(%s%d, *, '\\" FMT_U32 ";')\n",
+                       inFile == NULL ? "NULL " : "",
+                       inFile != NULL ? safe_fileno(inFile->cFile) : 0,
+                       *terminationChar););
+    cInFile = inFile->cFile;
+    if (unlikely(cInFile == NULL)) {
+      logError(printf("ut8SetRead: Attempt to read from closed file.\n"););
+      raise_error(FILE_ERROR);
+#if FREAD_WRONG_FOR_WRITE_ONLY_FILES
+    } else if (unlikely(!inFile->readingAllowed)) {
+      logError(printf("ut8SetRead(%d, *, *): "
+                      "The file is not open for reading.\n",
+                      safe_fileno(cInFile)););
+      raise_error(FILE_ERROR);
+#endif
+    } else if (*terminationChar == (charType) EOF ||
+               !charIsSetElem(*terminationChar, charSet)) {
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, 0))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = 0;
+      } /* if */
+    } else {
+      /* Short strings are collected in buffer. Longer strings */
+      /* are collected in the result, which grows as needed.   */
+      memory = buffer;
+      memlength = READ_TOKEN_BUFFER_SIZE;
+      memory[0] = *terminationChar;
+      position = 1;
+      flockfile(cInFile);
+      ch = getUtf8CharUnlocked(cInFile, &okay);
+      while (ch != (charType) EOF && okay && charIsSetElem(ch, charSet)) {
+        if (unlikely(position >= memlength)) {
+          newmemlength = memlength + READ_STRI_SIZE_DELTA;
+          if (result == NULL) {
+            if (likely(ALLOC_STRI_CHECK_SIZE(result, newmemlength))) {
+              memcpy(result->mem, buffer, position * sizeof(strElemType));
+            } /* if */
+          } else {
+            REALLOC_STRI_CHECK_SIZE(resized_result, result, memlength, newmemlength);
+            if (unlikely(resized_result == NULL)) {
+              FREE_STRI(result, memlength);
+            } else {
+              COUNT3_STRI(memlength, newmemlength);
+            } /* if */
+            result = resized_result;
+          } /* if */
+          if (unlikely(result == NULL)) {
+            funlockfile(cInFile);
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+          memory = result->mem;
+          memlength = newmemlength;
+        } /* if */
+        memory[position++] = ch;
+        ch = getUtf8CharUnlocked(cInFile, &okay);
+      } /* while */
+      funlockfile(cInFile);
+      if (unlikely(!okay ||
+                   (ch == (charType) EOF && position == 1 && ferror(cInFile)))) {
+        if (result != NULL) {
+          FREE_STRI(result, memlength);
+        } /* if */
+        if (!okay) {
+          logError(printf("ut8SetRead(%d, *, '\\" FMT_U32 ";'): "
+                          "The file contains an invalid encoding.\n",
+                          safe_fileno(cInFile), *terminationChar););
+          raise_error(RANGE_ERROR);
+        } else {
+          logError(printf("ut8SetRead(%d, *, '\\" FMT_U32 ";'): "
+                          "getc_unlocked(%d) failed:\n"
+                          "errno=%d\nerror: %s\n",
+                          safe_fileno(cInFile), *terminationChar,
+                          safe_fileno(cInFile), errno, strerror(errno)););
+          raise_error(FILE_ERROR);
+        } /* if */
+        result = NULL;
+      } else if (result == NULL) {
+        if (unlikely(!ALLOC_STRI_SIZE_OK(result, position))) {
+          raise_error(MEMORY_ERROR);
+        } else {
+          memcpy(result->mem, buffer, position * sizeof(strElemType));
+          result->size = position;
+          *terminationChar = ch;
+        } /* if */
+      } else {
+        REALLOC_STRI_SIZE_SMALLER(resized_result, result, memlength, position);
+        if (unlikely(resized_result == NULL)) {
+          FREE_STRI(result, memlength);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          result = resized_result;
+          COUNT3_STRI(memlength, position);
+          result->size = position;
+          *terminationChar = ch;
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("ut8SetRead(%d, *, '\\" FMT_U32 ";') --> \"%s\"\n",
+                       safe_fileno(cInFile), *terminationChar,
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* ut8SetRead */
+
+
+
 /**
  *  Read a word from an UTF-8 file.
  *  Before reading the word it skips spaces and tabs. The function
@@ -33,5 +33,7 @@ charType ut8Getc (fileType inFile);
 striType ut8Gets (fileType inFile, intType length);
 striType ut8LineRead (fileType inFile, charType *terminationChar);
 void ut8Seek (fileType aFile, intType file_position);
+striType ut8SetRead (fileType inFile, const const_setType charSet,
+    charType *terminationChar);
 striType ut8WordRead (fileType inFile, charType *terminationChar);
 void ut8Write (fileType outFile, const const_striType stri);
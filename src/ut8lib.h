@@ -29,5 +29,6 @@ objectType ut8_getc      (listType arguments);
 objectType ut8_gets      (listType arguments);
 objectType ut8_line_read (listType arguments);
 objectType ut8_seek      (listType arguments);
+objectType ut8_set_read  (listType arguments);
 objectType ut8_word_read (listType arguments);
 objectType ut8_write     (listType arguments);